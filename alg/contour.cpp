@@ -37,13 +37,22 @@
 
 #include "gdal.h"
 #include "gdal_alg.h"
+#include "gdal_thread_pool.h"
 #include "cpl_conv.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
 
+#include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
 
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
@@ -212,6 +221,412 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/* ==================================================================== */
+/*                  Multi-threaded contour generation                   */
+/* ==================================================================== */
+/*                                                                      */
+/*      The raster is split into horizontal strips whose contours are   */
+/*      generated in parallel, each strip starting from the last line   */
+/*      of the strip above it.  Strips share the horizontal edges       */
+/*      going through the pixel centers of that line, so the lines      */
+/*      crossing the boundary between two strips end at exactly the     */
+/*      same points in both strips, and are joined afterwards.          */
+/************************************************************************/
+
+namespace
+{
+
+// A line emitted by the contour generation of a strip
+struct ContourStripLine
+{
+    double level = 0;
+    marching_squares::LineString ls{};
+    bool closed = false;
+};
+
+// Collect the lines emitted by the segment merger of a strip
+struct ContourStripLineCollector
+{
+    CPL_DISALLOW_COPY_ASSIGN(ContourStripLineCollector)
+
+    explicit ContourStripLineCollector(std::vector<ContourStripLine> &lines)
+        : lines_(lines)
+    {
+    }
+
+    void addLine(double level, marching_squares::LineString &ls, bool closed)
+    {
+        lines_.emplace_back();
+        lines_.back().level = level;
+        lines_.back().ls.swap(ls);
+        lines_.back().closed = closed;
+    }
+
+  private:
+    std::vector<ContourStripLine> &lines_;
+};
+
+template <typename LevelGenerator> struct ContourStripJob
+{
+    LevelGenerator *levels = nullptr;
+    size_t width = 0;
+    size_t height = 0;
+    bool useNoData = false;
+    double noDataValue = 0;
+    bool polygonize = false;
+    size_t startLine = 0;
+    size_t lineCount = 0;
+    // Content of line startLine - 1, or nullptr for the first strip
+    const double *previousLine = nullptr;
+    const double *lines = nullptr;
+
+    std::vector<ContourStripLine> result{};
+    std::string errorMsg{};
+};
+
+template <typename LevelGenerator> void ContourStripJobFunc(void *pData)
+{
+    using namespace marching_squares;
+
+    auto job = static_cast<ContourStripJob<LevelGenerator> *>(pData);
+    try
+    {
+        ContourStripLineCollector collector(job->result);
+        SegmentMerger<ContourStripLineCollector, LevelGenerator> merger(
+            collector, *job->levels, job->polygonize);
+        ContourGenerator<decltype(merger), LevelGenerator> cg(
+            job->width, job->height, job->useNoData, job->noDataValue, merger,
+            *job->levels);
+        if (job->previousLine)
+            cg.setStartLine(job->startLine, job->previousLine);
+        for (size_t i = 0; i < job->lineCount; i++)
+            cg.feedLine(job->lines + i * job->width);
+        // Lines crossing the strip boundaries are not closed yet.
+        merger.emitRemainingLines();
+    }
+    catch (const std::exception &e)
+    {
+        job->errorMsg = e.what();
+    }
+}
+
+// Join the lines of consecutive strips that end on their common boundary,
+// and forward the completed lines to the line writer.
+template <typename LineWriter> class ContourStripStitcher
+{
+  public:
+    explicit ContourStripStitcher(LineWriter &lineWriter)
+        : lineWriter_(lineWriter)
+    {
+    }
+
+    // Declare a boundary between two strips, the upper one ending at line
+    // lineIdx - 1 and the lower one starting at line lineIdx.
+    void addBoundary(size_t lineIdx)
+    {
+        boundaries_.insert(static_cast<double>(lineIdx - 1) + .5);
+    }
+
+    void addLines(std::vector<ContourStripLine> &lines)
+    {
+        for (auto &line : lines)
+        {
+            const auto &front = line.ls.front();
+            const auto &back = line.ls.back();
+            if (line.closed || front == back ||
+                (boundaries_.find(front.y) == boundaries_.end() &&
+                 boundaries_.find(back.y) == boundaries_.end()))
+            {
+                lineWriter_.addLine(line.level, line.ls, line.closed);
+            }
+            else
+            {
+                pending_.emplace_back(std::move(line));
+            }
+        }
+        lines.clear();
+    }
+
+    // Join the pending lines, and write the resulting ones that do not end
+    // on the boundary at openBoundaryY, below which strips have not been
+    // processed yet. openBoundaryY is NaN once all strips are processed.
+    void stitch(double openBoundaryY)
+    {
+        typedef std::tuple<double, double, double> Key;
+        std::map<Key, std::vector<size_t>> endToLines;
+        const auto keyOf = [](const ContourStripLine &line,
+                              const marching_squares::Point &p)
+        { return Key(line.level, p.x, p.y); };
+        for (size_t i = 0; i < pending_.size(); i++)
+        {
+            const auto &line = pending_[i];
+            for (const auto &p : {line.ls.front(), line.ls.back()})
+            {
+                if (p.y != openBoundaryY &&
+                    boundaries_.find(p.y) != boundaries_.end())
+                    endToLines[keyOf(line, p)].push_back(i);
+            }
+        }
+
+        std::vector<bool> used(pending_.size());
+        const auto findOther = [&](const ContourStripLine &line,
+                                   const marching_squares::Point &p)
+        {
+            const auto it = endToLines.find(keyOf(line, p));
+            if (it != endToLines.end())
+            {
+                for (const size_t j : it->second)
+                {
+                    if (!used[j])
+                        return j;
+                }
+            }
+            return pending_.size();
+        };
+
+        std::vector<ContourStripLine> stillPending;
+        for (size_t i = 0; i < pending_.size(); i++)
+        {
+            if (used[i])
+                continue;
+            used[i] = true;
+            ContourStripLine &line = pending_[i];
+            auto &ls = line.ls;
+
+            // Extend the line at its end, then at its start.
+            while (!(ls.front() == ls.back()))
+            {
+                const size_t j = findOther(line, ls.back());
+                if (j == pending_.size())
+                    break;
+                used[j] = true;
+                auto &other = pending_[j].ls;
+                if (other.front() == ls.back())
+                {
+                    other.pop_front();
+                    ls.splice(ls.end(), other);
+                }
+                else
+                {
+                    other.pop_back();
+                    ls.insert(ls.end(), other.rbegin(), other.rend());
+                }
+            }
+            while (!(ls.front() == ls.back()))
+            {
+                const size_t j = findOther(line, ls.front());
+                if (j == pending_.size())
+                    break;
+                used[j] = true;
+                auto &other = pending_[j].ls;
+                if (other.back() == ls.front())
+                {
+                    other.pop_back();
+                    ls.splice(ls.begin(), other);
+                }
+                else
+                {
+                    other.pop_front();
+                    ls.insert(ls.begin(), other.rbegin(), other.rend());
+                }
+            }
+
+            if (ls.front() == ls.back())
+            {
+                lineWriter_.addLine(line.level, ls, /* closed */ true);
+            }
+            else if (ls.front().y == openBoundaryY ||
+                     ls.back().y == openBoundaryY)
+            {
+                stillPending.emplace_back(std::move(line));
+            }
+            else
+            {
+                lineWriter_.addLine(line.level, ls, /* closed */ false);
+            }
+        }
+        pending_ = std::move(stillPending);
+    }
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(ContourStripStitcher)
+
+    LineWriter &lineWriter_;
+    std::set<double> boundaries_{};
+    std::vector<ContourStripLine> pending_{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                    GDALContourGenerateByStrips()                     */
+/************************************************************************/
+
+template <typename LineWriter, typename LevelGenerator>
+static bool GDALContourGenerateByStrips(GDALRasterBandH hBand, bool useNoData,
+                                        double noDataValue,
+                                        LineWriter &lineWriter,
+                                        LevelGenerator &levels,
+                                        bool polygonize, int nThreads,
+                                        GDALProgressFunc pfnProgress,
+                                        void *pProgressArg)
+{
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+
+    // Compute the height of the strips, so that a batch of one strip per
+    // thread fits in the memory budget, and that there is at least one
+    // strip per thread.
+    const GIntBig nMaxMemory = std::max(static_cast<GIntBig>(10 * 1000 * 1000),
+                                        GDALGetCacheMax64() / 10);
+    const GIntBig nBytesPerLine =
+        static_cast<GIntBig>(nXSize) * static_cast<GIntBig>(sizeof(double));
+    int nStripYSize = static_cast<int>(std::max(
+        static_cast<GIntBig>(1),
+        std::min(static_cast<GIntBig>((nYSize + nThreads - 1) / nThreads),
+                 nMaxMemory / (nBytesPerLine * nThreads))));
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hBand, nullptr, &nBlockYSize);
+    if (nBlockYSize > 0 && nStripYSize > nBlockYSize)
+        nStripYSize = nStripYSize / nBlockYSize * nBlockYSize;
+    const int nStrips = (nYSize - 1) / nStripYSize + 1;
+    const int nBatchYSize = std::min(nYSize, nStripYSize * nThreads);
+
+    // The first line of the buffer is the line above the batch.
+    std::vector<double> adfLines;
+    try
+    {
+        adfLines.resize(static_cast<size_t>(nXSize) * (nBatchYSize + 1));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
+        return false;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    ContourStripStitcher<LineWriter> stitcher(lineWriter);
+    std::vector<ContourStripJob<LevelGenerator>> asJobs;
+    for (int iFirstStrip = 0; iFirstStrip < nStrips; iFirstStrip += nThreads)
+    {
+        const int nJobs = std::min(nThreads, nStrips - iFirstStrip);
+        const int nYOff = iFirstStrip * nStripYSize;
+        const int nReqYSize =
+            std::min(nYSize, nYOff + nJobs * nStripYSize) - nYOff;
+
+        if (iFirstStrip > 0)
+        {
+            std::copy(adfLines.begin() + static_cast<size_t>(nXSize) *
+                                             nBatchYSize,
+                      adfLines.end(), adfLines.begin());
+        }
+        if (GDALRasterIO(hBand, GF_Read, 0, nYOff, nXSize, nReqYSize,
+                         adfLines.data() + nXSize, nXSize, nReqYSize,
+                         GDT_Float64, 0, 0) != CE_None)
+        {
+            return false;
+        }
+
+        asJobs.clear();
+        asJobs.resize(nJobs);
+        for (int i = 0; i < nJobs; i++)
+        {
+            auto &sJob = asJobs[i];
+            const int nStripYOff = nYOff + i * nStripYSize;
+            sJob.levels = &levels;
+            sJob.width = nXSize;
+            sJob.height = nYSize;
+            sJob.useNoData = useNoData;
+            sJob.noDataValue = noDataValue;
+            sJob.polygonize = polygonize;
+            sJob.startLine = nStripYOff;
+            sJob.lineCount = std::min(nStripYSize, nYSize - nStripYOff);
+            const double *padfLine =
+                adfLines.data() +
+                static_cast<size_t>(nXSize) * (nStripYOff - nYOff);
+            sJob.previousLine = nStripYOff > 0 ? padfLine : nullptr;
+            sJob.lines = padfLine + nXSize;
+            if (nStripYOff > 0)
+                stitcher.addBoundary(nStripYOff);
+        }
+        const int nYEnd = nYOff + nReqYSize;
+        if (nYEnd < nYSize)
+            stitcher.addBoundary(nYEnd);
+
+        if (poJobQueue && nJobs > 1)
+        {
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob(ContourStripJobFunc<LevelGenerator>,
+                                      &sJob);
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (auto &sJob : asJobs)
+                ContourStripJobFunc<LevelGenerator>(&sJob);
+        }
+
+        // Write the lines in the order of the strips.
+        for (auto &sJob : asJobs)
+        {
+            if (!sJob.errorMsg.empty())
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         sJob.errorMsg.c_str());
+                return false;
+            }
+            stitcher.addLines(sJob.result);
+        }
+        stitcher.stitch(nYEnd < nYSize
+                            ? static_cast<double>(nYEnd - 1) + .5
+                            : std::numeric_limits<double>::quiet_NaN());
+
+        if (!pfnProgress(static_cast<double>(nYEnd) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                   GDALContourGenerateWithWriter()                    */
+/*                                                                      */
+/*      Generate the contours of a band, with the given line writer     */
+/*      (GDALRingAppender or PolygonRingAppender) and level iterator.   */
+/************************************************************************/
+
+template <typename LineWriter, typename LevelGenerator>
+static bool GDALContourGenerateWithWriter(
+    GDALRasterBandH hBand, bool useNoData, double noDataValue,
+    LineWriter &lineWriter, LevelGenerator &levels, bool polygonize,
+    int nThreads, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    if (nThreads > 1 && GDALGetRasterBandYSize(hBand) > 1)
+    {
+        return GDALContourGenerateByStrips(hBand, useNoData, noDataValue,
+                                           lineWriter, levels, polygonize,
+                                           nThreads, pfnProgress,
+                                           pProgressArg);
+    }
+
+    SegmentMerger<LineWriter, LevelGenerator> writer(lineWriter, levels,
+                                                     polygonize);
+    ContourGeneratorFromRaster<decltype(writer), LevelGenerator> cg(
+        hBand, useNoData, noDataValue, writer, levels);
+    return cg.process(pfnProgress, pProgressArg);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -547,6 +962,17 @@ mode.
  *
  * If YES, contour polygons will be created, rather than polygon lines.
  *
+ *   NUM_THREADS=number_of_threads/ALL_CPUS (GDAL >= 3.10)
+ *
+ * Number of threads used to generate contours. When greater than 1, the
+ * raster is processed by horizontal strips in parallel, and the lines
+ * crossing the strip boundaries are joined afterwards. The resulting
+ * contours are the same, but their order and their starting points may
+ * differ from a single-threaded run, and contours going through pixel
+ * centers (which can happen at the level equal to the raster minimum) may
+ * be split differently. For that reason, the GDAL_NUM_THREADS configuration
+ * option is not taken into account, and this defaults to 1.
+ *
  *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
@@ -653,6 +1079,13 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    // Do not default to GDAL_NUM_THREADS, as the output is not strictly
+    // identical with several threads.
+    const char *pszThreads = CSLFetchNameValueDef(options, "NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -720,12 +1153,9 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(),
                     -std::numeric_limits<double>::infinity(), dfMaximum);
-                SegmentMerger<RingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ true, nThreads, pfnProgress, pProgressArg);
             }
             else if (expBase > 0.0)
             {
@@ -734,12 +1164,9 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 // with a degenerate min=max range.
                 ExponentialLevelRangeIterator levels(
                     expBase, -std::numeric_limits<double>::infinity());
-                SegmentMerger<RingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ true, nThreads, pfnProgress, pProgressArg);
             }
             else
             {
@@ -749,12 +1176,9 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 IntervalLevelRangeIterator levels(
                     contourBase, contourInterval,
                     -std::numeric_limits<double>::infinity());
-                SegmentMerger<RingAppender, IntervalLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ true);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ true, nThreads, pfnProgress, pProgressArg);
             }
         }
         else
@@ -764,33 +1188,27 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
             {
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(), dfMinimum, dfMaximum);
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ false, nThreads, pfnProgress,
+                    pProgressArg);
             }
             else if (expBase > 0.0)
             {
                 ExponentialLevelRangeIterator levels(expBase, dfMinimum);
-                SegmentMerger<GDALRingAppender, ExponentialLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           ExponentialLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ false, nThreads, pfnProgress,
+                    pProgressArg);
             }
             else
             {
                 IntervalLevelRangeIterator levels(contourBase, contourInterval,
                                                   dfMinimum);
-                SegmentMerger<GDALRingAppender, IntervalLevelRangeIterator>
-                    writer(appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           IntervalLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                ok = GDALContourGenerateWithWriter(
+                    hBand, useNoData, noDataValue, appender, levels,
+                    /* polygonize */ false, nThreads, pfnProgress,
+                    pProgressArg);
             }
         }
     }
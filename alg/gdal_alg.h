@@ -60,6 +60,10 @@ int CPL_DLL CPL_STDCALL GDALDitherRGB2PCT(
 int CPL_DLL CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff,
                                           int nYOff, int nXSize, int nYSize);
 
+int CPL_DLL GDALChecksumImageEx(GDALRasterBandH hBand, int nXOff, int nYOff,
+                                int nXSize, int nYSize,
+                                CSLConstList papszOptions, char **ppszHash);
+
 CPLErr CPL_DLL CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
                                                 GDALRasterBandH hProximityBand,
                                                 char **papszOptions,
@@ -246,6 +250,16 @@ int CPL_DLL GDALApproxTransform(void *pTransformArg, int bDstToSrc,
                                 int nPointCount, double *x, double *y,
                                 double *z, int *panSuccess);
 
+/* Warp plan transformer */
+void CPL_DLL *
+GDALCreateWarpPlanTransformer(GDALTransformerFunc pfnBaseTransformer,
+                              void *pBaseTransformArg, int bOwnBaseTransformer);
+void CPL_DLL GDALDestroyWarpPlanTransformer(void *pTransformArg);
+int CPL_DLL GDALWarpPlanTransform(void *pTransformArg, int bDstToSrc,
+                                  int nPointCount, double *x, double *y,
+                                  double *z, int *panSuccess);
+void CPL_DLL GDALClearWarpPlanCache(void);
+
 int CPL_DLL CPL_STDCALL GDALSimpleImageWarp(
     GDALDatasetH hSrcDS, GDALDatasetH hDstDS, int nBandCount, int *panBandList,
     GDALTransformerFunc pfnTransform, void *pTransformArg,
@@ -173,6 +173,11 @@ constexpr const char *GDAL_APPROX_TRANSFORMER_CLASS_NAME =
     "GDALApproxTransformer";
 constexpr const char *GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME =
     "GDALGenImgProjTransformer";
+constexpr const char *GDAL_WARP_PLAN_TRANSFORMER_CLASS_NAME =
+    "GDALWarpPlanTransformer";
+
+void *GDALDeserializeWarpPlanTransformer(CPLXMLNode *psTree);
+void *GDALGetWarpPlanBaseTransformer(void *pTransformArg);
 
 bool GDALIsTransformer(void *hTransformerArg, const char *pszClassName);
 
@@ -37,7 +37,11 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -194,11 +198,12 @@ char **RPCInfoV2ToMD(GDALRPCInfoV2 *psRPCInfo)
 /*                          RPCComputeTerms()                           */
 /************************************************************************/
 
-static void RPCComputeTerms(double dfLong, double dfLat, double dfHeight,
-                            double *padfTerms)
+template <class T>
+static void RPCComputeTerms(const T dfLong, const T dfLat, const T dfHeight,
+                            const T dfOne, T *padfTerms)
 
 {
-    padfTerms[0] = 1.0;
+    padfTerms[0] = dfOne;
     padfTerms[1] = dfLong;
     padfTerms[2] = dfLat;
     padfTerms[3] = dfHeight;
@@ -236,6 +241,12 @@ typedef enum
     /*! Cubic Convolution Approximation (4x4 kernel) */ DRA_Cubic = 2
 } DEMResampleAlg;
 
+// Cache of DEM blocks, shared by the transformers using the same DEM.
+// The key is (nYBlock << 32) | nXBlock)
+typedef lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>,
+                     std::mutex>
+    GDALRPCDEMBlockCache;
+
 typedef struct
 {
 
@@ -264,8 +275,7 @@ typedef struct
     int bApplyDEMVDatumShift;
 
     GDALDataset *poDS;
-    // the key is (nYBlock << 32) | nXBlock)
-    lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>> *poCacheDEM;
+    std::shared_ptr<GDALRPCDEMBlockCache> *poCacheDEM;
 
     OGRCoordinateTransformation *poCT;
 
@@ -357,20 +367,16 @@ static double RPCEvaluate(const double *padfTerms, const double *padfCoefs)
 #endif
 
 /************************************************************************/
-/*                         RPCTransformPoint()                          */
+/*                     RPCNormalizeLongLatHeight()                      */
 /************************************************************************/
 
-static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
-                              double dfLong, double dfLat, double dfHeight,
-                              double *pdfPixel, double *pdfLine)
+static void
+RPCNormalizeLongLatHeight(const GDALRPCTransformInfo *psRPCTransformInfo,
+                          double dfLong, double dfLat, double dfHeight,
+                          double &dfNormalizedLong, double &dfNormalizedLat,
+                          double &dfNormalizedHeight)
 
 {
-    double adfTermsWithMargin[20 + 1] = {};
-    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
-    double *padfTerms =
-        adfTermsWithMargin +
-        (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
-
     // Avoid dateline issues.
     double diffLong = dfLong - psRPCTransformInfo->sRPC.dfLONG_OFF;
     if (diffLong < -270)
@@ -382,14 +388,11 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
         diffLong -= 360;
     }
 
-    const double dfNormalizedLong =
-        diffLong / psRPCTransformInfo->sRPC.dfLONG_SCALE;
-    const double dfNormalizedLat =
-        (dfLat - psRPCTransformInfo->sRPC.dfLAT_OFF) /
-        psRPCTransformInfo->sRPC.dfLAT_SCALE;
-    const double dfNormalizedHeight =
-        (dfHeight - psRPCTransformInfo->sRPC.dfHEIGHT_OFF) /
-        psRPCTransformInfo->sRPC.dfHEIGHT_SCALE;
+    dfNormalizedLong = diffLong / psRPCTransformInfo->sRPC.dfLONG_SCALE;
+    dfNormalizedLat = (dfLat - psRPCTransformInfo->sRPC.dfLAT_OFF) /
+                      psRPCTransformInfo->sRPC.dfLAT_SCALE;
+    dfNormalizedHeight = (dfHeight - psRPCTransformInfo->sRPC.dfHEIGHT_OFF) /
+                         psRPCTransformInfo->sRPC.dfHEIGHT_SCALE;
 
     // The absolute values of the 3 above normalized values are supposed to be
     // below 1. Warn (as debug message) if it is not the case. We allow for some
@@ -439,8 +442,31 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
             }
         }
     }
+}
+
+/************************************************************************/
+/*                         RPCTransformPoint()                          */
+/************************************************************************/
+
+static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
+                              double dfLong, double dfLat, double dfHeight,
+                              double *pdfPixel, double *pdfLine)
+
+{
+    double adfTermsWithMargin[20 + 1] = {};
+    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
+    double *padfTerms =
+        adfTermsWithMargin +
+        (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
+
+    double dfNormalizedLong = 0.0;
+    double dfNormalizedLat = 0.0;
+    double dfNormalizedHeight = 0.0;
+    RPCNormalizeLongLatHeight(psRPCTransformInfo, dfLong, dfLat, dfHeight,
+                              dfNormalizedLong, dfNormalizedLat,
+                              dfNormalizedHeight);
 
-    RPCComputeTerms(dfNormalizedLong, dfNormalizedLat, dfNormalizedHeight,
+    RPCComputeTerms(dfNormalizedLong, dfNormalizedLat, dfNormalizedHeight, 1.0,
                     padfTerms);
 
 #ifdef USE_SSE2_OPTIM
@@ -470,6 +496,142 @@ static void RPCTransformPoint(const GDALRPCTransformInfo *psRPCTransformInfo,
                psRPCTransformInfo->sRPC.dfLINE_OFF + 0.5;
 }
 
+/************************************************************************/
+/*                         RPCTransformPoints()                         */
+/************************************************************************/
+
+// Same as RPCTransformPoint() on arrays of points. The output arrays may be
+// the input ones. With SSE2, the polynomials are evaluated for two points at
+// once, with the operations of RPCEvaluate4() in the same order, so that the
+// results are identical.
+static void RPCTransformPoints(const GDALRPCTransformInfo *psRPCTransformInfo,
+                               int nPointCount, const double *padfLong,
+                               const double *padfLat, const double *padfHeight,
+                               double *padfPixel, double *padfLine)
+
+{
+    int i = 0;
+#ifdef USE_SSE2_OPTIM
+    const double *padfCoeffs = psRPCTransformInfo->padfCoeffs;
+    const GDALRPCInfoV2 &sRPC = psRPCTransformInfo->sRPC;
+    const auto samp_scale =
+        XMMReg2Double::Load1ValHighAndLow(&sRPC.dfSAMP_SCALE);
+    const auto samp_off = XMMReg2Double::Load1ValHighAndLow(&sRPC.dfSAMP_OFF);
+    const auto line_scale =
+        XMMReg2Double::Load1ValHighAndLow(&sRPC.dfLINE_SCALE);
+    const auto line_off = XMMReg2Double::Load1ValHighAndLow(&sRPC.dfLINE_OFF);
+    const double dfOne = 1.0;
+    const double dfHalf = 0.5;
+    const auto one = XMMReg2Double::Load1ValHighAndLow(&dfOne);
+    const auto half = XMMReg2Double::Load1ValHighAndLow(&dfHalf);
+    for (; i + 1 < nPointCount; i += 2)
+    {
+        double adfNormalizedLong[2];
+        double adfNormalizedLat[2];
+        double adfNormalizedHeight[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            RPCNormalizeLongLatHeight(
+                psRPCTransformInfo, padfLong[i + j], padfLat[i + j],
+                padfHeight[i + j], adfNormalizedLong[j], adfNormalizedLat[j],
+                adfNormalizedHeight[j]);
+        }
+
+        XMMReg2Double aoTerms[20];
+        RPCComputeTerms(XMMReg2Double::Load2Val(adfNormalizedLong),
+                        XMMReg2Double::Load2Val(adfNormalizedLat),
+                        XMMReg2Double::Load2Val(adfNormalizedHeight), one,
+                        aoTerms);
+
+        // LINE_NUM_COEFF, LINE_DEN_COEFF, SAMP_NUM_COEFF and SAMP_DEN_COEFF,
+        // for the terms of even and odd index.
+        XMMReg2Double aoSumsEven[4] = {
+            XMMReg2Double::Zero(), XMMReg2Double::Zero(), XMMReg2Double::Zero(),
+            XMMReg2Double::Zero()};
+        XMMReg2Double aoSumsOdd[4] = {
+            XMMReg2Double::Zero(), XMMReg2Double::Zero(), XMMReg2Double::Zero(),
+            XMMReg2Double::Zero()};
+        for (int k = 0; k < 20; k += 2)
+        {
+            for (int iPoly = 0; iPoly < 4; ++iPoly)
+            {
+                aoSumsEven[iPoly] +=
+                    aoTerms[k] * XMMReg2Double::Load1ValHighAndLow(
+                                     padfCoeffs + iPoly * 20 + k);
+                aoSumsOdd[iPoly] +=
+                    aoTerms[k + 1] * XMMReg2Double::Load1ValHighAndLow(
+                                         padfCoeffs + iPoly * 20 + k + 1);
+            }
+        }
+
+        const auto resultY = (aoSumsEven[0] + aoSumsOdd[0]) /
+                             (aoSumsEven[1] + aoSumsOdd[1]);
+        const auto resultX = (aoSumsEven[2] + aoSumsOdd[2]) /
+                             (aoSumsEven[3] + aoSumsOdd[3]);
+
+        // RPCs are using the center of upper left pixel = 0,0 convention
+        // convert to top left corner = 0,0 convention used in GDAL.
+        (resultX * samp_scale + samp_off + half).Store2Val(padfPixel + i);
+        (resultY * line_scale + line_off + half).Store2Val(padfLine + i);
+    }
+#endif
+    for (; i < nPointCount; ++i)
+    {
+        RPCTransformPoint(psRPCTransformInfo, padfLong[i], padfLat[i],
+                          padfHeight[i], padfPixel + i, padfLine + i);
+    }
+}
+
+namespace
+{
+
+/************************************************************************/
+/*                            RPCPointBatch                             */
+/************************************************************************/
+
+// Points of an array gathered to be transformed together by
+// RPCTransformPoints().
+struct RPCPointBatch
+{
+    std::vector<int> anIndex{};
+    std::vector<double> adfLong{};
+    std::vector<double> adfLat{};
+    std::vector<double> adfHeight{};
+
+    explicit RPCPointBatch(int nPointCount)
+    {
+        anIndex.reserve(nPointCount);
+        adfLong.reserve(nPointCount);
+        adfLat.reserve(nPointCount);
+        adfHeight.reserve(nPointCount);
+    }
+
+    void Add(int i, double dfLong, double dfLat, double dfHeight)
+    {
+        anIndex.push_back(i);
+        adfLong.push_back(dfLong);
+        adfLat.push_back(dfLat);
+        adfHeight.push_back(dfHeight);
+    }
+
+    // Transform the points and store their pixel/line at their index in
+    // padfX and padfY.
+    void Transform(const GDALRPCTransformInfo *psTransform, double *padfX,
+                   double *padfY)
+    {
+        const int nCount = static_cast<int>(anIndex.size());
+        RPCTransformPoints(psTransform, nCount, adfLong.data(), adfLat.data(),
+                           adfHeight.data(), adfLong.data(), adfLat.data());
+        for (int j = 0; j < nCount; ++j)
+        {
+            padfX[anIndex[j]] = adfLong[j];
+            padfY[anIndex[j]] = adfLat[j];
+        }
+    }
+};
+
+}  // namespace
+
 /************************************************************************/
 /*                     GDALSerializeRPCDEMResample()                    */
 /************************************************************************/
@@ -730,8 +892,8 @@ void *GDALCreateRPCTransformerV1(GDALRPCInfoV1 *psRPCInfo, int bReversed,
  * extra debug information will be displayed in the "RPC" debug category, so
  * requiring CPL_DEBUG to be also set) and/or by setting RPC_INVERSE_LOG to a
  * filename that will contain the content of iterations (this last option only
- * makes sense when debugging point by point, since each time
- * RPCInverseTransformPoint() is called, the file is rewritten).
+ * makes sense when debugging point by point, since the file is rewritten for
+ * each point).
  *
  * Additional options to the transformer can be supplied in papszOptions.
  *
@@ -1106,6 +1268,8 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
 
     if (psTransform->poDS)
         GDALClose(psTransform->poDS);
+    // Release our reference to the DEM block cache, which is destroyed with
+    // the last transformer using it.
     delete psTransform->poCacheDEM;
     if (psTransform->poCT)
         OCTDestroyCoordinateTransformation(
@@ -1120,38 +1284,72 @@ void GDALDestroyRPCTransformer(void *pTransformAlg)
 }
 
 /************************************************************************/
-/*                      RPCInverseTransformPoint()                      */
+/*                     RPCInverseTransformPoints()                      */
 /************************************************************************/
 
-static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
-                                     double dfPixel, double dfLine,
-                                     double dfUserHeight, double *pdfLong,
-                                     double *pdfLat)
+// Compute the long/lat of an array of pixel/line/height points. The points
+// iterate in lockstep, so that the RPC polynomials of each iteration are
+// evaluated on all the points not converged yet at once.
+static void RPCInverseTransformPoints(GDALRPCTransformInfo *psTransform,
+                                      int nPointCount, const double *padfPixel,
+                                      const double *padfLine,
+                                      const double *padfUserHeight,
+                                      double *padfLong, double *padfLat,
+                                      int *panSuccess)
 
 {
     // Memo:
     // Known to work with 40 iterations with DEM on all points (int coord and
     // +0.5,+0.5 shift) of flock1.20160216_041050_0905.tif, especially on (0,0).
 
-    /* -------------------------------------------------------------------- */
-    /*      Compute an initial approximation based on linear                */
-    /*      interpolation from our reference point.                         */
-    /* -------------------------------------------------------------------- */
-    double dfResultX = psTransform->adfPLToLatLongGeoTransform[0] +
-                       psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
-                       psTransform->adfPLToLatLongGeoTransform[2] * dfLine;
-
-    double dfResultY = psTransform->adfPLToLatLongGeoTransform[3] +
-                       psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
-                       psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
+    struct PointState
+    {
+        double dfResultX = 0.0;
+        double dfResultY = 0.0;
+        double dfPixelDeltaX = 0.0;
+        double dfPixelDeltaY = 0.0;
+        double dfLastResultX = 0.0;
+        double dfLastResultY = 0.0;
+        double dfLastPixelDeltaX = 0.0;
+        double dfLastPixelDeltaY = 0.0;
+        bool bLastPixelDeltaValid = false;
+        int nCountConsecutiveErrorBelow2 = 0;
+    };
+
+    std::vector<PointState> asStates(nPointCount);
+    // Indices of the points not converged yet.
+    std::vector<int> anActive;
+    anActive.reserve(nPointCount);
 
-    if (psTransform->bRPCInverseVerbose)
+    for (int i = 0; i < nPointCount; i++)
     {
-        CPLDebug("RPC", "Computing inverse transform for (pixel,line)=(%f,%f)",
-                 dfPixel, dfLine);
+        // Compute an initial approximation based on linear interpolation
+        // from our reference point.
+        const double dfPixel = padfPixel[i];
+        const double dfLine = padfLine[i];
+        asStates[i].dfResultX =
+            psTransform->adfPLToLatLongGeoTransform[0] +
+            psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
+            psTransform->adfPLToLatLongGeoTransform[2] * dfLine;
+
+        asStates[i].dfResultY =
+            psTransform->adfPLToLatLongGeoTransform[3] +
+            psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
+            psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
+
+        if (psTransform->bRPCInverseVerbose)
+        {
+            CPLDebug("RPC",
+                     "Computing inverse transform for (pixel,line)=(%f,%f)",
+                     dfPixel, dfLine);
+        }
+        panSuccess[i] = FALSE;
+        anActive.push_back(i);
     }
+
+    // The log only makes sense when transforming a single point.
     VSILFILE *fpLog = nullptr;
-    if (psTransform->pszRPCInverseLog)
+    if (psTransform->pszRPCInverseLog && nPointCount == 1)
     {
         fpLog = VSIFOpenL(
             CPLResetExtension(psTransform->pszRPCInverseLog, "csvt"), "wb");
@@ -1171,200 +1369,237 @@ static bool RPCInverseTransformPoint(GDALRPCTransformInfo *psTransform,
     /*      Now iterate, trying to find a closer LL location that will      */
     /*      back transform to the indicated pixel and line.                 */
     /* -------------------------------------------------------------------- */
-    double dfPixelDeltaX = 0.0;
-    double dfPixelDeltaY = 0.0;
-    double dfLastResultX = 0.0;
-    double dfLastResultY = 0.0;
-    double dfLastPixelDeltaX = 0.0;
-    double dfLastPixelDeltaY = 0.0;
-    bool bLastPixelDeltaValid = false;
     const int nMaxIterations = (psTransform->nMaxIterations > 0)
                                    ? psTransform->nMaxIterations
                                : (psTransform->poDS != nullptr) ? 20
                                                                 : 10;
-    int nCountConsecutiveErrorBelow2 = 0;
 
-    int iIter = 0;  // Used after for.
-    for (; iIter < nMaxIterations; iIter++)
+    std::vector<int> anBatch;
+    std::vector<double> adfLong;
+    std::vector<double> adfLat;
+    std::vector<double> adfHeight;
+    std::vector<double> adfBackPixel;
+    std::vector<double> adfBackLine;
+    anBatch.reserve(nPointCount);
+    adfLong.reserve(nPointCount);
+    adfLat.reserve(nPointCount);
+    adfHeight.reserve(nPointCount);
+
+    for (int iIter = 0; iIter < nMaxIterations && !anActive.empty(); iIter++)
     {
-        double dfBackPixel = 0.0;
-        double dfBackLine = 0.0;
-
-        // Update DEMH.
-        double dfDEMH = 0.0;
-        double dfDEMPixel = 0.0;
-        double dfDEMLine = 0.0;
-        if (!GDALRPCGetHeightAtLongLat(psTransform, dfResultX, dfResultY,
-                                       &dfDEMH, &dfDEMPixel, &dfDEMLine))
+        // Update DEMH of all the active points.
+        anBatch.clear();
+        adfLong.clear();
+        adfLat.clear();
+        adfHeight.clear();
+        for (const int i : anActive)
         {
-            if (psTransform->poDS)
+            const double dfPixel = padfPixel[i];
+            const double dfLine = padfLine[i];
+            const double dfResultX = asStates[i].dfResultX;
+            const double dfResultY = asStates[i].dfResultY;
+
+            double dfDEMH = 0.0;
+            double dfDEMPixel = 0.0;
+            double dfDEMLine = 0.0;
+            if (!GDALRPCGetHeightAtLongLat(psTransform, dfResultX, dfResultY,
+                                           &dfDEMH, &dfDEMPixel, &dfDEMLine))
             {
-                CPLDebug("RPC", "DEM (pixel, line) = (%g, %g)", dfDEMPixel,
-                         dfDEMLine);
-            }
-
-            // The first time, the guess might be completely out of the
-            // validity of the DEM, so pickup the "reference Z" as the
-            // first guess or the closest point of the DEM by snapping to it.
-            if (iIter == 0)
-            {
-                bool bUseRefZ = true;
                 if (psTransform->poDS)
                 {
-                    if (dfDEMPixel >= psTransform->poDS->GetRasterXSize())
-                        dfDEMPixel = psTransform->poDS->GetRasterXSize() - 0.5;
-                    else if (dfDEMPixel < 0)
-                        dfDEMPixel = 0.5;
-                    if (dfDEMLine >= psTransform->poDS->GetRasterYSize())
-                        dfDEMLine = psTransform->poDS->GetRasterYSize() - 0.5;
-                    else if (dfDEMPixel < 0)
-                        dfDEMPixel = 0.5;
-                    if (GDALRPCGetDEMHeight(psTransform, dfDEMPixel, dfDEMLine,
-                                            &dfDEMH))
+                    CPLDebug("RPC", "DEM (pixel, line) = (%g, %g)", dfDEMPixel,
+                             dfDEMLine);
+                }
+
+                // The first time, the guess might be completely out of the
+                // validity of the DEM, so pickup the "reference Z" as the
+                // first guess or the closest point of the DEM by snapping to
+                // it.
+                if (iIter == 0)
+                {
+                    bool bUseRefZ = true;
+                    if (psTransform->poDS)
                     {
-                        bUseRefZ = false;
+                        if (dfDEMPixel >= psTransform->poDS->GetRasterXSize())
+                            dfDEMPixel =
+                                psTransform->poDS->GetRasterXSize() - 0.5;
+                        else if (dfDEMPixel < 0)
+                            dfDEMPixel = 0.5;
+                        if (dfDEMLine >= psTransform->poDS->GetRasterYSize())
+                            dfDEMLine =
+                                psTransform->poDS->GetRasterYSize() - 0.5;
+                        else if (dfDEMPixel < 0)
+                            dfDEMPixel = 0.5;
+                        if (GDALRPCGetDEMHeight(psTransform, dfDEMPixel,
+                                                dfDEMLine, &dfDEMH))
+                        {
+                            bUseRefZ = false;
+                            CPLDebug(
+                                "RPC",
+                                "Iteration %d for (pixel, line) = (%g, %g): "
+                                "No elevation value at %.15g %.15g. "
+                                "Using elevation %g at DEM (pixel, line) = "
+                                "(%g, %g) (snapping to boundaries) instead",
+                                iIter, dfPixel, dfLine, dfResultX, dfResultY,
+                                dfDEMH, dfDEMPixel, dfDEMLine);
+                        }
+                    }
+                    if (bUseRefZ)
+                    {
+                        dfDEMH = psTransform->dfRefZ;
                         CPLDebug("RPC",
                                  "Iteration %d for (pixel, line) = (%g, %g): "
                                  "No elevation value at %.15g %.15g. "
-                                 "Using elevation %g at DEM (pixel, line) = "
-                                 "(%g, %g) (snapping to boundaries) instead",
+                                 "Using elevation %g of reference point "
+                                 "instead",
                                  iIter, dfPixel, dfLine, dfResultX, dfResultY,
-                                 dfDEMH, dfDEMPixel, dfDEMLine);
+                                 dfDEMH);
                     }
                 }
-                if (bUseRefZ)
+                else
                 {
-                    dfDEMH = psTransform->dfRefZ;
                     CPLDebug("RPC",
                              "Iteration %d for (pixel, line) = (%g, %g): "
-                             "No elevation value at %.15g %.15g. "
-                             "Using elevation %g of reference point instead",
-                             iIter, dfPixel, dfLine, dfResultX, dfResultY,
-                             dfDEMH);
+                             "No elevation value at %.15g %.15g. Erroring out",
+                             iIter, dfPixel, dfLine, dfResultX, dfResultY);
+                    continue;
                 }
             }
-            else
-            {
-                CPLDebug("RPC",
-                         "Iteration %d for (pixel, line) = (%g, %g): "
-                         "No elevation value at %.15g %.15g. Erroring out",
-                         iIter, dfPixel, dfLine, dfResultX, dfResultY);
-                if (fpLog)
-                    VSIFCloseL(fpLog);
-                return false;
-            }
-        }
 
-        RPCTransformPoint(psTransform, dfResultX, dfResultY,
-                          dfUserHeight + dfDEMH, &dfBackPixel, &dfBackLine);
+            anBatch.push_back(i);
+            adfLong.push_back(dfResultX);
+            adfLat.push_back(dfResultY);
+            adfHeight.push_back(padfUserHeight[i] + dfDEMH);
+        }
 
-        dfPixelDeltaX = dfBackPixel - dfPixel;
-        dfPixelDeltaY = dfBackLine - dfLine;
+        const int nBatchCount = static_cast<int>(anBatch.size());
+        adfBackPixel.resize(nBatchCount);
+        adfBackLine.resize(nBatchCount);
+        RPCTransformPoints(psTransform, nBatchCount, adfLong.data(),
+                           adfLat.data(), adfHeight.data(), adfBackPixel.data(),
+                           adfBackLine.data());
 
-        if (psTransform->bRPCInverseVerbose)
-        {
-            CPLDebug("RPC",
-                     "Iter %d: dfPixelDeltaX=%.02f, dfPixelDeltaY=%.02f, "
-                     "long=%f, lat=%f, height=%f",
-                     iIter, dfPixelDeltaX, dfPixelDeltaY, dfResultX, dfResultY,
-                     dfUserHeight + dfDEMH);
-        }
-        if (fpLog != nullptr)
+        anActive.clear();
+        for (int j = 0; j < nBatchCount; j++)
         {
-            VSIFPrintfL(fpLog,
-                        "%d,%.12f,%.12f,%f,\"POINT(%.12f %.12f)\",%f,%f\n",
-                        iIter, dfResultX, dfResultY, dfUserHeight + dfDEMH,
-                        dfResultX, dfResultY, dfPixelDeltaX, dfPixelDeltaY);
-        }
+            const int i = anBatch[j];
+            PointState &sState = asStates[i];
+
+            const double dfPixelDeltaX = adfBackPixel[j] - padfPixel[i];
+            const double dfPixelDeltaY = adfBackLine[j] - padfLine[i];
+            sState.dfPixelDeltaX = dfPixelDeltaX;
+            sState.dfPixelDeltaY = dfPixelDeltaY;
 
-        const double dfError =
-            std::max(std::abs(dfPixelDeltaX), std::abs(dfPixelDeltaY));
-        if (dfError < psTransform->dfPixErrThreshold)
-        {
-            iIter = -1;
             if (psTransform->bRPCInverseVerbose)
             {
-                CPLDebug("RPC", "Converged!");
+                CPLDebug("RPC",
+                         "Iter %d: dfPixelDeltaX=%.02f, dfPixelDeltaY=%.02f, "
+                         "long=%f, lat=%f, height=%f",
+                         iIter, dfPixelDeltaX, dfPixelDeltaY, sState.dfResultX,
+                         sState.dfResultY, adfHeight[j]);
             }
-            break;
-        }
-        else if (psTransform->poDS != nullptr && bLastPixelDeltaValid &&
-                 dfPixelDeltaX * dfLastPixelDeltaX < 0 &&
-                 dfPixelDeltaY * dfLastPixelDeltaY < 0)
-        {
-            // When there is a DEM, if the error changes sign, we might
-            // oscillate forever, so take a mean position as a new guess.
-            if (psTransform->bRPCInverseVerbose)
+            if (fpLog != nullptr)
             {
-                CPLDebug("RPC",
-                         "Oscillation detected. "
-                         "Taking mean of 2 previous results as new guess");
+                VSIFPrintfL(fpLog,
+                            "%d,%.12f,%.12f,%f,\"POINT(%.12f %.12f)\",%f,%f\n",
+                            iIter, sState.dfResultX, sState.dfResultY,
+                            adfHeight[j], sState.dfResultX, sState.dfResultY,
+                            dfPixelDeltaX, dfPixelDeltaY);
             }
-            dfResultX = (fabs(dfPixelDeltaX) * dfLastResultX +
-                         fabs(dfLastPixelDeltaX) * dfResultX) /
-                        (fabs(dfPixelDeltaX) + fabs(dfLastPixelDeltaX));
-            dfResultY = (fabs(dfPixelDeltaY) * dfLastResultY +
-                         fabs(dfLastPixelDeltaY) * dfResultY) /
-                        (fabs(dfPixelDeltaY) + fabs(dfLastPixelDeltaY));
-            bLastPixelDeltaValid = false;
-            nCountConsecutiveErrorBelow2 = 0;
-            continue;
-        }
 
-        double dfBoostFactor = 1.0;
-        if (psTransform->poDS != nullptr && nCountConsecutiveErrorBelow2 >= 5 &&
-            dfError < 2)
-        {
-            // When there is a DEM, if we remain below a given threshold
-            // (somewhat arbitrarily set to 2 pixels) for some time, apply a
-            // "boost factor" for the new guessed result, in the hope we will go
-            // out of the somewhat current stuck situation.
-            dfBoostFactor = 10;
-            if (psTransform->bRPCInverseVerbose)
+            const double dfError =
+                std::max(std::abs(dfPixelDeltaX), std::abs(dfPixelDeltaY));
+            if (dfError < psTransform->dfPixErrThreshold)
             {
-                CPLDebug("RPC", "Applying boost factor 10");
+                if (psTransform->bRPCInverseVerbose)
+                {
+                    CPLDebug("RPC", "Converged!");
+                }
+                padfLong[i] = sState.dfResultX;
+                padfLat[i] = sState.dfResultY;
+                panSuccess[i] = TRUE;
+                continue;
             }
-        }
 
-        if (dfError < 2)
-            nCountConsecutiveErrorBelow2++;
-        else
-            nCountConsecutiveErrorBelow2 = 0;
-
-        const double dfNewResultX =
-            dfResultX -
-            (dfPixelDeltaX * psTransform->adfPLToLatLongGeoTransform[1] *
-             dfBoostFactor) -
-            (dfPixelDeltaY * psTransform->adfPLToLatLongGeoTransform[2] *
-             dfBoostFactor);
-        const double dfNewResultY =
-            dfResultY -
-            (dfPixelDeltaX * psTransform->adfPLToLatLongGeoTransform[4] *
-             dfBoostFactor) -
-            (dfPixelDeltaY * psTransform->adfPLToLatLongGeoTransform[5] *
-             dfBoostFactor);
-
-        dfLastResultX = dfResultX;
-        dfLastResultY = dfResultY;
-        dfResultX = dfNewResultX;
-        dfResultY = dfNewResultY;
-        dfLastPixelDeltaX = dfPixelDeltaX;
-        dfLastPixelDeltaY = dfPixelDeltaY;
-        bLastPixelDeltaValid = true;
+            anActive.push_back(i);
+
+            if (psTransform->poDS != nullptr && sState.bLastPixelDeltaValid &&
+                dfPixelDeltaX * sState.dfLastPixelDeltaX < 0 &&
+                dfPixelDeltaY * sState.dfLastPixelDeltaY < 0)
+            {
+                // When there is a DEM, if the error changes sign, we might
+                // oscillate forever, so take a mean position as a new guess.
+                if (psTransform->bRPCInverseVerbose)
+                {
+                    CPLDebug("RPC",
+                             "Oscillation detected. "
+                             "Taking mean of 2 previous results as new guess");
+                }
+                sState.dfResultX =
+                    (fabs(dfPixelDeltaX) * sState.dfLastResultX +
+                     fabs(sState.dfLastPixelDeltaX) * sState.dfResultX) /
+                    (fabs(dfPixelDeltaX) + fabs(sState.dfLastPixelDeltaX));
+                sState.dfResultY =
+                    (fabs(dfPixelDeltaY) * sState.dfLastResultY +
+                     fabs(sState.dfLastPixelDeltaY) * sState.dfResultY) /
+                    (fabs(dfPixelDeltaY) + fabs(sState.dfLastPixelDeltaY));
+                sState.bLastPixelDeltaValid = false;
+                sState.nCountConsecutiveErrorBelow2 = 0;
+                continue;
+            }
+
+            double dfBoostFactor = 1.0;
+            if (psTransform->poDS != nullptr &&
+                sState.nCountConsecutiveErrorBelow2 >= 5 && dfError < 2)
+            {
+                // When there is a DEM, if we remain below a given threshold
+                // (somewhat arbitrarily set to 2 pixels) for some time, apply a
+                // "boost factor" for the new guessed result, in the hope we
+                // will go out of the somewhat current stuck situation.
+                dfBoostFactor = 10;
+                if (psTransform->bRPCInverseVerbose)
+                {
+                    CPLDebug("RPC", "Applying boost factor 10");
+                }
+            }
+
+            if (dfError < 2)
+                sState.nCountConsecutiveErrorBelow2++;
+            else
+                sState.nCountConsecutiveErrorBelow2 = 0;
+
+            const double dfNewResultX =
+                sState.dfResultX -
+                (dfPixelDeltaX * psTransform->adfPLToLatLongGeoTransform[1] *
+                 dfBoostFactor) -
+                (dfPixelDeltaY * psTransform->adfPLToLatLongGeoTransform[2] *
+                 dfBoostFactor);
+            const double dfNewResultY =
+                sState.dfResultY -
+                (dfPixelDeltaX * psTransform->adfPLToLatLongGeoTransform[4] *
+                 dfBoostFactor) -
+                (dfPixelDeltaY * psTransform->adfPLToLatLongGeoTransform[5] *
+                 dfBoostFactor);
+
+            sState.dfLastResultX = sState.dfResultX;
+            sState.dfLastResultY = sState.dfResultY;
+            sState.dfResultX = dfNewResultX;
+            sState.dfResultY = dfNewResultY;
+            sState.dfLastPixelDeltaX = dfPixelDeltaX;
+            sState.dfLastPixelDeltaY = dfPixelDeltaY;
+            sState.bLastPixelDeltaValid = true;
+        }
     }
     if (fpLog != nullptr)
         VSIFCloseL(fpLog);
 
-    if (iIter != -1)
+    for (const int i : anActive)
     {
+        const PointState &sState = asStates[i];
         CPLDebug("RPC", "Failed Iterations %d: Got: %.16g,%.16g  Offset=%g,%g",
-                 iIter, dfResultX, dfResultY, dfPixelDeltaX, dfPixelDeltaY);
-        return false;
+                 nMaxIterations, sState.dfResultX, sState.dfResultY,
+                 sState.dfPixelDeltaX, sState.dfPixelDeltaY);
     }
-
-    *pdfLong = dfResultX;
-    *pdfLat = dfResultY;
-    return true;
 }
 
 static double BiCubicKernel(double dfVal)
@@ -1384,6 +1619,52 @@ static double BiCubicKernel(double dfVal)
     return 0.16666666666666666667 * (a - (4.0 * b) + (6.0 * c) - (4.0 * d));
 }
 
+/************************************************************************/
+/*                       GDALRPCGetDEMBlockCache()                      */
+/************************************************************************/
+
+// Return the cache of the blocks of a DEM, shared by all the transformers
+// (typically those of the threads of a warping operation) using it while
+// they are alive.
+static std::shared_ptr<GDALRPCDEMBlockCache>
+GDALRPCGetDEMBlockCache(const char *pszDEMPath, GDALDataset *poDS)
+{
+    // As many blocks per CPU as the private cache each transformer used to
+    // have, so that threads warping different areas don't evict each other.
+    const size_t nCacheMaxBlocks =
+        static_cast<size_t>(std::max(4, CPLGetNumCPUs())) * 64;
+
+    static std::mutex oMutex;
+    static std::map<std::string, std::weak_ptr<GDALRPCDEMBlockCache>> oMap;
+
+    // Do not reuse the blocks of a DEM that has been modified.
+    std::string osKey(CPLSPrintf("%s|%d|%d", pszDEMPath, poDS->GetRasterXSize(),
+                                 poDS->GetRasterYSize()));
+    VSIStatBufL sStat;
+    if (VSIStatL(pszDEMPath, &sStat) == 0)
+    {
+        osKey += CPLSPrintf("|" CPL_FRMT_GIB "|" CPL_FRMT_GIB,
+                            static_cast<GIntBig>(sStat.st_size),
+                            static_cast<GIntBig>(sStat.st_mtime));
+    }
+
+    std::lock_guard<std::mutex> oLock(oMutex);
+    for (auto oIter = oMap.begin(); oIter != oMap.end();)
+    {
+        if (oIter->second.expired())
+            oIter = oMap.erase(oIter);
+        else
+            ++oIter;
+    }
+    auto poCache = oMap[osKey].lock();
+    if (!poCache)
+    {
+        poCache = std::make_shared<GDALRPCDEMBlockCache>(nCacheMaxBlocks);
+        oMap[osKey] = poCache;
+    }
+    return poCache;
+}
+
 /************************************************************************/
 /*                        GDALRPCExtractDEMWindow()                     */
 /************************************************************************/
@@ -1397,8 +1678,12 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
     // Request the DEM by blocks of BLOCK_SIZE * BLOCK_SIZE and put them
     // in poCacheDEM
     if (psTransform->poCacheDEM == nullptr)
-        psTransform->poCacheDEM =
-            new lru11::Cache<uint64_t, std::shared_ptr<std::vector<double>>>();
+    {
+        psTransform->poCacheDEM = new std::shared_ptr<GDALRPCDEMBlockCache>(
+            GDALRPCGetDEMBlockCache(psTransform->pszDEMPath,
+                                    psTransform->poDS));
+    }
+    GDALRPCDEMBlockCache &oCacheDEM = **psTransform->poCacheDEM;
 
     const int nXIters = (nX + nWidth - 1) / BLOCK_SIZE - nX / BLOCK_SIZE + 1;
     const int nYIters = (nY + nHeight - 1) / BLOCK_SIZE - nY / BLOCK_SIZE + 1;
@@ -1445,7 +1730,7 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
 #endif
 
             std::shared_ptr<std::vector<double>> poValue;
-            if (!psTransform->poCacheDEM->tryGet(nKey, poValue))
+            if (!oCacheDEM.tryGet(nKey, poValue))
             {
                 poValue = std::make_shared<std::vector<double>>(nReqXSize *
                                                                 nReqYSize);
@@ -1457,7 +1742,7 @@ static bool GDALRPCExtractDEMWindow(GDALRPCTransformInfo *psTransform, int nX,
                 {
                     return false;
                 }
-                psTransform->poCacheDEM->insert(nKey, poValue);
+                oCacheDEM.insert(nKey, poValue);
             }
 
             // Compose the cached block to the final buffer
@@ -1673,6 +1958,9 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
             panSuccess[i] = FALSE;
         return FALSE;
     }
+    // Read the window directly rather than through the DEM block cache: a
+    // whole line spans many blocks, which would evict those of the other
+    // threads.
     CPLErr eErr = psTransform->poDS->GetRasterBand(1)->RasterIO(
         GF_Read, nXLeft, nYTop, nXWidth, nYHeight, padfDEMBuffer, nXWidth,
         nYHeight, GDT_Float64, 0, 0, nullptr);
@@ -1695,6 +1983,9 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
     const int nY = static_cast<int>(dfY);
     const double dfDeltaY = dfY - nY;
 
+    // Points whose height is known, transformed after the loop.
+    RPCPointBatch oBatch(nPointCount);
+
     for (int i = 0; i < nPointCount; i++)
     {
         if (padfX[i] == HUGE_VAL)
@@ -1798,11 +2089,10 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
                             continue;
                         }
                         dfDEMH = adfElevData[k_valid_sample];
-                        RPCTransformPoint(
-                            psTransform, padfX[i], padfY[i],
+                        oBatch.Add(
+                            i, padfX[i], padfY[i],
                             dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                        psTransform->dfHeightScale,
-                            padfX + i, padfY + i);
+                                        psTransform->dfHeightScale);
 
                         panSuccess[i] = TRUE;
                         continue;
@@ -1817,11 +2107,10 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
                             continue;
                         }
                         dfDEMH = psTransform->dfDEMMissingValue;
-                        RPCTransformPoint(
-                            psTransform, padfX[i], padfY[i],
+                        oBatch.Add(
+                            i, padfX[i], padfY[i],
                             dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                        psTransform->dfHeightScale,
-                            padfX + i, padfY + i);
+                                        psTransform->dfHeightScale);
 
                         panSuccess[i] = TRUE;
                         continue;
@@ -1874,14 +2163,15 @@ GDALRPCTransformWholeLineWithDEM(const GDALRPCTransformInfo *psTransform,
             padfY[i] = HUGE_VAL;
             continue;
         }
-        RPCTransformPoint(psTransform, padfX[i], padfY[i],
-                          dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                      psTransform->dfHeightScale,
-                          padfX + i, padfY + i);
+        oBatch.Add(i, padfX[i], padfY[i],
+                   dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
+                               psTransform->dfHeightScale);
 
         panSuccess[i] = TRUE;
     }
 
+    oBatch.Transform(psTransform, padfX, padfY);
+
     VSIFree(padfDEMBuffer);
 
     return TRUE;
@@ -2146,6 +2436,9 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
             }
         }
 
+        // Fetch the heights, and then evaluate the RPC polynomials on all
+        // the points at once.
+        RPCPointBatch oBatch(nPointCount);
         for (int i = 0; i < nPointCount; i++)
         {
             if (!RPCIsValidLongLat(psTransform, padfX[i], padfY[i]))
@@ -2165,11 +2458,11 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
                 continue;
             }
 
-            RPCTransformPoint(psTransform, padfX[i], padfY[i],
-                              (padfZ ? padfZ[i] : 0.0) + dfHeight, padfX + i,
-                              padfY + i);
+            oBatch.Add(i, padfX[i], padfY[i],
+                       (padfZ ? padfZ[i] : 0.0) + dfHeight);
             panSuccess[i] = TRUE;
         }
+        oBatch.Transform(psTransform, padfX, padfY);
 
         return TRUE;
     }
@@ -2186,20 +2479,29 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
     /*      function uses an iterative method from an initial linear        */
     /*      approximation.                                                  */
     /* -------------------------------------------------------------------- */
-    for (int i = 0; i < nPointCount; i++)
+    std::vector<double> adfLong(nPointCount);
+    std::vector<double> adfLat(nPointCount);
+    if (psTransform->pszRPCInverseLog)
     {
-        double dfResultX = 0.0;
-        double dfResultY = 0.0;
-
-        if (!RPCInverseTransformPoint(psTransform, padfX[i], padfY[i], padfZ[i],
-                                      &dfResultX, &dfResultY))
+        // The log is written point by point.
+        for (int i = 0; i < nPointCount; i++)
         {
-            panSuccess[i] = FALSE;
-            padfX[i] = HUGE_VAL;
-            padfY[i] = HUGE_VAL;
-            continue;
+            RPCInverseTransformPoints(psTransform, 1, padfX + i, padfY + i,
+                                      padfZ + i, adfLong.data() + i,
+                                      adfLat.data() + i, panSuccess + i);
         }
-        if (!RPCIsValidLongLat(psTransform, padfX[i], padfY[i]))
+    }
+    else
+    {
+        RPCInverseTransformPoints(psTransform, nPointCount, padfX, padfY,
+                                  padfZ, adfLong.data(), adfLat.data(),
+                                  panSuccess);
+    }
+
+    for (int i = 0; i < nPointCount; i++)
+    {
+        if (!panSuccess[i] ||
+            !RPCIsValidLongLat(psTransform, padfX[i], padfY[i]))
         {
             panSuccess[i] = FALSE;
             padfX[i] = HUGE_VAL;
@@ -2207,10 +2509,8 @@ int GDALRPCTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
             continue;
         }
 
-        padfX[i] = dfResultX;
-        padfY[i] = dfResultY;
-
-        panSuccess[i] = TRUE;
+        padfX[i] = adfLong[i];
+        padfY[i] = adfLat[i];
     }
 
     return TRUE;
@@ -32,8 +32,11 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -41,10 +44,12 @@
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "gdalgenericinverse.h"
 
 CPL_C_START
@@ -64,6 +69,10 @@ struct TPSTransformInfo
 
     bool bReversed{};
 
+    // Number of threads used to solve the systems and to transform large
+    // batches of points.
+    int nThreads = 1;
+
     std::vector<gdal::GCP> asGCPs{};
 
     volatile int nRefCount{};
@@ -95,9 +104,12 @@ static void *GDALCreateSimilarTPSTransformer(void *hTransformArg,
             gcp.Pixel() /= dfRatioX;
             gcp.Line() /= dfRatioY;
         }
-        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformer(
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("NUM_THREADS",
+                                CPLSPrintf("%d", psInfo->nThreads));
+        psInfo = static_cast<TPSTransformInfo *>(GDALCreateTPSTransformerInt(
             static_cast<int>(newGCPs.size()), gdal::GCP::c_ptr(newGCPs),
-            psInfo->bReversed));
+            psInfo->bReversed, aosOptions.List()));
     }
 
     return psInfo;
@@ -146,7 +158,7 @@ void *GDALCreateTPSTransformer(int nGCPCount, const GDAL_GCP *pasGCPList,
 static void GDALTPSComputeForwardInThread(void *pData)
 {
     TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pData);
-    psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
+    psInfo->bForwardSolved = psInfo->poForward->solve(psInfo->nThreads) != 0;
 }
 
 void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
@@ -260,17 +272,20 @@ void *GDALCreateTPSTransformerInt(int nGCPCount, const GDAL_GCP *pasGCPList,
         else
             nThreads = atoi(pszWarpThreads);
     }
+    psInfo->nThreads = std::max(1, nThreads);
 
     if (nThreads > 1)
     {
         // Compute direct and reverse transforms in parallel.
         CPLJoinableThread *hThread =
             CPLCreateJoinableThread(GDALTPSComputeForwardInThread, psInfo);
-        psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
+        psInfo->bReverseSolved =
+            psInfo->poReverse->solve(psInfo->nThreads) != 0;
         if (hThread != nullptr)
             CPLJoinThread(hThread);
         else
-            psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
+            psInfo->bForwardSolved =
+                psInfo->poForward->solve(psInfo->nThreads) != 0;
     }
     else
     {
@@ -319,38 +334,13 @@ void GDALDestroyTPSTransformer(void *pTransformArg)
 }
 
 /************************************************************************/
-/*                          GDALTPSTransform()                          */
+/*                       GDALTPSTransformPoints()                       */
 /************************************************************************/
 
-/**
- * Transforms point based on GCP derived polynomial model.
- *
- * This function matches the GDALTransformerFunc signature, and can be
- * used to transform one or more points from pixel/line coordinates to
- * georeferenced coordinates (SrcToDst) or vice versa (DstToSrc).
- *
- * @param pTransformArg return value from GDALCreateTPSTransformer().
- * @param bDstToSrc TRUE if transformation is from the destination
- * (georeferenced) coordinates to pixel/line or FALSE when transforming
- * from pixel/line to georeferenced coordinates.
- * @param nPointCount the number of values in the x, y and z arrays.
- * @param x array containing the X values to be transformed.
- * @param y array containing the Y values to be transformed.
- * @param z array containing the Z values to be transformed.
- * @param panSuccess array in which a flag indicating success (TRUE) or
- * failure (FALSE) of the transformation are placed.
- *
- * @return TRUE.
- */
-
-int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
-                     double *x, double *y, CPL_UNUSED double *z,
-                     int *panSuccess)
+static void GDALTPSTransformPoints(TPSTransformInfo *psInfo, int bDstToSrc,
+                                   int nPointCount, double *x, double *y,
+                                   int *panSuccess)
 {
-    VALIDATE_POINTER1(pTransformArg, "GDALTPSTransform", 0);
-
-    TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pTransformArg);
-
     for (int i = 0; i < nPointCount; i++)
     {
         double xy_out[2] = {0.0, 0.0};
@@ -391,6 +381,104 @@ int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
         }
         panSuccess[i] = TRUE;
     }
+}
+
+namespace
+{
+struct TPSTransformJob
+{
+    TPSTransformInfo *psInfo = nullptr;
+    int bDstToSrc = FALSE;
+    int nPointCount = 0;
+    double *x = nullptr;
+    double *y = nullptr;
+    int *panSuccess = nullptr;
+};
+}  // namespace
+
+static void GDALTPSTransformJobFunc(void *pData)
+{
+    const auto psJob = static_cast<TPSTransformJob *>(pData);
+    GDALTPSTransformPoints(psJob->psInfo, psJob->bDstToSrc,
+                           psJob->nPointCount, psJob->x, psJob->y,
+                           psJob->panSuccess);
+}
+
+/************************************************************************/
+/*                          GDALTPSTransform()                          */
+/************************************************************************/
+
+/**
+ * Transforms point based on GCP derived polynomial model.
+ *
+ * This function matches the GDALTransformerFunc signature, and can be
+ * used to transform one or more points from pixel/line coordinates to
+ * georeferenced coordinates (SrcToDst) or vice versa (DstToSrc).
+ *
+ * @param pTransformArg return value from GDALCreateTPSTransformer().
+ * @param bDstToSrc TRUE if transformation is from the destination
+ * (georeferenced) coordinates to pixel/line or FALSE when transforming
+ * from pixel/line to georeferenced coordinates.
+ * @param nPointCount the number of values in the x, y and z arrays.
+ * @param x array containing the X values to be transformed.
+ * @param y array containing the Y values to be transformed.
+ * @param z array containing the Z values to be transformed.
+ * @param panSuccess array in which a flag indicating success (TRUE) or
+ * failure (FALSE) of the transformation are placed.
+ *
+ * @return TRUE.
+ */
+
+int GDALTPSTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
+                     double *x, double *y, CPL_UNUSED double *z,
+                     int *panSuccess)
+{
+    VALIDATE_POINTER1(pTransformArg, "GDALTPSTransform", 0);
+
+    TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pTransformArg);
+
+    // Evaluating the spline at one point costs one basis function per GCP.
+    // Only split the points between threads when each thread gets enough
+    // of them to make the cost of the thread pool negligible.
+    constexpr double MIN_BASIS_FUNCTIONS_PER_JOB = 1e6;
+    const int nJobs = static_cast<int>(std::min<double>(
+        std::min(psInfo->nThreads, nPointCount),
+        static_cast<double>(nPointCount) * psInfo->asGCPs.size() /
+            MIN_BASIS_FUNCTIONS_PER_JOB));
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nJobs > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool =
+            GDALGetGlobalThreadPool(psInfo->nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+
+    if (poJobQueue)
+    {
+        std::vector<TPSTransformJob> asJobs(nJobs);
+        for (int i = 0; i < nJobs; i++)
+        {
+            const int nStart = static_cast<int>(
+                static_cast<GIntBig>(nPointCount) * i / nJobs);
+            const int nEnd = static_cast<int>(
+                static_cast<GIntBig>(nPointCount) * (i + 1) / nJobs);
+            auto &sJob = asJobs[i];
+            sJob.psInfo = psInfo;
+            sJob.bDstToSrc = bDstToSrc;
+            sJob.nPointCount = nEnd - nStart;
+            sJob.x = x + nStart;
+            sJob.y = y + nStart;
+            sJob.panSuccess = panSuccess + nStart;
+            poJobQueue->SubmitJob(GDALTPSTransformJobFunc, &sJob);
+        }
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        GDALTPSTransformPoints(psInfo, bDstToSrc, nPointCount, x, y,
+                               panSuccess);
+    }
 
     return TRUE;
 }
@@ -30,15 +30,71 @@
 #include "cpl_port.h"
 #include "gdal_alg.h"
 
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+
+/************************************************************************/
+/*                           ChecksumValues()                           */
+/************************************************************************/
+
+// Return the contribution to the checksum of nCount consecutive values,
+// the first one being at index iPrime in the prime number cycle.
+// Floating point data is converted to 32bit integer, with the standard
+// behavior of GDALCopyWords when converting from floating point to Int32.
+template <class T>
+static GIntBig ChecksumValues(const T *pValues, size_t nCount, int iPrime)
+{
+    constexpr int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
+
+    GIntBig nChecksum = 0;
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        int nVal;
+        if constexpr (std::is_same<T, double>::value)
+        {
+            double dfVal = pValues[i];
+            if (!std::isfinite(dfVal))
+            {
+                nVal = INT_MIN;
+            }
+            else
+            {
+                dfVal += 0.5;
+
+                if (dfVal < -2147483647.0)
+                    nVal = -2147483647;
+                else if (dfVal > 2147483647)
+                    nVal = 2147483647;
+                else
+                    nVal = static_cast<GInt32>(floor(dfVal));
+            }
+        }
+        else
+        {
+            nVal = pValues[i];
+        }
+        nChecksum += nVal % anPrimes[iPrime++];
+        if (iPrime > 10)
+            iPrime = 0;
+    }
+    return nChecksum;
+}
 
 /************************************************************************/
 /*                         GDALChecksumImage()                          */
@@ -52,6 +108,9 @@
  * so decimal portions of such raster data will not affect the checksum.
  * Real and Imaginary components of complex bands influence the result.
  *
+ * Starting with GDAL 3.10, the GDAL_NUM_THREADS configuration option can be
+ * set to compute the checksum with several threads.
+ *
  * @param hBand the raster band to read from.
  * @param nXOff pixel offset of window to read.
  * @param nYOff line offset of window to read.
@@ -59,6 +118,7 @@
  * @param nYSize line size of window to read.
  *
  * @return Checksum value, or -1 in case of error (starting with GDAL 3.6)
+ * @see GDALChecksumImageEx()
  */
 
 int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
@@ -67,307 +127,377 @@ int CPL_STDCALL GDALChecksumImage(GDALRasterBandH hBand, int nXOff, int nYOff,
 {
     VALIDATE_POINTER1(hBand, "GDALChecksumImage", 0);
 
-    const static int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
+    return GDALChecksumImageEx(hBand, nXOff, nYOff, nXSize, nYSize, nullptr,
+                               nullptr);
+}
+
+/************************************************************************/
+/*                        GDALChecksumImageEx()                         */
+/************************************************************************/
+
+/**
+ * Compute checksum, and optionally a content hash, for image region.
+ *
+ * The checksum is the same as the one returned by GDALChecksumImage(). The
+ * contribution of each value to the checksum only depends on its position
+ * in the window, so the window is processed in block-aligned strips that
+ * can be read and checksummed in parallel, and whose results are summed.
+ *
+ * If the HASH=SHA256 option is set, a SHA-256 based hash of the content is
+ * computed in the same pass. Contrary to the checksum, it takes into account
+ * the exact pixel values. It is defined as the SHA-256 digest of the
+ * concatenation of the SHA-256 digests of each line of the window, a line
+ * being the sequence of its pixel values in the data type of the band,
+ * in little-endian byte order. It is thus independent of the block
+ * structure of the band and of the number of threads.
+ *
+ * Options:
+ * <ul>
+ * <li>HASH=NONE/SHA256: whether to compute a content hash. Defaults to
+ * NONE.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: number of worker threads.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option,
+ * or 1. Strips are read concurrently only if the dataset of the band is
+ * thread-safe (see GDALDataset::IsThreadSafe()). Otherwise reads are
+ * serialized, but overlap with the checksum computation of other strips.</li>
+ * </ul>
+ *
+ * @param hBand the raster band to read from.
+ * @param nXOff pixel offset of window to read.
+ * @param nYOff line offset of window to read.
+ * @param nXSize pixel size of window to read.
+ * @param nYSize line size of window to read.
+ * @param papszOptions NULL terminated list of options, or NULL.
+ * @param ppszHash Pointer to a string that receives the hexadecimal
+ * representation of the hash, to be freed with CPLFree(), if HASH is set.
+ * May be NULL. Set to NULL in case of error.
+ *
+ * @return Checksum value, or -1 in case of error.
+ * @since GDAL 3.10
+ */
+
+int GDALChecksumImageEx(GDALRasterBandH hBand, int nXOff, int nYOff,
+                        int nXSize, int nYSize, CSLConstList papszOptions,
+                        char **ppszHash)
+{
+    VALIDATE_POINTER1(hBand, "GDALChecksumImageEx", -1);
 
-    int nChecksum = 0;
-    int iPrime = 0;
-    const GDALDataType eDataType = GDALGetRasterDataType(hBand);
+    if (ppszHash)
+        *ppszHash = nullptr;
+
+    const char *pszHash = CSLFetchNameValueDef(papszOptions, "HASH", "NONE");
+    bool bHash = false;
+    if (EQUAL(pszHash, "SHA256"))
+    {
+        bHash = ppszHash != nullptr;
+    }
+    else if (!EQUAL(pszHash, "NONE"))
+    {
+        CPLError(CE_Failure, CPLE_NotSupported, "Unsupported HASH=%s",
+                 pszHash);
+        return -1;
+    }
+
+    if (nXSize <= 0 || nYSize <= 0)
+        return 0;
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    const GDALDataType eDataType = poBand->GetRasterDataType();
     const bool bComplex = CPL_TO_BOOL(GDALDataTypeIsComplex(eDataType));
     const bool bIsFloatingPoint =
         (eDataType == GDT_Float32 || eDataType == GDT_Float64 ||
          eDataType == GDT_CFloat32 || eDataType == GDT_CFloat64);
+    // Data type in which values are checksummed
+    const GDALDataType eDstDataType =
+        bIsFloatingPoint ? (bComplex ? GDT_CFloat64 : GDT_Float64)
+                         : (bComplex ? GDT_CInt32 : GDT_Int32);
+    // When hashing, values are read in the band data type, and converted
+    // line by line to eDstDataType for the checksum.
+    const GDALDataType eReadDataType = bHash ? eDataType : eDstDataType;
+    const int nReadDataTypeSize = GDALGetDataTypeSizeBytes(eReadDataType);
+    const int nValsPerIter = bComplex ? 2 : 1;
+
+    const char *pszThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
 
-    const auto IntFromDouble = [](double dfVal)
+    /* -------------------------------------------------------------------- */
+    /*      Split the window in strips aligned on blocks, of the height of  */
+    /*      a block, and each strip in chunks of a width that is a          */
+    /*      multiple of the block width.                                    */
+    /* -------------------------------------------------------------------- */
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    nBlockXSize = std::max(1, nBlockXSize);
+    nBlockYSize = std::max(1, nBlockYSize);
+    const int nChunkYSize = nBlockYSize;
+    int nChunkXSize = nXSize;
     {
-        int nVal;
-        if (!std::isfinite(dfVal))
-        {
-            nVal = INT_MIN;
-        }
-        else
+        // Memory used by each thread
+        const GIntBig nMaxChunkSize =
+            std::max(static_cast<GIntBig>(10 * 1000 * 1000),
+                     GDALGetCacheMax64() / 10) /
+            nThreads;
+        if (static_cast<GIntBig>(nXSize) * nChunkYSize >=
+            nMaxChunkSize / nReadDataTypeSize)
         {
-            // Standard behavior of GDALCopyWords when converting
-            // from floating point to Int32.
-            dfVal += 0.5;
-
-            if (dfVal < -2147483647.0)
-                nVal = -2147483647;
-            else if (dfVal > 2147483647)
-                nVal = 2147483647;
-            else
-                nVal = static_cast<GInt32>(floor(dfVal));
+            nChunkXSize = static_cast<int>(std::min(
+                static_cast<GIntBig>(nXSize),
+                nBlockXSize *
+                    std::max(static_cast<GIntBig>(1),
+                             nMaxChunkSize /
+                                 (static_cast<GIntBig>(nBlockXSize) *
+                                  nChunkYSize * nReadDataTypeSize))));
         }
-        return nVal;
+    }
+
+    struct Context
+    {
+        GDALRasterBand *poBand = nullptr;
+        int nXOff = 0;
+        int nYOff = 0;
+        int nXSize = 0;
+        GDALDataType eReadDataType = GDT_Unknown;
+        GDALDataType eDstDataType = GDT_Unknown;
+        int nValsPerIter = 1;
+        int nChunkXSize = 0;
+        bool bHash = false;
+        bool bSetNumThreads = false;
+        // Protects reads if the dataset is not thread-safe
+        std::mutex *poReadMutex = nullptr;
+        std::atomic<bool> bError{false};
+        // Digest of each line of the window
+        std::vector<std::array<GByte, CPL_SHA256_HASH_SIZE>> aabyLineDigests{};
     };
 
-    if (bIsFloatingPoint && nXOff == 0 && nYOff == 0)
+    struct Strip
     {
-        const GDALDataType eDstDataType = bComplex ? GDT_CFloat64 : GDT_Float64;
-        int nBlockXSize = 0;
-        int nBlockYSize = 0;
-        GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
-        const int nDstDataTypeSize = GDALGetDataTypeSizeBytes(eDstDataType);
-        int nChunkXSize = nBlockXSize;
-        const int nChunkYSize = nBlockYSize;
-        if (nBlockXSize < nXSize)
+        Context *psCtxt = nullptr;
+        int iYStart = 0;  // relative to the window
+        int iYEnd = 0;
+        GIntBig nChecksum = 0;
+    };
+
+    const auto ProcessStrip = [](void *pData)
+    {
+        Strip *psStrip = static_cast<Strip *>(pData);
+        Context *psCtxt = psStrip->psCtxt;
+        if (psCtxt->bError)
+            return;
+
+        // Do not nest parallelism from the thread pool in the reads
+        std::unique_ptr<CPLConfigOptionSetter> poSetter;
+        if (psCtxt->bSetNumThreads)
+            poSetter = std::make_unique<CPLConfigOptionSetter>(
+                "GDAL_NUM_THREADS", "1", false);
+
+        const int nLines = psStrip->iYEnd - psStrip->iYStart;
+        const int nReadDTSize =
+            GDALGetDataTypeSizeBytes(psCtxt->eReadDataType);
+        const int nDstDTSize = GDALGetDataTypeSizeBytes(psCtxt->eDstDataType);
+        GByte *pabyChunk = static_cast<GByte *>(
+            VSI_MALLOC3_VERBOSE(psCtxt->nChunkXSize, nLines, nReadDTSize));
+        std::vector<GByte> abyConverted;
+        std::vector<CPL_SHA256Context> asLineHashes;
+        if (psCtxt->bHash)
         {
-            const GIntBig nMaxChunkSize =
-                std::max(static_cast<GIntBig>(10 * 1000 * 1000),
-                         GDALGetCacheMax64() / 10);
-            if (nDstDataTypeSize > 0 &&
-                static_cast<GIntBig>(nXSize) * nChunkYSize <
-                    nMaxChunkSize / nDstDataTypeSize)
+            try
             {
-                // A full line of height nChunkYSize can fit in the maximum
-                // allowed memory
-                nChunkXSize = nXSize;
+                abyConverted.resize(static_cast<size_t>(psCtxt->nChunkXSize) *
+                                    nDstDTSize);
+                asLineHashes.resize(nLines);
             }
-            else
+            catch (const std::exception &)
             {
-                // Otherwise compute a size that is a multiple of nBlockXSize
-                nChunkXSize = static_cast<int>(std::min(
-                    static_cast<GIntBig>(nXSize),
-                    nBlockXSize *
-                        std::max(static_cast<GIntBig>(1),
-                                 nMaxChunkSize /
-                                     (static_cast<GIntBig>(nBlockXSize) *
-                                      nChunkYSize * nDstDataTypeSize))));
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory in GDALChecksumImageEx()");
+                CPLFree(pabyChunk);
+                pabyChunk = nullptr;
             }
+            for (auto &sLineHash : asLineHashes)
+                CPL_SHA256Init(&sLineHash);
         }
-
-        double *padfLineData = static_cast<double *>(
-            VSI_MALLOC3_VERBOSE(nChunkXSize, nChunkYSize, nDstDataTypeSize));
-        if (padfLineData == nullptr)
+        if (pabyChunk == nullptr)
         {
-            return -1;
+            psCtxt->bError = true;
+            return;
         }
-        const int nValsPerIter = bComplex ? 2 : 1;
 
-        const int nYBlocks = DIV_ROUND_UP(nYSize, nChunkYSize);
-        const int nXBlocks = DIV_ROUND_UP(nXSize, nChunkXSize);
-        for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+        for (int iXStart = 0; iXStart < psCtxt->nXSize;
+             iXStart += psCtxt->nChunkXSize)
         {
-            const int iYStart = iYBlock * nChunkYSize;
-            const int iYEnd =
-                iYBlock == nYBlocks - 1 ? nYSize : iYStart + nChunkYSize;
-            const int nChunkActualHeight = iYEnd - iYStart;
-            for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
+            const int nChunkActualXSize =
+                std::min(psCtxt->nChunkXSize, psCtxt->nXSize - iXStart);
+            CPLErr eErr;
             {
-                const int iXStart = iXBlock * nChunkXSize;
-                const int iXEnd =
-                    iXBlock == nXBlocks - 1 ? nXSize : iXStart + nChunkXSize;
-                const int nChunkActualXSize = iXEnd - iXStart;
-                if (GDALRasterIO(
-                        hBand, GF_Read, iXStart, iYStart, nChunkActualXSize,
-                        nChunkActualHeight, padfLineData, nChunkActualXSize,
-                        nChunkActualHeight, eDstDataType, 0, 0) != CE_None)
-                {
-                    CPLError(CE_Failure, CPLE_FileIO,
-                             "Checksum value could not be computed due to I/O "
-                             "read error.");
-                    nChecksum = -1;
-                    iYBlock = nYBlocks;
-                    break;
-                }
-                const size_t xIters =
-                    static_cast<size_t>(nValsPerIter) * nChunkActualXSize;
-                for (int iY = iYStart; iY < iYEnd; ++iY)
-                {
-                    // Initialize iPrime so that it is consistent with a
-                    // per full line iteration strategy
-                    iPrime = (nValsPerIter *
-                              (static_cast<int64_t>(iY) * nXSize + iXStart)) %
-                             11;
-                    const size_t nOffset = nValsPerIter *
-                                           static_cast<size_t>(iY - iYStart) *
-                                           nChunkActualXSize;
-                    for (size_t i = 0; i < xIters; ++i)
-                    {
-                        const double dfVal = padfLineData[nOffset + i];
-                        nChecksum += IntFromDouble(dfVal) % anPrimes[iPrime++];
-                        if (iPrime > 10)
-                            iPrime = 0;
-                    }
-                    nChecksum &= 0xffff;
-                }
+                std::unique_ptr<std::lock_guard<std::mutex>> poLock;
+                if (psCtxt->poReadMutex)
+                    poLock = std::make_unique<std::lock_guard<std::mutex>>(
+                        *(psCtxt->poReadMutex));
+                eErr = psCtxt->poBand->RasterIO(
+                    GF_Read, psCtxt->nXOff + iXStart,
+                    psCtxt->nYOff + psStrip->iYStart, nChunkActualXSize,
+                    nLines, pabyChunk, nChunkActualXSize, nLines,
+                    psCtxt->eReadDataType, 0, 0, nullptr);
             }
-        }
-
-        CPLFree(padfLineData);
-    }
-    else if (bIsFloatingPoint)
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CFloat64 : GDT_Float64;
-
-        double *padfLineData = static_cast<double *>(VSI_MALLOC2_VERBOSE(
-            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
-        if (padfLineData == nullptr)
-        {
-            return -1;
-        }
-
-        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
-        {
-            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
-                             padfLineData, nXSize, 1, eDstDataType, 0,
-                             0) != CE_None)
+            if (eErr != CE_None)
             {
                 CPLError(CE_Failure, CPLE_FileIO,
-                         "Checksum value couldn't be computed due to "
-                         "I/O read error.");
-                nChecksum = -1;
+                         "Checksum value could not be computed due to I/O "
+                         "read error.");
+                psCtxt->bError = true;
                 break;
             }
-            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
-                                           : static_cast<size_t>(nXSize);
 
-            for (size_t i = 0; i < nCount; i++)
+            const size_t nLineBytes =
+                static_cast<size_t>(nChunkActualXSize) * nReadDTSize;
+            const size_t nValues =
+                static_cast<size_t>(psCtxt->nValsPerIter) * nChunkActualXSize;
+            for (int iLine = 0; iLine < nLines; ++iLine)
             {
-                const double dfVal = padfLineData[i];
-                nChecksum += IntFromDouble(dfVal) % anPrimes[iPrime++];
-                if (iPrime > 10)
-                    iPrime = 0;
+                GByte *pabyLine = pabyChunk + iLine * nLineBytes;
+                const GByte *pabyValues = pabyLine;
+                if (psCtxt->eReadDataType != psCtxt->eDstDataType)
+                {
+                    GDALCopyWords64(pabyLine, psCtxt->eReadDataType,
+                                    nReadDTSize, abyConverted.data(),
+                                    psCtxt->eDstDataType, nDstDTSize,
+                                    nChunkActualXSize);
+                    pabyValues = abyConverted.data();
+                }
+
+                // Index of the prime number of the first value of the line,
+                // consistent with a per full line iteration strategy
+                const int iPrime = static_cast<int>(
+                    (psCtxt->nValsPerIter *
+                     (static_cast<int64_t>(psStrip->iYStart + iLine) *
+                          psCtxt->nXSize +
+                      iXStart)) %
+                    11);
+                if (psCtxt->eDstDataType == GDT_Float64 ||
+                    psCtxt->eDstDataType == GDT_CFloat64)
+                {
+                    psStrip->nChecksum += ChecksumValues(
+                        reinterpret_cast<const double *>(pabyValues), nValues,
+                        iPrime);
+                }
+                else
+                {
+                    psStrip->nChecksum += ChecksumValues(
+                        reinterpret_cast<const GInt32 *>(pabyValues), nValues,
+                        iPrime);
+                }
 
-                nChecksum &= 0xffff;
+                if (psCtxt->bHash)
+                {
+#ifdef CPL_MSB
+                    const int nWordSize = nReadDTSize / psCtxt->nValsPerIter;
+                    if (nWordSize > 1)
+                        GDALSwapWordsEx(pabyLine, nWordSize,
+                                        static_cast<int>(nValues), nWordSize);
+#endif
+                    CPL_SHA256Update(&asLineHashes[iLine], pabyLine,
+                                     nLineBytes);
+                }
             }
         }
 
-        CPLFree(padfLineData);
-    }
-    else if (nXOff == 0 && nYOff == 0)
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CInt32 : GDT_Int32;
-        int nBlockXSize = 0;
-        int nBlockYSize = 0;
-        GDALGetBlockSize(hBand, &nBlockXSize, &nBlockYSize);
-        const int nDstDataTypeSize = GDALGetDataTypeSizeBytes(eDstDataType);
-        int nChunkXSize = nBlockXSize;
-        const int nChunkYSize = nBlockYSize;
-        if (nBlockXSize < nXSize)
+        if (!psCtxt->bError && psCtxt->bHash)
         {
-            const GIntBig nMaxChunkSize =
-                std::max(static_cast<GIntBig>(10 * 1000 * 1000),
-                         GDALGetCacheMax64() / 10);
-            if (nDstDataTypeSize > 0 &&
-                static_cast<GIntBig>(nXSize) * nChunkYSize <
-                    nMaxChunkSize / nDstDataTypeSize)
-            {
-                // A full line of height nChunkYSize can fit in the maximum
-                // allowed memory
-                nChunkXSize = nXSize;
-            }
-            else
+            for (int iLine = 0; iLine < nLines; ++iLine)
             {
-                // Otherwise compute a size that is a multiple of nBlockXSize
-                nChunkXSize = static_cast<int>(std::min(
-                    static_cast<GIntBig>(nXSize),
-                    nBlockXSize *
-                        std::max(static_cast<GIntBig>(1),
-                                 nMaxChunkSize /
-                                     (static_cast<GIntBig>(nBlockXSize) *
-                                      nChunkYSize * nDstDataTypeSize))));
+                CPL_SHA256Final(
+                    &asLineHashes[iLine],
+                    psCtxt->aabyLineDigests[psStrip->iYStart + iLine].data());
             }
         }
 
-        int *panChunkData = static_cast<GInt32 *>(
-            VSI_MALLOC3_VERBOSE(nChunkXSize, nChunkYSize, nDstDataTypeSize));
-        if (panChunkData == nullptr)
-        {
-            return -1;
-        }
-        const int nValsPerIter = bComplex ? 2 : 1;
+        CPLFree(pabyChunk);
+    };
 
-        const int nYBlocks = DIV_ROUND_UP(nYSize, nChunkYSize);
-        const int nXBlocks = DIV_ROUND_UP(nXSize, nChunkXSize);
-        for (int iYBlock = 0; iYBlock < nYBlocks; ++iYBlock)
+    Context sCtxt;
+    sCtxt.poBand = poBand;
+    sCtxt.nXOff = nXOff;
+    sCtxt.nYOff = nYOff;
+    sCtxt.nXSize = nXSize;
+    sCtxt.eReadDataType = eReadDataType;
+    sCtxt.eDstDataType = eDstDataType;
+    sCtxt.nValsPerIter = nValsPerIter;
+    sCtxt.nChunkXSize = nChunkXSize;
+    sCtxt.bHash = bHash;
+    if (bHash)
+    {
+        try
         {
-            const int iYStart = iYBlock * nChunkYSize;
-            const int iYEnd =
-                iYBlock == nYBlocks - 1 ? nYSize : iYStart + nChunkYSize;
-            const int nChunkActualHeight = iYEnd - iYStart;
-            for (int iXBlock = 0; iXBlock < nXBlocks; ++iXBlock)
-            {
-                const int iXStart = iXBlock * nChunkXSize;
-                const int iXEnd =
-                    iXBlock == nXBlocks - 1 ? nXSize : iXStart + nChunkXSize;
-                const int nChunkActualXSize = iXEnd - iXStart;
-                if (GDALRasterIO(
-                        hBand, GF_Read, iXStart, iYStart, nChunkActualXSize,
-                        nChunkActualHeight, panChunkData, nChunkActualXSize,
-                        nChunkActualHeight, eDstDataType, 0, 0) != CE_None)
-                {
-                    CPLError(CE_Failure, CPLE_FileIO,
-                             "Checksum value could not be computed due to I/O "
-                             "read error.");
-                    nChecksum = -1;
-                    iYBlock = nYBlocks;
-                    break;
-                }
-                const size_t xIters =
-                    static_cast<size_t>(nValsPerIter) * nChunkActualXSize;
-                for (int iY = iYStart; iY < iYEnd; ++iY)
-                {
-                    // Initialize iPrime so that it is consistent with a
-                    // per full line iteration strategy
-                    iPrime = (nValsPerIter *
-                              (static_cast<int64_t>(iY) * nXSize + iXStart)) %
-                             11;
-                    const size_t nOffset = nValsPerIter *
-                                           static_cast<size_t>(iY - iYStart) *
-                                           nChunkActualXSize;
-                    for (size_t i = 0; i < xIters; ++i)
-                    {
-                        nChecksum +=
-                            panChunkData[nOffset + i] % anPrimes[iPrime++];
-                        if (iPrime > 10)
-                            iPrime = 0;
-                    }
-                    nChecksum &= 0xffff;
-                }
-            }
+            sCtxt.aabyLineDigests.resize(nYSize);
         }
-
-        CPLFree(panChunkData);
-    }
-    else
-    {
-        const GDALDataType eDstDataType = bComplex ? GDT_CInt32 : GDT_Int32;
-
-        int *panLineData = static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(
-            nXSize, GDALGetDataTypeSizeBytes(eDstDataType)));
-        if (panLineData == nullptr)
+        catch (const std::exception &)
         {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in GDALChecksumImageEx()");
             return -1;
         }
+    }
 
-        for (int iLine = nYOff; iLine < nYOff + nYSize; iLine++)
-        {
-            if (GDALRasterIO(hBand, GF_Read, nXOff, iLine, nXSize, 1,
-                             panLineData, nXSize, 1, eDstDataType, 0,
-                             0) != CE_None)
-            {
-                CPLError(CE_Failure, CPLE_FileIO,
-                         "Checksum value could not be computed due to I/O "
-                         "read error.");
-                nChecksum = -1;
-                break;
-            }
-            const size_t nCount = bComplex ? static_cast<size_t>(nXSize) * 2
-                                           : static_cast<size_t>(nXSize);
+    // Strips are aligned on the block grid of the band
+    std::vector<Strip> asStrips;
+    for (int iY = 0; iY < nYSize;)
+    {
+        const int iYEnd = std::min(
+            nYSize, ((nYOff + iY) / nChunkYSize + 1) * nChunkYSize - nYOff);
+        Strip sStrip;
+        sStrip.psCtxt = &sCtxt;
+        sStrip.iYStart = iY;
+        sStrip.iYEnd = iYEnd;
+        asStrips.push_back(sStrip);
+        iY = iYEnd;
+    }
 
-            for (size_t i = 0; i < nCount; i++)
-            {
-                nChecksum += panLineData[i] % anPrimes[iPrime++];
-                if (iPrime > 10)
-                    iPrime = 0;
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && asStrips.size() > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    std::mutex oReadMutex;
+    if (poJobQueue)
+    {
+        GDALDataset *poDS = poBand->GetDataset();
+        if (!poDS || !poDS->IsThreadSafe())
+            sCtxt.poReadMutex = &oReadMutex;
+        sCtxt.bSetNumThreads = true;
+    }
+    for (auto &sStrip : asStrips)
+    {
+        if (!poJobQueue || !poJobQueue->SubmitJob(ProcessStrip, &sStrip))
+            ProcessStrip(&sStrip);
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
 
-                nChecksum &= 0xffff;
-            }
-        }
+    if (sCtxt.bError)
+        return -1;
+
+    // Sum of the contributions of each strip, which does not depend on the
+    // order of evaluation.
+    GIntBig nChecksum = 0;
+    for (const auto &sStrip : asStrips)
+        nChecksum += sStrip.nChecksum;
 
-        CPLFree(panLineData);
+    if (bHash)
+    {
+        GByte abyHash[CPL_SHA256_HASH_SIZE];
+        CPL_SHA256Context sHashCtxt;
+        CPL_SHA256Init(&sHashCtxt);
+        for (const auto &abyLineDigest : sCtxt.aabyLineDigests)
+            CPL_SHA256Update(&sHashCtxt, abyLineDigest.data(),
+                             abyLineDigest.size());
+        CPL_SHA256Final(&sHashCtxt, abyHash);
+        *ppszHash = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
     }
 
-    // coverity[return_overflow]
-    return nChecksum;
+    return static_cast<int>(nChecksum & 0xffff);
 }
@@ -40,6 +40,7 @@
 #include <limits>
 #include <map>
 #include <utility>
+#include <vector>
 #include <algorithm>
 
 #include "cpl_conv.h"
@@ -72,6 +73,156 @@ static void GDALGridGetPointBounds(const void *hFeature, CPLRectObj *pBounds)
     pBounds->maxy = dfY;
 }
 
+/************************************************************************/
+/*                       GDALGridTileCandidates                         */
+/************************************************************************/
+
+// Points found by a single quadtree search over an output tile enlarged by
+// the search radius, and the subset of them that may be used by the current
+// row of the tile.  Points are kept in the order in which
+// CPLQuadTreeSearch() returned them: as the quadtree is always traversed in
+// the same order, filtering them by the area of interest of a grid node
+// gives the same list as a quadtree search over that area.
+struct GDALGridTileCandidates
+{
+    CPLRectObj sTileAoi{};
+    std::vector<GDALGridPoint *> apsTilePoints{};
+    std::vector<double> adfTileX{};
+    std::vector<double> adfTileY{};
+
+    CPLRectObj sRowAoi{};
+    std::vector<GDALGridPoint *> apsRowPoints{};
+    std::vector<double> adfRowX{};
+    std::vector<double> adfRowY{};
+};
+
+/************************************************************************/
+/*                      GDALGridTileCandidatesSet()                     */
+/************************************************************************/
+
+static void GDALGridTileCandidatesSet(GDALGridTileCandidates *psTile,
+                                      const CPLQuadTree *hQuadTree,
+                                      const CPLRectObj &sTileAoi)
+{
+    psTile->sTileAoi = sTileAoi;
+    psTile->apsTilePoints.clear();
+    psTile->adfTileX.clear();
+    psTile->adfTileY.clear();
+    int nFeatureCount = 0;
+    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
+        CPLQuadTreeSearch(hQuadTree, &sTileAoi, &nFeatureCount));
+    psTile->apsTilePoints.assign(papsPoints, papsPoints + nFeatureCount);
+    CPLFree(papsPoints);
+    psTile->adfTileX.resize(nFeatureCount);
+    psTile->adfTileY.resize(nFeatureCount);
+    for (int k = 0; k < nFeatureCount; k++)
+    {
+        const GDALGridPoint *psPoint = psTile->apsTilePoints[k];
+        psTile->adfTileX[k] = psPoint->psXYArrays->padfX[psPoint->i];
+        psTile->adfTileY[k] = psPoint->psXYArrays->padfY[psPoint->i];
+    }
+    // Invalidate the row selection.
+    psTile->sRowAoi.minx = 0;
+    psTile->sRowAoi.maxx = -1;
+}
+
+/************************************************************************/
+/*                    GDALGridTileCandidatesSetRow()                    */
+/************************************************************************/
+
+// Select the candidates of the tile whose Y is in [dfMinY, dfMaxY].
+static void GDALGridTileCandidatesSetRow(GDALGridTileCandidates *psTile,
+                                         double dfMinY, double dfMaxY)
+{
+    psTile->sRowAoi = psTile->sTileAoi;
+    psTile->sRowAoi.miny = std::max(dfMinY, psTile->sTileAoi.miny);
+    psTile->sRowAoi.maxy = std::min(dfMaxY, psTile->sTileAoi.maxy);
+    psTile->apsRowPoints.clear();
+    psTile->adfRowX.clear();
+    psTile->adfRowY.clear();
+    const size_t nCount = psTile->apsTilePoints.size();
+    const double *padfY = psTile->adfTileY.data();
+    for (size_t k = 0; k < nCount; k++)
+    {
+        if (padfY[k] >= dfMinY && padfY[k] <= dfMaxY)
+        {
+            psTile->apsRowPoints.push_back(psTile->apsTilePoints[k]);
+            psTile->adfRowX.push_back(psTile->adfTileX[k]);
+            psTile->adfRowY.push_back(padfY[k]);
+        }
+    }
+}
+
+/************************************************************************/
+/*                        GDALGridQuadTreeSearch()                      */
+/************************************************************************/
+
+static inline bool GDALGridRectContains(const CPLRectObj &sOuter,
+                                        const CPLRectObj *psInner)
+{
+    return psInner->minx >= sOuter.minx && psInner->maxx <= sOuter.maxx &&
+           psInner->miny >= sOuter.miny && psInner->maxy <= sOuter.maxy;
+}
+
+// Equivalent of CPLQuadTreeSearch() over the quadtree of the parameters,
+// that uses the candidates of the current tile when they cover the area of
+// interest.  The returned array must be freed with CPLFree().
+static GDALGridPoint **
+GDALGridQuadTreeSearch(const GDALGridExtraParameters *psExtraParams,
+                       const CPLRectObj *psAoi, int *pnFeatureCount)
+{
+    const GDALGridTileCandidates *psTile = psExtraParams->psTileCandidates;
+    if (psTile != nullptr)
+    {
+        const std::vector<GDALGridPoint *> *papsCandidates = nullptr;
+        const double *padfX = nullptr;
+        const double *padfY = nullptr;
+        if (GDALGridRectContains(psTile->sRowAoi, psAoi))
+        {
+            papsCandidates = &psTile->apsRowPoints;
+            padfX = psTile->adfRowX.data();
+            padfY = psTile->adfRowY.data();
+        }
+        else if (GDALGridRectContains(psTile->sTileAoi, psAoi))
+        {
+            papsCandidates = &psTile->apsTilePoints;
+            padfX = psTile->adfTileX.data();
+            padfY = psTile->adfTileY.data();
+        }
+        if (papsCandidates)
+        {
+            const double dfMinX = psAoi->minx;
+            const double dfMaxX = psAoi->maxx;
+            const double dfMinY = psAoi->miny;
+            const double dfMaxY = psAoi->maxy;
+            const int nCandidates = static_cast<int>(papsCandidates->size());
+            int nCount = 0;
+            for (int k = 0; k < nCandidates; k++)
+            {
+                nCount += (padfX[k] >= dfMinX) & (padfX[k] <= dfMaxX) &
+                          (padfY[k] >= dfMinY) & (padfY[k] <= dfMaxY);
+            }
+            *pnFeatureCount = nCount;
+            if (nCount == 0)
+                return nullptr;
+            GDALGridPoint **papsPoints = static_cast<GDALGridPoint **>(
+                CPLMalloc(sizeof(GDALGridPoint *) * nCount));
+            nCount = 0;
+            for (int k = 0; k < nCandidates; k++)
+            {
+                if (padfX[k] >= dfMinX && padfX[k] <= dfMaxX &&
+                    padfY[k] >= dfMinY && padfY[k] <= dfMaxY)
+                {
+                    papsPoints[nCount++] = (*papsCandidates)[k];
+                }
+            }
+            return papsPoints;
+        }
+    }
+    return reinterpret_cast<GDALGridPoint **>(CPLQuadTreeSearch(
+        psExtraParams->hQuadTree, psAoi, pnFeatureCount));
+}
+
 /************************************************************************/
 /*                   GDALGridInverseDistanceToAPower()                  */
 /************************************************************************/
@@ -273,8 +424,7 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -288,8 +438,8 @@ CPLErr GDALGridInverseDistanceToAPowerNearestNeighbor(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -382,8 +532,7 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     const double dfRPower2 = psExtraParams->dfRadiusPower2PreComp;
     const double dfPowerDiv2 = psExtraParams->dfPowerDiv2PreComp;
@@ -396,8 +545,8 @@ static CPLErr GDALGridInverseDistanceToAPowerNearestNeighborPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -682,8 +831,8 @@ CPLErr GDALGridMovingAverage(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -765,8 +914,7 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
@@ -778,8 +926,8 @@ static CPLErr GDALGridMovingAveragePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     if (nFeatureCount != 0)
     {
         for (int k = 0; k < nFeatureCount; k++)
@@ -935,8 +1083,8 @@ CPLErr GDALGridNearestNeighbor(const void *poOptionsIn, GUInt32 nPoints,
             sAoi.maxx = dfXPoint + dfSearchRadius;
             sAoi.maxy = dfYPoint + dfSearchRadius;
             int nFeatureCount = 0;
-            GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-                CPLQuadTreeSearch(hQuadTree, &sAoi, &nFeatureCount));
+            GDALGridPoint **papsPoints =
+                GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
             if (nFeatureCount != 0)
             {
                 // Nearest distance will be initialized with the distance to the
@@ -1085,8 +1233,8 @@ CPLErr GDALGridDataMetricMinimum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1179,8 +1327,7 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1188,8 +1335,8 @@ static CPLErr GDALGridDataMetricMinimumOrMaximumPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -1379,8 +1526,8 @@ CPLErr GDALGridDataMetricMaximum(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1536,8 +1683,8 @@ CPLErr GDALGridDataMetricRange(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1632,8 +1779,7 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1641,8 +1787,8 @@ static CPLErr GDALGridDataMetricRangePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -1806,8 +1952,8 @@ CPLErr GDALGridDataMetricCount(const void *poOptionsIn, GUInt32 nPoints,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -1894,8 +2040,7 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -1903,8 +2048,8 @@ static CPLErr GDALGridDataMetricCountPerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -2067,8 +2212,8 @@ CPLErr GDALGridDataMetricAverageDistance(const void *poOptionsIn,
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount; k++)
@@ -2158,8 +2303,7 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
 
     GDALGridExtraParameters *psExtraParams =
         static_cast<GDALGridExtraParameters *>(hExtraParamsIn);
-    const CPLQuadTree *phQuadTree = psExtraParams->hQuadTree;
-    CPLAssert(phQuadTree);
+    CPLAssert(psExtraParams->hQuadTree);
 
     CPLRectObj sAoi;
     sAoi.minx = dfXPoint - dfSearchRadius;
@@ -2167,8 +2311,8 @@ static CPLErr GDALGridDataMetricAverageDistancePerQuadrant(
     sAoi.maxx = dfXPoint + dfSearchRadius;
     sAoi.maxy = dfYPoint + dfSearchRadius;
     int nFeatureCount = 0;
-    GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-        CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+    GDALGridPoint **papsPoints =
+        GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
     std::multimap<double, double> oMapDistanceToZValuesPerQuadrant[4];
 
     if (nFeatureCount != 0)
@@ -2333,8 +2477,8 @@ CPLErr GDALGridDataMetricAverageDistancePts(
         sAoi.maxx = dfXPoint + dfSearchRadius;
         sAoi.maxy = dfYPoint + dfSearchRadius;
         int nFeatureCount = 0;
-        GDALGridPoint **papsPoints = reinterpret_cast<GDALGridPoint **>(
-            CPLQuadTreeSearch(phQuadTree, &sAoi, &nFeatureCount));
+        GDALGridPoint **papsPoints =
+            GDALGridQuadTreeSearch(psExtraParams, &sAoi, &nFeatureCount);
         if (nFeatureCount != 0)
         {
             for (int k = 0; k < nFeatureCount - 1; k++)
@@ -2569,6 +2713,12 @@ struct _GDALGridJob
     int (*pfnProgress)(GDALGridJob *psJob);
     GDALDataType eType;
 
+    // Size in pixels of the square output tiles whose candidate points are
+    // collected once, or 0 to process by rows.  When non-zero, a job
+    // processes rows of tiles, and nYStart / nYStep are in rows of tiles.
+    GUInt32 nTileSize;
+    double dfTileSearchRadius;
+
     int *pnCounter;
     volatile int *pbStop;
     CPLCond *hCond;
@@ -2613,6 +2763,161 @@ static int GDALGridProgressMonoThread(GDALGridJob *psJob)
     return FALSE;
 }
 
+/************************************************************************/
+/*                       GDALGridJobProcessTiles()                      */
+/************************************************************************/
+
+// Process the job by square tiles.  The quadtree is searched once per tile,
+// over the tile enlarged by the search radius, and the grid nodes of the tile
+// are computed from these candidates.
+static void GDALGridJobProcessTiles(GDALGridJob *psJob)
+{
+    int (*pfnProgress)(GDALGridJob * psJob) = psJob->pfnProgress;
+    const GUInt32 nXSize = psJob->nXSize;
+    const GUInt32 nTileSize = psJob->nTileSize;
+
+    double *padfValues = static_cast<double *>(
+        VSI_MALLOC3_VERBOSE(sizeof(double), nXSize, nTileSize));
+    GDALGridTileCandidates *psTile = nullptr;
+    try
+    {
+        psTile = new GDALGridTileCandidates();
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+    }
+    if (padfValues == nullptr || psTile == nullptr)
+    {
+        CPLFree(padfValues);
+        delete psTile;
+        *(psJob->pbStop) = TRUE;
+        if (pfnProgress != nullptr)
+            pfnProgress(psJob);  // To notify the main thread.
+        return;
+    }
+
+    const GUInt32 nYSize = psJob->nYSize;
+    const double dfXMin = psJob->dfXMin;
+    const double dfYMin = psJob->dfYMin;
+    const double dfDeltaX = psJob->dfDeltaX;
+    const double dfDeltaY = psJob->dfDeltaY;
+    const double dfRadius = psJob->dfTileSearchRadius;
+    GDALGridFunction pfnGDALGridMethod = psJob->pfnGDALGridMethod;
+    GDALGridExtraParameters sExtraParameters = *psJob->psExtraParameters;
+    sExtraParameters.psTileCandidates = psTile;
+    const GDALDataType eType = psJob->eType;
+
+    const int nDataTypeSize = GDALGetDataTypeSizeBytes(eType);
+    const size_t nLineSpace = static_cast<size_t>(nXSize) * nDataTypeSize;
+    const GUInt32 nTileRows = (nYSize + nTileSize - 1) / nTileSize;
+
+    try
+    {
+        for (GUInt32 iTileRow = psJob->nYStart;
+             iTileRow < nTileRows && !*psJob->pbStop;
+             iTileRow += psJob->nYStep)
+        {
+            const GUInt32 nYStart = iTileRow * nTileSize;
+            const GUInt32 nYEnd = std::min(nYStart + nTileSize, nYSize);
+
+            for (GUInt32 nXStart = 0; nXStart < nXSize && !*psJob->pbStop;
+                 nXStart += nTileSize)
+            {
+                const GUInt32 nXEnd = std::min(nXStart + nTileSize, nXSize);
+
+                // Use the same expressions as for the grid nodes, so that
+                // the area of interest of each node is within the one of
+                // the tile.
+                const double dfX1 = dfXMin + (nXStart + 0.5) * dfDeltaX;
+                const double dfX2 = dfXMin + (nXEnd - 1 + 0.5) * dfDeltaX;
+                const double dfY1 = dfYMin + (nYStart + 0.5) * dfDeltaY;
+                const double dfY2 = dfYMin + (nYEnd - 1 + 0.5) * dfDeltaY;
+                CPLRectObj sTileAoi;
+                sTileAoi.minx = std::min(dfX1, dfX2) - dfRadius;
+                sTileAoi.maxx = std::max(dfX1, dfX2) + dfRadius;
+                sTileAoi.miny = std::min(dfY1, dfY2) - dfRadius;
+                sTileAoi.maxy = std::max(dfY1, dfY2) + dfRadius;
+                GDALGridTileCandidatesSet(psTile, sExtraParameters.hQuadTree,
+                                          sTileAoi);
+
+                for (GUInt32 nYPoint = nYStart; nYPoint < nYEnd; nYPoint++)
+                {
+                    const double dfYPoint =
+                        dfYMin + (nYPoint + 0.5) * dfDeltaY;
+                    GDALGridTileCandidatesSetRow(psTile, dfYPoint - dfRadius,
+                                                 dfYPoint + dfRadius);
+                    double *padfRowValues =
+                        padfValues +
+                        static_cast<size_t>(nYPoint - nYStart) * nXSize;
+
+                    for (GUInt32 nXPoint = nXStart; nXPoint < nXEnd;
+                         nXPoint++)
+                    {
+                        const double dfXPoint =
+                            dfXMin + (nXPoint + 0.5) * dfDeltaX;
+
+                        if ((*pfnGDALGridMethod)(
+                                psJob->poOptions, psJob->nPoints, psJob->padfX,
+                                psJob->padfY, psJob->padfZ, dfXPoint, dfYPoint,
+                                padfRowValues + nXPoint,
+                                &sExtraParameters) != CE_None)
+                        {
+                            CPLError(
+                                CE_Failure, CPLE_AppDefined,
+                                "Gridding failed at X position %lu, "
+                                "Y position %lu",
+                                static_cast<long unsigned int>(nXPoint),
+                                static_cast<long unsigned int>(nYPoint));
+                            *psJob->pbStop = TRUE;
+                            break;
+                        }
+                    }
+                    if (*psJob->pbStop)
+                        break;
+                }
+            }
+
+            if (*psJob->pbStop)
+            {
+                if (pfnProgress != nullptr)
+                    pfnProgress(psJob);  // To notify the main thread.
+                break;
+            }
+
+            for (GUInt32 nYPoint = nYStart; nYPoint < nYEnd; nYPoint++)
+            {
+                GDALCopyWords(padfValues +
+                                  static_cast<size_t>(nYPoint - nYStart) *
+                                      nXSize,
+                              GDT_Float64, sizeof(double),
+                              psJob->pabyData + nYPoint * nLineSpace, eType,
+                              nDataTypeSize, nXSize);
+            }
+
+            bool bStop = false;
+            for (GUInt32 nYPoint = nYStart;
+                 nYPoint < nYEnd && pfnProgress != nullptr && !bStop;
+                 nYPoint++)
+            {
+                bStop = pfnProgress(psJob) != FALSE;
+            }
+            if (bStop)
+                break;
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+        *psJob->pbStop = TRUE;
+        if (pfnProgress != nullptr)
+            pfnProgress(psJob);  // To notify the main thread.
+    }
+
+    delete psTile;
+    CPLFree(padfValues);
+}
+
 /************************************************************************/
 /*                         GDALGridJobProcess()                         */
 /************************************************************************/
@@ -2620,6 +2925,12 @@ static int GDALGridProgressMonoThread(GDALGridJob *psJob)
 static void GDALGridJobProcess(void *user_data)
 {
     GDALGridJob *const psJob = static_cast<GDALGridJob *>(user_data);
+    if (psJob->nTileSize > 0)
+    {
+        GDALGridJobProcessTiles(psJob);
+        return;
+    }
+
     int (*pfnProgress)(GDALGridJob * psJob) = psJob->pfnProgress;
     const GUInt32 nXSize = psJob->nXSize;
 
@@ -2715,6 +3026,10 @@ struct GDALGridContext
     double *padfZ;
     bool bFreePadfXYZArrays;
 
+    // Radius of the quadtree searches of the gridding method, or 0 if it
+    // does not do fixed-size searches.
+    double dfTileSearchRadius;
+
     CPLWorkerThreadPool *poWorkerThreadPool;
 };
 
@@ -2744,6 +3059,12 @@ static void GDALGridContextCreateQuadTree(GDALGridContext *psContext);
  * the number of worker threads, or ALL_CPUS to use all the cores/CPUs of the
  * computer (default value).
  *
+ * Starting with GDAL 3.10, when the search radius of a method using a
+ * quadtree spans several output cells, the grid is processed by square tiles:
+ * the candidate points of a tile are collected with a single quadtree search,
+ * and the cells of the tile are computed from them. Tiles are distributed over
+ * the worker threads. The result is the same as with a search per cell.
+ *
  * @param eAlgorithm Gridding method.
  * @param poOptions Options to control chosen gridding method.
  * @param nPoints Number of elements in input arrays.
@@ -3212,6 +3533,7 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
     psContext->sXYArrays.padfX = padfX;
     psContext->sXYArrays.padfY = padfY;
     psContext->sExtraParameters.hQuadTree = nullptr;
+    psContext->sExtraParameters.psTileCandidates = nullptr;
     psContext->sExtraParameters.dfInitialSearchRadius = 0.0;
     psContext->sExtraParameters.pafX = pafXAligned;
     psContext->sExtraParameters.pafY = pafYAligned;
@@ -3260,6 +3582,56 @@ GDALGridContext *GDALGridContextCreate(GDALGridAlgorithm eAlgorithm,
         psContext->sExtraParameters.dfRadiusPower2PreComp = pow(dfRadius, 2);
     }
 
+    psContext->dfTileSearchRadius = 0.0;
+    if (psContext->sExtraParameters.hQuadTree != nullptr)
+    {
+        switch (eAlgorithm)
+        {
+            case GGA_InverseDistanceToAPowerNearestNeighbor:
+            {
+                const auto poOpts = static_cast<
+                    const GDALGridInverseDistanceToAPowerNearestNeighborOptions
+                        *>(poOptions);
+                psContext->dfTileSearchRadius = poOpts->dfRadius;
+                break;
+            }
+            case GGA_MovingAverage:
+            {
+                const auto poOpts =
+                    static_cast<const GDALGridMovingAverageOptions *>(
+                        poOptions);
+                psContext->dfTileSearchRadius =
+                    std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+                break;
+            }
+            case GGA_NearestNeighbor:
+            {
+                const auto poOpts =
+                    static_cast<const GDALGridNearestNeighborOptions *>(
+                        poOptions);
+                psContext->dfTileSearchRadius =
+                    std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+                break;
+            }
+            case GGA_MetricMinimum:
+            case GGA_MetricMaximum:
+            case GGA_MetricRange:
+            case GGA_MetricCount:
+            case GGA_MetricAverageDistance:
+            case GGA_MetricAverageDistancePts:
+            {
+                const auto poOpts =
+                    static_cast<const GDALGridDataMetricsOptions *>(poOptions);
+                psContext->dfTileSearchRadius =
+                    std::max(poOpts->dfRadius1, poOpts->dfRadius2);
+                break;
+            }
+            case GGA_InverseDistanceToAPower:
+            case GGA_Linear:
+                break;
+        }
+    }
+
     if (eAlgorithm == GGA_Linear)
     {
         psContext->sExtraParameters.psTriangulation =
@@ -3521,6 +3893,26 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     sJob.pbStop = &bStop;
     sJob.hCond = nullptr;
     sJob.hCondMutex = nullptr;
+    sJob.nTileSize = 0;
+    sJob.dfTileSearchRadius = psContext->dfTileSearchRadius;
+
+    // When the search radius spans several grid nodes, the quadtree is
+    // searched once per tile of about the size of the search radius, instead
+    // of once per grid node.
+    if (psContext->dfTileSearchRadius > 0 && dfDeltaX != 0 && dfDeltaY != 0)
+    {
+        const double dfRadiusInNodes =
+            psContext->dfTileSearchRadius /
+            std::min(std::fabs(dfDeltaX), std::fabs(dfDeltaY));
+        const char *pszTileSize =
+            CPLGetConfigOption("GDAL_GRID_TILE_SIZE", nullptr);
+        const double dfTileSize =
+            pszTileSize ? CPLAtof(pszTileSize)
+                        : std::min(64.0, std::floor(dfRadiusInNodes));
+        if (dfTileSize >= 2)
+            sJob.nTileSize = static_cast<GUInt32>(std::min(
+                dfTileSize, static_cast<double>(std::max(nXSize, nYSize))));
+    }
 
     if (psContext->poWorkerThreadPool == nullptr)
     {
@@ -3535,6 +3927,13 @@ CPLErr GDALGridContextProcess(GDALGridContext *psContext, double dfXMin,
     else
     {
         int nThreads = psContext->poWorkerThreadPool->GetThreadCount();
+        if (sJob.nTileSize > 0)
+        {
+            const GUInt32 nTileRows =
+                (nYSize + sJob.nTileSize - 1) / sJob.nTileSize;
+            nThreads =
+                static_cast<int>(std::min<GUInt32>(nThreads, nTileRows));
+        }
         GDALGridJob *pasJobs = static_cast<GDALGridJob *>(
             CPLMalloc(sizeof(GDALGridJob) * nThreads));
 
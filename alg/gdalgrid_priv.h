@@ -49,9 +49,13 @@ typedef struct
     int i;
 } GDALGridPoint;
 
+struct GDALGridTileCandidates;
+
 typedef struct
 {
     CPLQuadTree *hQuadTree;
+    /*! Candidate points of the output tile being processed, or NULL. */
+    struct GDALGridTileCandidates *psTileCandidates;
     double dfInitialSearchRadius;
     float *pafX;  // Aligned to be usable with AVX
     float *pafY;
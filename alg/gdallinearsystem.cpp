@@ -35,7 +35,9 @@
 
 #include "cpl_port.h"
 #include "cpl_conv.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdallinearsystem.h"
+#include "gdal_thread_pool.h"
 
 #ifdef HAVE_ARMADILLO
 #include "armadillo_headers.h"
@@ -45,13 +47,97 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <memory>
 
 #ifndef HAVE_ARMADILLO
 namespace
 {
+// Number of columns factorized before the columns on their right are updated,
+// so that each of those columns stays in cache while the updates of all the
+// columns of the panel are applied to it.
+constexpr int LU_PANEL_SIZE = 64;
+
+// Apply the row permutations and the updates of the steps [k0, k1) to the
+// columns [iColStart, iColEnd) on the right of the panel [k0, k1). The
+// updates of each element are done in the same order as in the unblocked
+// algorithm, so that the results are the same.
+void updateColumns(GDALMatrix &A, const std::vector<int> &pivots, int k0,
+                   int k1, int iColStart, int iColEnd)
+{
+    int const m = A.getNumRows();
+    for (int iCol = iColStart; iCol < iColEnd; ++iCol)
+    {
+        double *col = &A(0, iCol);
+        for (int step = k0; step < k1; ++step)
+        {
+            if (pivots[step] != step)
+                std::swap(col[pivots[step]], col[step]);
+        }
+        int step = k0;
+        // Apply the updates of 4 steps at once, so that each element of the
+        // column is loaded and stored once for them.
+        for (; step + 3 < k1; step += 4)
+        {
+            const double *colStep0 = &A(0, step);
+            const double *colStep1 = colStep0 + m;
+            const double *colStep2 = colStep1 + m;
+            const double *colStep3 = colStep2 + m;
+            const double u0 = col[step];
+            col[step + 1] -= colStep0[step + 1] * u0;
+            const double u1 = col[step + 1];
+            col[step + 2] -= colStep0[step + 2] * u0;
+            col[step + 2] -= colStep1[step + 2] * u1;
+            const double u2 = col[step + 2];
+            col[step + 3] -= colStep0[step + 3] * u0;
+            col[step + 3] -= colStep1[step + 3] * u1;
+            col[step + 3] -= colStep2[step + 3] * u2;
+            const double u3 = col[step + 3];
+            for (int iRow = step + 4; iRow < m; ++iRow)
+            {
+                double val = col[iRow];
+                val -= colStep0[iRow] * u0;
+                val -= colStep1[iRow] * u1;
+                val -= colStep2[iRow] * u2;
+                val -= colStep3[iRow] * u3;
+                col[iRow] = val;
+            }
+        }
+        for (; step < k1; ++step)
+        {
+            const double *colStep = &A(0, step);
+            const double u = col[step];
+            for (int iRow = step + 1; iRow < m; ++iRow)
+            {
+                col[iRow] -= colStep[iRow] * u;
+            }
+        }
+    }
+}
+
+struct UpdateColumnsJob
+{
+    GDALMatrix *A = nullptr;
+    const std::vector<int> *pivots = nullptr;
+    int k0 = 0;
+    int k1 = 0;
+    int iColStart = 0;
+    int iColEnd = 0;
+};
+
+void updateColumnsJobFunc(void *pData)
+{
+    auto job = static_cast<UpdateColumnsJob *>(pData);
+    updateColumns(*job->A, *job->pivots, job->k0, job->k1, job->iColStart,
+                  job->iColEnd);
+}
+
 // LU decomposition of the quadratic matrix A
 // see https://en.wikipedia.org/wiki/LU_decomposition#C_code_examples
-bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
+// The decomposition is done by panels of LU_PANEL_SIZE columns, and the
+// columns on the right of each panel are updated in parallel when nThreads > 1
+bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps,
+           int nThreads)
 {
     assert(A.getNumRows() == A.getNumCols());
     if (eps < 0)
@@ -62,65 +148,137 @@ bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
     std::vector<int> perm(m);
     for (int iRow = 0; iRow < m; ++iRow)
         perm[iRow] = iRow;
+    // row swapped with each row at each step
+    std::vector<int> pivots(perm);
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1 && m > 2 * LU_PANEL_SIZE)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+    std::vector<UpdateColumnsJob> jobs;
 
-    for (int step = 0; step < m - 1; ++step)
+    for (int k0 = 0; k0 < m - 1; k0 += LU_PANEL_SIZE)
     {
-        // determine pivot element
-        int iMax = step;
-        double dMax = std::abs(A(step, step));
-        for (int i = step + 1; i < m; ++i)
+        int const k1 = std::min(k0 + LU_PANEL_SIZE, m);
+        for (int step = k0; step < std::min(k1, m - 1); ++step)
         {
-            if (std::abs(A(i, step)) > dMax)
+            // determine pivot element
+            int iMax = step;
+            double dMax = std::abs(A(step, step));
+            for (int i = step + 1; i < m; ++i)
             {
-                iMax = i;
-                dMax = std::abs(A(i, step));
+                if (std::abs(A(i, step)) > dMax)
+                {
+                    iMax = i;
+                    dMax = std::abs(A(i, step));
+                }
+            }
+            if (dMax <= eps)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "GDALLinearSystemSolve: matrix not invertible");
+                return false;
+            }
+            // swap rows of the panel. The other columns are swapped later.
+            pivots[step] = iMax;
+            if (iMax != step)
+            {
+                std::swap(perm[iMax], perm[step]);
+                for (int iCol = k0; iCol < k1; ++iCol)
+                {
+                    std::swap(A(iMax, iCol), A(step, iCol));
+                }
+            }
+            for (int iRow = step + 1; iRow < m; ++iRow)
+            {
+                A(iRow, step) /= A(step, step);
+            }
+            for (int iCol = step + 1; iCol < k1; ++iCol)
+            {
+                const double u = A(step, iCol);
+                for (int iRow = step + 1; iRow < m; ++iRow)
+                {
+                    A(iRow, iCol) -= A(iRow, step) * u;
+                }
             }
         }
-        if (dMax <= eps)
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "GDALLinearSystemSolve: matrix not invertible");
-            return false;
-        }
-        // swap rows
-        if (iMax != step)
+
+        // update the columns on the right of the panel
+        int const nCols = m - k1;
+        int const nJobs =
+            poJobQueue ? std::min(nThreads, nCols / LU_PANEL_SIZE) : 1;
+        if (nJobs > 1)
         {
-            std::swap(perm[iMax], perm[step]);
-            for (int iCol = 0; iCol < m; ++iCol)
+            jobs.resize(nJobs);
+            for (int i = 0; i < nJobs; ++i)
             {
-                std::swap(A(iMax, iCol), A(step, iCol));
+                auto &job = jobs[i];
+                job.A = &A;
+                job.pivots = &pivots;
+                job.k0 = k0;
+                job.k1 = k1;
+                job.iColStart =
+                    k1 + static_cast<int>(static_cast<int64_t>(nCols) * i /
+                                          nJobs);
+                job.iColEnd =
+                    k1 + static_cast<int>(static_cast<int64_t>(nCols) *
+                                          (i + 1) / nJobs);
+                poJobQueue->SubmitJob(updateColumnsJobFunc, &job);
             }
+            poJobQueue->WaitCompletion();
         }
-        for (int iRow = step + 1; iRow < m; ++iRow)
+        else
         {
-            A(iRow, step) /= A(step, step);
+            updateColumns(A, pivots, k0, k1, k1, m);
         }
-        for (int iCol = step + 1; iCol < m; ++iCol)
+    }
+
+    // apply the row permutations of the next panels to the columns of L
+    for (int iCol = 0; iCol < m; ++iCol)
+    {
+        double *col = &A(0, iCol);
+        int const k1 = std::min((iCol / LU_PANEL_SIZE + 1) * LU_PANEL_SIZE, m);
+        for (int step = k1; step < m - 1; ++step)
         {
-            for (int iRow = step + 1; iRow < m; ++iRow)
-            {
-                A(iRow, iCol) -= A(iRow, step) * A(step, iCol);
-            }
+            if (pivots[step] != step)
+                std::swap(col[pivots[step]], col[step]);
         }
     }
 
     // LUP solve;
+    // The forward substitution goes through the columns of L, and the
+    // backward one deals with all the columns of RHS at once, so that
+    // the elements of A are read in memory order, or at least only once.
     for (int iCol = 0; iCol < n; ++iCol)
     {
         for (int iRow = 0; iRow < m; ++iRow)
         {
             X(iRow, iCol) = RHS(perm[iRow], iCol);
-            for (int k = 0; k < iRow; ++k)
+        }
+        for (int k = 0; k < m; ++k)
+        {
+            const double x = X(k, iCol);
+            for (int iRow = k + 1; iRow < m; ++iRow)
             {
-                X(iRow, iCol) -= A(iRow, k) * X(k, iCol);
+                X(iRow, iCol) -= A(iRow, k) * x;
             }
         }
-        for (int iRow = m - 1; iRow >= 0; --iRow)
+    }
+    for (int iRow = m - 1; iRow >= 0; --iRow)
+    {
+        for (int k = iRow + 1; k < m; ++k)
         {
-            for (int k = iRow + 1; k < m; ++k)
+            const double a = A(iRow, k);
+            for (int iCol = 0; iCol < n; ++iCol)
             {
-                X(iRow, iCol) -= A(iRow, k) * X(k, iCol);
+                X(iRow, iCol) -= a * X(k, iCol);
             }
+        }
+        for (int iCol = 0; iCol < n; ++iCol)
+        {
             X(iRow, iCol) /= A(iRow, iRow);
         }
     }
@@ -133,8 +291,10 @@ bool solve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X, double eps)
 /*                                                                      */
 /*   Solves the linear system A*X_i = RHS_i for each column i           */
 /*   where A is a square matrix.                                        */
+/*   nThreads is only used when GDAL is built without Armadillo.        */
 /************************************************************************/
-bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X)
+bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X,
+                           CPL_UNUSED int nThreads)
 {
     assert(A.getNumRows() == RHS.getNumRows());
     assert(A.getNumCols() == X.getNumRows());
@@ -157,7 +317,7 @@ bool GDALLinearSystemSolve(GDALMatrix &A, GDALMatrix &RHS, GDALMatrix &X)
 #endif
 
 #else  // HAVE_ARMADILLO
-        return solve(A, RHS, X, 0);
+        return solve(A, RHS, X, 0, nThreads);
 #endif
     }
     catch (std::exception const &e)
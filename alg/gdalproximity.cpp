@@ -32,15 +32,21 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
+#include "gdal_thread_pool.h"
 
 static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    int *panNearY, int bForward, int iLine,
@@ -49,6 +55,462 @@ static CPLErr ProcessProximityLine(GInt32 *panSrcScanline, int *panNearX,
                                    double *pdfSrcNoDataValue, int nTargetValues,
                                    int *panTargetValues);
 
+/************************************************************************/
+/* ==================================================================== */
+/*              Exact Euclidean distance transform (EDT)                */
+/* ==================================================================== */
+/************************************************************************/
+
+// Separable exact Euclidean distance transform of Felzenszwalb and
+// Huttenlocher ("Distance Transforms of Sampled Functions", 2012).
+// A first pass computes, for each column, the distance to the nearest
+// target pixel of that column. A second pass computes, for each line, the
+// lower envelope of the parabolas centered on each pixel of the line, of
+// height the square of the column distance.
+//
+// All the I/O is done on batches of full-width lines that fit in the
+// memory budget, so that each source block is read only twice whatever its
+// layout. The column distances are computed in two sweeps: a top to bottom
+// sweep, whose results are stored in a working dataset (in memory if they
+// fit in the budget, in a temporary tiled GeoTIFF file otherwise), then a
+// bottom to top sweep, during which the line pass is also done. Each sweep
+// carries the distances of the last line of the previous batch. Within a
+// batch, the work is split between threads; all I/O is done by the calling
+// thread.
+
+namespace
+{
+struct ProximityEDTContext
+{
+    int nXSize = 0;
+    int nYSize = 0;
+    double dfMaxDist = 0;
+    double dfDistMult = 1;
+    const double *pdfSrcNoDataValue = nullptr;
+    int nTargetValues = 0;
+    const int *panTargetValues = nullptr;
+    float fNoDataValue = 0;
+    bool bFixedBufVal = false;
+    double dfFixedBufVal = 0;
+
+    bool IsTarget(GInt32 nVal) const
+    {
+        if (nTargetValues == 0)
+            return nVal != 0;
+        for (int i = 0; i < nTargetValues; i++)
+        {
+            if (nVal == panTargetValues[i])
+                return true;
+        }
+        return false;
+    }
+};
+
+constexpr GInt32 EDT_INFINITE_DIST = std::numeric_limits<GInt32>::max();
+
+struct ProximityEDTJob
+{
+    const ProximityEDTContext *psCtxt = nullptr;
+    const GInt32 *panSrc = nullptr;
+    GInt32 *panDist = nullptr;
+    // Column distances of the line preceding the batch in the direction of
+    // the sweep, or nullptr at the edge of the raster.
+    const GInt32 *panCarry = nullptr;
+    float *pafProximity = nullptr;
+    int nBufXSize = 0;  // width of the buffers
+    int nBufYSize = 0;  // height of the buffers
+    int iStart = 0;     // first column (resp. line) of the job
+    int iEnd = 0;       // last column (resp. line) of the job, excluded
+};
+}  // namespace
+
+/************************************************************************/
+/*                     ProximityEDTDownwardJob()                        */
+/************************************************************************/
+
+// Distance to the nearest target pixel of the same column, above or on the
+// pixel, for the columns [iStart, iEnd[ of a batch of lines.
+static void ProximityEDTDownwardJob(void *pData)
+{
+    const ProximityEDTJob *psJob = static_cast<const ProximityEDTJob *>(pData);
+    const ProximityEDTContext *psCtxt = psJob->psCtxt;
+    const int nBufXSize = psJob->nBufXSize;
+    const int nBufYSize = psJob->nBufYSize;
+
+    for (int iLine = 0; iLine < nBufYSize; ++iLine)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nBufXSize;
+        const GInt32 *panSrcLine = psJob->panSrc + nOffset;
+        GInt32 *panDistLine = psJob->panDist + nOffset;
+        const GInt32 *panPrevDistLine =
+            iLine > 0 ? panDistLine - nBufXSize : psJob->panCarry;
+        for (int i = psJob->iStart; i < psJob->iEnd; ++i)
+        {
+            if (psCtxt->IsTarget(panSrcLine[i]))
+                panDistLine[i] = 0;
+            else if (panPrevDistLine == nullptr ||
+                     panPrevDistLine[i] == EDT_INFINITE_DIST)
+                panDistLine[i] = EDT_INFINITE_DIST;
+            else
+                panDistLine[i] = panPrevDistLine[i] + 1;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      ProximityEDTUpwardJob()                         */
+/************************************************************************/
+
+// Completes the column distances of the columns [iStart, iEnd[ of a batch
+// of lines with the target pixels below them.
+static void ProximityEDTUpwardJob(void *pData)
+{
+    const ProximityEDTJob *psJob = static_cast<const ProximityEDTJob *>(pData);
+    const int nBufXSize = psJob->nBufXSize;
+
+    for (int iLine = psJob->nBufYSize - 1; iLine >= 0; --iLine)
+    {
+        GInt32 *panDistLine =
+            psJob->panDist + static_cast<size_t>(iLine) * nBufXSize;
+        const GInt32 *panNextDistLine = iLine < psJob->nBufYSize - 1
+                                            ? panDistLine + nBufXSize
+                                            : psJob->panCarry;
+        if (panNextDistLine == nullptr)
+            continue;
+        for (int i = psJob->iStart; i < psJob->iEnd; ++i)
+        {
+            if (panNextDistLine[i] != EDT_INFINITE_DIST &&
+                panNextDistLine[i] + 1 < panDistLine[i])
+            {
+                panDistLine[i] = panNextDistLine[i] + 1;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                       ProximityEDTLinesJob()                         */
+/************************************************************************/
+
+// Final proximity values of the lines [iStart, iEnd[ of a batch of
+// full-width lines, from their column distances.
+static void ProximityEDTLinesJob(void *pData)
+{
+    const ProximityEDTJob *psJob = static_cast<const ProximityEDTJob *>(pData);
+    const ProximityEDTContext *psCtxt = psJob->psCtxt;
+    const int nXSize = psJob->nBufXSize;
+    const double dfMaxDistSq = psCtxt->dfMaxDist * psCtxt->dfMaxDist;
+
+    // Lower envelope of the parabolas: apex abscissa, and abscissa from
+    // which each parabola is the lowest one.
+    std::vector<int> anApex(nXSize);
+    std::vector<double> adfBoundary(nXSize + 1);
+    std::vector<double> adfSqDist(nXSize);
+
+    for (int iLine = psJob->iStart; iLine < psJob->iEnd; ++iLine)
+    {
+        const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+        const GInt32 *panSrcLine = psJob->panSrc + nOffset;
+        const GInt32 *panDistLine = psJob->panDist + nOffset;
+        float *pafProximityLine = psJob->pafProximity + nOffset;
+
+        int k = -1;
+        for (int q = 0; q < nXSize; ++q)
+        {
+            if (panDistLine[q] == EDT_INFINITE_DIST)
+                continue;
+            const double dfFq =
+                static_cast<double>(panDistLine[q]) * panDistLine[q];
+            adfSqDist[q] = dfFq;
+            if (k < 0)
+            {
+                k = 0;
+                anApex[0] = q;
+                adfBoundary[0] = -std::numeric_limits<double>::infinity();
+                adfBoundary[1] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            // Abscissa of the intersection with the last parabola of the
+            // envelope, which is removed if hidden by the new one. This
+            // terminates as adfBoundary[0] is -infinity.
+            double s;
+            while (true)
+            {
+                const int v = anApex[k];
+                s = ((dfFq + static_cast<double>(q) * q) -
+                     (adfSqDist[v] + static_cast<double>(v) * v)) /
+                    (2.0 * (q - v));
+                if (s > adfBoundary[k])
+                    break;
+                --k;
+            }
+            ++k;
+            anApex[k] = q;
+            adfBoundary[k] = s;
+            adfBoundary[k + 1] = std::numeric_limits<double>::infinity();
+        }
+
+        int iEnvelope = 0;
+        for (int q = 0; q < nXSize; ++q)
+        {
+            double dfDistSq = std::numeric_limits<double>::infinity();
+            if (k >= 0)
+            {
+                while (adfBoundary[iEnvelope + 1] < q)
+                    ++iEnvelope;
+                const int v = anApex[iEnvelope];
+                dfDistSq = static_cast<double>(q - v) * (q - v) + adfSqDist[v];
+            }
+
+            // Same post-processing as the scanline algorithm.
+            if (dfDistSq == 0.0)
+            {
+                pafProximityLine[q] = 0.0f;
+            }
+            else if ((psCtxt->pdfSrcNoDataValue != nullptr &&
+                      panSrcLine[q] == *(psCtxt->pdfSrcNoDataValue)) ||
+                     !(dfDistSq <= dfMaxDistSq))
+            {
+                pafProximityLine[q] = psCtxt->fNoDataValue;
+            }
+            else if (psCtxt->bFixedBufVal)
+            {
+                pafProximityLine[q] =
+                    static_cast<float>(psCtxt->dfFixedBufVal);
+            }
+            else
+            {
+                pafProximityLine[q] =
+                    static_cast<float>(static_cast<float>(sqrt(dfDistSq)) *
+                                       psCtxt->dfDistMult);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                       RunProximityEDTJobs()                          */
+/************************************************************************/
+
+// Split [0, nCount[ between nThreads jobs and run them.
+static void RunProximityEDTJobs(CPLJobQueue *poJobQueue, CPLThreadFunc pfnFunc,
+                                ProximityEDTJob sTemplate, int nCount,
+                                int nThreads,
+                                std::vector<ProximityEDTJob> &asJobs)
+{
+    const int nJobs = std::max(1, std::min(nThreads, nCount));
+    asJobs.resize(nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        asJobs[i] = sTemplate;
+        asJobs[i].iStart =
+            static_cast<int>(static_cast<GIntBig>(nCount) * i / nJobs);
+        asJobs[i].iEnd =
+            static_cast<int>(static_cast<GIntBig>(nCount) * (i + 1) / nJobs);
+    }
+    if (poJobQueue && nJobs > 1)
+    {
+        for (auto &sJob : asJobs)
+            poJobQueue->SubmitJob(pfnFunc, &sJob);
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            pfnFunc(&sJob);
+    }
+}
+
+/************************************************************************/
+/*                      GDALComputeProximityEDT()                       */
+/************************************************************************/
+
+static CPLErr GDALComputeProximityEDT(GDALRasterBandH hSrcBand,
+                                      GDALRasterBandH hProximityBand,
+                                      const ProximityEDTContext &sCtxt,
+                                      int nThreads,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg)
+{
+    const int nXSize = sCtxt.nXSize;
+    const int nYSize = sCtxt.nYSize;
+
+    // Memory budget of a batch.
+    const char *pszMaxMemory =
+        CPLGetConfigOption("GDAL_PROXIMITY_EDT_MAX_MEMORY", nullptr);
+    const GIntBig nMaxMemory =
+        pszMaxMemory ? std::max(static_cast<GIntBig>(1),
+                                CPLAtoGIntBig(pszMaxMemory))
+                     : std::max(static_cast<GIntBig>(100 * 1000 * 1000),
+                                GDALGetCacheMax64() / 2);
+
+    /* -------------------------------------------------------------------- */
+    /*      Create the working dataset for the column distances.            */
+    /* -------------------------------------------------------------------- */
+    const bool bInMemory = static_cast<GIntBig>(nXSize) * nYSize *
+                               static_cast<GIntBig>(sizeof(GInt32)) <=
+                           nMaxMemory;
+    GDALDriverH hDriver = GDALGetDriverByName(bInMemory ? "MEM" : "GTiff");
+    if (hDriver == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GDALComputeProximity needs %s driver",
+                 bInMemory ? "MEM" : "GTiff");
+        return CE_Failure;
+    }
+    constexpr int TMP_BLOCK_SIZE = 256;
+    CPLString osTmpFile;
+    CPLStringList aosOptions;
+    if (!bInMemory)
+    {
+        osTmpFile = CPLGenerateTempFilename("proximity");
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", TMP_BLOCK_SIZE));
+        aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", TMP_BLOCK_SIZE));
+        aosOptions.SetNameValue("BIGTIFF", "IF_SAFER");
+    }
+    GDALDatasetH hWorkDS = GDALCreate(hDriver, osTmpFile, nXSize, nYSize, 1,
+                                      GDT_Int32, aosOptions.List());
+    if (hWorkDS == nullptr)
+        return CE_Failure;
+    // On Unix, attempt at deleting the temporary file now, so that
+    // if the process gets interrupted, it is automatically destroyed
+    // by the operating system.
+    const bool bTempFileAlreadyDeleted =
+        bInMemory || VSIUnlink(osTmpFile) == 0;
+    GDALRasterBandH hWorkBand = GDALGetRasterBand(hWorkDS, 1);
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+    std::vector<ProximityEDTJob> asJobs;
+
+    // Batches of full-width lines. Aligned on the blocks of the temporary
+    // file when it is used.
+    int nBatchYSize = static_cast<int>(std::min(
+        static_cast<GIntBig>(nYSize),
+        std::max(static_cast<GIntBig>(1),
+                 nMaxMemory / (static_cast<GIntBig>(nXSize) *
+                               static_cast<GIntBig>(2 * sizeof(GInt32) +
+                                                    sizeof(float))))));
+    if (!bInMemory && nBatchYSize > TMP_BLOCK_SIZE)
+        nBatchYSize = nBatchYSize / TMP_BLOCK_SIZE * TMP_BLOCK_SIZE;
+    const int nBatches = (nYSize + nBatchYSize - 1) / nBatchYSize;
+
+    std::vector<GInt32> anSrc;
+    std::vector<GInt32> anDist;
+    std::vector<GInt32> anCarry;
+    std::vector<float> afProximity;
+    CPLErr eErr = CE_None;
+    try
+    {
+        anSrc.resize(static_cast<size_t>(nXSize) * nBatchYSize);
+        anDist.resize(static_cast<size_t>(nXSize) * nBatchYSize);
+        anCarry.resize(nXSize);
+        afProximity.resize(static_cast<size_t>(nXSize) * nBatchYSize);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALComputeProximity()");
+        eErr = CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      First pass: top to bottom sweep of the column distances.        */
+    /* -------------------------------------------------------------------- */
+    for (int iBatch = 0; eErr == CE_None && iBatch < nBatches; ++iBatch)
+    {
+        const int iYOff = iBatch * nBatchYSize;
+        const int nReqYSize = std::min(nBatchYSize, nYSize - iYOff);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iYOff, nXSize, nReqYSize,
+                            anSrc.data(), nXSize, nReqYSize, GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        ProximityEDTJob sJob;
+        sJob.psCtxt = &sCtxt;
+        sJob.panSrc = anSrc.data();
+        sJob.panDist = anDist.data();
+        sJob.panCarry = iBatch > 0 ? anCarry.data() : nullptr;
+        sJob.nBufXSize = nXSize;
+        sJob.nBufYSize = nReqYSize;
+        RunProximityEDTJobs(poJobQueue.get(), ProximityEDTDownwardJob, sJob,
+                            nXSize, nThreads, asJobs);
+
+        memcpy(anCarry.data(),
+               anDist.data() + static_cast<size_t>(nReqYSize - 1) * nXSize,
+               sizeof(GInt32) * nXSize);
+
+        eErr = GDALRasterIO(hWorkBand, GF_Write, 0, iYOff, nXSize, nReqYSize,
+                            anDist.data(), nXSize, nReqYSize, GDT_Int32, 0, 0);
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.5 * (iYOff + nReqYSize) / nYSize, "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: bottom to top sweep of the column distances, and   */
+    /*      lower envelope of each line.                                    */
+    /* -------------------------------------------------------------------- */
+    for (int iBatch = nBatches - 1; eErr == CE_None && iBatch >= 0; --iBatch)
+    {
+        const int iYOff = iBatch * nBatchYSize;
+        const int nReqYSize = std::min(nBatchYSize, nYSize - iYOff);
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iYOff, nXSize, nReqYSize,
+                            anSrc.data(), nXSize, nReqYSize, GDT_Int32, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hWorkBand, GF_Read, 0, iYOff, nXSize,
+                                nReqYSize, anDist.data(), nXSize, nReqYSize,
+                                GDT_Int32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        ProximityEDTJob sJob;
+        sJob.psCtxt = &sCtxt;
+        sJob.panSrc = anSrc.data();
+        sJob.panDist = anDist.data();
+        sJob.panCarry = iBatch < nBatches - 1 ? anCarry.data() : nullptr;
+        sJob.pafProximity = afProximity.data();
+        sJob.nBufXSize = nXSize;
+        sJob.nBufYSize = nReqYSize;
+        RunProximityEDTJobs(poJobQueue.get(), ProximityEDTUpwardJob, sJob,
+                            nXSize, nThreads, asJobs);
+        RunProximityEDTJobs(poJobQueue.get(), ProximityEDTLinesJob, sJob,
+                            nReqYSize, nThreads, asJobs);
+
+        memcpy(anCarry.data(), anDist.data(), sizeof(GInt32) * nXSize);
+
+        eErr = GDALRasterIO(hProximityBand, GF_Write, 0, iYOff, nXSize,
+                            nReqYSize, afProximity.data(), nXSize, nReqYSize,
+                            GDT_Float32, 0, 0);
+
+        if (eErr == CE_None &&
+            !pfnProgress(0.5 + 0.5 * (nYSize - iYOff) / nYSize, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    GDALClose(hWorkDS);
+    if (!bTempFileAlreadyDeleted)
+    {
+        GDALDeleteDataset(GDALGetDriverByName("GTiff"), osTmpFile);
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALComputeProximity()                        */
 /************************************************************************/
@@ -105,6 +567,22 @@ the proximity output.
 
 If this option is set, all pixels within the MAXDIST threadhold are
 set to this fixed value instead of to a proximity distance.
+
+  ALGORITHM=SCANLINE/EXACT
+
+Algorithm used to find the nearest target pixel. SCANLINE, the default,
+propagates the nearest target pixel found in neighbouring pixels, in two
+passes over the lines of the image, and may slightly overestimate some
+distances. EXACT (GDAL >= 3.10) uses an exact separable Euclidean distance
+transform, which can use several threads. It reads the source image twice
+by batches of full-width lines, once from top to bottom and once from
+bottom to top, and stores intermediate results in a temporary file when
+they do not fit in memory.
+
+  NUM_THREADS=number_of_threads/ALL_CPUS
+
+Number of threads to use with ALGORITHM=EXACT. Defaults to the value of the
+GDAL_NUM_THREADS configuration option, or 1. (GDAL >= 3.10)
 */
 
 CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
@@ -153,6 +631,20 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         }
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Which algorithm?                                                */
+    /* -------------------------------------------------------------------- */
+    const char *pszAlgorithm =
+        CSLFetchNameValueDef(papszOptions, "ALGORITHM", "SCANLINE");
+    if (!EQUAL(pszAlgorithm, "SCANLINE") && !EQUAL(pszAlgorithm, "EXACT"))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Unrecognized ALGORITHM value '%s', should be SCANLINE or "
+                 "EXACT.",
+                 pszAlgorithm);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      What is our maxdist value?                                      */
     /* -------------------------------------------------------------------- */
@@ -251,6 +743,38 @@ CPLErr CPL_STDCALL GDALComputeProximity(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the exact distance transform if requested.                  */
+    /* -------------------------------------------------------------------- */
+    if (EQUAL(pszAlgorithm, "EXACT"))
+    {
+        const char *pszThreads =
+            CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                                 CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+        const int nThreads =
+            std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                          ? CPLGetNumCPUs()
+                                          : atoi(pszThreads)));
+
+        ProximityEDTContext sCtxt;
+        sCtxt.nXSize = nXSize;
+        sCtxt.nYSize = nYSize;
+        sCtxt.dfMaxDist = dfMaxDist;
+        sCtxt.dfDistMult = dfDistMult;
+        sCtxt.pdfSrcNoDataValue = pdfSrcNoData;
+        sCtxt.nTargetValues = nTargetValues;
+        sCtxt.panTargetValues = panTargetValues;
+        sCtxt.fNoDataValue = fNoDataValue;
+        sCtxt.bFixedBufVal = bFixedBufVal;
+        sCtxt.dfFixedBufVal = dfFixedBufVal;
+
+        const CPLErr eErr =
+            GDALComputeProximityEDT(hSrcBand, hProximityBand, sCtxt, nThreads,
+                                    pfnProgress, pProgressArg);
+        CPLFree(panTargetValues);
+        return eErr;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      We need a signed type for the working proximity values kept     */
     /*      on disk.  If our proximity band is not signed, then create a    */
@@ -36,7 +36,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
+#include <cmath>
 #include <limits>
+#include <memory>
 #include <vector>
 #include <algorithm>
 
@@ -45,9 +47,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -547,39 +551,80 @@ static void GDALCollectRingsFromGeometry(const OGRGeometry *poShape,
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                          GDALRasterizeShape                          */
+/*                                                                      */
+/*      A geometry (or a part of a geometry) collected as a set of      */
+/*      rings or lines, in pixel/line coordinates of the raster.        */
 /************************************************************************/
-static void gv_rasterize_one_shape(
+
+struct GDALRasterizeShape
+{
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int> aPartSize{};
+};
+
+/************************************************************************/
+/*                     GDALRasterizeCollectShape()                      */
+/************************************************************************/
+
+static void GDALRasterizeCollectShape(const OGRGeometry *poShape,
+                                      GDALBurnValueSrc eBurnValueSrc,
+                                      GDALTransformerFunc pfnTransformer,
+                                      void *pTransformArg,
+                                      GDALRasterizeShape &oShape)
+{
+    oShape.eGeomType = wkbFlatten(poShape->getGeometryType());
+    std::vector<double> &aPointX = oShape.aPointX;
+    std::vector<double> &aPointY = oShape.aPointY;
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform polygon geometries into a set of rings and a part     */
+    /*      size list.                                                      */
+    /* -------------------------------------------------------------------- */
+    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY,
+                                 oShape.aPointVariant, oShape.aPartSize,
+                                 eBurnValueSrc);
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform points if needed.                                     */
+    /* -------------------------------------------------------------------- */
+    if (pfnTransformer != nullptr)
+    {
+        int *panSuccess =
+            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
+
+        // TODO: We need to add all appropriate error checking at some point.
+        pfnTransformer(pTransformArg, FALSE, static_cast<int>(aPointX.size()),
+                       aPointX.data(), aPointY.data(), nullptr, panSuccess);
+        CPLFree(panSuccess);
+    }
+}
+
+/************************************************************************/
+/*                       GDALRasterizeBurnShape()                       */
+/*                                                                      */
+/*      Burn a collected shape into the buffer of the nXOff, nYOff,     */
+/*      nXSize, nYSize window of the raster.  The shape coordinates     */
+/*      are modified.                                                   */
+/************************************************************************/
+
+static void GDALRasterizeBurnShape(
     unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
     int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
-    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
+    GSpacing nBandSpace, int bAllTouched, GDALRasterizeShape &oShape,
     GDALDataType eBurnValueType, const double *padfBurnValues,
     const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
-    GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
-    void *pTransformArg)
+    GDALRasterMergeAlg eMergeAlg)
 
 {
-    if (poShape == nullptr || poShape->IsEmpty())
-        return;
-    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
-
-    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
-         eGeomType == wkbGeometryCollection) &&
-        eMergeAlg == GRMA_Replace)
-    {
-        // Speed optimization: in replace mode, we can rasterize each part of
-        // a geometry collection separately.
-        const auto poGC = poShape->toGeometryCollection();
-        for (const auto poPart : *poGC)
-        {
-            gv_rasterize_one_shape(
-                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
-                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
-                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
-                eMergeAlg, pfnTransformer, pTransformArg);
-        }
-        return;
-    }
+    const OGRwkbGeometryType eGeomType = oShape.eGeomType;
+    std::vector<double> &aPointX = oShape.aPointX;
+    std::vector<double> &aPointY = oShape.aPointY;
+    std::vector<double> &aPointVariant = oShape.aPointVariant;
+    const std::vector<int> &aPartSize = oShape.aPartSize;
 
     if (nPixelSpace == 0)
     {
@@ -617,32 +662,6 @@ static void gv_rasterize_one_shape(
     sInfo.bFillSetVisitedPoints = false;
     sInfo.poSetVisitedPoints = nullptr;
 
-    /* -------------------------------------------------------------------- */
-    /*      Transform polygon geometries into a set of rings and a part     */
-    /*      size list.                                                      */
-    /* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry(poShape, aPointX, aPointY, aPointVariant,
-                                 aPartSize, eBurnValueSrc);
-
-    /* -------------------------------------------------------------------- */
-    /*      Transform points if needed.                                     */
-    /* -------------------------------------------------------------------- */
-    if (pfnTransformer != nullptr)
-    {
-        int *panSuccess =
-            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
-
-        // TODO: We need to add all appropriate error checking at some point.
-        pfnTransformer(pTransformArg, FALSE, static_cast<int>(aPointX.size()),
-                       aPointX.data(), aPointY.data(), nullptr, panSuccess);
-        CPLFree(panSuccess);
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Shift to account for the buffer offset of this buffer.          */
     /* -------------------------------------------------------------------- */
@@ -744,6 +763,50 @@ static void gv_rasterize_one_shape(
     delete sInfo.poSetVisitedPoints;
 }
 
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void gv_rasterize_one_shape(
+    unsigned char *pabyChunkBuf, int nXOff, int nYOff, int nXSize, int nYSize,
+    int nBands, GDALDataType eType, int nPixelSpace, GSpacing nLineSpace,
+    GSpacing nBandSpace, int bAllTouched, const OGRGeometry *poShape,
+    GDALDataType eBurnValueType, const double *padfBurnValues,
+    const int64_t *panBurnValues, GDALBurnValueSrc eBurnValueSrc,
+    GDALRasterMergeAlg eMergeAlg, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg)
+
+{
+    if (poShape == nullptr || poShape->IsEmpty())
+        return;
+    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
+
+    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
+         eGeomType == wkbGeometryCollection) &&
+        eMergeAlg == GRMA_Replace)
+    {
+        // Speed optimization: in replace mode, we can rasterize each part of
+        // a geometry collection separately.
+        const auto poGC = poShape->toGeometryCollection();
+        for (const auto poPart : *poGC)
+        {
+            gv_rasterize_one_shape(
+                pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands, eType,
+                nPixelSpace, nLineSpace, nBandSpace, bAllTouched, poPart,
+                eBurnValueType, padfBurnValues, panBurnValues, eBurnValueSrc,
+                eMergeAlg, pfnTransformer, pTransformArg);
+        }
+        return;
+    }
+
+    GDALRasterizeShape oShape;
+    GDALRasterizeCollectShape(poShape, eBurnValueSrc, pfnTransformer,
+                              pTransformArg, oShape);
+    GDALRasterizeBurnShape(pabyChunkBuf, nXOff, nYOff, nXSize, nYSize, nBands,
+                           eType, nPixelSpace, nLineSpace, nBandSpace,
+                           bAllTouched, oShape, eBurnValueType, padfBurnValues,
+                           panBurnValues, eBurnValueSrc, eMergeAlg);
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -1443,6 +1506,274 @@ static CPLErr GDALRasterizeGeometriesInternal(
     return eErr;
 }
 
+/************************************************************************/
+/*                     GDALRasterizeBatchShape                          */
+/************************************************************************/
+
+namespace
+{
+
+// A shape of a batch of features, with the range of raster lines it may
+// touch.
+struct GDALRasterizeBatchShape
+{
+    GDALRasterizeShape oShape{};
+    size_t nBurnValuesOffset = 0;
+    int nYMin = 0;
+    int nYMax = 0;
+};
+
+struct GDALRasterizeStripJob
+{
+    const std::vector<GDALRasterizeBatchShape> *paoShapes = nullptr;
+    const double *padfBurnValues = nullptr;
+    std::vector<size_t> anShapeIdx{};
+    unsigned char *pabyBuf = nullptr;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    int nBands = 0;
+    GDALDataType eType = GDT_Unknown;
+    GSpacing nLineSpace = 0;
+    GSpacing nBandSpace = 0;
+    int bAllTouched = FALSE;
+    GDALBurnValueSrc eBurnValueSrc = GBV_UserBurnValue;
+    GDALRasterMergeAlg eMergeAlg = GRMA_Replace;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                     GDALRasterizeStripJobFunc()                      */
+/************************************************************************/
+
+static void GDALRasterizeStripJobFunc(void *pData)
+{
+    GDALRasterizeStripJob *psJob = static_cast<GDALRasterizeStripJob *>(pData);
+
+    // Burning shifts the coordinates, so work on a copy of each shape.
+    GDALRasterizeShape oShape;
+    for (const size_t iShape : psJob->anShapeIdx)
+    {
+        const GDALRasterizeBatchShape &oBatchShape =
+            (*psJob->paoShapes)[iShape];
+        oShape.eGeomType = oBatchShape.oShape.eGeomType;
+        oShape.aPointX = oBatchShape.oShape.aPointX;
+        oShape.aPointY = oBatchShape.oShape.aPointY;
+        oShape.aPointVariant = oBatchShape.oShape.aPointVariant;
+        oShape.aPartSize = oBatchShape.oShape.aPartSize;
+        GDALRasterizeBurnShape(
+            psJob->pabyBuf, 0, psJob->nYOff, psJob->nXSize, psJob->nYSize,
+            psJob->nBands, psJob->eType, 0, psJob->nLineSpace,
+            psJob->nBandSpace, psJob->bAllTouched, oShape, GDT_Float64,
+            psJob->padfBurnValues + oBatchShape.nBurnValuesOffset, nullptr,
+            psJob->eBurnValueSrc, psJob->eMergeAlg);
+    }
+}
+
+/************************************************************************/
+/*                    GDALRasterizeAddBatchShapes()                     */
+/*                                                                      */
+/*      Collect a geometry into shapes of the batch, splitting          */
+/*      collections as gv_rasterize_one_shape() does.  Returns the      */
+/*      approximate memory used by the new shapes.                      */
+/************************************************************************/
+
+static size_t GDALRasterizeAddBatchShapes(
+    const OGRGeometry *poShape, int nRasterYSize, size_t nBurnValuesOffset,
+    GDALBurnValueSrc eBurnValueSrc, GDALRasterMergeAlg eMergeAlg,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg,
+    std::vector<GDALRasterizeBatchShape> &aoShapes)
+{
+    if (poShape == nullptr || poShape->IsEmpty())
+        return 0;
+    const auto eGeomType = wkbFlatten(poShape->getGeometryType());
+
+    if ((eGeomType == wkbMultiLineString || eGeomType == wkbMultiPolygon ||
+         eGeomType == wkbGeometryCollection) &&
+        eMergeAlg == GRMA_Replace)
+    {
+        size_t nMem = 0;
+        for (const auto poPart : *(poShape->toGeometryCollection()))
+        {
+            nMem += GDALRasterizeAddBatchShapes(
+                poPart, nRasterYSize, nBurnValuesOffset, eBurnValueSrc,
+                eMergeAlg, pfnTransformer, pTransformArg, aoShapes);
+        }
+        return nMem;
+    }
+
+    GDALRasterizeBatchShape oBatchShape;
+    GDALRasterizeCollectShape(poShape, eBurnValueSrc, pfnTransformer,
+                              pTransformArg, oBatchShape.oShape);
+    const auto &aPointY = oBatchShape.oShape.aPointY;
+    if (aPointY.empty())
+        return 0;
+
+    // Allow one line of margin for the rounding done by the line and point
+    // rasterizers.
+    double dfYMin = aPointY[0];
+    double dfYMax = aPointY[0];
+    bool bAllFinite = true;
+    for (const double dfY : aPointY)
+    {
+        if (!std::isfinite(dfY))
+            bAllFinite = false;
+        dfYMin = std::min(dfYMin, dfY);
+        dfYMax = std::max(dfYMax, dfY);
+    }
+    if (bAllFinite)
+    {
+        if (dfYMax < -1 || dfYMin > nRasterYSize + 1)
+            return 0;
+        oBatchShape.nYMin =
+            static_cast<int>(std::max(0.0, std::floor(dfYMin) - 1));
+        oBatchShape.nYMax = static_cast<int>(
+            std::min(static_cast<double>(nRasterYSize - 1),
+                     std::floor(dfYMax) + 1));
+    }
+    else
+    {
+        oBatchShape.nYMin = 0;
+        oBatchShape.nYMax = nRasterYSize - 1;
+    }
+    oBatchShape.nBurnValuesOffset = nBurnValuesOffset;
+
+    const size_t nMem =
+        sizeof(GDALRasterizeBatchShape) +
+        oBatchShape.oShape.aPointX.capacity() * sizeof(double) +
+        aPointY.capacity() * sizeof(double) +
+        oBatchShape.oShape.aPointVariant.capacity() * sizeof(double) +
+        oBatchShape.oShape.aPartSize.capacity() * sizeof(int);
+    aoShapes.emplace_back(std::move(oBatchShape));
+    return nMem;
+}
+
+/************************************************************************/
+/*                       GDALRasterizeBatch()                           */
+/*                                                                      */
+/*      Burn a batch of shapes into the raster, chunk by chunk.  Each   */
+/*      chunk is split into one horizontal strip per thread, and each   */
+/*      strip burns the shapes that intersect it, in the order of the   */
+/*      features.  With ALL_TOUCHED, chunks are not split.              */
+/************************************************************************/
+
+static CPLErr GDALRasterizeBatch(
+    GDALDataset *poDS, int nBandCount, int *panBandList, GDALDataType eType,
+    unsigned char *pabyChunkBuf, int nYChunkSize, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSrc, GDALRasterMergeAlg eMergeAlg,
+    const std::vector<GDALRasterizeBatchShape> &aoShapes,
+    const std::vector<double> &adfBurnValues, CPLJobQueue *poJobQueue,
+    int nThreads, double dfProgressStart, double dfProgressEnd,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const GSpacing nLineSpace =
+        static_cast<GSpacing>(nXSize) * GDALGetDataTypeSizeBytes(eType);
+    std::vector<GDALRasterizeStripJob> asJobs;
+
+    for (int iY = 0; iY < nYSize; iY += nYChunkSize)
+    {
+        const int nThisYChunkSize = std::min(nYChunkSize, nYSize - iY);
+        // The edges burnt with ALL_TOUCHED depend on the offset of the
+        // window, so burn each chunk as a single strip in that case.
+        const int nStrips =
+            bAllTouched ? 1 : std::min(nThreads, nThisYChunkSize);
+        const int nStripYSize = (nThisYChunkSize + nStrips - 1) / nStrips;
+
+        // Bin the shapes into the strips of this chunk.
+        asJobs.clear();
+        asJobs.resize(nStrips);
+        bool bHasShapes = false;
+        for (size_t iShape = 0; iShape < aoShapes.size(); iShape++)
+        {
+            const auto &oBatchShape = aoShapes[iShape];
+            if (oBatchShape.nYMax < iY ||
+                oBatchShape.nYMin >= iY + nThisYChunkSize)
+                continue;
+            const int iFirstStrip =
+                (std::max(oBatchShape.nYMin, iY) - iY) / nStripYSize;
+            const int iLastStrip =
+                (std::min(oBatchShape.nYMax, iY + nThisYChunkSize - 1) - iY) /
+                nStripYSize;
+            for (int iStrip = iFirstStrip; iStrip <= iLastStrip; iStrip++)
+                asJobs[iStrip].anShapeIdx.push_back(iShape);
+            bHasShapes = true;
+        }
+        if (!bHasShapes)
+            continue;
+
+        // Only re-read image if not a single chunk is being rendered.
+        if (nYChunkSize < nYSize)
+        {
+            if (poDS->RasterIO(GF_Read, 0, iY, nXSize, nThisYChunkSize,
+                               pabyChunkBuf, nXSize, nThisYChunkSize, eType,
+                               nBandCount, panBandList, 0, 0, 0,
+                               nullptr) != CE_None)
+                return CE_Failure;
+        }
+
+        for (int iStrip = 0; iStrip < nStrips; iStrip++)
+        {
+            auto &sJob = asJobs[iStrip];
+            const int nStripYOff = iStrip * nStripYSize;
+            sJob.paoShapes = &aoShapes;
+            sJob.padfBurnValues = adfBurnValues.data();
+            sJob.pabyBuf = pabyChunkBuf + nStripYOff * nLineSpace;
+            sJob.nYOff = iY + nStripYOff;
+            sJob.nXSize = nXSize;
+            sJob.nYSize = std::max(
+                0, std::min(nStripYSize, nThisYChunkSize - nStripYOff));
+            sJob.nBands = nBandCount;
+            sJob.eType = eType;
+            sJob.nLineSpace = nLineSpace;
+            sJob.nBandSpace = nThisYChunkSize * nLineSpace;
+            sJob.bAllTouched = bAllTouched;
+            sJob.eBurnValueSrc = eBurnValueSrc;
+            sJob.eMergeAlg = eMergeAlg;
+        }
+
+        if (poJobQueue && nStrips > 1)
+        {
+            for (auto &sJob : asJobs)
+            {
+                if (sJob.nYSize > 0 && !sJob.anShapeIdx.empty())
+                    poJobQueue->SubmitJob(GDALRasterizeStripJobFunc, &sJob);
+            }
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (auto &sJob : asJobs)
+            {
+                if (sJob.nYSize > 0)
+                    GDALRasterizeStripJobFunc(&sJob);
+            }
+        }
+
+        // Only write image if not a single chunk is being rendered.
+        if (nYChunkSize < nYSize)
+        {
+            if (poDS->RasterIO(GF_Write, 0, iY, nXSize, nThisYChunkSize,
+                               pabyChunkBuf, nXSize, nThisYChunkSize, eType,
+                               nBandCount, panBandList, 0, 0, 0,
+                               nullptr) != CE_None)
+                return CE_Failure;
+        }
+
+        if (!pfnProgress(dfProgressStart +
+                             (dfProgressEnd - dfProgressStart) *
+                                 (iY + nThisYChunkSize) / nYSize,
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1498,6 +1829,13 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.10) Number of worker threads used to burn
+ * the geometries, or ALL_CPUS. Each chunk is split into horizontal strips
+ * burnt in parallel, except with ALL_TOUCHED=TRUE where chunks are burnt
+ * one at a time so that the result does not depend on the number of threads.
+ * Features are still read and transformed in the calling thread. Defaults
+ * to 1. The GDAL_NUM_THREADS configuration option is not taken into
+ * account.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1601,9 +1939,33 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
     CPLErr eErr = CE_None;
     const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
 
+    // Do not default to GDAL_NUM_THREADS: callers must opt in.
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads)));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>();
+
+    // Features are read and transformed once per batch, and each batch is
+    // burnt over all the chunks.
+    const size_t nMaxBatchMem = static_cast<size_t>(std::min<GIntBig>(
+        std::numeric_limits<size_t>::max() / 2,
+        CPLAtoGIntBig(CPLGetConfigOption(
+            "GDAL_RASTERIZE_MAX_MEMORY",
+            CPLSPrintf(CPL_FRMT_GIB,
+                       std::max<GIntBig>(100 * 1024 * 1024,
+                                         GDALGetCacheMax64() / 2))))));
+    std::vector<GDALRasterizeBatchShape> aoBatchShapes;
+    std::vector<double> adfBatchBurnValues;
+
     pfnProgress(0.0, nullptr, pProgressArg);
 
-    for (int iLayer = 0; iLayer < nLayerCount; iLayer++)
+    for (int iLayer = 0; iLayer < nLayerCount && eErr == CE_None; iLayer++)
     {
         OGRLayer *poLayer = reinterpret_cast<OGRLayer *>(pahLayers[iLayer]);
 
@@ -1701,75 +2063,99 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
 
         /* --------------------------------------------------------------------
          */
-        /*      Loop over image in designated chunks. */
+        /*      Read the features by batches, and burn each batch over */
+        /*      the image in designated chunks. */
         /* --------------------------------------------------------------------
          */
-
-        double *padfAttrValues = static_cast<double *>(
-            VSI_MALLOC_VERBOSE(sizeof(double) * nBandCount));
-        if (padfAttrValues == nullptr)
-            eErr = CE_Failure;
-
-        for (int iY = 0; iY < poDS->GetRasterYSize() && eErr == CE_None;
-             iY += nYChunkSize)
+        const GIntBig nFeatureCount = poLayer->GetFeatureCount(FALSE);
+        const double dfLayerProgressStart =
+            static_cast<double>(iLayer) / nLayerCount;
+        const double dfLayerProgressRatio = 1.0 / nLayerCount;
+        GIntBig nFeaturesRead = 0;
+        bool bLayerDone = false;
+
+        while (eErr == CE_None && !bLayerDone)
         {
-            int nThisYChunkSize = nYChunkSize;
-            if (nThisYChunkSize + iY > poDS->GetRasterYSize())
-                nThisYChunkSize = poDS->GetRasterYSize() - iY;
-
-            // Only re-read image if not a single chunk is being rendered.
-            if (nYChunkSize < poDS->GetRasterYSize())
-            {
-                eErr = poDS->RasterIO(
-                    GF_Read, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
-                    pabyChunkBuf, poDS->GetRasterXSize(), nThisYChunkSize,
-                    eType, nBandCount, panBandList, 0, 0, 0, nullptr);
-                if (eErr != CE_None)
-                    break;
-            }
-
-            for (auto &poFeat : poLayer)
+            const double dfBatchProgressStart =
+                nFeatureCount > 0
+                    ? std::min(1.0, static_cast<double>(nFeaturesRead) /
+                                        nFeatureCount)
+                    : 0.0;
+
+            aoBatchShapes.clear();
+            adfBatchBurnValues.clear();
+            size_t nBatchMem = 0;
+            try
             {
-                OGRGeometry *poGeom = poFeat->GetGeometryRef();
-
-                if (pszBurnAttribute)
+                while (nBatchMem < nMaxBatchMem)
                 {
-                    const double dfAttrValue =
-                        poFeat->GetFieldAsDouble(iBurnField);
-                    for (int iBand = 0; iBand < nBandCount; iBand++)
-                        padfAttrValues[iBand] = dfAttrValue;
+                    auto poFeat =
+                        std::unique_ptr<OGRFeature>(poLayer->GetNextFeature());
+                    if (!poFeat)
+                    {
+                        bLayerDone = true;
+                        break;
+                    }
+                    nFeaturesRead++;
 
-                    padfBurnValues = padfAttrValues;
-                }
+                    const OGRGeometry *poGeom = poFeat->GetGeometryRef();
+                    if (poGeom == nullptr || poGeom->IsEmpty())
+                        continue;
 
-                gv_rasterize_one_shape(
-                    pabyChunkBuf, 0, iY, poDS->GetRasterXSize(),
-                    nThisYChunkSize, nBandCount, eType, 0, 0, 0, bAllTouched,
-                    poGeom, GDT_Float64, padfBurnValues, nullptr,
-                    eBurnValueSource, eMergeAlg, pfnTransformer, pTransformArg);
+                    const size_t nBurnValuesOffset = adfBatchBurnValues.size();
+                    if (pszBurnAttribute)
+                    {
+                        adfBatchBurnValues.resize(
+                            nBurnValuesOffset + nBandCount,
+                            poFeat->GetFieldAsDouble(iBurnField));
+                    }
+                    else
+                    {
+                        adfBatchBurnValues.insert(adfBatchBurnValues.end(),
+                                                  padfBurnValues,
+                                                  padfBurnValues + nBandCount);
+                    }
+                    nBatchMem += GDALRasterizeAddBatchShapes(
+                        poGeom, poDS->GetRasterYSize(), nBurnValuesOffset,
+                        eBurnValueSource, eMergeAlg, pfnTransformer,
+                        pTransformArg, aoBatchShapes);
+                }
             }
-
-            // Only write image if not a single chunk is being rendered.
-            if (nYChunkSize < poDS->GetRasterYSize())
+            catch (const std::bad_alloc &)
             {
-                eErr = poDS->RasterIO(
-                    GF_Write, 0, iY, poDS->GetRasterXSize(), nThisYChunkSize,
-                    pabyChunkBuf, poDS->GetRasterXSize(), nThisYChunkSize,
-                    eType, nBandCount, panBandList, 0, 0, 0, nullptr);
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory while reading features of layer %s",
+                         poLayer->GetLayerDefn()->GetName());
+                eErr = CE_Failure;
+                break;
             }
 
-            poLayer->ResetReading();
+            const double dfBatchProgressEnd =
+                nFeatureCount > 0 && !bLayerDone
+                    ? std::min(1.0, static_cast<double>(nFeaturesRead) /
+                                        nFeatureCount)
+                    : 1.0;
+            if (aoBatchShapes.empty())
+                continue;
 
-            if (!pfnProgress((iY + nThisYChunkSize) /
-                                 static_cast<double>(poDS->GetRasterYSize()),
-                             "", pProgressArg))
-            {
-                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                eErr = CE_Failure;
-            }
+            eErr = GDALRasterizeBatch(
+                poDS, nBandCount, panBandList, eType, pabyChunkBuf,
+                nYChunkSize, bAllTouched, eBurnValueSource, eMergeAlg,
+                aoBatchShapes, adfBatchBurnValues, poJobQueue.get(), nThreads,
+                dfLayerProgressStart +
+                    dfLayerProgressRatio * dfBatchProgressStart,
+                dfLayerProgressStart +
+                    dfLayerProgressRatio * dfBatchProgressEnd,
+                pfnProgress, pProgressArg);
         }
 
-        VSIFree(padfAttrValues);
+        if (eErr == CE_None &&
+            !pfnProgress(dfLayerProgressStart + dfLayerProgressRatio, "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
 
         if (bNeedToFreeTransformer)
         {
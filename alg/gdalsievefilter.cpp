@@ -33,112 +33,879 @@
 #include <cstring>
 
 #include <algorithm>
-#include <set>
-#include <vector>
+#include <functional>
+#include <map>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 
 #define MY_MAX_INT 2147483647
 
 /*
  * General Plan
  *
- * 1) make a pass with the polygon enumerator to build up the
- *    polygon map array.  Also accumulate polygon size information.
+ * The raster is split into horizontal strips, which are processed
+ * independently (and in parallel when several threads are used) by
+ * batches of one strip per thread. Polygons touching the first or last
+ * line of a strip are "border" polygons, and are the only ones for which
+ * information is kept between passes.
  *
- * 2) Identify the polygons that need to be merged.
+ * 1) make a pass over the strips with the polygon enumerator to compute
+ *    the size of each polygon of the strip, and record the border polygons
+ *    with their size. As soon as a batch of strips is done, merge its
+ *    border polygons with the connected ones of the strips above, so that
+ *    only the border polygon ids of the last line of the batch are kept.
  *
- * 3) Make a pass with the polygon enumerator.  For each "to be merged"
- *    polygon keep track of its largest neighbour.
+ * 2) Accumulate the sizes of the merged border polygons.
  *
- * 4) Fix up remappings that would go to polygons smaller than the seive
- *    size.  Ensure these in term map to the largest neighbour of the
- *    "to be sieved" polygons.
+ * 3) Make a second pass over the strips. For each polygon smaller than the
+ *    sieve size, keep track of its largest neighbour, as the first
+ *    neighbour, in raster order, of the largest size. The largest
+ *    neighbours of the polygons inside a strip are followed in the strip
+ *    until a polygon larger than the sieve size or a border polygon is
+ *    found. The largest neighbours of border polygons are collected over
+ *    all strips.
  *
- * 5) Make another pass with the polygon enumerator. This time we remap
- *    the actual pixel values of all polygons to be merged.
+ * 4) Follow the largest neighbours of the small border polygons until a
+ *    polygon larger than the sieve size is found.
+ *
+ * 5) Make a third pass over the strips, redoing 3) for the polygons
+ *    inside the strip, and remap the actual pixel values of all polygons
+ *    to be merged.
  */
 
+namespace
+{
+
 /************************************************************************/
-/*                          GPMaskImageData()                           */
-/*                                                                      */
-/*      Mask out image pixels to a special nodata value if the mask     */
-/*      band is zero.                                                   */
+/*                         GDALSieveNeighbour                           */
 /************************************************************************/
 
-static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
-                              int iY, int nXSize, std::int64_t *panImageLine)
+// Largest neighbour of a polygon seen so far.
+struct GDALSieveNeighbour
+{
+    // Size of the neighbour, or -1 if there is no neighbour.
+    int nSize = -1;
+    // Position in raster order of the first contact with the neighbour.
+    GIntBig nKey = 0;
+    // Polygon id in the strip (>= 0) or -(border polygon id + 1).
+    int nNode = 0;
+};
 
+/************************************************************************/
+/*                           GDALSieveTarget                            */
+/************************************************************************/
+
+constexpr int SIEVE_TARGET_NONE = 0;
+constexpr int SIEVE_TARGET_VALUE = 1;
+constexpr int SIEVE_TARGET_BORDER = 2;
+
+// What a small polygon gets merged into: nothing, a known pixel value, or
+// the same thing as a small border polygon.
+struct GDALSieveTarget
 {
-    const CPLErr eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1,
-                                     pabyMaskLine, nXSize, 1, GDT_Byte, 0, 0);
-    if (eErr == CE_None)
+    int nKind = SIEVE_TARGET_NONE;
+    int nBorderId = -1;
+    std::int64_t nValue = 0;
+};
+
+/************************************************************************/
+/*                        GDALSieveBorderInfo                           */
+/************************************************************************/
+
+// Largest neighbour of a border polygon, reduced over all strips.
+struct GDALSieveBorderCandidate
+{
+    int nSize = -1;
+    GIntBig nKey = 0;
+    GDALSieveTarget sTarget{};
+};
+
+/************************************************************************/
+/*                            GDALSieveStrip                            */
+/************************************************************************/
+
+struct GDALSieveStrip
+{
+    int nYOff = 0;
+    int nYSize = 0;
+    // Id of the first border polygon of the strip.
+    int nBorderOffset = 0;
+    int nBorderCount = 0;
+};
+
+/************************************************************************/
+/*                          GDALSieveContext                            */
+/************************************************************************/
+
+struct GDALSieveContext
+{
+    int nXSize = 0;
+    int nConnectedness = 0;
+    int nSizeThreshold = 0;
+    int nStrips = 0;
+    std::vector<GDALSieveStrip> asStrips{};
+
+    // Indexed by border polygon id. anBorderRoot is the union-find parent
+    // of border polygons during the first pass, and then the id of the
+    // merged border polygon.
+    std::vector<std::int64_t> anBorderValue{};
+    std::vector<GIntBig> anBorderSize{};
+    std::vector<int> anBorderRoot{};
+
+    // Indexed by final border polygon id, once border polygons are merged.
+    std::vector<GDALSieveBorderCandidate> asBorderCandidate{};
+    std::vector<GDALSieveTarget> asBorderTarget{};
+
+    int GetBorderSize(int iBorder) const
     {
-        for (int i = 0; i < nXSize; i++)
+        return static_cast<int>(std::min(
+            anBorderSize[iBorder], static_cast<GIntBig>(MY_MAX_INT)));
+    }
+};
+
+/************************************************************************/
+/*                            GDALSieveJob                              */
+/************************************************************************/
+
+struct GDALSieveJob
+{
+    const GDALSieveContext *psCtxt = nullptr;
+    int iStrip = 0;
+    int nPass = 1;
+    // Pixel values, with masked pixels set to GP_NODATA_MARKER.
+    std::int64_t *panVal = nullptr;
+    // Pixel values to write (third pass only). May be panVal.
+    std::int64_t *panWriteVal = nullptr;
+    GInt32 *panId = nullptr;
+    bool bOK = true;
+
+    // Border polygon ids of the first line (first pass only), and of the
+    // last line of the strip, relative to the strip during the first pass,
+    // merged border polygon ids during the other passes.
+    std::vector<int> anTopBorder{};
+    std::vector<int> anBottomBorder{};
+
+    // First pass outputs.
+    GDALSieveStrip *psStrip = nullptr;
+    std::vector<std::int64_t> anBorderValue{};
+    std::vector<GIntBig> anBorderSize{};
+    GIntBig nPolygons = 0;
+
+    // Labelling of the strip, kept between the two steps of the second
+    // and third passes.
+    std::unique_ptr<GDALRasterPolygonEnumerator> poEnum{};
+    std::vector<GIntBig> anLocalSize{};
+    std::vector<int> anBorderIdx{};
+
+    // Merged border polygon ids of the last line of the previous strip.
+    const int *panAboveBorder = nullptr;
+
+    // Second pass output: largest neighbours of border polygons.
+    std::vector<std::pair<int, GDALSieveBorderCandidate>> aoBorderCandidates{};
+
+    // Third pass outputs.
+    int nSieveTargets = 0;
+    int nIsolatedSmall = 0;
+    int nFailedMerges = 0;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                         GDALSieveLabelStrip()                        */
+/*                                                                      */
+/*      Assign final polygon ids to the pixels of a strip, and          */
+/*      compute the size of the polygons and the numbering of its       */
+/*      border polygons. This is deterministic, so that all passes      */
+/*      see the same ids.                                               */
+/************************************************************************/
+
+static bool GDALSieveLabelStrip(GDALSieveJob *psJob,
+                                GDALRasterPolygonEnumerator &oEnum,
+                                std::vector<GIntBig> &anSize,
+                                std::vector<int> &anBorderIdx,
+                                int &nBorderCount)
+{
+    const GDALSieveContext *psCtxt = psJob->psCtxt;
+    const GDALSieveStrip &oStrip = psCtxt->asStrips[psJob->iStrip];
+    const int nXSize = psCtxt->nXSize;
+    const size_t nLineSize = static_cast<size_t>(nXSize);
+
+    for (int iY = 0; iY < oStrip.nYSize; iY++)
+    {
+        std::int64_t *panThisLineVal = psJob->panVal + iY * nLineSize;
+        GInt32 *panThisLineId = psJob->panId + iY * nLineSize;
+        if (!(iY == 0 ? oEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
+                                          panThisLineId, nXSize)
+                      : oEnum.ProcessLine(panThisLineVal - nLineSize,
+                                          panThisLineVal,
+                                          panThisLineId - nLineSize,
+                                          panThisLineId, nXSize)))
         {
-            if (pabyMaskLine[i] == 0)
-                panImageLine[i] = GP_NODATA_MARKER;
+            return false;
         }
     }
 
-    return eErr;
+    oEnum.CompleteMerges();
+
+    try
+    {
+        anSize.assign(oEnum.nNextPolygonId, 0);
+        anBorderIdx.assign(oEnum.nNextPolygonId, -1);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    const size_t nPixels = oStrip.nYSize * nLineSize;
+    for (size_t i = 0; i < nPixels; i++)
+    {
+        GInt32 &nId = psJob->panId[i];
+        if (nId >= 0)
+        {
+            nId = oEnum.panPolyIdMap[nId];
+            anSize[nId]++;
+        }
+    }
+
+    // Number the polygons of the first line, and then of the last line.
+    nBorderCount = 0;
+    const auto NumberBorderLine = [&](const GInt32 *panLineId)
+    {
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const int nId = panLineId[iX];
+            if (nId >= 0 && anBorderIdx[nId] < 0)
+                anBorderIdx[nId] = nBorderCount++;
+        }
+    };
+    if (psJob->iStrip > 0)
+        NumberBorderLine(psJob->panId);
+    if (psJob->iStrip < psCtxt->nStrips - 1)
+        NumberBorderLine(psJob->panId + (oStrip.nYSize - 1) * nLineSize);
+
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALSieveFirstPassJob()                       */
+/************************************************************************/
+
+static void GDALSieveFirstPassJob(void *pData)
+{
+    GDALSieveJob *psJob = static_cast<GDALSieveJob *>(pData);
+    const GDALSieveContext *psCtxt = psJob->psCtxt;
+    GDALSieveStrip *psStrip = psJob->psStrip;
+    const int nXSize = psCtxt->nXSize;
+
+    GDALRasterPolygonEnumerator oEnum(psCtxt->nConnectedness);
+    std::vector<GIntBig> anSize;
+    std::vector<int> anBorderIdx;
+    int nBorderCount = 0;
+    if (!GDALSieveLabelStrip(psJob, oEnum, anSize, anBorderIdx, nBorderCount))
+    {
+        psJob->bOK = false;
+        return;
+    }
+
+    psJob->nPolygons = 0;
+    for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+    {
+        if (oEnum.panPolyIdMap[iPoly] == iPoly)
+            psJob->nPolygons++;
+    }
+
+    try
+    {
+        psJob->anBorderValue.resize(nBorderCount);
+        psJob->anBorderSize.resize(nBorderCount);
+        for (int iPoly = 0; iPoly < oEnum.nNextPolygonId; iPoly++)
+        {
+            const int iBorder = anBorderIdx[iPoly];
+            if (iBorder >= 0)
+            {
+                psJob->anBorderValue[iBorder] = oEnum.panPolyValue[iPoly];
+                psJob->anBorderSize[iBorder] = anSize[iPoly];
+            }
+        }
+
+        const auto GetBorderLine = [&](const GInt32 *panLineId,
+                                       std::vector<int> &anLine)
+        {
+            anLine.resize(nXSize);
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                const int nId = panLineId[iX];
+                anLine[iX] = nId >= 0 ? anBorderIdx[nId] : -1;
+            }
+        };
+        if (psJob->iStrip > 0)
+            GetBorderLine(psJob->panId, psJob->anTopBorder);
+        if (psJob->iStrip < psCtxt->nStrips - 1)
+            GetBorderLine(psJob->panId +
+                              static_cast<size_t>(psStrip->nYSize - 1) * nXSize,
+                          psJob->anBottomBorder);
+    }
+    catch (const std::exception &)
+    {
+        psJob->bOK = false;
+        return;
+    }
+    psStrip->nBorderCount = nBorderCount;
 }
 
-// TODO: What is "eaches" supposed to be?
+/************************************************************************/
+/*                        UpdateSieveNeighbour()                        */
+/************************************************************************/
+
+static inline void UpdateSieveNeighbour(GDALSieveNeighbour &sNeighbour,
+                                        int nSize, GIntBig nKey, int nNode)
+{
+    if (nSize > sNeighbour.nSize ||
+        (nSize == sNeighbour.nSize && nKey < sNeighbour.nKey))
+    {
+        sNeighbour.nSize = nSize;
+        sNeighbour.nKey = nKey;
+        sNeighbour.nNode = nNode;
+    }
+}
 
 /************************************************************************/
-/*                          CompareNeighbour()                          */
-/*                                                                      */
-/*      Compare two neighbouring polygons, and update eaches            */
-/*      "biggest neighbour" if the other is larger than its current     */
-/*      largest neighbour.                                              */
+/*                       GDALSieveLabelPassJob()                        */
 /*                                                                      */
-/*      Note that this should end up with each polygon knowing the      */
-/*      id of its largest neighbour.  No attempt is made to             */
-/*      restrict things to small polygons that we will be merging,      */
-/*      nor to exclude assigning "biggest neighbours" that are still    */
-/*      smaller than our sieve threshold.                               */
+/*      First step of the second and third passes over a strip:         */
+/*      label it, and compute the merged border polygon ids of its      */
+/*      last line, which the next strip needs.                          */
 /************************************************************************/
 
-static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
-                                    int *panPolyIdMap,
-                                    std::int64_t * /* panPolyValue */,
-                                    const std::vector<int> &anPolySizes,
-                                    std::vector<int> &anBigNeighbour)
+static void GDALSieveLabelPassJob(void *pData)
+{
+    GDALSieveJob *psJob = static_cast<GDALSieveJob *>(pData);
+    const GDALSieveContext *psCtxt = psJob->psCtxt;
+    const GDALSieveStrip &oStrip = psCtxt->asStrips[psJob->iStrip];
+    const int nXSize = psCtxt->nXSize;
+
+    int nBorderCount = 0;
+    try
+    {
+        psJob->poEnum = std::make_unique<GDALRasterPolygonEnumerator>(
+            psCtxt->nConnectedness);
+        if (psJob->iStrip < psCtxt->nStrips - 1)
+            psJob->anBottomBorder.resize(nXSize);
+    }
+    catch (const std::exception &)
+    {
+        psJob->bOK = false;
+        return;
+    }
+    if (!GDALSieveLabelStrip(psJob, *(psJob->poEnum), psJob->anLocalSize,
+                             psJob->anBorderIdx, nBorderCount))
+    {
+        psJob->bOK = false;
+        return;
+    }
 
+    if (psJob->iStrip < psCtxt->nStrips - 1)
+    {
+        const GInt32 *panLineId =
+            psJob->panId + static_cast<size_t>(oStrip.nYSize - 1) * nXSize;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const int nId = panLineId[iX];
+            psJob->anBottomBorder[iX] =
+                nId >= 0 ? psCtxt->anBorderRoot[oStrip.nBorderOffset +
+                                                psJob->anBorderIdx[nId]]
+                         : -1;
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALSieveNeighboursPassJob()                     */
+/*                                                                      */
+/*      Second step of the second and third passes over a strip.        */
+/************************************************************************/
+
+static void GDALSieveNeighboursPassJob(void *pData)
 {
-    // Nodata polygon do not need neighbours, and cannot be neighbours
-    // to valid polygons.
-    if (nPolyId1 < 0 || nPolyId2 < 0)
+    GDALSieveJob *psJob = static_cast<GDALSieveJob *>(pData);
+    const GDALSieveContext *psCtxt = psJob->psCtxt;
+    const GDALSieveStrip &oStrip = psCtxt->asStrips[psJob->iStrip];
+    const int nXSize = psCtxt->nXSize;
+    const size_t nLineSize = static_cast<size_t>(nXSize);
+    const int nSizeThreshold = psCtxt->nSizeThreshold;
+    const bool bEightConnected = psCtxt->nConnectedness == 8;
+    const bool bCollectBorder = psJob->nPass == 2;
+
+    const GDALRasterPolygonEnumerator &oEnum = *(psJob->poEnum);
+    const std::vector<GIntBig> &anLocalSize = psJob->anLocalSize;
+    const std::vector<int> &anBorderIdx = psJob->anBorderIdx;
+    const int nPolys = oEnum.nNextPolygonId;
+
+    /* -------------------------------------------------------------------- */
+    /*      Identify each polygon of the strip: border polygons are         */
+    /*      identified by their final border id, so that fragments of a     */
+    /*      border polygon in the strip are not neighbours of each other.   */
+    /* -------------------------------------------------------------------- */
+    std::vector<int> anNode;
+    std::vector<int> anSize;
+    std::vector<GDALSieveNeighbour> asNeighbour;
+    std::map<int, GDALSieveNeighbour> oMapAboveNeighbour;
+    try
+    {
+        anNode.resize(nPolys);
+        anSize.resize(nPolys);
+        asNeighbour.resize(nPolys);
+    }
+    catch (const std::exception &)
+    {
+        psJob->bOK = false;
+        return;
+    }
+    for (int iPoly = 0; iPoly < nPolys; iPoly++)
+    {
+        if (anBorderIdx[iPoly] >= 0)
+        {
+            const int iBorder =
+                psCtxt->anBorderRoot[oStrip.nBorderOffset + anBorderIdx[iPoly]];
+            anNode[iPoly] = -(iBorder + 1);
+            anSize[iPoly] = psCtxt->GetBorderSize(iBorder);
+        }
+        else
+        {
+            anNode[iPoly] = iPoly;
+            anSize[iPoly] = static_cast<int>(std::min(
+                anLocalSize[iPoly], static_cast<GIntBig>(MY_MAX_INT)));
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Check our neighbours, and update the largest neighbour of       */
+    /*      small polygons.  The neighbours of a pixel are compared in      */
+    /*      the same order for all pixels, so that nKey orders the          */
+    /*      contacts in raster order.                                       */
+    /* -------------------------------------------------------------------- */
+    const auto CompareNeighbour =
+        [&](int iThisPoly, int iOtherPoly, int iOtherBorder, GIntBig nKey)
+    {
+        const int nThisNode = anNode[iThisPoly];
+        const int nThisSize = anSize[iThisPoly];
+        const int nOtherNode =
+            iOtherPoly >= 0 ? anNode[iOtherPoly] : -(iOtherBorder + 1);
+        if (nThisNode == nOtherNode)
+            return;
+        const int nOtherSize = iOtherPoly >= 0
+                                   ? anSize[iOtherPoly]
+                                   : psCtxt->GetBorderSize(iOtherBorder);
+
+        if (nThisSize < nSizeThreshold && (bCollectBorder || nThisNode >= 0))
+        {
+            UpdateSieveNeighbour(asNeighbour[iThisPoly], nOtherSize, nKey,
+                                 nOtherNode);
+        }
+        if (nOtherSize < nSizeThreshold)
+        {
+            if (iOtherPoly >= 0)
+            {
+                if (bCollectBorder || nOtherNode >= 0)
+                    UpdateSieveNeighbour(asNeighbour[iOtherPoly], nThisSize,
+                                         nKey, nThisNode);
+            }
+            else if (bCollectBorder)
+            {
+                UpdateSieveNeighbour(oMapAboveNeighbour[iOtherBorder],
+                                     nThisSize, nKey, nThisNode);
+            }
+        }
+    };
+
+    // Final border ids of the last line of the previous strip.
+    const int *panAboveBorder = psJob->panAboveBorder;
+
+    for (int iY = 0; iY < oStrip.nYSize; iY++)
+    {
+        const GInt32 *panThisLineId = psJob->panId + iY * nLineSize;
+        const GInt32 *panLastLineId =
+            iY > 0 ? panThisLineId - nLineSize : nullptr;
+        const GIntBig nLineKey =
+            static_cast<GIntBig>(oStrip.nYOff + iY) * nXSize * 4;
+
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            const int iThisPoly = panThisLineId[iX];
+            if (iThisPoly < 0)
+                continue;
+            const GIntBig nKey = nLineKey + static_cast<GIntBig>(iX) * 4;
+
+            if (panLastLineId)
+            {
+                if (panLastLineId[iX] >= 0)
+                    CompareNeighbour(iThisPoly, panLastLineId[iX], -1, nKey);
+                if (bEightConnected && iX > 0 && panLastLineId[iX - 1] >= 0)
+                    CompareNeighbour(iThisPoly, panLastLineId[iX - 1], -1,
+                                     nKey + 1);
+                if (bEightConnected && iX < nXSize - 1 &&
+                    panLastLineId[iX + 1] >= 0)
+                    CompareNeighbour(iThisPoly, panLastLineId[iX + 1], -1,
+                                     nKey + 2);
+            }
+            else if (panAboveBorder)
+            {
+                if (panAboveBorder[iX] >= 0)
+                    CompareNeighbour(iThisPoly, -1, panAboveBorder[iX], nKey);
+                if (bEightConnected && iX > 0 && panAboveBorder[iX - 1] >= 0)
+                    CompareNeighbour(iThisPoly, -1, panAboveBorder[iX - 1],
+                                     nKey + 1);
+                if (bEightConnected && iX < nXSize - 1 &&
+                    panAboveBorder[iX + 1] >= 0)
+                    CompareNeighbour(iThisPoly, -1, panAboveBorder[iX + 1],
+                                     nKey + 2);
+            }
+
+            if (iX > 0 && panThisLineId[iX - 1] >= 0)
+                CompareNeighbour(iThisPoly, panThisLineId[iX - 1], -1,
+                                 nKey + 3);
+
+            // We don't need to compare to next pixel or next line
+            // since they will be compared to us.
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Follow the largest neighbours of the small polygons inside      */
+    /*      the strip, until a polygon larger than the threshold, or a      */
+    /*      border polygon is found.                                        */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALSieveTarget> asTarget;
+    std::vector<GByte> abyState;  // 0: not visited, 1: in chain, 2: done
+    std::vector<int> anChain;
+    try
+    {
+        asTarget.resize(nPolys);
+        abyState.resize(nPolys);
+    }
+    catch (const std::exception &)
+    {
+        psJob->bOK = false;
         return;
+    }
+
+    const auto GetTarget = [&](int iPoly)
+    {
+        GDALSieveTarget sTarget;
+        int iCur = iPoly;
+        while (true)
+        {
+            if (abyState[iCur] == 2)
+            {
+                sTarget = asTarget[iCur];
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (abyState[iCur] == 1)
+                break;
+            abyState[iCur] = 1;
+            anChain.push_back(iCur);
+
+            const GDALSieveNeighbour &sNeighbour = asNeighbour[iCur];
+            if (sNeighbour.nSize < 0)
+                break;
+            if (sNeighbour.nSize >= nSizeThreshold)
+            {
+                sTarget.nKind = SIEVE_TARGET_VALUE;
+                sTarget.nValue =
+                    sNeighbour.nNode >= 0
+                        ? oEnum.panPolyValue[sNeighbour.nNode]
+                        : psCtxt->anBorderValue[-sNeighbour.nNode - 1];
+                break;
+            }
+            if (sNeighbour.nNode < 0)
+            {
+                sTarget.nKind = SIEVE_TARGET_BORDER;
+                sTarget.nBorderId = -sNeighbour.nNode - 1;
+                break;
+            }
+            iCur = sNeighbour.nNode;
+        }
+
+        // Map the whole chain to the result.
+        for (const int iChainPoly : anChain)
+        {
+            abyState[iChainPoly] = 2;
+            asTarget[iChainPoly] = sTarget;
+        }
+        anChain.clear();
+        return sTarget;
+    };
 
-    // Make sure we are working with the final merged polygon ids.
-    nPolyId1 = panPolyIdMap[nPolyId1];
-    nPolyId2 = panPolyIdMap[nPolyId2];
+    /* -------------------------------------------------------------------- */
+    /*      Second pass: collect the largest neighbours of border           */
+    /*      polygons.                                                       */
+    /* -------------------------------------------------------------------- */
+    if (bCollectBorder)
+    {
+        const auto AddBorderCandidate =
+            [&](int iBorder, const GDALSieveNeighbour &sNeighbour)
+        {
+            GDALSieveBorderCandidate sCandidate;
+            sCandidate.nSize = sNeighbour.nSize;
+            sCandidate.nKey = sNeighbour.nKey;
+            if (sNeighbour.nNode < 0)
+            {
+                sCandidate.sTarget.nKind = SIEVE_TARGET_BORDER;
+                sCandidate.sTarget.nBorderId = -sNeighbour.nNode - 1;
+            }
+            else if (sNeighbour.nSize >= nSizeThreshold)
+            {
+                sCandidate.sTarget.nKind = SIEVE_TARGET_VALUE;
+                sCandidate.sTarget.nValue =
+                    oEnum.panPolyValue[sNeighbour.nNode];
+            }
+            else
+            {
+                sCandidate.sTarget = GetTarget(sNeighbour.nNode);
+            }
+            psJob->aoBorderCandidates.emplace_back(iBorder, sCandidate);
+        };
 
-    if (nPolyId1 == nPolyId2)
+        try
+        {
+            for (int iPoly = 0; iPoly < nPolys; iPoly++)
+            {
+                if (anNode[iPoly] < 0 && oEnum.panPolyIdMap[iPoly] == iPoly &&
+                    asNeighbour[iPoly].nSize >= 0)
+                {
+                    AddBorderCandidate(-anNode[iPoly] - 1, asNeighbour[iPoly]);
+                }
+            }
+            for (const auto &oIter : oMapAboveNeighbour)
+                AddBorderCandidate(oIter.first, oIter.second);
+        }
+        catch (const std::exception &)
+        {
+            psJob->bOK = false;
+        }
         return;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Third pass: remap the pixel values of the polygons to be        */
+    /*      merged.                                                         */
+    /* -------------------------------------------------------------------- */
+    for (int iPoly = 0; iPoly < nPolys; iPoly++)
+    {
+        if (oEnum.panPolyIdMap[iPoly] != iPoly || anNode[iPoly] < 0 ||
+            anSize[iPoly] >= nSizeThreshold)
+            continue;
+        GDALSieveTarget sTarget = GetTarget(iPoly);
+        if (sTarget.nKind == SIEVE_TARGET_BORDER)
+            sTarget = psCtxt->asBorderTarget[sTarget.nBorderId];
+        asTarget[iPoly] = sTarget;
+
+        psJob->nSieveTargets++;
+        if (asNeighbour[iPoly].nSize < 0)
+            psJob->nIsolatedSmall++;
+        else if (sTarget.nKind == SIEVE_TARGET_NONE)
+            psJob->nFailedMerges++;
+    }
+
+    const size_t nPixels = oStrip.nYSize * nLineSize;
+    for (size_t i = 0; i < nPixels; i++)
+    {
+        const int iPoly = psJob->panId[i];
+        if (iPoly < 0 || anSize[iPoly] >= nSizeThreshold)
+            continue;
+        const GDALSieveTarget &sTarget =
+            anNode[iPoly] >= 0 ? asTarget[iPoly]
+                               : psCtxt->asBorderTarget[-anNode[iPoly] - 1];
+        if (sTarget.nKind == SIEVE_TARGET_VALUE)
+            psJob->panWriteVal[i] = sTarget.nValue;
+    }
+}
 
-    // Nodata polygon do not need neighbours, and cannot be neighbours
-    // to valid polygons.
-    // Should no longer happen with r28826 optimization.
-    // if( panPolyValue[nPolyId1] == GP_NODATA_MARKER
-    //    || panPolyValue[nPolyId2] == GP_NODATA_MARKER )
-    //    return;
+/************************************************************************/
+/*                       GDALSieveRunJobs()                             */
+/************************************************************************/
 
-    if (anBigNeighbour[nPolyId1] == -1 ||
-        anPolySizes[anBigNeighbour[nPolyId1]] < anPolySizes[nPolyId2])
-        anBigNeighbour[nPolyId1] = nPolyId2;
+static void GDALSieveRunJobs(CPLJobQueue *poJobQueue, CPLThreadFunc pfnFunc,
+                             std::vector<GDALSieveJob> &asJobs)
+{
+    if (poJobQueue && asJobs.size() > 1)
+    {
+        for (auto &sJob : asJobs)
+            poJobQueue->SubmitJob(pfnFunc, &sJob);
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            pfnFunc(&sJob);
+    }
+}
 
-    if (anBigNeighbour[nPolyId2] == -1 ||
-        anPolySizes[anBigNeighbour[nPolyId2]] < anPolySizes[nPolyId1])
-        anBigNeighbour[nPolyId2] = nPolyId1;
+/************************************************************************/
+/*                        GDALSieveFindBorder()                         */
+/************************************************************************/
+
+static int GDALSieveFindBorder(std::vector<int> &anParent, int iBorder)
+{
+    while (anParent[iBorder] != iBorder)
+    {
+        anParent[iBorder] = anParent[anParent[iBorder]];
+        iBorder = anParent[iBorder];
+    }
+    return iBorder;
+}
+
+/************************************************************************/
+/*                        GDALSieveMergeSeam()                          */
+/*                                                                      */
+/*      Merge the border polygons of the first line of a strip with     */
+/*      the connected border polygons of the last line of the strip     */
+/*      above.                                                          */
+/************************************************************************/
+
+static void GDALSieveMergeSeam(GDALSieveContext &sCtxt,
+                               const std::vector<int> &anAboveBorder,
+                               const GDALSieveJob &sJob)
+{
+    std::vector<int> &anParent = sCtxt.anBorderRoot;
+    const auto Merge = [&](int iBorder1, int iBorder2)
+    {
+        if (iBorder1 < 0 ||
+            sCtxt.anBorderValue[iBorder1] != sCtxt.anBorderValue[iBorder2])
+            return;
+        iBorder1 = GDALSieveFindBorder(anParent, iBorder1);
+        iBorder2 = GDALSieveFindBorder(anParent, iBorder2);
+        if (iBorder1 < iBorder2)
+            anParent[iBorder2] = iBorder1;
+        else if (iBorder2 < iBorder1)
+            anParent[iBorder1] = iBorder2;
+    };
+
+    const int nXSize = sCtxt.nXSize;
+    const bool bEightConnected = sCtxt.nConnectedness == 8;
+    const int nBorderOffset = sJob.psStrip->nBorderOffset;
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        const int nTop = sJob.anTopBorder[iX];
+        if (nTop < 0)
+            continue;
+        const int iTop = nBorderOffset + nTop;
+        Merge(anAboveBorder[iX], iTop);
+        if (bEightConnected && iX > 0)
+            Merge(anAboveBorder[iX - 1], iTop);
+        if (bEightConnected && iX < nXSize - 1)
+            Merge(anAboveBorder[iX + 1], iTop);
+    }
+}
+
+/************************************************************************/
+/*                     GDALSieveFinalizeBorders()                       */
+/*                                                                      */
+/*      Once all seams are merged, map each border polygon to its       */
+/*      merged polygon, and accumulate their sizes.                     */
+/************************************************************************/
+
+static void GDALSieveFinalizeBorders(GDALSieveContext &sCtxt)
+{
+    std::vector<int> &anParent = sCtxt.anBorderRoot;
+    const int nBorders = static_cast<int>(anParent.size());
+    for (int iBorder = 0; iBorder < nBorders; iBorder++)
+    {
+        const int iRoot = GDALSieveFindBorder(anParent, iBorder);
+        anParent[iBorder] = iRoot;
+        if (iRoot != iBorder)
+        {
+            sCtxt.anBorderSize[iRoot] += sCtxt.anBorderSize[iBorder];
+            sCtxt.anBorderSize[iBorder] = 0;
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GDALSieveResolveBorders()                       */
+/*                                                                      */
+/*      Follow the largest neighbours of small border polygons until    */
+/*      a polygon larger than the threshold is found.                   */
+/************************************************************************/
+
+static void GDALSieveResolveBorders(GDALSieveContext &sCtxt,
+                                    int &nSieveTargets, int &nIsolatedSmall,
+                                    int &nFailedMerges)
+{
+    const int nBorders = static_cast<int>(sCtxt.anBorderValue.size());
+    sCtxt.asBorderTarget.resize(nBorders);
+    std::vector<GByte> abyState(nBorders);  // 0: not visited, 1: in chain,
+                                            // 2: done
+    std::vector<int> anChain;
+
+    for (int iBorder = 0; iBorder < nBorders; iBorder++)
+    {
+        if (sCtxt.anBorderRoot[iBorder] != iBorder ||
+            sCtxt.GetBorderSize(iBorder) >= sCtxt.nSizeThreshold)
+            continue;
+
+        nSieveTargets++;
+        if (sCtxt.asBorderCandidate[iBorder].nSize < 0)
+            nIsolatedSmall++;
+
+        GDALSieveTarget sTarget;
+        int iCur = iBorder;
+        while (true)
+        {
+            if (abyState[iCur] == 2)
+            {
+                sTarget = sCtxt.asBorderTarget[iCur];
+                break;
+            }
+            // Check that we don't cycle on an already visited polygon.
+            if (abyState[iCur] == 1)
+                break;
+            abyState[iCur] = 1;
+            anChain.push_back(iCur);
+
+            const GDALSieveTarget &sNext =
+                sCtxt.asBorderCandidate[iCur].sTarget;
+            if (sCtxt.asBorderCandidate[iCur].nSize < 0 ||
+                sNext.nKind != SIEVE_TARGET_BORDER)
+            {
+                sTarget = sNext;
+                break;
+            }
+            if (sCtxt.GetBorderSize(sNext.nBorderId) >= sCtxt.nSizeThreshold)
+            {
+                sTarget.nKind = SIEVE_TARGET_VALUE;
+                sTarget.nValue = sCtxt.anBorderValue[sNext.nBorderId];
+                break;
+            }
+            iCur = sNext.nBorderId;
+        }
+
+        // Map the whole chain to the result.
+        for (const int iChainBorder : anChain)
+        {
+            abyState[iChainBorder] = 2;
+            sCtxt.asBorderTarget[iChainBorder] = sTarget;
+        }
+        anChain.clear();
+
+        if (sCtxt.asBorderCandidate[iBorder].nSize >= 0 &&
+            sTarget.nKind == SIEVE_TARGET_NONE)
+            nFailedMerges++;
+    }
 }
 
 /************************************************************************/
@@ -164,13 +931,18 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * as the threshold will not be altered.  Polygons surrounded by nodata areas
  * will therefore not be altered.
  *
- * The algorithm makes three passes over the input file to enumerate the
- * polygons and collect limited information about them.  Memory use is
- * proportional to the number of polygons (roughly 24 bytes per polygon), but
- * is not directly related to the size of the raster.  So very large raster
- * files can be processed effectively if there aren't too many polygons.  But
- * extremely noisy rasters with many one pixel polygons will end up being
- * expensive (in memory) to process.
+ * When several neighbours have the largest size, the first one met in raster
+ * order is used.
+ *
+ * The algorithm makes three passes over the input file, which is processed
+ * by horizontal strips that can be handled in parallel, to enumerate the
+ * polygons and collect limited information about them.  Since GDAL 3.10,
+ * information is only kept for the polygons touching the first or last line
+ * of a strip, so that memory use does not grow with the number of polygons
+ * inside strips.  Each thread works on one strip at a time, of about 32 MB
+ * of working memory and at least 128 lines.  About 90 bytes are also kept
+ * for each polygon touching a strip boundary, which depends on the raster
+ * content: in the worst case, twice the raster width per strip boundary.
  *
  * @param hSrcBand the source raster band to be processed.
  * @param hMaskBand an optional mask band.  All pixels in the mask band with a
@@ -182,8 +954,13 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
  * @param nConnectedness either 4 indicating that diagonal pixels are not
  * considered directly adjacent for polygon membership purposes or 8
  * indicating they are.
- * @param papszOptions algorithm options in name=value list form.  None
- * currently supported.
+ * @param papszOptions algorithm options in name=value list form.
+ * The following option is supported:
+ * <ul>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: number of threads used to
+ * process strips. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1. (GDAL >= 3.10)</li>
+ * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
  * @param pProgressArg callback argument passed to pfnProgress.
@@ -194,8 +971,7 @@ static inline void CompareNeighbour(int nPolyId1, int nPolyId2,
 CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
                                    GDALRasterBandH hMaskBand,
                                    GDALRasterBandH hDstBand, int nSizeThreshold,
-                                   int nConnectedness,
-                                   CPL_UNUSED char **papszOptions,
+                                   int nConnectedness, char **papszOptions,
                                    GDALProgressFunc pfnProgress,
                                    void *pProgressArg)
 {
@@ -205,126 +981,305 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     if (pfnProgress == nullptr)
         pfnProgress = GDALDummyProgress;
 
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the height of the strips from the memory budget of      */
+    /*      a strip.  It does not depend on the number of threads, and      */
+    /*      is at least SIEVE_MIN_STRIP_YSIZE lines, so that the number     */
+    /*      of polygons touching a strip boundary stays small compared to   */
+    /*      the number of pixels.                                           */
+    /* -------------------------------------------------------------------- */
+    constexpr int SIEVE_MIN_STRIP_YSIZE = 128;
+    // Mostly for testing: sets the budget exactly, without minimum height.
+    const char *pszMaxMemory =
+        CPLGetConfigOption("GDAL_SIEVE_MAX_MEMORY", nullptr);
+    const GIntBig nMaxMemory =
+        pszMaxMemory ? std::max(static_cast<GIntBig>(1),
+                                CPLAtoGIntBig(pszMaxMemory))
+                     : static_cast<GIntBig>(32 * 1000 * 1000);
+    // Pixel values and polygon ids, original pixel values and mask, and
+    // an allowance for the per-polygon working arrays.
+    const GIntBig nBytesPerPixel =
+        static_cast<GIntBig>(sizeof(std::int64_t) + sizeof(GInt32)) +
+        (hMaskBand ? static_cast<GIntBig>(sizeof(std::int64_t) + 1) : 0) + 16;
+    GIntBig nStripYSize64 =
+        nMaxMemory / (nBytesPerPixel * std::max(1, nXSize));
+    if (pszMaxMemory == nullptr)
+        nStripYSize64 = std::max(nStripYSize64,
+                                 static_cast<GIntBig>(SIEVE_MIN_STRIP_YSIZE));
+    int nStripYSize = static_cast<int>(std::max(
+        static_cast<GIntBig>(1),
+        std::min(static_cast<GIntBig>(nYSize),
+                 std::min(nStripYSize64, static_cast<GIntBig>(MY_MAX_INT) /
+                                             std::max(1, nXSize)))));
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hSrcBand, nullptr, &nBlockYSize);
+    if (nBlockYSize > 0 && nStripYSize > nBlockYSize && nStripYSize < nYSize)
+        nStripYSize = nStripYSize / nBlockYSize * nBlockYSize;
+
+    GDALSieveContext sCtxt;
+    sCtxt.nXSize = nXSize;
+    sCtxt.nConnectedness = nConnectedness;
+    sCtxt.nSizeThreshold = nSizeThreshold;
+    sCtxt.nStrips = nYSize > 0 ? (nYSize - 1) / nStripYSize + 1 : 0;
+
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
-    int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    int nYSize = GDALGetRasterBandYSize(hSrcBand);
-    auto panLastLineValKeeper = std::unique_ptr<std::int64_t, VSIFreeReleaser>(
-        static_cast<std::int64_t *>(
-            VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize)));
-    auto panThisLineValKeeper = std::unique_ptr<std::int64_t, VSIFreeReleaser>(
-        static_cast<std::int64_t *>(
-            VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize)));
-    auto panLastLineIdKeeper = std::unique_ptr<GInt32, VSIFreeReleaser>(
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize)));
-    auto panThisLineIdKeeper = std::unique_ptr<GInt32, VSIFreeReleaser>(
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize)));
-    auto panThisLineWriteValKeeper =
-        std::unique_ptr<std::int64_t, VSIFreeReleaser>(
-            static_cast<std::int64_t *>(
-                VSI_MALLOC2_VERBOSE(sizeof(std::int64_t), nXSize)));
-    auto pabyMaskLineKeeper = std::unique_ptr<GByte, VSIFreeReleaser>(
-        hMaskBand != nullptr ? static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize))
-                             : nullptr);
-
-    auto panLastLineVal = panLastLineValKeeper.get();
-    auto panThisLineVal = panThisLineValKeeper.get();
-    auto panLastLineId = panLastLineIdKeeper.get();
-    auto panThisLineId = panThisLineIdKeeper.get();
-    auto panThisLineWriteVal = panThisLineWriteValKeeper.get();
-    auto pabyMaskLine = pabyMaskLineKeeper.get();
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        panThisLineWriteVal == nullptr ||
-        (hMaskBand != nullptr && pabyMaskLine == nullptr))
+    const int nBatchYSize = std::min(nYSize, nStripYSize * nThreads);
+    const size_t nBatchPixels = static_cast<size_t>(nXSize) * nBatchYSize;
+    std::vector<std::int64_t> anVal;
+    std::vector<GInt32> anId;
+    std::vector<std::int64_t> anWriteVal;
+    std::vector<GByte> abyMask;
+    try
+    {
+        sCtxt.asStrips.resize(sCtxt.nStrips);
+        anVal.resize(nBatchPixels);
+        anId.resize(nBatchPixels);
+        if (hMaskBand != nullptr)
+        {
+            anWriteVal.resize(nBatchPixels);
+            abyMask.resize(nBatchPixels);
+        }
+    }
+    catch (const std::exception &)
     {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
         return CE_Failure;
     }
+    for (int iStrip = 0; iStrip < sCtxt.nStrips; iStrip++)
+    {
+        sCtxt.asStrips[iStrip].nYOff = iStrip * nStripYSize;
+        sCtxt.asStrips[iStrip].nYSize =
+            std::min(nStripYSize, nYSize - iStrip * nStripYSize);
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
 
     /* -------------------------------------------------------------------- */
-    /*      The first pass over the raster is only used to build up the     */
-    /*      polygon id map so we will know in advance what polygons are     */
-    /*      what on the second pass.                                        */
+    /*      Run one pass over the strips, by batches of one strip per       */
+    /*      thread.  I/O is done in this thread.                            */
     /* -------------------------------------------------------------------- */
-    GDALRasterPolygonEnumerator oFirstEnum(nConnectedness);
-    std::vector<int> anPolySizes;
+    // Border polygon ids of the last line of the previous batch.
+    std::vector<int> anAboveBorder;
 
-    CPLErr eErr = CE_None;
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    const auto RunPass =
+        [&](int nPass, double dfProgressStart, double dfProgressEnd,
+            const std::function<bool(std::vector<GDALSieveJob> &)>
+                &fnBatchDone)
     {
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-        if (eErr != CE_None)
-            break;
-
-        if (iY == 0)
-            eErr = oFirstEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                          panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        else
-            eErr = oFirstEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                          panLastLineId, panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Accumulate polygon sizes. */
-        /* --------------------------------------------------------------------
-         */
-        if (oFirstEnum.nNextPolygonId > static_cast<int>(anPolySizes.size()))
-            anPolySizes.resize(oFirstEnum.nNextPolygonId);
-
-        for (int iX = 0; iX < nXSize; iX++)
+        anAboveBorder.clear();
+        std::vector<GDALSieveJob> asJobs;
+        for (int iFirstStrip = 0; iFirstStrip < sCtxt.nStrips;
+             iFirstStrip += nThreads)
         {
-            const int iPoly = panThisLineId[iX];
+            const int nJobs = std::min(nThreads, sCtxt.nStrips - iFirstStrip);
+            const int nYOff = sCtxt.asStrips[iFirstStrip].nYOff;
+            const GDALSieveStrip &oLastStrip =
+                sCtxt.asStrips[iFirstStrip + nJobs - 1];
+            const int nReqYSize =
+                oLastStrip.nYOff + oLastStrip.nYSize - nYOff;
+            const size_t nReqPixels = static_cast<size_t>(nXSize) * nReqYSize;
+
+            /* ---------------------------------------------------------- */
+            /*      Read the image data, and mask out pixels.             */
+            /* ---------------------------------------------------------- */
+            if (GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nReqYSize,
+                             anVal.data(), nXSize, nReqYSize, GDT_Int64, 0,
+                             0) != CE_None)
+                return false;
+            if (hMaskBand != nullptr)
+            {
+                if (GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize,
+                                 nReqYSize, abyMask.data(), nXSize, nReqYSize,
+                                 GDT_Byte, 0, 0) != CE_None)
+                    return false;
+                if (nPass == 3)
+                    memcpy(anWriteVal.data(), anVal.data(),
+                           nReqPixels * sizeof(std::int64_t));
+                for (size_t i = 0; i < nReqPixels; i++)
+                {
+                    if (abyMask[i] == 0)
+                        anVal[i] = GP_NODATA_MARKER;
+                }
+            }
 
-            if (iPoly >= 0 && anPolySizes[iPoly] < MY_MAX_INT)
-                anPolySizes[iPoly] += 1;
-        }
+            /* ---------------------------------------------------------- */
+            /*      Process the strips.                                   */
+            /* ---------------------------------------------------------- */
+            asJobs.clear();
+            asJobs.resize(nJobs);
+            for (int i = 0; i < nJobs; i++)
+            {
+                GDALSieveJob &sJob = asJobs[i];
+                const size_t nOffset =
+                    static_cast<size_t>(nXSize) *
+                    (sCtxt.asStrips[iFirstStrip + i].nYOff - nYOff);
+                sJob.psCtxt = &sCtxt;
+                sJob.iStrip = iFirstStrip + i;
+                sJob.nPass = nPass;
+                sJob.psStrip = &sCtxt.asStrips[iFirstStrip + i];
+                sJob.panVal = anVal.data() + nOffset;
+                sJob.panWriteVal = (hMaskBand != nullptr ? anWriteVal.data()
+                                                         : anVal.data()) +
+                                   nOffset;
+                sJob.panId = anId.data() + nOffset;
+            }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      swap this/last lines. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(0.25 * ((iY + 1) / static_cast<double>(nYSize)), "",
-                         pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
+            const auto CheckJobs = [&asJobs]()
+            {
+                for (const auto &sJob : asJobs)
+                {
+                    if (!sJob.bOK)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "GDALSieveFilter(): out of memory");
+                        return false;
+                    }
+                }
+                return true;
+            };
+            if (nPass == 1)
+            {
+                GDALSieveRunJobs(poJobQueue.get(), GDALSieveFirstPassJob,
+                                 asJobs);
+            }
+            else
+            {
+                // Label the strips, and then look at their neighbours, with
+                // the last line of the strip above.
+                GDALSieveRunJobs(poJobQueue.get(), GDALSieveLabelPassJob,
+                                 asJobs);
+                if (!CheckJobs())
+                    return false;
+                for (int i = 0; i < nJobs; i++)
+                {
+                    if (i > 0)
+                        asJobs[i].panAboveBorder =
+                            asJobs[i - 1].anBottomBorder.data();
+                    else if (iFirstStrip > 0)
+                        asJobs[i].panAboveBorder = anAboveBorder.data();
+                }
+                GDALSieveRunJobs(poJobQueue.get(), GDALSieveNeighboursPassJob,
+                                 asJobs);
+            }
+            if (!CheckJobs() || !fnBatchDone(asJobs))
+                return false;
+            if (nPass > 1)
+                std::swap(anAboveBorder, asJobs.back().anBottomBorder);
+
+            /* ---------------------------------------------------------- */
+            /*      Write the updated data out.                           */
+            /* ---------------------------------------------------------- */
+            if (nPass == 3 &&
+                GDALRasterIO(hDstBand, GF_Write, 0, nYOff, nXSize, nReqYSize,
+                             hMaskBand != nullptr ? anWriteVal.data()
+                                                  : anVal.data(),
+                             nXSize, nReqYSize, GDT_Int64, 0, 0) != CE_None)
+                return false;
+
+            /* ---------------------------------------------------------- */
+            /*      Report progress, and support interrupts.              */
+            /* ---------------------------------------------------------- */
+            if (!pfnProgress(dfProgressStart +
+                                 (dfProgressEnd - dfProgressStart) *
+                                     ((nYOff + nReqYSize) /
+                                      static_cast<double>(nYSize)),
+                             "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return false;
+            }
         }
-    }
+        return true;
+    };
 
     /* -------------------------------------------------------------------- */
-    /*      Make a pass through the maps, ensuring every polygon id         */
-    /*      points to the final id it should use, not an intermediate       */
-    /*      value.                                                          */
+    /*      The first pass over the raster is only used to compute the      */
+    /*      sizes of polygons, and record the border polygons.              */
     /* -------------------------------------------------------------------- */
-    if (eErr == CE_None)
-        oFirstEnum.CompleteMerges();
+    GIntBig nPolygons = 0;
+    if (!RunPass(1, 0.0, 0.25,
+                 [&sCtxt, &nPolygons,
+                  &anAboveBorder](std::vector<GDALSieveJob> &asJobs)
+                 {
+                     for (auto &sJob : asJobs)
+                     {
+                         const GIntBig nBorders =
+                             static_cast<GIntBig>(sCtxt.anBorderValue.size()) +
+                             sJob.psStrip->nBorderCount;
+                         if (nBorders > MY_MAX_INT)
+                         {
+                             CPLError(CE_Failure, CPLE_AppDefined,
+                                      "GDALSieveFilter(): too many polygons "
+                                      "on strip boundaries");
+                             return false;
+                         }
+                         sJob.psStrip->nBorderOffset =
+                             static_cast<int>(sCtxt.anBorderValue.size());
+                         try
+                         {
+                             sCtxt.anBorderValue.insert(
+                                 sCtxt.anBorderValue.end(),
+                                 sJob.anBorderValue.begin(),
+                                 sJob.anBorderValue.end());
+                             sCtxt.anBorderSize.insert(
+                                 sCtxt.anBorderSize.end(),
+                                 sJob.anBorderSize.begin(),
+                                 sJob.anBorderSize.end());
+                             for (int i = 0; i < sJob.psStrip->nBorderCount;
+                                  i++)
+                             {
+                                 sCtxt.anBorderRoot.push_back(
+                                     sJob.psStrip->nBorderOffset + i);
+                             }
+                         }
+                         catch (const std::exception &)
+                         {
+                             CPLError(CE_Failure, CPLE_OutOfMemory,
+                                      "GDALSieveFilter(): out of memory");
+                             return false;
+                         }
+                         nPolygons += sJob.nPolygons;
+
+                         // Merge the seam with the strip above right away,
+                         // and only keep the last line of this strip.
+                         if (sJob.iStrip > 0)
+                             GDALSieveMergeSeam(sCtxt, anAboveBorder, sJob);
+                         anAboveBorder = std::move(sJob.anBottomBorder);
+                         for (int &nBorder : anAboveBorder)
+                         {
+                             if (nBorder >= 0)
+                                 nBorder += sJob.psStrip->nBorderOffset;
+                         }
+                     }
+                     return true;
+                 }))
+    {
+        return CE_Failure;
+    }
 
     /* -------------------------------------------------------------------- */
     /*      Check if there are polygons                                     */
     /* -------------------------------------------------------------------- */
-    if (!oFirstEnum.panPolyIdMap || !oFirstEnum.panPolyValue)
+    if (nPolygons == 0)
     {
         // Can happen if all pixels are masked
         if (hSrcBand == hDstBand)
@@ -340,36 +1295,14 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Push the sizes of merged polygon fragments into the             */
-    /*      merged polygon id's count.                                      */
-    /* -------------------------------------------------------------------- */
-    for (int iPoly = 0; iPoly < oFirstEnum.nNextPolygonId; iPoly++)
-    {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-        {
-            GIntBig nSize = anPolySizes[oFirstEnum.panPolyIdMap[iPoly]];
-
-            nSize += anPolySizes[iPoly];
-
-            if (nSize > MY_MAX_INT)
-                nSize = MY_MAX_INT;
-
-            anPolySizes[oFirstEnum.panPolyIdMap[iPoly]] =
-                static_cast<int>(nSize);
-            anPolySizes[iPoly] = 0;
-        }
-    }
-
-    /* -------------------------------------------------------------------- */
-    /*      We will use a new enumerator for the second pass primarily      */
-    /*      so we can preserve the first pass map.                          */
+    /*      Merge the polygons crossing strip boundaries.                   */
     /* -------------------------------------------------------------------- */
-    GDALRasterPolygonEnumerator oSecondEnum(nConnectedness);
-
-    std::vector<int> anBigNeighbour;
+    anAboveBorder.clear();
+    anAboveBorder.shrink_to_fit();
     try
     {
-        anBigNeighbour.resize(anPolySizes.size());
+        GDALSieveFinalizeBorders(sCtxt);
+        sCtxt.asBorderCandidate.resize(sCtxt.anBorderValue.size());
     }
     catch (const std::exception &)
     {
@@ -378,108 +1311,31 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
-        anBigNeighbour[iPoly] = -1;
-
     /* ==================================================================== */
-    /*      Second pass ... identify the largest neighbour for each         */
-    /*      polygon.                                                        */
+    /*      Second pass ... identify the largest neighbour of each          */
+    /*      small border polygon.                                           */
     /* ==================================================================== */
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    if (!RunPass(2, 0.25, 0.5,
+                 [&sCtxt](std::vector<GDALSieveJob> &asJobs)
+                 {
+                     for (const auto &sJob : asJobs)
+                     {
+                         for (const auto &oIter : sJob.aoBorderCandidates)
+                         {
+                             const auto &sNew = oIter.second;
+                             auto &sCur = sCtxt.asBorderCandidate[oIter.first];
+                             if (sNew.nSize > sCur.nSize ||
+                                 (sNew.nSize == sCur.nSize &&
+                                  sNew.nKey < sCur.nKey))
+                             {
+                                 sCur = sNew;
+                             }
+                         }
+                     }
+                     return true;
+                 }))
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the image data. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Determine what polygon the various pixels belong to (redoing */
-        /*      the same thing done in the first pass above). */
-        /* --------------------------------------------------------------------
-         */
-        if (iY == 0)
-            eErr = oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                           panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-        else
-            eErr = oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                           panLastLineId, panThisLineId, nXSize)
-                       ? CE_None
-                       : CE_Failure;
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Check our neighbours, and update our biggest neighbour map */
-        /*      as appropriate. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            if (iY > 0)
-            {
-                CompareNeighbour(panThisLineId[iX], panLastLineId[iX],
-                                 oFirstEnum.panPolyIdMap,
-                                 oFirstEnum.panPolyValue, anPolySizes,
-                                 anBigNeighbour);
-
-                if (iX > 0 && nConnectedness == 8)
-                    CompareNeighbour(panThisLineId[iX], panLastLineId[iX - 1],
-                                     oFirstEnum.panPolyIdMap,
-                                     oFirstEnum.panPolyValue, anPolySizes,
-                                     anBigNeighbour);
-
-                if (iX < nXSize - 1 && nConnectedness == 8)
-                    CompareNeighbour(panThisLineId[iX], panLastLineId[iX + 1],
-                                     oFirstEnum.panPolyIdMap,
-                                     oFirstEnum.panPolyValue, anPolySizes,
-                                     anBigNeighbour);
-            }
-
-            if (iX > 0)
-                CompareNeighbour(panThisLineId[iX], panThisLineId[iX - 1],
-                                 oFirstEnum.panPolyIdMap,
-                                 oFirstEnum.panPolyValue, anPolySizes,
-                                 anBigNeighbour);
-
-            // We don't need to compare to next pixel or next line
-            // since they will be compared to us.
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Swap pixel value, and polygon id lines to be ready for the */
-        /*      next line. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(0.25 + 0.25 * ((iY + 1) / static_cast<double>(nYSize)),
-                         "", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-        }
+        return CE_Failure;
     }
 
     /* -------------------------------------------------------------------- */
@@ -490,170 +1346,40 @@ CPLErr CPL_STDCALL GDALSieveFilter(GDALRasterBandH hSrcBand,
     int nFailedMerges = 0;
     int nIsolatedSmall = 0;
     int nSieveTargets = 0;
-
-    for (int iPoly = 0; iPoly < static_cast<int>(anPolySizes.size()); iPoly++)
+    try
     {
-        if (oFirstEnum.panPolyIdMap[iPoly] != iPoly)
-            continue;
-
-        // Ignore nodata polygons.
-        if (oFirstEnum.panPolyValue[iPoly] == GP_NODATA_MARKER)
-            continue;
-
-        // Don't try to merge polygons larger than the threshold.
-        if (anPolySizes[iPoly] >= nSizeThreshold)
-        {
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        nSieveTargets++;
-
-        // if we have no neighbours but we are small, what shall we do?
-        if (anBigNeighbour[iPoly] == -1)
-        {
-            nIsolatedSmall++;
-            continue;
-        }
-
-        std::set<int> oSetVisitedPoly;
-        oSetVisitedPoly.insert(iPoly);
-
-        // Walk through our neighbours until we find a polygon large enough.
-        int iFinalId = iPoly;
-        bool bFoundBigEnoughPoly = false;
-        while (true)
-        {
-            iFinalId = anBigNeighbour[iFinalId];
-            if (iFinalId < 0)
-            {
-                break;
-            }
-            // If the biggest neighbour is larger than the threshold
-            // then we are golden.
-            if (anPolySizes[iFinalId] >= nSizeThreshold)
-            {
-                bFoundBigEnoughPoly = true;
-                break;
-            }
-            // Check that we don't cycle on an already visited polygon.
-            if (oSetVisitedPoly.find(iFinalId) != oSetVisitedPoly.end())
-                break;
-            oSetVisitedPoly.insert(iFinalId);
-        }
-
-        if (!bFoundBigEnoughPoly)
-        {
-            nFailedMerges++;
-            anBigNeighbour[iPoly] = -1;
-            continue;
-        }
-
-        // Map the whole intermediate chain to it.
-        int iPolyCur = iPoly;
-        while (anBigNeighbour[iPolyCur] != iFinalId)
-        {
-            int iNextPoly = anBigNeighbour[iPolyCur];
-            anBigNeighbour[iPolyCur] = iFinalId;
-            iPolyCur = iNextPoly;
-        }
+        GDALSieveResolveBorders(sCtxt, nSieveTargets, nIsolatedSmall,
+                                nFailedMerges);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
+        return CE_Failure;
     }
-
-    CPLDebug("GDALSieveFilter",
-             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
-             nIsolatedSmall, nFailedMerges);
 
     /* ==================================================================== */
     /*      Make a third pass over the image, actually applying the         */
-    /*      merges.  We reuse the second enumerator but preserve the        */
-    /*      "final maps" from the first.                                    */
+    /*      merges.                                                         */
     /* ==================================================================== */
-    oSecondEnum.Clear();
-
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    if (!RunPass(3, 0.5, 1.0,
+                 [&](std::vector<GDALSieveJob> &asJobs)
+                 {
+                     for (const auto &sJob : asJobs)
+                     {
+                         nSieveTargets += sJob.nSieveTargets;
+                         nIsolatedSmall += sJob.nIsolatedSmall;
+                         nFailedMerges += sJob.nFailedMerges;
+                     }
+                     return true;
+                 }))
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the image data. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, GDT_Int64, 0, 0);
-
-        memcpy(panThisLineWriteVal, panThisLineVal,
-               sizeof(panThisLineVal[0]) * nXSize);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
-
-        if (eErr != CE_None)
-            continue;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Determine what polygon the various pixels belong to (redoing */
-        /*      the same thing done in the first pass above). */
-        /* --------------------------------------------------------------------
-         */
-        if (iY == 0)
-            oSecondEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
-                                    panThisLineId, nXSize);
-        else
-            oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
-                                    panLastLineId, panThisLineId, nXSize);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Reprocess the actual pixel values according to the polygon */
-        /*      merging, and write out this line of image data. */
-        /* --------------------------------------------------------------------
-         */
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int iThisPoly = panThisLineId[iX];
-            if (iThisPoly >= 0)
-            {
-                iThisPoly = oFirstEnum.panPolyIdMap[iThisPoly];
-
-                if (anBigNeighbour[iThisPoly] != -1)
-                {
-                    panThisLineWriteVal[iX] =
-                        oFirstEnum.panPolyValue[anBigNeighbour[iThisPoly]];
-                }
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Write the update data out. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, iY, nXSize, 1,
-                            panThisLineWriteVal, nXSize, 1, GDT_Int64, 0, 0);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Swap pixel value, and polygon id lines to be ready for the */
-        /*      next line. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(panLastLineVal, panThisLineVal);
-        std::swap(panLastLineId, panThisLineId);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress, and support interrupts. */
-        /* --------------------------------------------------------------------
-         */
-        if (eErr == CE_None &&
-            !pfnProgress(0.5 + 0.5 * ((iY + 1) / static_cast<double>(nYSize)),
-                         "", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-        }
+        return CE_Failure;
     }
 
-    return eErr;
+    CPLDebug("GDALSieveFilter",
+             "Small Polygons: %d, Isolated: %d, Unmergable: %d", nSieveTargets,
+             nIsolatedSmall, nFailedMerges);
+
+    return CE_None;
 }
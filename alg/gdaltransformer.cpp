@@ -53,6 +53,10 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2_OPTIM
+#include "gdalsse_priv.h"
+#endif
 #include "ogr_core.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
@@ -1795,6 +1799,11 @@ static void GDALGCPAntimeridianUnwrap(int nGCPCount, GDAL_GCP *pasGCPList,
  * a continuous set. This option can be set to YES to force that behavior
  * (useful if no SRS information is available), or to NO to disable it.
  * </li>
+ * <li>NUM_THREADS=number_of_threads or ALL_CPUS. Number of threads used by the
+ * Thin Plate Spline transformer when there are more than 100 GCPs, to solve
+ * its systems of equations and, since GDAL 3.10, to transform large batches
+ * of points. Defaults to the GDAL_NUM_THREADS configuration option.
+ * </li>
  * <li> SRC_METHOD: may have a value which is one of GEOTRANSFORM,
  * GCP_POLYNOMIAL, GCP_TPS, GEOLOC_ARRAY, RPC to force only one geolocation
  * method to be considered on the source dataset. Will be used for pixel/line
@@ -2827,6 +2836,68 @@ void GDALDestroyGenImgProjTransformer(void *hTransformArg)
     CPLFree(psInfo);
 }
 
+/************************************************************************/
+/*                     GDALApplyGeoTransformInPlace()                   */
+/************************************************************************/
+
+// Apply padfGT to the points of padfX/padfY for which panSuccess[] is set.
+// Points are processed 4 at a time with SIMD registers when possible, with
+// the same operation order as the scalar code, so results are identical.
+static void GDALApplyGeoTransformInPlace(const double *padfGT, int nPointCount,
+                                         double *padfX, double *padfY,
+                                         const int *panSuccess)
+{
+    int i = 0;
+#ifdef USE_SSE2_OPTIM
+    const auto gt0 = XMMReg4Double::Load1ValHighAndLow(padfGT + 0);
+    const auto gt1 = XMMReg4Double::Load1ValHighAndLow(padfGT + 1);
+    const auto gt2 = XMMReg4Double::Load1ValHighAndLow(padfGT + 2);
+    const auto gt3 = XMMReg4Double::Load1ValHighAndLow(padfGT + 3);
+    const auto gt4 = XMMReg4Double::Load1ValHighAndLow(padfGT + 4);
+    const auto gt5 = XMMReg4Double::Load1ValHighAndLow(padfGT + 5);
+    for (; i + 3 < nPointCount; i += 4)
+    {
+        if (panSuccess[i] && panSuccess[i + 1] && panSuccess[i + 2] &&
+            panSuccess[i + 3])
+        {
+            const auto x = XMMReg4Double::Load4Val(padfX + i);
+            const auto y = XMMReg4Double::Load4Val(padfY + i);
+            const auto newX = gt0 + x * gt1 + y * gt2;
+            const auto newY = gt3 + x * gt4 + y * gt5;
+            newX.Store4Val(padfX + i);
+            newY.Store4Val(padfY + i);
+        }
+        else
+        {
+            for (int j = i; j < i + 4; j++)
+            {
+                if (!panSuccess[j])
+                    continue;
+                const double dfNewX =
+                    padfGT[0] + padfX[j] * padfGT[1] + padfY[j] * padfGT[2];
+                const double dfNewY =
+                    padfGT[3] + padfX[j] * padfGT[4] + padfY[j] * padfGT[5];
+                padfX[j] = dfNewX;
+                padfY[j] = dfNewY;
+            }
+        }
+    }
+#endif
+    for (; i < nPointCount; i++)
+    {
+        if (!panSuccess[i])
+            continue;
+
+        const double dfNewX =
+            padfGT[0] + padfX[i] * padfGT[1] + padfY[i] * padfGT[2];
+        const double dfNewY =
+            padfGT[3] + padfX[i] * padfGT[4] + padfY[i] * padfGT[5];
+
+        padfX[i] = dfNewX;
+        padfY[i] = dfNewY;
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2889,21 +2960,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformInPlace(padfGeoTransform, nPointCount, padfX,
+                                     padfY, panSuccess);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2940,21 +2998,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformInPlace(padfGeoTransform, nPointCount, padfX,
+                                     padfY, panSuccess);
     }
 
     return TRUE;
@@ -4145,9 +4190,9 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     /*      NOTE: the above comment is not true: gdalwarp uses approximator */
     /*      also to compute the source pixel of each target pixel.          */
     /* -------------------------------------------------------------------- */
+#ifdef check_error
     for (int i = nPoints - 1; i >= 0; i--)
     {
-#ifdef check_error
         double xtemp = x[i];
         double ytemp = y[i];
         double ztemp = z[i];
@@ -4156,20 +4201,53 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         int btemp = FALSE;
         psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc, 1,
                                      &xtemp, &ytemp, &ztemp, &btemp);
-#endif
         const double dfDist = (x[i] - x[0]);
         x[i] = xSMETransformed[0] + dfDeltaX * dfDist;
         y[i] = ySMETransformed[0] + dfDeltaY * dfDist;
         z[i] = zSMETransformed[0] + dfDeltaZ * dfDist;
-#ifdef check_error
         const double dfError2 = fabs(x[i] - xtemp) + fabs(y[i] - ytemp);
         if (dfError2 > 4 /*10 * dfMaxError*/)
         {
             /*ok*/ printf("Error = %f on (%f, %f)\n", dfError2, x_ori, y_ori);
         }
+        panSuccess[i] = TRUE;
+    }
+#else
+    // x[0] is only overwritten after all the other points have been
+    // interpolated from it.
+    const double dfX0 = x[0];
+    int i = 0;
+#ifdef USE_SSE2_OPTIM
+    {
+        const auto x0 = XMMReg4Double::Load1ValHighAndLow(&dfX0);
+        const auto xStart = XMMReg4Double::Load1ValHighAndLow(xSMETransformed);
+        const auto yStart = XMMReg4Double::Load1ValHighAndLow(ySMETransformed);
+        const auto zStart = XMMReg4Double::Load1ValHighAndLow(zSMETransformed);
+        const auto deltaX = XMMReg4Double::Load1ValHighAndLow(&dfDeltaX);
+        const auto deltaY = XMMReg4Double::Load1ValHighAndLow(&dfDeltaY);
+        const auto deltaZ = XMMReg4Double::Load1ValHighAndLow(&dfDeltaZ);
+        for (; i + 3 < nPoints; i += 4)
+        {
+            const auto dist = XMMReg4Double::Load4Val(x + i) - x0;
+            (xStart + deltaX * dist).Store4Val(x + i);
+            (yStart + deltaY * dist).Store4Val(y + i);
+            (zStart + deltaZ * dist).Store4Val(z + i);
+            panSuccess[i] = TRUE;
+            panSuccess[i + 1] = TRUE;
+            panSuccess[i + 2] = TRUE;
+            panSuccess[i + 3] = TRUE;
+        }
+    }
 #endif
+    for (; i < nPoints; i++)
+    {
+        const double dfDist = (x[i] - dfX0);
+        x[i] = xSMETransformed[0] + dfDeltaX * dfDist;
+        y[i] = ySMETransformed[0] + dfDeltaY * dfDist;
+        z[i] = zSMETransformed[0] + dfDeltaZ * dfDist;
         panSuccess[i] = TRUE;
     }
+#endif
 
     return TRUE;
 }
@@ -4578,6 +4656,11 @@ CPLErr GDALDeserializeTransformer(CPLXMLNode *psTree,
         *ppfnFunc = GDALApproxTransform;
         *ppTransformArg = GDALDeserializeApproxTransformer(psTree);
     }
+    else if (EQUAL(psTree->pszValue, "WarpPlanTransformer"))
+    {
+        *ppfnFunc = GDALWarpPlanTransform;
+        *ppTransformArg = GDALDeserializeWarpPlanTransformer(psTree);
+    }
     else
     {
         GDALTransformDeserializeFunc pfnDeserializeFunc = nullptr;
@@ -4753,6 +4836,23 @@ static GDALTransformerInfo *GetGenImgProjTransformInfo(const char *pszFunc,
         return nullptr;
     }
 
+    if (EQUAL(psInfo->pszClassName, GDAL_WARP_PLAN_TRANSFORMER_CLASS_NAME))
+    {
+        pTransformArg = GDALGetWarpPlanBaseTransformer(pTransformArg);
+        psInfo = static_cast<GDALTransformerInfo *>(pTransformArg);
+
+        if (psInfo == nullptr ||
+            memcmp(psInfo->abySignature, GDAL_GTI2_SIGNATURE,
+                   strlen(GDAL_GTI2_SIGNATURE)) != 0)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Attempt to call %s on "
+                     "a non-GTI2 transformer.",
+                     pszFunc);
+            return nullptr;
+        }
+    }
+
     if (EQUAL(psInfo->pszClassName, GDAL_APPROX_TRANSFORMER_CLASS_NAME))
     {
         ApproxTransformInfo *psATInfo =
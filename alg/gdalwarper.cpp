@@ -1279,6 +1279,24 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * EXCLUDED_VALUES_PCT_THRESHOLD.
  * Only taken into account by Average currently.</li>
  *
+ * <li>ADVISE_READ_CHUNKS=YES/NO: (GDAL >= 3.10) Whether
+ * GDALDataset::AdviseRead() should be called on the source window of each
+ * chunk before it is read, when it has not been already called for the
+ * whole source window. With ChunkAndWarpMulti(), a thread additionally
+ * loads in the block cache the source windows of the chunks following the
+ * ones being processed, while they are being warped, which hides the latency
+ * of remote sources behind computation. This is only done for the source
+ * bands whose reads go through the block cache, as determined after the
+ * first chunk has been read. The amount of source data loaded ahead, in
+ * native blocks, is limited by the warp memory limit and by a quarter of the
+ * block cache size. Defaults to YES.</li>
+ *
+ * <li>WARP_PLAN=YES/NO: (GDAL >= 3.10) Whether the transformations done by
+ * the warp operation should be memoized by wrapping the transformer in a
+ * GDALCreateWarpPlanTransformer(). This speeds up repeated warps of source
+ * datasets of the same shape and georeferencing into the same target grid,
+ * as done by tile services. Defaults to NO.</li>
+ *
  * </ul>
  */
 
@@ -2563,6 +2563,178 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
     return bHasValid;
 }
 
+/************************************************************************/
+/*                          GWKGetMaskBits()                            */
+/*                                                                      */
+/*      Return nLen (<= 32) consecutive bits of a validity mask,        */
+/*      starting at bit iOffset, as the low bits of a word.             */
+/************************************************************************/
+
+static CPL_INLINE GUInt32 GWKGetMaskBits(const GUInt32 *panMask,
+                                         GPtrDiff_t iOffset, int nLen)
+{
+    const GPtrDiff_t iWord = iOffset >> 5;
+    const int nShift = static_cast<int>(iOffset & 0x1f);
+    GUInt64 nBits = panMask[iWord] >> nShift;
+    if (nShift + nLen > 32)
+        nBits |= static_cast<GUInt64>(panMask[iWord + 1]) << (32 - nShift);
+    return static_cast<GUInt32>(nBits &
+                                ((static_cast<GUInt64>(1) << nLen) - 1));
+}
+
+/************************************************************************/
+/*                        GWKGetPixelRowRealT()                         */
+/************************************************************************/
+
+#if defined(__x86_64) || defined(_M_X64)
+// Validity (0 or 1) of 4 consecutive pixels, indexed by their 4 validity
+// bits.
+alignas(32) static constexpr double aadfGWKMaskNibbleToValidity[16][4] = {
+    {0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}, {1, 1, 0, 0},
+    {0, 0, 1, 0}, {1, 0, 1, 0}, {0, 1, 1, 0}, {1, 1, 1, 0},
+    {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}, {1, 1, 0, 1},
+    {0, 0, 1, 1}, {1, 0, 1, 1}, {0, 1, 1, 1}, {1, 1, 1, 1}};
+#endif
+
+// Same result as GWKGetPixelRow() for a non-complex working data type,
+// but reads the source buffer with its native type and combines the
+// unified and per-band validity masks 32 pixels at a time with word
+// operations, instead of testing each bit of each mask separately. On
+// x86_64, the conversion of the row to double and the expansion of the
+// validity bits into densities are done 4 pixels at a time.
+template <class T>
+static bool GWKGetPixelRowRealT(const GDALWarpKernel *poWK, int iBand,
+                                GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                                double *padfDensity, double adfReal[])
+{
+    const int nSrcLen = nHalfSrcLen * 2;
+    const T *pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) + iSrcOffset;
+    int i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    for (; i + 4 <= nSrcLen; i += 4)
+        XMMReg4Double::Load4Val(pSrc + i).Store4Val(adfReal + i);
+#endif
+    for (; i < nSrcLen; ++i)
+        adfReal[i] = static_cast<double>(pSrc[i]);
+
+    if (padfDensity == nullptr)
+        return true;
+
+    const GUInt32 *panUnifiedSrcValid = poWK->panUnifiedSrcValid;
+    const GUInt32 *panBandSrcValid = poWK->papanBandSrcValid != nullptr
+                                         ? poWK->papanBandSrcValid[iBand]
+                                         : nullptr;
+    const float *pafSrcDensity = poWK->pafUnifiedSrcDensity != nullptr
+                                     ? poWK->pafUnifiedSrcDensity + iSrcOffset
+                                     : nullptr;
+
+    bool bHasValid = false;
+#if defined(__x86_64) || defined(_M_X64)
+    const XMMReg4Double vZero = XMMReg4Double::Zero();
+    const double dfOne = 1.0;
+    const XMMReg4Double vOne = XMMReg4Double::Load1ValHighAndLow(&dfOne);
+    const double dfThreshold = SRC_DENSITY_THRESHOLD;
+    const XMMReg4Double vThreshold =
+        XMMReg4Double::Load1ValHighAndLow(&dfThreshold);
+    // Number of densities above the threshold, per lane
+    XMMReg4Double vValidCount = XMMReg4Double::Zero();
+#endif
+    for (int iChunk = 0; iChunk < nSrcLen; iChunk += 32)
+    {
+        const int nLen = std::min(32, nSrcLen - iChunk);
+        double *padfChunkDensity = padfDensity + iChunk;
+
+        GUInt32 nValid =
+            static_cast<GUInt32>((static_cast<GUInt64>(1) << nLen) - 1);
+        if (panUnifiedSrcValid != nullptr)
+            nValid &= GWKGetMaskBits(panUnifiedSrcValid, iSrcOffset + iChunk,
+                                     nLen);
+        if (panBandSrcValid != nullptr)
+            nValid &=
+                GWKGetMaskBits(panBandSrcValid, iSrcOffset + iChunk, nLen);
+        if (nValid == 0)
+        {
+            for (i = 0; i < nLen; ++i)
+                padfChunkDensity[i] = 0.0;
+            continue;
+        }
+
+        const float *pafChunkSrcDensity =
+            pafSrcDensity != nullptr ? pafSrcDensity + iChunk : nullptr;
+        // A density of 1 is above SRC_DENSITY_THRESHOLD.
+        if (pafChunkSrcDensity == nullptr)
+            bHasValid = true;
+
+        i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+        for (; i + 4 <= nLen; i += 4)
+        {
+            const XMMReg4Double vValid = XMMReg4Double::Load4Val(
+                aadfGWKMaskNibbleToValidity[(nValid >> i) & 0xf]);
+            if (pafChunkSrcDensity == nullptr)
+            {
+                vValid.Store4Val(padfChunkDensity + i);
+            }
+            else
+            {
+                const XMMReg4Double vDensity = XMMReg4Double::Ternary(
+                    XMMReg4Double::NotEquals(vValid, vZero),
+                    XMMReg4Double::Load4Val(pafChunkSrcDensity + i), vZero);
+                vDensity.Store4Val(padfChunkDensity + i);
+                vValidCount += XMMReg4Double::Ternary(
+                    XMMReg4Double::Greater(vDensity, vThreshold), vOne, vZero);
+            }
+        }
+#endif
+        for (; i < nLen; ++i)
+        {
+            const double dfDensity =
+                ((nValid >> i) & 1) == 0 ? 0.0
+                : pafChunkSrcDensity != nullptr
+                    ? static_cast<double>(pafChunkSrcDensity[i])
+                    : 1.0;
+            padfChunkDensity[i] = dfDensity;
+            if (dfDensity > SRC_DENSITY_THRESHOLD)
+                bHasValid = true;
+        }
+    }
+#if defined(__x86_64) || defined(_M_X64)
+    if (vValidCount.GetHorizSum() > 0)
+        bHasValid = true;
+#endif
+
+    return bHasValid;
+}
+
+/************************************************************************/
+/*                          GWKGetPixelRowT()                           */
+/*                                                                      */
+/*      Dispatch to GWKGetPixelRowRealT() when the working data type    */
+/*      is known at compile time (T != void), or to the generic         */
+/*      GWKGetPixelRow() otherwise.                                     */
+/************************************************************************/
+
+template <class T>
+static CPL_INLINE bool GWKGetPixelRowT(const GDALWarpKernel *poWK, int iBand,
+                                       GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                                       double *padfDensity, double adfReal[],
+                                       double * /* padfImag */)
+{
+    return GWKGetPixelRowRealT<T>(poWK, iBand, iSrcOffset, nHalfSrcLen,
+                                  padfDensity, adfReal);
+}
+
+template <>
+CPL_INLINE bool GWKGetPixelRowT<void>(const GDALWarpKernel *poWK, int iBand,
+                                      GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                                      double *padfDensity, double adfReal[],
+                                      double *padfImag)
+{
+    return GWKGetPixelRow(poWK, iBand, iSrcOffset, nHalfSrcLen, padfDensity,
+                          adfReal, padfImag);
+}
+
 /************************************************************************/
 /*                          GWKGetPixelT()                              */
 /************************************************************************/
@@ -2599,6 +2771,7 @@ static bool GWKGetPixelT(const GDALWarpKernel *poWK, int iBand,
 /*     Set of bilinear interpolators                                    */
 /************************************************************************/
 
+template <class T = void>
 static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                        double dfSrcX, double dfSrcY,
                                        double *pdfDensity, double *pdfReal,
@@ -2649,8 +2822,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY >= 0 && iSrcY < nSrcYSize && iSrcOffset >= 0 &&
         iSrcOffset < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
-                       adfImag))
+        GWKGetPixelRowT<T>(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
+                           adfImag))
     {
         double dfMult1 = dfRatioX * dfRatioY;
         double dfMult2 = (1.0 - dfRatioX) * dfRatioY;
@@ -2689,8 +2862,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY + 1 >= 0 && iSrcY + 1 < nSrcYSize &&
         iSrcOffset + nSrcXSize >= 0 && iSrcOffset + nSrcXSize < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset + nSrcXSize, 1, adfDensity,
-                       adfReal, adfImag))
+        GWKGetPixelRowT<T>(poWK, iBand, iSrcOffset + nSrcXSize, 1, adfDensity,
+                           adfReal, adfImag))
     {
         double dfMult1 = dfRatioX * (1.0 - dfRatioY);
         double dfMult2 = (1.0 - dfRatioX) * (1.0 - dfRatioY);
@@ -2920,6 +3093,7 @@ static bool GWKBilinearResampleNoMasks4SampleT(const GDALWarpKernel *poWK,
                            (adfCoeffs)[2] * (v)[2] + (adfCoeffs)[3] * (v)[3]))
 #endif
 
+template <class T = void>
 static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                     double dfSrcX, double dfSrcY,
                                     double *pdfDensity, double *pdfReal,
@@ -2939,8 +3113,8 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get the bilinear interpolation at the image borders.
     if (iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize || iSrcY - 1 < 0 ||
         iSrcY + 2 >= poWK->nSrcYSize)
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                          pdfDensity, pdfReal, pdfImag);
+        return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
+                                             pdfDensity, pdfReal, pdfImag);
 
     double adfValueDens[4] = {};
     double adfValueReal[4] = {};
@@ -2951,15 +3125,16 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
 
     for (GPtrDiff_t i = -1; i < 3; i++)
     {
-        if (!GWKGetPixelRow(poWK, iBand, iSrcOffset + i * poWK->nSrcXSize - 1,
-                            2, adfDensity, adfReal, adfImag) ||
+        if (!GWKGetPixelRowT<T>(poWK, iBand,
+                                iSrcOffset + i * poWK->nSrcXSize - 1, 2,
+                                adfDensity, adfReal, adfImag) ||
             adfDensity[0] < SRC_DENSITY_THRESHOLD ||
             adfDensity[1] < SRC_DENSITY_THRESHOLD ||
             adfDensity[2] < SRC_DENSITY_THRESHOLD ||
             adfDensity[3] < SRC_DENSITY_THRESHOLD)
         {
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                              pdfDensity, pdfReal, pdfImag);
+            return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
+                                                 pdfDensity, pdfReal, pdfImag);
         }
 
         adfValueDens[i + 1] = CONVOL4(adfCoeffsX, adfDensity);
@@ -3550,16 +3725,19 @@ struct _GWKResampleWrkStruct
 /*                    GWKResampleCreateWrkStruct()                      */
 /************************************************************************/
 
+template <class T = void>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct);
 
+template <class T = void>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
                                         double *pdfImag,
                                         GWKResampleWrkStruct *psWrkStruct);
 
+template <class T = void>
 static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
 {
     const int nXDist = (poWK->nXRadius + 1) * 2;
@@ -3600,7 +3778,7 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
 
     if (poWK->eResample == GRA_Lanczos)
     {
-        psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos;
+        psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos<T>;
 
         const double dfXScale = poWK->dfXScale;
         if (dfXScale < 1.0)
@@ -3637,7 +3815,7 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
         }
     }
     else
-        psWrkStruct->pfnGWKResample = GWKResample;
+        psWrkStruct->pfnGWKResample = GWKResample<T>;
 
     return psWrkStruct;
 }
@@ -3661,6 +3839,7 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct *psWrkStruct)
 /*                           GWKResample()                              */
 /************************************************************************/
 
+template <class T>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct)
@@ -3733,8 +3912,8 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRowT<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         // Calculate the Y weight.
@@ -3822,6 +4001,7 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
 /*                      GWKResampleOptimizedLanczos()                   */
 /************************************************************************/
 
+template <class T>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
@@ -4040,8 +4220,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRowT<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         const double dfWeight1 = padfWeightsY[j - poWK->nFiltInitY];
@@ -5560,6 +5740,7 @@ static CPLErr GWKGeneralCase(GDALWarpKernel *poWK)
 /*      General case for non-complex data types.                        */
 /************************************************************************/
 
+template <class T>
 static void GWKRealCaseThread(void *pData)
 
 {
@@ -5598,7 +5779,7 @@ static void GWKRealCaseThread(void *pData)
     GWKResampleWrkStruct *psWrkStruct = nullptr;
     if (poWK->eResample != GRA_NearestNeighbour)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        psWrkStruct = GWKResampleCreateWrkStruct<T>(poWK);
     }
     const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
         poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
@@ -5736,7 +5917,7 @@ static void GWKRealCaseThread(void *pData)
                 else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
                 {
                     double dfValueImagIgnored = 0.0;
-                    GWKBilinearResample4Sample(
+                    GWKBilinearResample4Sample<T>(
                         poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImagIgnored);
@@ -5771,7 +5952,7 @@ static void GWKRealCaseThread(void *pData)
                     else
                     {
                         double dfValueImagIgnored = 0.0;
-                        GWKCubicResample4Sample(
+                        GWKCubicResample4Sample<T>(
                             poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                             padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                             &dfValueReal, &dfValueImagIgnored);
@@ -5856,7 +6037,24 @@ static void GWKRealCaseThread(void *pData)
 
 static CPLErr GWKRealCase(GDALWarpKernel *poWK)
 {
-    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread);
+    // Instantiate the per-type variants for the data types commonly met
+    // with nodata, validity masks or alpha bands, so that the resampling
+    // kernels read the source pixels directly instead of going through the
+    // generic GWKGetPixelRow() switch for each row of the kernel.
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GByte>);
+        case GDT_UInt16:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GUInt16>);
+        case GDT_Int16:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<GInt16>);
+        case GDT_Float32:
+            return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<float>);
+        default:
+            break;
+    }
+    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread<void>);
 }
 
 /************************************************************************/
@@ -37,10 +37,13 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -68,6 +71,14 @@ struct GDALWarpPrivateData
     std::vector<int> abSuccess{};
     std::vector<double> adfDstX{};
     std::vector<double> adfDstY{};
+    // Set by CollectChunkList() when AdviseRead() has been issued for the
+    // union of the source windows of all chunks.
+    bool bWholeSourceAdvised = false;
+    // Warp plan transformer wrapping the transformer of the warp options,
+    // installed by Initialize() when WARP_PLAN=YES, and wrapped transformer.
+    void *pWarpPlanTransformerArg = nullptr;
+    GDALTransformerFunc pfnBaseTransformer = nullptr;
+    void *pBaseTransformerArg = nullptr;
 };
 
 static std::mutex gMutex{};
@@ -182,6 +193,8 @@ GDALWarpOperation::GDALWarpOperation()
 GDALWarpOperation::~GDALWarpOperation()
 
 {
+    WipeOptions();
+
     {
         std::lock_guard<std::mutex> oLock(gMutex);
         auto oItem = gMapPrivate.find(this);
@@ -191,8 +204,6 @@ GDALWarpOperation::~GDALWarpOperation()
         }
     }
 
-    WipeOptions();
-
     if (hIOMutex != nullptr)
     {
         CPLDestroyMutex(hIOMutex);
@@ -227,6 +238,15 @@ void GDALWarpOperation::WipeOptions()
         GDALDestroyWarpOptions(psOptions);
         psOptions = nullptr;
     }
+
+    GDALWarpPrivateData *privateData = GetWarpPrivateData(this);
+    if (privateData->pWarpPlanTransformerArg != nullptr)
+    {
+        GDALDestroyWarpPlanTransformer(privateData->pWarpPlanTransformerArg);
+        privateData->pWarpPlanTransformerArg = nullptr;
+        privateData->pfnBaseTransformer = nullptr;
+        privateData->pBaseTransformerArg = nullptr;
+    }
 }
 
 /************************************************************************/
@@ -620,6 +640,27 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
     }
     else
     {
+        /* --------------------------------------------------------------------
+         */
+        /*      Memoize the transformations in a warp plan if requested. */
+        /* --------------------------------------------------------------------
+         */
+        const GDALTransformerFunc pfnBaseTransformer =
+            psOptions->pfnTransformer;
+        void *const pBaseTransformerArg = psOptions->pTransformerArg;
+        if (CPLFetchBool(psOptions->papszWarpOptions, "WARP_PLAN", false) &&
+            pfnBaseTransformer != GDALWarpPlanTransform)
+        {
+            void *pWarpPlanTransformerArg = GDALCreateWarpPlanTransformer(
+                pfnBaseTransformer, pBaseTransformerArg, FALSE);
+            GDALWarpPrivateData *privateData = GetWarpPrivateData(this);
+            privateData->pWarpPlanTransformerArg = pWarpPlanTransformerArg;
+            privateData->pfnBaseTransformer = pfnBaseTransformer;
+            privateData->pBaseTransformerArg = pBaseTransformerArg;
+            psOptions->pfnTransformer = GDALWarpPlanTransform;
+            psOptions->pTransformerArg = pWarpPlanTransformerArg;
+        }
+
         psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
                                         psOptions->pfnTransformer,
                                         psOptions->pTransformerArg);
@@ -637,14 +678,14 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
         for (double dfY : {-89.9999, 89.9999})
         {
             double dfX = 0;
-            if ((GDALIsTransformer(psOptions->pTransformerArg,
+            if ((GDALIsTransformer(pBaseTransformerArg,
                                    GDAL_APPROX_TRANSFORMER_CLASS_NAME) &&
                  GDALTransformLonLatToDestApproxTransformer(
-                     psOptions->pTransformerArg, &dfX, &dfY)) ||
-                (GDALIsTransformer(psOptions->pTransformerArg,
+                     pBaseTransformerArg, &dfX, &dfY)) ||
+                (GDALIsTransformer(pBaseTransformerArg,
                                    GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME) &&
                  GDALTransformLonLatToDestGenImgProjTransformer(
-                     psOptions->pTransformerArg, &dfX, &dfY)))
+                     pBaseTransformerArg, &dfX, &dfY)))
             {
                 aDstXYSpecialPoints.emplace_back(
                     std::pair<double, double>(dfX, dfY));
@@ -653,7 +694,7 @@ CPLErr GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions)
 
         m_bIsTranslationOnPixelBoundaries =
             GDALTransformIsTranslationOnPixelBoundaries(
-                psOptions->pfnTransformer, psOptions->pTransformerArg) &&
+                pfnBaseTransformer, pBaseTransformerArg) &&
             CPLTestBool(
                 CPLGetConfigOption("GDAL_WARP_USE_TRANSLATION_OPTIM", "YES"));
         if (m_bIsTranslationOnPixelBoundaries)
@@ -886,6 +927,8 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
         dfApproxAccArea +=
             static_cast<double>(pasThisChunk->ssx) * pasThisChunk->ssy;
     }
+    GDALWarpPrivateData *privateData = GetWarpPrivateData(this);
+    privateData->bWholeSourceAdvised = false;
     if (nSrcXOff < nSrcX2Off)
     {
         const double dfTotalArea =
@@ -893,6 +936,7 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
         // This is really a gross heuristics, but should work in most cases
         if (dfApproxAccArea >= dfTotalArea * 0.80)
         {
+            privateData->bWholeSourceAdvised = true;
             GDALDataset::FromHandle(psOptions->hSrcDS)
                 ->AdviseRead(nSrcXOff, nSrcYOff, nSrcX2Off - nSrcXOff,
                              nSrcY2Off - nSrcYOff, nDstXSize, nDstYSize,
@@ -902,6 +946,319 @@ void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
     }
 }
 
+/************************************************************************/
+/*                          AdviseReadChunk()                           */
+/************************************************************************/
+
+// Let the source driver know about the source window of a chunk before it
+// is read, so that it can fetch it in as few requests as possible (e.g.
+// multi-range requests on cloud storage). This is a no-op when the
+// window of the whole warp was already advised by CollectChunkList().
+static void AdviseReadChunk(const GDALWarpOptions *psOptions,
+                            bool bWholeSourceAdvised,
+                            const GDALWarpChunk *psChunk)
+{
+    if (bWholeSourceAdvised || psChunk->ssx <= 0 || psChunk->ssy <= 0 ||
+        !CPLTestBool(CSLFetchNameValueDef(psOptions->papszWarpOptions,
+                                          "ADVISE_READ_CHUNKS", "YES")))
+        return;
+
+    GDALDataset::FromHandle(psOptions->hSrcDS)
+        ->AdviseRead(psChunk->sx, psChunk->sy, psChunk->ssx, psChunk->ssy,
+                     psChunk->dsx, psChunk->dsy, psOptions->eWorkingDataType,
+                     psOptions->nBandCount, psOptions->panSrcBands, nullptr);
+}
+
+/************************************************************************/
+/*                          GDALWarpPrefetcher                          */
+/************************************************************************/
+
+namespace
+{
+// Prefetch queue used by ChunkAndWarpMulti(). While the chunk threads are
+// busy warping, a thread loads the source windows of the following chunks
+// in the block cache of the source dataset, so that they only hit the cache
+// when their chunk is processed. The source dataset is only accessed with
+// the IO mutex held, and the chunk threads waiting for it have priority.
+// Only the bands whose reads go through the block cache are prefetched,
+// otherwise their blocks would be read twice. They are identified once the
+// first chunk has been read, as the bands that have its first block in the
+// cache. The amount of source data prefetched ahead of the last started
+// chunk, counted in native blocks, is bounded by the warp memory limit, and
+// by a quarter of the block cache size so that prefetched blocks do not
+// evict the ones being used.
+class GDALWarpPrefetcher
+{
+  public:
+    GDALWarpPrefetcher(const GDALWarpOptions *psOptions, CPLMutex *hIOMutex,
+                       const GDALWarpChunk *pasChunks, int nChunks,
+                       bool bWholeSourceAdvised);
+    ~GDALWarpPrefetcher();
+
+    void Start();
+    void SetLastStartedChunk(int iChunk);
+    void WaitingForIOMutex(bool bWaiting);
+    bool MarkChunkRead(int iChunk);
+
+  private:
+    enum class ChunkState
+    {
+        NONE,
+        PREFETCHED,
+        READ
+    };
+
+    const GDALWarpOptions *m_psOptions;
+    CPLMutex *m_hIOMutex;
+    const GDALWarpChunk *m_pasChunks;
+    const int m_nChunks;
+    const bool m_bWholeSourceAdvised;
+    GIntBig m_nMaxBytes = 0;
+    // Source bands read through the block cache
+    std::vector<GDALRasterBand *> m_apoBands{};
+
+    std::thread m_oThread{};
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    std::vector<ChunkState> m_aeState{};
+    int m_iLastStartedChunk = -1;
+    int m_iNextChunk = 0;
+    int m_nWaitingForIOMutex = 0;
+    bool m_bStop = false;
+
+    GIntBig GetChunkBytes(int iChunk) const;
+    bool FindCachedBands();
+    void Run();
+    void PrefetchChunk(int iChunk);
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALWarpPrefetcher)
+};
+
+GDALWarpPrefetcher::GDALWarpPrefetcher(const GDALWarpOptions *psOptions,
+                                       CPLMutex *hIOMutex,
+                                       const GDALWarpChunk *pasChunks,
+                                       int nChunks, bool bWholeSourceAdvised)
+    : m_psOptions(psOptions), m_hIOMutex(hIOMutex), m_pasChunks(pasChunks),
+      m_nChunks(nChunks), m_bWholeSourceAdvised(bWholeSourceAdvised),
+      m_aeState(nChunks, ChunkState::NONE)
+{
+    m_nMaxBytes = std::min(static_cast<GIntBig>(psOptions->dfWarpMemoryLimit),
+                           GDALGetCacheMax64() / 4);
+}
+
+GDALWarpPrefetcher::~GDALWarpPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bStop = true;
+    }
+    m_oCV.notify_one();
+    if (m_oThread.joinable())
+        m_oThread.join();
+}
+
+void GDALWarpPrefetcher::Start()
+{
+    m_oThread = std::thread([this]() { Run(); });
+}
+
+// Called by the main thread once the thread of a chunk has been started.
+void GDALWarpPrefetcher::SetLastStartedChunk(int iChunk)
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_iLastStartedChunk = iChunk;
+    }
+    m_oCV.notify_one();
+}
+
+// Called by a chunk thread before and after it acquires the IO mutex.
+void GDALWarpPrefetcher::WaitingForIOMutex(bool bWaiting)
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_nWaitingForIOMutex += bWaiting ? 1 : -1;
+    }
+    m_oCV.notify_one();
+}
+
+// Called by a chunk thread holding the IO mutex before it reads its source
+// window. Returns whether the window has been prefetched.
+bool GDALWarpPrefetcher::MarkChunkRead(int iChunk)
+{
+    bool bPrefetched;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        bPrefetched = m_aeState[iChunk] == ChunkState::PREFETCHED;
+        m_aeState[iChunk] = ChunkState::READ;
+    }
+    m_oCV.notify_one();
+    return bPrefetched;
+}
+
+// Size of the native blocks intersecting the source window of a chunk.
+GIntBig GDALWarpPrefetcher::GetChunkBytes(int iChunk) const
+{
+    const GDALWarpChunk *psChunk = m_pasChunks + iChunk;
+    if (psChunk->ssx <= 0 || psChunk->ssy <= 0)
+        return 0;
+    GIntBig nBytes = 0;
+    for (GDALRasterBand *poBand : m_apoBands)
+    {
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        const int nXBlocks = (psChunk->sx + psChunk->ssx - 1) / nBlockXSize -
+                             psChunk->sx / nBlockXSize + 1;
+        const int nYBlocks = (psChunk->sy + psChunk->ssy - 1) / nBlockYSize -
+                             psChunk->sy / nBlockYSize + 1;
+        nBytes += static_cast<GIntBig>(nXBlocks) * nBlockXSize * nYBlocks *
+                  nBlockYSize *
+                  GDALGetDataTypeSizeBytes(poBand->GetRasterDataType());
+    }
+    return nBytes;
+}
+
+// Wait until a chunk with a source window has been read, and fill
+// m_apoBands with the source bands that have the first block of that window
+// in the block cache. Returns false if there is no band to prefetch.
+bool GDALWarpPrefetcher::FindCachedBands()
+{
+    const GDALWarpChunk *psChunk = nullptr;
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        while (!m_bStop && psChunk == nullptr)
+        {
+            for (int i = 0; i < m_nChunks; ++i)
+            {
+                if (m_aeState[i] == ChunkState::READ &&
+                    m_pasChunks[i].ssx > 0 && m_pasChunks[i].ssy > 0)
+                {
+                    psChunk = m_pasChunks + i;
+                    break;
+                }
+            }
+            if (psChunk == nullptr)
+                m_oCV.wait(oLock);
+        }
+        if (m_bStop)
+            return false;
+    }
+
+    // The source window of a chunk is read with the IO mutex held.
+    if (!CPLAcquireMutex(m_hIOMutex, 600.0))
+        return false;
+    GDALDataset *poSrcDS = GDALDataset::FromHandle(m_psOptions->hSrcDS);
+    for (int i = 0; i < m_psOptions->nBandCount; ++i)
+    {
+        GDALRasterBand *poBand =
+            poSrcDS->GetRasterBand(m_psOptions->panSrcBands[i]);
+        if (!poBand)
+            continue;
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        if (nBlockXSize <= 0 || nBlockYSize <= 0)
+            continue;
+        GDALRasterBlock *poBlock = poBand->TryGetLockedBlockRef(
+            psChunk->sx / nBlockXSize, psChunk->sy / nBlockYSize);
+        if (poBlock)
+        {
+            poBlock->DropLock();
+            m_apoBands.push_back(poBand);
+        }
+    }
+    CPLReleaseMutex(m_hIOMutex);
+
+    CPLDebug("WARP",
+             "%d of %d source bands are read through the block cache and "
+             "will be prefetched",
+             static_cast<int>(m_apoBands.size()), m_psOptions->nBandCount);
+    return !m_apoBands.empty();
+}
+
+void GDALWarpPrefetcher::Run()
+{
+    if (!FindCachedBands())
+        return;
+
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    while (!m_bStop)
+    {
+        const int iChunk = std::max(m_iNextChunk, m_iLastStartedChunk + 1);
+        if (iChunk >= m_nChunks)
+            break;
+        GIntBig nBytesAhead = 0;
+        for (int i = m_iLastStartedChunk + 1; i <= iChunk; ++i)
+            nBytesAhead += GetChunkBytes(i);
+        if (nBytesAhead > m_nMaxBytes || m_nWaitingForIOMutex > 0)
+        {
+            m_oCV.wait(oLock);
+            continue;
+        }
+        m_iNextChunk = iChunk + 1;
+        oLock.unlock();
+
+        if (!CPLAcquireMutex(m_hIOMutex, 600.0))
+        {
+            oLock.lock();
+            break;
+        }
+        bool bPrefetch;
+        {
+            std::lock_guard<std::mutex> oStateLock(m_oMutex);
+            bPrefetch = m_aeState[iChunk] == ChunkState::NONE;
+        }
+        if (bPrefetch)
+        {
+            PrefetchChunk(iChunk);
+            std::lock_guard<std::mutex> oStateLock(m_oMutex);
+            if (m_aeState[iChunk] == ChunkState::NONE)
+                m_aeState[iChunk] = ChunkState::PREFETCHED;
+        }
+        CPLReleaseMutex(m_hIOMutex);
+
+        oLock.lock();
+    }
+}
+
+// Must be called with the IO mutex held.
+void GDALWarpPrefetcher::PrefetchChunk(int iChunk)
+{
+    const GDALWarpChunk *psChunk = m_pasChunks + iChunk;
+    if (psChunk->ssx <= 0 || psChunk->ssy <= 0)
+        return;
+    CPLDebug("WARP", "Prefetching source window of chunk %d", iChunk);
+
+    AdviseReadChunk(m_psOptions, m_bWholeSourceAdvised, psChunk);
+
+    // Errors will be reported when the chunk is read.
+    CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+    for (GDALRasterBand *poBand : m_apoBands)
+    {
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        for (int iYBlock = psChunk->sy / nBlockYSize;
+             iYBlock <= (psChunk->sy + psChunk->ssy - 1) / nBlockYSize;
+             ++iYBlock)
+        {
+            for (int iXBlock = psChunk->sx / nBlockXSize;
+                 iXBlock <= (psChunk->sx + psChunk->ssx - 1) / nBlockXSize;
+                 ++iXBlock)
+            {
+                GDALRasterBlock *poBlock =
+                    poBand->GetLockedBlockRef(iXBlock, iYBlock);
+                if (!poBlock)
+                    return;
+                poBlock->DropLock();
+            }
+        }
+    }
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                         ChunkAndWarpImage()                          */
 /************************************************************************/
@@ -958,6 +1315,8 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
     /*      information for each region.                                    */
     /* -------------------------------------------------------------------- */
     double dfPixelsProcessed = 0.0;
+    const bool bWholeSourceAdvised =
+        GetWarpPrivateData(this)->bWholeSourceAdvised;
 
     for (int iChunk = 0; pasChunkList != nullptr && iChunk < nChunkListCount;
          iChunk++)
@@ -969,6 +1328,8 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
         const double dfProgressBase = dfPixelsProcessed / dfTotalPixels;
         const double dfProgressScale = dfChunkPixels / dfTotalPixels;
 
+        AdviseReadChunk(psOptions, bWholeSourceAdvised, pasThisChunk);
+
         CPLErr eErr = WarpRegion(
             pasThisChunk->dx, pasThisChunk->dy, pasThisChunk->dsx,
             pasThisChunk->dsy, pasThisChunk->sx, pasThisChunk->sy,
@@ -1018,6 +1379,9 @@ typedef struct
     double dfProgressBase;
     double dfProgressScale;
     CPLMutex *hIOMutex;
+    bool bWholeSourceAdvised;
+    GDALWarpPrefetcher *poPrefetcher;
+    int iChunk;
 
     CPLMutex *hCondMutex;
     volatile int bIOMutexTaken;
@@ -1031,11 +1395,17 @@ static void ChunkThreadMain(void *pThreadData)
         static_cast<volatile ChunkThreadData *>(pThreadData);
 
     GDALWarpChunk *pasChunkInfo = psData->pasChunkInfo;
+    GDALWarpPrefetcher *poPrefetcher = psData->poPrefetcher;
 
     /* -------------------------------------------------------------------- */
     /*      Acquire IO mutex.                                               */
     /* -------------------------------------------------------------------- */
-    if (!CPLAcquireMutex(psData->hIOMutex, 600.0))
+    if (poPrefetcher)
+        poPrefetcher->WaitingForIOMutex(true);
+    const bool bIOMutexAcquired = CPLAcquireMutex(psData->hIOMutex, 600.0);
+    if (poPrefetcher)
+        poPrefetcher->WaitingForIOMutex(false);
+    if (!bIOMutexAcquired)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Failed to acquire IOMutex in WarpRegion().");
@@ -1051,6 +1421,15 @@ static void ChunkThreadMain(void *pThreadData)
             CPLReleaseMutex(psData->hCondMutex);
         }
 
+        // The previous chunk is being warped while we hold the IO mutex,
+        // so the latency of fetching this one is hidden behind its
+        // computation. Not needed if the prefetcher already loaded it.
+        if (!(poPrefetcher && poPrefetcher->MarkChunkRead(psData->iChunk)))
+        {
+            AdviseReadChunk(psData->poOperation->GetOptions(),
+                            psData->bWholeSourceAdvised, pasChunkInfo);
+        }
+
         psData->eErr = psData->poOperation->WarpRegion(
             pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
             pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
@@ -1123,6 +1502,25 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
     asThreadData[1].poOperation = this;
     asThreadData[1].hIOMutex = hIOMutex;
 
+    asThreadData[0].bWholeSourceAdvised =
+        GetWarpPrivateData(this)->bWholeSourceAdvised;
+    asThreadData[1].bWholeSourceAdvised =
+        asThreadData[0].bWholeSourceAdvised;
+
+    // Prefetch the source windows of the chunks following the ones being
+    // processed.
+    std::unique_ptr<GDALWarpPrefetcher> poPrefetcher;
+    if (pasChunkList != nullptr && nChunkListCount > 2 &&
+        CPLTestBool(CSLFetchNameValueDef(psOptions->papszWarpOptions,
+                                         "ADVISE_READ_CHUNKS", "YES")))
+    {
+        poPrefetcher = std::make_unique<GDALWarpPrefetcher>(
+            psOptions, hIOMutex, pasChunkList, nChunkListCount,
+            asThreadData[0].bWholeSourceAdvised);
+    }
+    asThreadData[0].poPrefetcher = poPrefetcher.get();
+    asThreadData[1].poPrefetcher = poPrefetcher.get();
+
     double dfPixelsProcessed = 0.0;
     double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
 
@@ -1150,6 +1548,7 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
             dfPixelsProcessed += dfChunkPixels;
 
             asThreadData[iThread].pasChunkInfo = pasThisChunk;
+            asThreadData[iThread].iChunk = iChunk;
 
             if (iChunk == 0)
             {
@@ -1186,6 +1585,13 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                     CPLCondWait(hCond, hCondMutex);
                 CPLReleaseMutex(hCondMutex);
             }
+
+            if (poPrefetcher)
+            {
+                poPrefetcher->SetLastStartedChunk(iChunk);
+                if (iChunk == 0)
+                    poPrefetcher->Start();
+            }
         }
 
         /* --------------------------------------------------------------------
@@ -1219,6 +1625,7 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
         if (asThreadData[iThread].hThreadHandle)
             CPLJoinThread(asThreadData[iThread].hThreadHandle);
     }
+    poPrefetcher.reset();
 
     CPLDestroyCond(hCond);
     CPLDestroyMutex(hCondMutex);
@@ -2779,17 +3186,31 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
     /*      Transform them to the input pixel coordinate space              */
     /* -------------------------------------------------------------------- */
 
-    const auto RefreshTransformer = [this]()
+    GDALTransformerFunc pfnTransformer = psOptions->pfnTransformer;
+    void *pTransformerArg = psOptions->pTransformerArg;
+    if (bTryWithCheckWithInvertProj)
+    {
+        // The results of CHECK_WITH_INVERT_PROJ=YES are not the ones
+        // memoized by the warp plan, if any: bypass it.
+        const GDALWarpPrivateData *privateData = GetWarpPrivateData(this);
+        if (privateData->pWarpPlanTransformerArg != nullptr)
+        {
+            pfnTransformer = privateData->pfnBaseTransformer;
+            pTransformerArg = privateData->pBaseTransformerArg;
+        }
+    }
+
+    const auto RefreshTransformer = [pTransformerArg]()
     {
-        if (GDALIsTransformer(psOptions->pTransformerArg,
+        if (GDALIsTransformer(pTransformerArg,
                               GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME))
         {
-            GDALRefreshGenImgProjTransformer(psOptions->pTransformerArg);
+            GDALRefreshGenImgProjTransformer(pTransformerArg);
         }
-        else if (GDALIsTransformer(psOptions->pTransformerArg,
+        else if (GDALIsTransformer(pTransformerArg,
                                    GDAL_APPROX_TRANSFORMER_CLASS_NAME))
         {
-            GDALRefreshApproxTransformer(psOptions->pTransformerArg);
+            GDALRefreshApproxTransformer(pTransformerArg);
         }
     };
 
@@ -2798,9 +3219,8 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", "YES");
         RefreshTransformer();
     }
-    int ret = psOptions->pfnTransformer(psOptions->pTransformerArg, TRUE,
-                                        nSamplePoints, padfX, padfY, padfZ,
-                                        pabSuccess);
+    int ret = pfnTransformer(pTransformerArg, TRUE, nSamplePoints, padfX,
+                             padfY, padfZ, pabSuccess);
     if (bTryWithCheckWithInvertProj)
     {
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", nullptr);
@@ -0,0 +1,623 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Warp plan transformer: memoizes the coordinate transformations
+ *           done for a given source/target geometry pair.
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_mem_cache.h"
+#include "cpl_minixml.h"
+
+/************************************************************************/
+/* ==================================================================== */
+/*                             GDALWarpPlan                             */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+
+// Lookup key of one call to the base transformer: its direction, its
+// number of points, the Y input of its first point (the row, for the
+// per-scanline calls of the warper) and a 128-bit digest of all its input
+// coordinates. Two different calls may share a key: a match must be
+// confirmed against the input coordinates stored in GDALWarpPlanBatch.
+struct GDALWarpPlanKey
+{
+    std::uint64_t nDigest1 = 0;
+    std::uint64_t nDigest2 = 0;
+    double dfY0 = 0;
+    int nPointCount = 0;
+    bool bDstToSrc = false;
+
+    bool operator==(const GDALWarpPlanKey &other) const
+    {
+        return nDigest1 == other.nDigest1 && nDigest2 == other.nDigest2 &&
+               memcmp(&dfY0, &other.dfY0, sizeof(dfY0)) == 0 &&
+               nPointCount == other.nPointCount &&
+               bDstToSrc == other.bDstToSrc;
+    }
+};
+
+struct GDALWarpPlanKeyHash
+{
+    size_t operator()(const GDALWarpPlanKey &oKey) const
+    {
+        return static_cast<size_t>(oKey.nDigest1);
+    }
+};
+
+// Input coordinates and result of one call to the base transformer.
+struct GDALWarpPlanBatch
+{
+    std::vector<double> adfInX{};
+    std::vector<double> adfInY{};
+    std::vector<double> adfInZ{};
+    bool bHasZ = false;
+
+    int bRet = FALSE;
+    std::vector<double> adfX{};
+    std::vector<double> adfY{};
+    std::vector<double> adfZ{};
+    std::vector<int> anSuccess{};
+};
+
+// All the transformations done so far for a given base transformer, looked
+// up by the GDALWarpPlanKey of each call. The warper
+// always issues the same calls (sampling of the source window, then one
+// call per target scanline) for a given target window, so repeated warps
+// of same-shaped data into the same target grid are all hits.
+struct GDALWarpPlan
+{
+    std::mutex oMutex{};
+    std::unordered_map<GDALWarpPlanKey, std::shared_ptr<GDALWarpPlanBatch>,
+                       GDALWarpPlanKeyHash>
+        oMapBatches{};
+    size_t nMemoryUsage = 0;
+};
+
+/************************************************************************/
+/*                            ComputeKey()                              */
+/************************************************************************/
+
+static inline std::uint64_t MixDigest(std::uint64_t nVal)
+{
+    // Finalizer of splitmix64
+    nVal ^= nVal >> 30;
+    nVal *= UINT64_C(0xbf58476d1ce4e5b9);
+    nVal ^= nVal >> 27;
+    nVal *= UINT64_C(0x94d049bb133111eb);
+    nVal ^= nVal >> 31;
+    return nVal;
+}
+
+static void UpdateDigest(std::uint64_t &nDigest1, std::uint64_t &nDigest2,
+                         const double *padfValues, int nCount)
+{
+    for (int i = 0; i < nCount; ++i)
+    {
+        std::uint64_t nVal;
+        memcpy(&nVal, padfValues + i, sizeof(nVal));
+        nDigest1 = MixDigest(nDigest1 ^ nVal) + UINT64_C(0x9e3779b97f4a7c15);
+        nDigest2 = (nDigest2 ^ nVal) * UINT64_C(0x100000001b3) +
+                   (nDigest2 >> 29);
+    }
+}
+
+static GDALWarpPlanKey ComputeKey(int bDstToSrc, int nPointCount,
+                                  const double *x, const double *y,
+                                  const double *z)
+{
+    GDALWarpPlanKey oKey;
+    oKey.bDstToSrc = bDstToSrc != FALSE;
+    oKey.nPointCount = nPointCount;
+    oKey.dfY0 = y[0];
+    std::uint64_t nDigest1 = static_cast<std::uint64_t>(nPointCount);
+    std::uint64_t nDigest2 = UINT64_C(0xcbf29ce484222325) ^ (z ? 1 : 0);
+    UpdateDigest(nDigest1, nDigest2, x, nPointCount);
+    UpdateDigest(nDigest1, nDigest2, y, nPointCount);
+    if (z)
+        UpdateDigest(nDigest1, nDigest2, z, nPointCount);
+    oKey.nDigest1 = MixDigest(nDigest1);
+    oKey.nDigest2 = MixDigest(nDigest2);
+    return oKey;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                         GetWarpPlanCache()                           */
+/************************************************************************/
+
+static std::mutex gWarpPlanCacheMutex;
+
+static lru11::Cache<std::string, std::shared_ptr<GDALWarpPlan>> &
+GetWarpPlanCache()
+{
+    static lru11::Cache<std::string, std::shared_ptr<GDALWarpPlan>> oCache(
+        std::max(1, atoi(CPLGetConfigOption("GDAL_WARP_PLAN_CACHE_SIZE",
+                                            "16"))),
+        0);
+    return oCache;
+}
+
+/************************************************************************/
+/*                         GetWarpPlanMaxMemory()                       */
+/************************************************************************/
+
+static size_t GetWarpPlanMaxMemory()
+{
+    // Memory of a single plan. Once reached, new calls are forwarded to the
+    // base transformer without being recorded.
+    static const size_t nMaxMemory = static_cast<size_t>(
+        std::max(0.0, CPLAtof(CPLGetConfigOption("GDAL_WARP_PLAN_MAX_MEMORY",
+                                                 "64"))) *
+        1024 * 1024);
+    return nMaxMemory;
+}
+
+/************************************************************************/
+/*                          GetOrCreateWarpPlan()                       */
+/************************************************************************/
+
+static std::shared_ptr<GDALWarpPlan>
+GetOrCreateWarpPlan(GDALTransformerFunc pfnBaseTransformer,
+                    void *pBaseTransformArg)
+{
+    // Transformers that cannot be serialized have no stable identity, so
+    // give them a private plan.
+    std::string osKey;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        CPLXMLNode *psTree =
+            GDALSerializeTransformer(pfnBaseTransformer, pBaseTransformArg);
+        if (psTree)
+        {
+            char *pszXML = CPLSerializeXMLTree(psTree);
+            if (pszXML)
+                osKey = pszXML;
+            CPLFree(pszXML);
+            CPLDestroyXMLNode(psTree);
+        }
+    }
+    if (osKey.empty())
+        return std::make_shared<GDALWarpPlan>();
+
+    std::lock_guard<std::mutex> oLock(gWarpPlanCacheMutex);
+    auto &oCache = GetWarpPlanCache();
+    std::shared_ptr<GDALWarpPlan> poPlan;
+    if (!oCache.tryGet(osKey, poPlan))
+    {
+        poPlan = std::make_shared<GDALWarpPlan>();
+        oCache.insert(osKey, poPlan);
+    }
+    return poPlan;
+}
+
+/************************************************************************/
+/*                        GDALClearWarpPlanCache()                      */
+/************************************************************************/
+
+/**
+ * Empty the global cache of warp plans.
+ *
+ * Transformers created by GDALCreateWarpPlanTransformer() that are still
+ * alive keep their plan.
+ *
+ * @since GDAL 3.10
+ */
+void GDALClearWarpPlanCache()
+{
+    std::lock_guard<std::mutex> oLock(gWarpPlanCacheMutex);
+    GetWarpPlanCache().clear();
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                       GDALWarpPlanTransformer                        */
+/* ==================================================================== */
+/************************************************************************/
+
+namespace
+{
+struct GDALWarpPlanTransformInfo
+{
+    GDALTransformerInfo sTI;
+
+    GDALTransformerFunc pfnBaseTransformer = nullptr;
+    void *pBaseTransformArg = nullptr;
+    bool bOwnBaseTransformer = false;
+
+    std::shared_ptr<GDALWarpPlan> poPlan{};
+
+    // Destination geotransform of the base transformer when the plan was
+    // attached, if it is a GenImgProj transformer (possibly wrapped by an
+    // approximate transformer), which can be changed afterwards with
+    // GDALSetGenImgProjTransformerDstGeoTransform().
+    bool bHasDstGeoTransform = false;
+    double adfDstGeoTransform[6] = {0, 0, 0, 0, 0, 0};
+
+    GDALWarpPlanTransformInfo() : sTI()
+    {
+        memset(&sTI, 0, sizeof(sTI));
+    }
+
+    GDALWarpPlanTransformInfo(const GDALWarpPlanTransformInfo &) = delete;
+    GDALWarpPlanTransformInfo &
+    operator=(const GDALWarpPlanTransformInfo &) = delete;
+};
+}  // namespace
+
+static CPLXMLNode *GDALSerializeWarpPlanTransformer(void *pTransformArg);
+static void *GDALCreateSimilarWarpPlanTransformer(void *hTransformArg,
+                                                  double dfSrcRatioX,
+                                                  double dfSrcRatioY);
+
+/************************************************************************/
+/*                        GetBaseDstGeoTransform()                      */
+/************************************************************************/
+
+static bool GetBaseDstGeoTransform(void *pBaseTransformArg,
+                                   double *padfGeoTransform)
+{
+    if (!GDALIsTransformer(pBaseTransformArg,
+                           GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME) &&
+        !GDALIsTransformer(pBaseTransformArg,
+                           GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+    {
+        return false;
+    }
+    padfGeoTransform[1] = std::numeric_limits<double>::quiet_NaN();
+    GDALGetTransformerDstGeoTransform(pBaseTransformArg, padfGeoTransform);
+    return !std::isnan(padfGeoTransform[1]);
+}
+
+/************************************************************************/
+/*                GDALCreateWarpPlanTransformerInternal()               */
+/************************************************************************/
+
+static void *
+GDALCreateWarpPlanTransformerInternal(GDALTransformerFunc pfnBaseTransformer,
+                                      void *pBaseTransformArg,
+                                      bool bOwnBaseTransformer,
+                                      std::shared_ptr<GDALWarpPlan> poPlan)
+{
+    auto psInfo = new GDALWarpPlanTransformInfo();
+    memcpy(psInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
+           strlen(GDAL_GTI2_SIGNATURE));
+    psInfo->sTI.pszClassName = GDAL_WARP_PLAN_TRANSFORMER_CLASS_NAME;
+    psInfo->sTI.pfnTransform = GDALWarpPlanTransform;
+    psInfo->sTI.pfnCleanup = GDALDestroyWarpPlanTransformer;
+    psInfo->sTI.pfnSerialize = GDALSerializeWarpPlanTransformer;
+    psInfo->sTI.pfnCreateSimilar = GDALCreateSimilarWarpPlanTransformer;
+
+    psInfo->pfnBaseTransformer = pfnBaseTransformer;
+    psInfo->pBaseTransformArg = pBaseTransformArg;
+    psInfo->bOwnBaseTransformer = bOwnBaseTransformer;
+    psInfo->poPlan = std::move(poPlan);
+    psInfo->bHasDstGeoTransform =
+        GetBaseDstGeoTransform(pBaseTransformArg, psInfo->adfDstGeoTransform);
+
+    return psInfo;
+}
+
+/************************************************************************/
+/*                    GDALCreateWarpPlanTransformer()                   */
+/************************************************************************/
+
+/**
+ * Create a transformer that memoizes the results of another one.
+ *
+ * Each call is looked up by its direction and a digest of its input
+ * coordinates, and a recorded result is only reused if its input
+ * coordinates are bitwise identical to the ones of the call. The
+ * recorded calls (the "warp plan") are shared by all warp plan
+ * transformers whose base transformers serialize to the same XML, through a
+ * global LRU cache of GDAL_WARP_PLAN_CACHE_SIZE plans (default 16).
+ *
+ * This is typically useful when warping many source datasets of the same
+ * shape and georeferencing into the same target grid (e.g. tile services),
+ * where GDALWarpOperation always issues the same transformations: the
+ * source window computation and the per-scanline source coordinates of the
+ * kernel are then only computed once. The base transformer is typically
+ * the one returned by GDALCreateGenImgProjTransformer2(), possibly wrapped
+ * by GDALCreateApproxTransformer().
+ *
+ * The memory used by a single plan is limited by the
+ * GDAL_WARP_PLAN_MAX_MEMORY configuration option, in megabytes (default 64).
+ * Calls beyond that limit are forwarded to the base transformer.
+ *
+ * @param pfnBaseTransformer base transformer function.
+ * @param pBaseTransformArg base transformer argument.
+ * @param bOwnBaseTransformer whether the base transformer must be destroyed
+ * by GDALDestroyWarpPlanTransformer().
+ *
+ * @return transformer argument suitable for use with
+ * GDALWarpPlanTransform(), to be destroyed with
+ * GDALDestroyWarpPlanTransformer().
+ *
+ * @since GDAL 3.10
+ */
+void *GDALCreateWarpPlanTransformer(GDALTransformerFunc pfnBaseTransformer,
+                                    void *pBaseTransformArg,
+                                    int bOwnBaseTransformer)
+{
+    VALIDATE_POINTER1(pfnBaseTransformer, "GDALCreateWarpPlanTransformer",
+                      nullptr);
+
+    return GDALCreateWarpPlanTransformerInternal(
+        pfnBaseTransformer, pBaseTransformArg, CPL_TO_BOOL(bOwnBaseTransformer),
+        GetOrCreateWarpPlan(pfnBaseTransformer, pBaseTransformArg));
+}
+
+/************************************************************************/
+/*                    GDALGetWarpPlanBaseTransformer()                  */
+/************************************************************************/
+
+/** Return the base transformer argument of a warp plan transformer. */
+void *GDALGetWarpPlanBaseTransformer(void *pTransformArg)
+{
+    return static_cast<GDALWarpPlanTransformInfo *>(pTransformArg)
+        ->pBaseTransformArg;
+}
+
+/************************************************************************/
+/*                   GDALDestroyWarpPlanTransformer()                   */
+/************************************************************************/
+
+/**
+ * Destroy a transformer created by GDALCreateWarpPlanTransformer().
+ *
+ * @since GDAL 3.10
+ */
+void GDALDestroyWarpPlanTransformer(void *pTransformArg)
+{
+    if (pTransformArg == nullptr)
+        return;
+
+    auto psInfo = static_cast<GDALWarpPlanTransformInfo *>(pTransformArg);
+    if (psInfo->bOwnBaseTransformer)
+        GDALDestroyTransformer(psInfo->pBaseTransformArg);
+    delete psInfo;
+}
+
+/************************************************************************/
+/*                            IsSameInput()                             */
+/************************************************************************/
+
+static bool IsSameInput(const GDALWarpPlanBatch &oBatch, const double *x,
+                        const double *y, const double *z, size_t nBytes)
+{
+    return oBatch.bHasZ == (z != nullptr) &&
+           memcmp(oBatch.adfInX.data(), x, nBytes) == 0 &&
+           memcmp(oBatch.adfInY.data(), y, nBytes) == 0 &&
+           (z == nullptr || memcmp(oBatch.adfInZ.data(), z, nBytes) == 0);
+}
+
+/************************************************************************/
+/*                        GDALWarpPlanTransform()                       */
+/************************************************************************/
+
+/**
+ * Perform a transformation through a warp plan.
+ *
+ * This function matches the GDALTransformerFunc() signature.
+ *
+ * @since GDAL 3.10
+ */
+int GDALWarpPlanTransform(void *pTransformArg, int bDstToSrc, int nPointCount,
+                          double *x, double *y, double *z, int *panSuccess)
+{
+    auto psInfo = static_cast<GDALWarpPlanTransformInfo *>(pTransformArg);
+    if (nPointCount <= 0)
+        return psInfo->pfnBaseTransformer(psInfo->pBaseTransformArg, bDstToSrc,
+                                          nPointCount, x, y, z, panSuccess);
+
+    // If the destination geotransform of the base transformer has been
+    // changed since the plan was attached, the recorded results are stale:
+    // attach to the plan of the new geometry.
+    if (psInfo->bHasDstGeoTransform)
+    {
+        double adfDstGeoTransform[6];
+        GetBaseDstGeoTransform(psInfo->pBaseTransformArg, adfDstGeoTransform);
+        if (memcmp(adfDstGeoTransform, psInfo->adfDstGeoTransform,
+                   sizeof(adfDstGeoTransform)) != 0)
+        {
+            memcpy(psInfo->adfDstGeoTransform, adfDstGeoTransform,
+                   sizeof(adfDstGeoTransform));
+            psInfo->poPlan = GetOrCreateWarpPlan(psInfo->pfnBaseTransformer,
+                                                 psInfo->pBaseTransformArg);
+        }
+    }
+
+    const size_t nBytes = sizeof(double) * nPointCount;
+    const GDALWarpPlanKey oKey = ComputeKey(bDstToSrc, nPointCount, x, y, z);
+    // Inputs and outputs of x, y and z, and panSuccess.
+    const size_t nBatchMemory = sizeof(GDALWarpPlanKey) +
+                                sizeof(GDALWarpPlanBatch) +
+                                2 * (z ? 3 : 2) * nBytes +
+                                sizeof(int) * nPointCount;
+
+    GDALWarpPlan *poPlan = psInfo->poPlan.get();
+    bool bRecord;
+    {
+        std::lock_guard<std::mutex> oLock(poPlan->oMutex);
+        const auto oIter = poPlan->oMapBatches.find(oKey);
+        if (oIter != poPlan->oMapBatches.end())
+        {
+            const GDALWarpPlanBatch &oBatch = *(oIter->second);
+            if (IsSameInput(oBatch, x, y, z, nBytes))
+            {
+                memcpy(x, oBatch.adfX.data(), nBytes);
+                memcpy(y, oBatch.adfY.data(), nBytes);
+                if (z)
+                    memcpy(z, oBatch.adfZ.data(), nBytes);
+                memcpy(panSuccess, oBatch.anSuccess.data(),
+                       sizeof(int) * nPointCount);
+                return oBatch.bRet;
+            }
+            // Digest collision: this is a miss, and the recorded call
+            // is kept.
+            bRecord = false;
+        }
+        else
+        {
+            bRecord = poPlan->nMemoryUsage + nBatchMemory <=
+                      GetWarpPlanMaxMemory();
+        }
+    }
+
+    // The base transformer works in place: save the input coordinates of
+    // the call before invoking it.
+    std::shared_ptr<GDALWarpPlanBatch> poBatch;
+    if (bRecord)
+    {
+        poBatch = std::make_shared<GDALWarpPlanBatch>();
+        poBatch->adfInX.assign(x, x + nPointCount);
+        poBatch->adfInY.assign(y, y + nPointCount);
+        if (z)
+            poBatch->adfInZ.assign(z, z + nPointCount);
+        poBatch->bHasZ = z != nullptr;
+    }
+
+    const int bRet =
+        psInfo->pfnBaseTransformer(psInfo->pBaseTransformArg, bDstToSrc,
+                                   nPointCount, x, y, z, panSuccess);
+
+    if (!poBatch)
+        return bRet;
+
+    std::lock_guard<std::mutex> oLock(poPlan->oMutex);
+    if (poPlan->nMemoryUsage + nBatchMemory <= GetWarpPlanMaxMemory())
+    {
+        poBatch->bRet = bRet;
+        poBatch->adfX.assign(x, x + nPointCount);
+        poBatch->adfY.assign(y, y + nPointCount);
+        if (z)
+            poBatch->adfZ.assign(z, z + nPointCount);
+        poBatch->anSuccess.assign(panSuccess, panSuccess + nPointCount);
+        if (poPlan->oMapBatches.emplace(oKey, std::move(poBatch)).second)
+        {
+            poPlan->nMemoryUsage += nBatchMemory;
+        }
+    }
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                GDALCreateSimilarWarpPlanTransformer()                */
+/************************************************************************/
+
+static void *GDALCreateSimilarWarpPlanTransformer(void *hTransformArg,
+                                                  double dfSrcRatioX,
+                                                  double dfSrcRatioY)
+{
+    auto psInfo = static_cast<GDALWarpPlanTransformInfo *>(hTransformArg);
+
+    void *pBaseTransformArg = GDALCreateSimilarTransformer(
+        psInfo->pBaseTransformArg, dfSrcRatioX, dfSrcRatioY);
+    if (pBaseTransformArg == nullptr)
+        return nullptr;
+
+    if (dfSrcRatioX == 1.0 && dfSrcRatioY == 1.0)
+    {
+        // Same geometry: share the plan, which avoids re-serializing the
+        // base transformer, e.g. when the warp kernel clones the
+        // transformer for each of its threads.
+        return GDALCreateWarpPlanTransformerInternal(
+            psInfo->pfnBaseTransformer, pBaseTransformArg, true,
+            psInfo->poPlan);
+    }
+
+    return GDALCreateWarpPlanTransformer(psInfo->pfnBaseTransformer,
+                                         pBaseTransformArg, TRUE);
+}
+
+/************************************************************************/
+/*                  GDALSerializeWarpPlanTransformer()                  */
+/************************************************************************/
+
+static CPLXMLNode *GDALSerializeWarpPlanTransformer(void *pTransformArg)
+{
+    auto psInfo = static_cast<GDALWarpPlanTransformInfo *>(pTransformArg);
+
+    CPLXMLNode *psTree =
+        CPLCreateXMLNode(nullptr, CXT_Element, "WarpPlanTransformer");
+
+    CPLXMLNode *psTransformerContainer =
+        CPLCreateXMLNode(psTree, CXT_Element, "BaseTransformer");
+
+    CPLXMLNode *psTransformer = GDALSerializeTransformer(
+        psInfo->pfnBaseTransformer, psInfo->pBaseTransformArg);
+    if (psTransformer != nullptr)
+        CPLAddXMLChild(psTransformerContainer, psTransformer);
+
+    return psTree;
+}
+
+/************************************************************************/
+/*                 GDALDeserializeWarpPlanTransformer()                 */
+/************************************************************************/
+
+void *GDALDeserializeWarpPlanTransformer(CPLXMLNode *psTree)
+{
+    GDALTransformerFunc pfnBaseTransform = nullptr;
+    void *pBaseTransformArg = nullptr;
+
+    CPLXMLNode *psContainer = CPLGetXMLNode(psTree, "BaseTransformer");
+
+    if (psContainer != nullptr && psContainer->psChild != nullptr)
+    {
+        GDALDeserializeTransformer(psContainer->psChild, &pfnBaseTransform,
+                                   &pBaseTransformArg);
+    }
+
+    if (pfnBaseTransform == nullptr)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot get base transform for warp plan transformer.");
+        return nullptr;
+    }
+
+    return GDALCreateWarpPlanTransformer(pfnBaseTransform, pBaseTransformArg,
+                                         TRUE);
+}
@@ -56,6 +56,15 @@ class ContourGenerator
         std::fill(previousLine_.begin(), previousLine_.end(), NaN);
     }
 
+    // Start the generation at line lineIdx, previousLine being the content
+    // of line lineIdx - 1. This is used to process a horizontal strip of
+    // a raster independently of the lines above it.
+    void setStartLine(size_t lineIdx, const double *previousLine)
+    {
+        lineIdx_ = lineIdx;
+        std::copy(previousLine, previousLine + width_, previousLine_.begin());
+    }
+
     CPLErr feedLine(const double *line)
     {
         if (lineIdx_ <= height_)
@@ -68,7 +68,12 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
                     debug("remaining unclosed contour");
             }
         }
-        // write all remaining (non-closed) lines
+        emitRemainingLines();
+    }
+
+    // write all remaining (non-closed) lines
+    void emitRemainingLines()
+    {
         for (auto it = lines_.begin(); it != lines_.end(); ++it)
         {
             const int levelIdx = it->first;
@@ -79,6 +84,7 @@ template <typename LineWriter, typename LevelGenerator> struct SegmentMerger
                 it->second.pop_front();
             }
         }
+        lines_.clear();
     }
 
     void addBorderSegment(int levelIdx, const Point &start, const Point &end)
@@ -47,9 +47,12 @@
 #include "ogr_core.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "polygonize_polygonizer.h"
 
@@ -81,6 +84,567 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
     return CE_None;
 }
 
+/*
+ * Multi-threaded polygonization
+ *
+ * The raster is split into horizontal strips, which are labelled and traced
+ * independently (and in parallel) by batches of one strip per thread. The
+ * polygons inside a strip are converted to OGR polygons by the thread that
+ * traces the strip. The polygons touching the first or last line of a
+ * strip are only parts of raster polygons: they are kept as rings, and
+ * merged with the connected parts of the neighbouring strips, in the main
+ * thread. Once none of the parts of a raster polygon touches the last line
+ * of the strips processed so far, the rings of its parts are stitched and
+ * the polygon is written, after the polygons inside the strip. Features are
+ * thus written strip by strip, with the same geometries and values as when
+ * tracing the whole raster at once, but in a different order.
+ */
+
+namespace
+{
+
+/************************************************************************/
+/*                         GDALPolygonizeJob                            */
+/************************************************************************/
+
+template <class DataType> struct GDALPolygonizeJob
+{
+    int nXSize = 0;
+    int nConnectedness = 0;
+    int nYOff = 0;
+    int nYSize = 0;
+    bool bTopSeam = false;
+    bool bBottomSeam = false;
+    const double *padfGeoTransform = nullptr;
+    // Pixel values, with masked pixels set to GP_NODATA_MARKER.
+    DataType *panVal = nullptr;
+    bool bOK = true;
+
+    // Polygons inside the strip, and parts of polygons.
+    std::unique_ptr<StripPolygonCollector<DataType>> poCollector{};
+    // Part index of the pixels of the first and last lines, or -1.
+    std::vector<int> anTopPart{};
+    std::vector<int> anBottomPart{};
+};
+
+/************************************************************************/
+/*                        GDALPolygonizeContext                         */
+/************************************************************************/
+
+// Parts of polygons waiting for the parts of the next strips.
+template <class DataType> struct GDALPolygonizeContext
+{
+    using Part = typename StripPolygonCollector<DataType>::Part;
+
+    std::vector<Part> asParts{};
+    // Union-find parent of the parts.
+    std::vector<int> anParent{};
+    // Next part of the same polygon, in a circular list.
+    std::vector<int> anNext{};
+
+    // Part index, and pixel value, of the last line of the previous strip.
+    std::vector<int> anAboveBorder{};
+    std::vector<DataType> anAboveVal{};
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALPolygonizeTraceStrip()                      */
+/*                                                                      */
+/*      Label and trace a strip, like GDALPolygonizeT() does for the    */
+/*      whole raster, with rows numbered in the raster.                 */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool GDALPolygonizeTraceStrip(GDALPolygonizeJob<DataType> *psJob)
+{
+    const int nXSize = psJob->nXSize;
+    const int nYSize = psJob->nYSize;
+    const size_t nLineSize = static_cast<size_t>(nXSize);
+    std::vector<GInt32> anLastLineId(nXSize);
+    std::vector<GInt32> anThisLineId(nXSize);
+
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oFirstEnum(
+        psJob->nConnectedness);
+    for (int iY = 0; iY < nYSize; iY++)
+    {
+        DataType *panThisLineVal = psJob->panVal + iY * nLineSize;
+        if (!(iY == 0 ? oFirstEnum.ProcessLine(nullptr, panThisLineVal, nullptr,
+                                               anThisLineId.data(), nXSize)
+                      : oFirstEnum.ProcessLine(panThisLineVal - nLineSize,
+                                               panThisLineVal,
+                                               anLastLineId.data(),
+                                               anThisLineId.data(), nXSize)))
+        {
+            return false;
+        }
+        std::swap(anLastLineId, anThisLineId);
+    }
+    oFirstEnum.CompleteMerges();
+
+    GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
+        psJob->nConnectedness);
+    psJob->poCollector = std::make_unique<StripPolygonCollector<DataType>>(
+        psJob->nYOff, nYSize, psJob->bTopSeam, psJob->bBottomSeam,
+        psJob->padfGeoTransform);
+    Polygonizer<GInt32, DataType> oPolygonizer{-1, psJob->poCollector.get()};
+    std::vector<TwoArm> aoLastLineArm(nXSize + 2);
+    std::vector<TwoArm> aoThisLineArm(nXSize + 2);
+    for (auto &oArm : aoLastLineArm)
+        oArm.poPolyInside = oPolygonizer.getTheOuterPolygon();
+
+    // Final polygon ids of the first and last lines.
+    std::vector<GInt32> anTopId;
+    std::vector<GInt32> anBottomId;
+
+    for (int iY = 0; iY < nYSize + 1; iY++)
+    {
+        DataType *panThisLineVal = psJob->panVal + iY * nLineSize;
+        DataType *panLastLineVal =
+            iY > 0 ? panThisLineVal - nLineSize : nullptr;
+        if (iY == nYSize)
+        {
+            for (int iX = 0; iX < nXSize; iX++)
+                anThisLineId[iX] = decltype(oPolygonizer)::THE_OUTER_POLYGON_ID;
+            oPolygonizer.processLine(anThisLineId.data(), panLastLineVal,
+                                     aoThisLineArm.data(), aoLastLineArm.data(),
+                                     psJob->nYOff + iY, nXSize);
+            break;
+        }
+
+        if (!(iY == 0 ? oSecondEnum.ProcessLine(nullptr, panThisLineVal,
+                                                nullptr, anThisLineId.data(),
+                                                nXSize)
+                      : oSecondEnum.ProcessLine(panLastLineVal, panThisLineVal,
+                                                anLastLineId.data(),
+                                                anThisLineId.data(), nXSize)))
+        {
+            return false;
+        }
+
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            anLastLineId[iX] = anThisLineId[iX] == -1
+                                   ? -1
+                                   : oFirstEnum.panPolyIdMap[anThisLineId[iX]];
+        }
+        if (iY == 0)
+            anTopId = anLastLineId;
+        if (iY == nYSize - 1)
+            anBottomId = anLastLineId;
+
+        oPolygonizer.processLine(anLastLineId.data(), panLastLineVal,
+                                 aoThisLineArm.data(), aoLastLineArm.data(),
+                                 psJob->nYOff + iY, nXSize);
+
+        std::swap(anLastLineId, anThisLineId);
+        std::swap(aoThisLineArm, aoLastLineArm);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Find the part of the pixels of the first and last lines.        */
+    /* -------------------------------------------------------------------- */
+    const auto &aoParts = psJob->poCollector->aoParts;
+    std::vector<int> anIdToPart(oFirstEnum.nNextPolygonId, -1);
+    for (int iPart = 0; iPart < static_cast<int>(aoParts.size()); iPart++)
+    {
+        const auto &oPart = aoParts[iPart];
+        if (oPart.bTop)
+            anIdToPart[anTopId[oPart.aoRings[0][0][1]]] = iPart;
+        if (oPart.bBottom)
+            anIdToPart[anBottomId[oPart.iBottomRightCol]] = iPart;
+    }
+    const auto GetLineParts = [&anIdToPart](const std::vector<GInt32> &anId,
+                                            std::vector<int> &anPart)
+    {
+        anPart.resize(anId.size());
+        for (size_t i = 0; i < anId.size(); i++)
+            anPart[i] = anId[i] >= 0 ? anIdToPart[anId[i]] : -1;
+    };
+    if (psJob->bTopSeam)
+        GetLineParts(anTopId, psJob->anTopPart);
+    if (psJob->bBottomSeam)
+        GetLineParts(anBottomId, psJob->anBottomPart);
+
+    return true;
+}
+
+template <class DataType, class EqualityTest>
+static void GDALPolygonizeStripJob(void *pData)
+{
+    GDALPolygonizeJob<DataType> *psJob =
+        static_cast<GDALPolygonizeJob<DataType> *>(pData);
+    try
+    {
+        if (!GDALPolygonizeTraceStrip<DataType, EqualityTest>(psJob))
+            psJob->bOK = false;
+    }
+    catch (const std::exception &)
+    {
+        psJob->bOK = false;
+    }
+}
+
+/************************************************************************/
+/*                       GDALPolygonizeFindPart()                       */
+/************************************************************************/
+
+static int GDALPolygonizeFindPart(std::vector<int> &anParent, int iPart)
+{
+    while (anParent[iPart] != iPart)
+    {
+        anParent[iPart] = anParent[anParent[iPart]];
+        iPart = anParent[iPart];
+    }
+    return iPart;
+}
+
+/************************************************************************/
+/*                     GDALPolygonizeMergeStrip()                       */
+/*                                                                      */
+/*      Write the polygons inside a strip, merge its parts of polygons  */
+/*      with the connected ones of the strip above, and write the       */
+/*      polygons which have no part on the last line of the strip.      */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static bool GDALPolygonizeMergeStrip(GDALPolygonizeContext<DataType> &sCtxt,
+                                     GDALPolygonizeJob<DataType> &sJob,
+                                     OGRPolygonWriter<DataType> &oWriter,
+                                     int nStripYSize)
+{
+    auto &aoPolygons = sJob.poCollector->aoPolygons;
+    for (size_t i = 0; i < aoPolygons.size(); i++)
+    {
+        oWriter.write(aoPolygons[i].first, aoPolygons[i].second);
+        aoPolygons[i].first = nullptr;
+        if (oWriter.getErr() != CE_None)
+        {
+            for (; i < aoPolygons.size(); i++)
+                OGR_G_DestroyGeometry(aoPolygons[i].first);
+            aoPolygons.clear();
+            return false;
+        }
+    }
+    aoPolygons.clear();
+
+    auto &aoParts = sJob.poCollector->aoParts;
+    const int nPartOffset = static_cast<int>(sCtxt.asParts.size());
+    // Polygons which may be complete: the ones with a part on the last line
+    // of the strip above, or a part in this strip.
+    std::vector<int> anCandidates;
+    for (const int iPart : sCtxt.anAboveBorder)
+    {
+        if (iPart >= 0)
+            anCandidates.push_back(iPart);
+    }
+    for (int i = 0; i < static_cast<int>(aoParts.size()); i++)
+    {
+        sCtxt.asParts.push_back(std::move(aoParts[i]));
+        sCtxt.anParent.push_back(nPartOffset + i);
+        sCtxt.anNext.push_back(nPartOffset + i);
+        anCandidates.push_back(nPartOffset + i);
+    }
+    aoParts.clear();
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge the parts of the first line with the connected parts of   */
+    /*      the last line of the strip above.                               */
+    /* -------------------------------------------------------------------- */
+    const int nXSize = sJob.nXSize;
+    if (sJob.bTopSeam)
+    {
+        EqualityTest oEquals;
+        const DataType *panThisLineVal = sJob.panVal;
+        const auto Merge = [&](int iAbove, int iX)
+        {
+            const int iAbovePart = sCtxt.anAboveBorder[iAbove];
+            if (iAbovePart < 0 ||
+                !oEquals(sCtxt.anAboveVal[iAbove], panThisLineVal[iX]))
+                return;
+            int iPart1 = GDALPolygonizeFindPart(sCtxt.anParent, iAbovePart);
+            int iPart2 = GDALPolygonizeFindPart(
+                sCtxt.anParent, nPartOffset + sJob.anTopPart[iX]);
+            if (iPart1 == iPart2)
+                return;
+            if (iPart2 < iPart1)
+                std::swap(iPart1, iPart2);
+            sCtxt.anParent[iPart2] = iPart1;
+            std::swap(sCtxt.anNext[iPart1], sCtxt.anNext[iPart2]);
+        };
+
+        const bool bEightConnected = sJob.nConnectedness == 8;
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (sJob.anTopPart[iX] < 0)
+                continue;
+            Merge(iX, iX);
+            if (bEightConnected && iX > 0)
+                Merge(iX - 1, iX);
+            if (bEightConnected && iX < nXSize - 1)
+                Merge(iX + 1, iX);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Write the polygons that are complete.                           */
+    /* -------------------------------------------------------------------- */
+    const auto GetRoots = [&sCtxt](std::vector<int> &anParts)
+    {
+        for (int &iPart : anParts)
+            iPart = GDALPolygonizeFindPart(sCtxt.anParent, iPart);
+        std::sort(anParts.begin(), anParts.end());
+        anParts.erase(std::unique(anParts.begin(), anParts.end()),
+                      anParts.end());
+    };
+    // Polygons with a part on the last line of the strip.
+    std::vector<int> anOpen;
+    for (const int iPart : sJob.anBottomPart)
+    {
+        if (iPart >= 0)
+            anOpen.push_back(nPartOffset + iPart);
+    }
+    GetRoots(anOpen);
+    GetRoots(anCandidates);
+
+    std::vector<Ring> aoRings;
+    for (const int iRoot : anCandidates)
+    {
+        if (std::binary_search(anOpen.begin(), anOpen.end(), iRoot))
+            continue;
+
+        // The value of the polygon is the one of its bottom-right most cell.
+        aoRings.clear();
+        int iLast = iRoot;
+        int iPart = iRoot;
+        do
+        {
+            auto &oPart = sCtxt.asParts[iPart];
+            const auto &oLast = sCtxt.asParts[iLast];
+            if (std::make_pair(oPart.iBottomRightRow, oPart.iBottomRightCol) >
+                std::make_pair(oLast.iBottomRightRow, oLast.iBottomRightCol))
+                iLast = iPart;
+            for (auto &oRing : oPart.aoRings)
+                aoRings.push_back(std::move(oRing));
+            oPart.aoRings.clear();
+            oPart.aoRings.shrink_to_fit();
+            iPart = sCtxt.anNext[iPart];
+        } while (iPart != iRoot);
+
+        StitchRings(aoRings, static_cast<IndexType>(nStripYSize));
+        oWriter.write(CreateOGRPolygon(aoRings, sJob.padfGeoTransform),
+                      sCtxt.asParts[iLast].nValue);
+        if (oWriter.getErr() != CE_None)
+            return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Keep the parts and values of the last line for the next strip.  */
+    /* -------------------------------------------------------------------- */
+    if (sJob.bBottomSeam)
+    {
+        sCtxt.anAboveBorder.resize(nXSize);
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            sCtxt.anAboveBorder[iX] = sJob.anBottomPart[iX] >= 0
+                                          ? nPartOffset + sJob.anBottomPart[iX]
+                                          : -1;
+        }
+        const DataType *panLastLineVal =
+            sJob.panVal + static_cast<size_t>(sJob.nYSize - 1) * nXSize;
+        sCtxt.anAboveVal.assign(panLastLineVal, panLastLineVal + nXSize);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALPolygonizeStrips()                        */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeStrips(GDALRasterBandH hSrcBand,
+                                   GDALRasterBandH hMaskBand,
+                                   OGRLayerH hOutLayer, int iPixValField,
+                                   int nConnectedness, int nThreads,
+                                   double *padfGeoTransform,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressArg, GDALDataType eDT)
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the height of the strips from the memory budget of      */
+    /*      a strip.  It does not depend on the number of threads, so       */
+    /*      that the output does not either, and is at least                */
+    /*      POLYGONIZE_MIN_STRIP_YSIZE lines, so that few polygons are       */
+    /*      stitched.                                                       */
+    /* -------------------------------------------------------------------- */
+    constexpr int POLYGONIZE_MIN_STRIP_YSIZE = 128;
+    // Mostly for testing: sets the budget exactly, without minimum height.
+    const char *pszMaxMemory =
+        CPLGetConfigOption("GDAL_POLYGONIZE_MAX_MEMORY", nullptr);
+    const GIntBig nMaxMemory =
+        pszMaxMemory ? std::max(static_cast<GIntBig>(1),
+                                CPLAtoGIntBig(pszMaxMemory))
+                     : static_cast<GIntBig>(32 * 1000 * 1000);
+    // Pixel values and mask, and an allowance for the polygons of the strip,
+    // which are kept until the strip is done.
+    const GIntBig nBytesPerPixel =
+        static_cast<GIntBig>(sizeof(DataType)) + (hMaskBand ? 1 : 0) + 64;
+    GIntBig nStripYSize64 =
+        nMaxMemory / (nBytesPerPixel * std::max(1, nXSize));
+    if (pszMaxMemory == nullptr)
+        nStripYSize64 = std::max(
+            nStripYSize64, static_cast<GIntBig>(POLYGONIZE_MIN_STRIP_YSIZE));
+    constexpr GIntBig MAX_INT = std::numeric_limits<int>::max();
+    int nStripYSize = static_cast<int>(std::max(
+        static_cast<GIntBig>(1),
+        std::min(static_cast<GIntBig>(nYSize),
+                 std::min(nStripYSize64, MAX_INT / std::max(1, nXSize)))));
+    int nBlockYSize = 0;
+    GDALGetBlockSize(hSrcBand, nullptr, &nBlockYSize);
+    if (nBlockYSize > 0 && nStripYSize > nBlockYSize && nStripYSize < nYSize)
+        nStripYSize = nStripYSize / nBlockYSize * nBlockYSize;
+    const int nStrips = nYSize > 0 ? (nYSize - 1) / nStripYSize + 1 : 0;
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    const int nBatchYSize = std::min(nYSize, nStripYSize * nThreads);
+    const size_t nBatchPixels = static_cast<size_t>(nXSize) * nBatchYSize;
+    std::vector<DataType> anVal;
+    std::vector<GByte> abyMask;
+    try
+    {
+        anVal.resize(nBatchPixels);
+        if (hMaskBand != nullptr)
+            abyMask.resize(nBatchPixels);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory, "%s: Out of memory",
+                 __FUNCTION__);
+        return CE_Failure;
+    }
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    if (poThreadPool)
+        poJobQueue = poThreadPool->CreateJobQueue();
+
+    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                              padfGeoTransform};
+    GDALPolygonizeContext<DataType> sCtxt;
+
+    /* -------------------------------------------------------------------- */
+    /*      Process the strips by batches of one strip per thread.  I/O     */
+    /*      and writing of the features are done in this thread.            */
+    /* -------------------------------------------------------------------- */
+    std::vector<GDALPolygonizeJob<DataType>> asJobs;
+    for (int iFirstStrip = 0; iFirstStrip < nStrips; iFirstStrip += nThreads)
+    {
+        const int nJobs = std::min(nThreads, nStrips - iFirstStrip);
+        const int nYOff = iFirstStrip * nStripYSize;
+        const int nReqYSize =
+            std::min(nYSize, (iFirstStrip + nJobs) * nStripYSize) - nYOff;
+        const size_t nReqPixels = static_cast<size_t>(nXSize) * nReqYSize;
+
+        /* ---------------------------------------------------------------- */
+        /*      Read the image data, and mask out pixels.                   */
+        /* ---------------------------------------------------------------- */
+        if (GDALRasterIO(hSrcBand, GF_Read, 0, nYOff, nXSize, nReqYSize,
+                         anVal.data(), nXSize, nReqYSize, eDT, 0,
+                         0) != CE_None)
+            return CE_Failure;
+        if (hMaskBand != nullptr)
+        {
+            if (GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize, nReqYSize,
+                             abyMask.data(), nXSize, nReqYSize, GDT_Byte, 0,
+                             0) != CE_None)
+                return CE_Failure;
+            for (size_t i = 0; i < nReqPixels; i++)
+            {
+                if (abyMask[i] == 0)
+                    anVal[i] = GP_NODATA_MARKER;
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Trace the strips.                                           */
+        /* ---------------------------------------------------------------- */
+        asJobs.clear();
+        asJobs.resize(nJobs);
+        for (int i = 0; i < nJobs; i++)
+        {
+            const int iStrip = iFirstStrip + i;
+            GDALPolygonizeJob<DataType> &sJob = asJobs[i];
+            sJob.nXSize = nXSize;
+            sJob.nConnectedness = nConnectedness;
+            sJob.nYOff = iStrip * nStripYSize;
+            sJob.nYSize = std::min(nStripYSize, nYSize - sJob.nYOff);
+            sJob.bTopSeam = iStrip > 0;
+            sJob.bBottomSeam = iStrip < nStrips - 1;
+            sJob.padfGeoTransform = padfGeoTransform;
+            sJob.panVal = anVal.data() +
+                          static_cast<size_t>(nXSize) * (sJob.nYOff - nYOff);
+        }
+
+        if (poJobQueue && nJobs > 1)
+        {
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob(
+                    GDALPolygonizeStripJob<DataType, EqualityTest>, &sJob);
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (auto &sJob : asJobs)
+                GDALPolygonizeStripJob<DataType, EqualityTest>(&sJob);
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Write the polygons, strip by strip.                         */
+        /* ---------------------------------------------------------------- */
+        for (auto &sJob : asJobs)
+        {
+            if (!sJob.bOK)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "GDALPolygonize(): out of memory");
+                return CE_Failure;
+            }
+            try
+            {
+                if (!GDALPolygonizeMergeStrip<DataType, EqualityTest>(
+                        sCtxt, sJob, oPolygonWriter, nStripYSize))
+                    return CE_Failure;
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "GDALPolygonize(): out of memory");
+                return CE_Failure;
+            }
+            sJob.poCollector.reset();
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Report progress, and support interrupts.                    */
+        /* ---------------------------------------------------------------- */
+        if (!pfnProgress((nYOff + nReqYSize) / static_cast<double>(nYSize), "",
+                         pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GDALPolygonizeT()                          */
 /************************************************************************/
@@ -102,6 +666,12 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     const int nConnectedness =
         CSLFetchNameValue(papszOptions, "8CONNECTED") ? 8 : 4;
 
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
     /* -------------------------------------------------------------------- */
     /*      Confirm our output layer will support feature creation.         */
     /* -------------------------------------------------------------------- */
@@ -113,9 +683,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate working buffers.                                       */
-    /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
     const int nYSize = GDALGetRasterBandYSize(hSrcBand);
     if (nXSize > std::numeric_limits<int>::max() - 2)
@@ -124,29 +691,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    DataType *panLastLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    DataType *panThisLineVal =
-        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
-    GInt32 *panLastLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-    GInt32 *panThisLineId =
-        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
-
-    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
-
-    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
-        panLastLineId == nullptr || panThisLineId == nullptr ||
-        pabyMaskLine == nullptr)
-    {
-        CPLFree(panThisLineId);
-        CPLFree(panLastLineId);
-        CPLFree(panThisLineVal);
-        CPLFree(panLastLineVal);
-        CPLFree(pabyMaskLine);
-        return CE_Failure;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      Get the geotransform, if there is one, so we can convert the    */
     /*      vectors into georeferenced coordinates.                         */
@@ -182,6 +726,39 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         adfGeoTransform[5] = 1;
     }
 
+    if (nThreads > 1)
+    {
+        return GDALPolygonizeStrips<DataType, EqualityTest>(
+            hSrcBand, hMaskBand, hOutLayer, iPixValField, nConnectedness,
+            nThreads, adfGeoTransform, pfnProgress, pProgressArg, eDT);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate working buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    DataType *panLastLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    DataType *panThisLineVal =
+        static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
+    GInt32 *panLastLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+    GInt32 *panThisLineId =
+        static_cast<GInt32 *>(VSI_MALLOC2_VERBOSE(sizeof(GInt32), nXSize));
+
+    GByte *pabyMaskLine = static_cast<GByte *>(VSI_MALLOC_VERBOSE(nXSize));
+
+    if (panLastLineVal == nullptr || panThisLineVal == nullptr ||
+        panLastLineId == nullptr || panThisLineId == nullptr ||
+        pabyMaskLine == nullptr)
+    {
+        CPLFree(panThisLineId);
+        CPLFree(panLastLineId);
+        CPLFree(panThisLineVal);
+        CPLFree(panLastLineVal);
+        CPLFree(pabyMaskLine);
+        return CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -491,6 +1068,13 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: number of threads used to
+ * trace polygons. Defaults to 1. With more than one thread, the raster is
+ * processed by horizontal strips of at least 128 lines, traced in parallel,
+ * and the polygons crossing strips are stitched once all their parts are
+ * traced. Features then have the same geometries and values as with one
+ * thread, but are written strip by strip, in a different order.
+ * (GDAL >= 3.10)</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -565,6 +1149,13 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS: number of threads used to
+ * trace polygons. Defaults to 1. With more than one thread, the raster is
+ * processed by horizontal strips of at least 128 lines, traced in parallel,
+ * and the polygons crossing strips are stitched once all their parts are
+ * traced. Features then have the same geometries and values as with one
+ * thread, but are written strip by strip, in a different order.
+ * (GDAL >= 3.10)</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -30,6 +30,9 @@
 #include "polygonize_polygonizer.h"
 
 #include <algorithm>
+#include <unordered_map>
+
+#include "ogr_geometry.h"
 
 namespace gdal
 {
@@ -66,6 +69,212 @@ void RPolygon::updateBottomRightPos(IndexType iRow, IndexType iCol)
     iBottomRightCol = iCol;
 }
 
+void RPolygon::getRings(std::vector<Ring> &aoRings) const
+{
+    aoRings.clear();
+    std::vector<bool> oAccessedArc(oArcConnections.size(), false);
+    for (std::size_t iFirstArcIndex = 0; iFirstArcIndex < oArcs.size();
+         ++iFirstArcIndex)
+    {
+        if (oAccessedArc[iFirstArcIndex])
+            continue;
+
+        aoRings.emplace_back();
+        Ring &oRing = aoRings.back();
+        std::size_t iArcIndex = iFirstArcIndex;
+        do
+        {
+            const Arc &oArc = *oArcs[iArcIndex];
+            if (oArcRighthandFollow[iArcIndex])
+                oRing.insert(oRing.end(), oArc.begin(), oArc.end());
+            else
+                oRing.insert(oRing.end(), oArc.rbegin(), oArc.rend());
+            oAccessedArc[iArcIndex] = true;
+            iArcIndex = oArcConnections[iArcIndex];
+        } while (iArcIndex != iFirstArcIndex);
+    }
+}
+
+/**
+ * The rings of a raster polygon are made of pixel edges, with the polygon
+ * on the left-hand side (rows going downwards). Rings of the parts of a
+ * polygon only differ from the rings of the whole polygon along the lines
+ * between strips, where the edges of the parts on both sides of the line
+ * cancel out, and at the corners where two parts touch diagonally. So
+ * the rings are cut into edges, the horizontal edges on the lines between
+ * strips into unit edges, opposite unit edges are removed and the
+ * remaining edges are linked again.
+ */
+void StitchRings(std::vector<Ring> &aoRings, IndexType nStripYSize)
+{
+    struct Edge
+    {
+        Point oStart;
+        Point oEnd;
+        bool bRemoved;
+    };
+
+    const auto GetKey = [](const Point &oPoint)
+    {
+        return (static_cast<std::uint64_t>(oPoint[0]) << 32) | oPoint[1];
+    };
+
+    std::vector<Edge> aoEdges;
+    // index of the unit edges on the lines between strips, by position of
+    // their left end
+    std::unordered_map<std::uint64_t, std::size_t> oMapSeamEdges;
+    for (const Ring &oRing : aoRings)
+    {
+        for (std::size_t i = 0; i < oRing.size(); ++i)
+        {
+            const Point &oStart = oRing[i];
+            const Point &oEnd = oRing[(i + 1) % oRing.size()];
+            if (oStart[0] != oEnd[0] || oStart[0] % nStripYSize != 0)
+            {
+                aoEdges.push_back(Edge{oStart, oEnd, false});
+                continue;
+            }
+
+            const bool bEastward = oStart[1] < oEnd[1];
+            for (IndexType iCol = oStart[1]; iCol != oEnd[1];)
+            {
+                const IndexType iNextCol = bEastward ? iCol + 1 : iCol - 1;
+                const Point oLeft{oStart[0], std::min(iCol, iNextCol)};
+                const auto oIter = oMapSeamEdges.find(GetKey(oLeft));
+                if (oIter != oMapSeamEdges.end())
+                {
+                    aoEdges[oIter->second].bRemoved = true;
+                    oMapSeamEdges.erase(oIter);
+                }
+                else
+                {
+                    oMapSeamEdges[GetKey(oLeft)] = aoEdges.size();
+                    aoEdges.push_back(Edge{Point{oStart[0], iCol},
+                                           Point{oStart[0], iNextCol}, false});
+                }
+                iCol = iNextCol;
+            }
+        }
+    }
+
+    // Direction of an edge: 0 east, 1 south, 2 west, 3 north. Turning
+    // right adds 1.
+    const auto GetDirection = [](const Edge &oEdge)
+    {
+        if (oEdge.oStart[0] == oEdge.oEnd[0])
+            return oEdge.oStart[1] < oEdge.oEnd[1] ? 0 : 2;
+        return oEdge.oStart[0] < oEdge.oEnd[0] ? 1 : 3;
+    };
+
+    // Sort the remaining edges by start point, the ones going east or
+    // south first.
+    std::vector<std::size_t> anEdges;
+    for (std::size_t i = 0; i < aoEdges.size(); ++i)
+    {
+        if (!aoEdges[i].bRemoved)
+            anEdges.push_back(i);
+    }
+    std::sort(anEdges.begin(), anEdges.end(),
+              [&aoEdges, &GetKey, &GetDirection](std::size_t i, std::size_t j)
+              {
+                  const auto nKeyI = GetKey(aoEdges[i].oStart);
+                  const auto nKeyJ = GetKey(aoEdges[j].oStart);
+                  if (nKeyI != nKeyJ)
+                      return nKeyI < nKeyJ;
+                  return GetDirection(aoEdges[i]) < GetDirection(aoEdges[j]);
+              });
+    std::vector<std::uint64_t> anStartKeys;
+    anStartKeys.reserve(anEdges.size());
+    for (std::size_t i : anEdges)
+        anStartKeys.push_back(GetKey(aoEdges[i].oStart));
+
+    // The first edge of a ring not yet visited, in the order of their
+    // start point, starts at the top-left most corner of this ring.
+    // Where two edges start from the same corner, the polygon touches
+    // itself diagonally and the ring turns right, around the other cells.
+    aoRings.clear();
+    std::vector<bool> oVisited(anEdges.size(), false);
+    for (std::size_t iFirst = 0; iFirst < anEdges.size(); ++iFirst)
+    {
+        if (oVisited[iFirst])
+            continue;
+
+        aoRings.emplace_back();
+        Ring &oRing = aoRings.back();
+        oRing.push_back(aoEdges[anEdges[iFirst]].oStart);
+        std::size_t iCur = iFirst;
+        do
+        {
+            oVisited[iCur] = true;
+            const Edge &oEdge = aoEdges[anEdges[iCur]];
+            const int nDirection = GetDirection(oEdge);
+
+            const auto nEndKey = GetKey(oEdge.oEnd);
+            auto iNext = static_cast<std::size_t>(
+                std::lower_bound(anStartKeys.begin(), anStartKeys.end(),
+                                 nEndKey) -
+                anStartKeys.begin());
+            if (iNext == anStartKeys.size() || anStartKeys[iNext] != nEndKey)
+                break;  // should not happen: the ring is not closed
+            if (iNext + 1 < anStartKeys.size() &&
+                anStartKeys[iNext + 1] == nEndKey &&
+                GetDirection(aoEdges[anEdges[iNext]]) != (nDirection + 1) % 4)
+            {
+                ++iNext;
+            }
+
+            if (oVisited[iNext] && iNext != iFirst)
+                break;  // should not happen either
+            if (iNext != iFirst &&
+                GetDirection(aoEdges[anEdges[iNext]]) != nDirection)
+            {
+                oRing.push_back(oEdge.oEnd);
+            }
+            iCur = iNext;
+        } while (iCur != iFirst);
+    }
+}
+
+OGRGeometryH CreateOGRPolygon(const std::vector<Ring> &aoRings,
+                              const double *padfGeoTransform)
+{
+    auto poOGRPolygon = new OGRPolygon();
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+
+    for (const Ring &oRing : aoRings)
+    {
+        adfX.clear();
+        adfY.clear();
+
+        for (const Point &oPixel : oRing)
+        {
+            const double dfX = padfGeoTransform[0] +
+                               oPixel[1] * padfGeoTransform[1] +
+                               oPixel[0] * padfGeoTransform[2];
+            const double dfY = padfGeoTransform[3] +
+                               oPixel[1] * padfGeoTransform[4] +
+                               oPixel[0] * padfGeoTransform[5];
+
+            adfX.push_back(dfX);
+            adfY.push_back(dfY);
+        }
+
+        // close ring manually
+        adfX.push_back(adfX[0]);
+        adfY.push_back(adfY[0]);
+
+        // Set all the points at once rather than one by one through the
+        // C API.
+        auto poRing = new OGRLinearRing();
+        poRing->setPoints(static_cast<int>(adfX.size()), adfX.data(),
+                          adfY.data());
+        poOGRPolygon->addRingDirectly(poRing);
+    }
+
+    return OGRGeometry::ToHandle(poOGRPolygon);
+}
+
 /**
  * Process different kinds of Arm connections.
  */
@@ -468,65 +677,14 @@ template <typename DataType>
 void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
                                          DataType nPolygonCellValue)
 {
-    std::vector<bool> oAccessedArc(poPolygon->oArcConnections.size(), false);
-    double *padfGeoTransform = padfGeoTransform_;
-
-    OGRGeometryH hPolygon = OGR_G_CreateGeometry(wkbPolygon);
-
-    auto AddRingToPolygon = [&poPolygon, &oAccessedArc, &hPolygon,
-                             padfGeoTransform](std::size_t iFirstArcIndex)
-    {
-        OGRGeometryH hRing = OGR_G_CreateGeometry(wkbLinearRing);
-
-        auto AddArcToRing =
-            [&poPolygon, &hRing, padfGeoTransform](std::size_t iArcIndex)
-        {
-            auto oArc = poPolygon->oArcs[iArcIndex];
-            bool bArcFollowRighthand =
-                poPolygon->oArcRighthandFollow[iArcIndex];
-            for (std::size_t i = 0; i < oArc->size(); ++i)
-            {
-                const Point &oPixel =
-                    (*oArc)[bArcFollowRighthand ? i : (oArc->size() - i - 1)];
-
-                const double dfX = padfGeoTransform[0] +
-                                   oPixel[1] * padfGeoTransform[1] +
-                                   oPixel[0] * padfGeoTransform[2];
-                const double dfY = padfGeoTransform[3] +
-                                   oPixel[1] * padfGeoTransform[4] +
-                                   oPixel[0] * padfGeoTransform[5];
-
-                OGR_G_AddPoint_2D(hRing, dfX, dfY);
-            }
-        };
-
-        AddArcToRing(iFirstArcIndex);
-
-        std::size_t iArcIndex = iFirstArcIndex;
-        std::size_t iNextArcIndex = poPolygon->oArcConnections[iArcIndex];
-        oAccessedArc[iArcIndex] = true;
-        while (iNextArcIndex != iFirstArcIndex)
-        {
-            AddArcToRing(iNextArcIndex);
-            iArcIndex = iNextArcIndex;
-            iNextArcIndex = poPolygon->oArcConnections[iArcIndex];
-            oAccessedArc[iArcIndex] = true;
-        }
-
-        // close ring manually
-        OGR_G_AddPoint_2D(hRing, OGR_G_GetX(hRing, 0), OGR_G_GetY(hRing, 0));
-
-        OGR_G_AddGeometryDirectly(hPolygon, hRing);
-    };
-
-    std::vector<bool>::iterator ite;
-    while ((ite = std::find_if_not(oAccessedArc.begin(), oAccessedArc.end(),
-                                   [](bool accessed) { return accessed; })) !=
-           oAccessedArc.end())
-    {
-        AddRingToPolygon(ite - oAccessedArc.begin());
-    }
+    poPolygon->getRings(aoRings_);
+    write(CreateOGRPolygon(aoRings_, padfGeoTransform_), nPolygonCellValue);
+}
 
+template <typename DataType>
+void OGRPolygonWriter<DataType>::write(OGRGeometryH hPolygon,
+                                       DataType nPolygonCellValue)
+{
     // Create the feature object
     OGRFeatureH hFeat = OGR_F_Create(OGR_L_GetLayerDefn(hOutLayer_));
 
@@ -543,6 +701,50 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
     OGR_F_Destroy(hFeat);
 }
 
+template <typename DataType>
+StripPolygonCollector<DataType>::StripPolygonCollector(
+    IndexType nYOff, IndexType nYSize, bool bTopSeam, bool bBottomSeam,
+    const double *padfGeoTransform)
+    : PolygonReceiver<DataType>(), nYOff_(nYOff), nYSize_(nYSize),
+      bTopSeam_(bTopSeam), bBottomSeam_(bBottomSeam),
+      padfGeoTransform_(padfGeoTransform)
+{
+}
+
+template <typename DataType>
+StripPolygonCollector<DataType>::~StripPolygonCollector()
+{
+    for (auto &oPolygon : aoPolygons)
+        OGR_G_DestroyGeometry(oPolygon.first);
+}
+
+template <typename DataType>
+void StripPolygonCollector<DataType>::receive(RPolygon *poPolygon,
+                                              DataType nPolygonCellValue)
+{
+    poPolygon->getRings(aoRings_);
+
+    // The exterior ring starts at the top-left corner of the first cell.
+    const bool bTop = bTopSeam_ && aoRings_[0][0][0] == nYOff_;
+    const bool bBottom =
+        bBottomSeam_ && poPolygon->iBottomRightRow + 1 == nYOff_ + nYSize_;
+    if (!bTop && !bBottom)
+    {
+        aoPolygons.emplace_back(
+            CreateOGRPolygon(aoRings_, padfGeoTransform_), nPolygonCellValue);
+        return;
+    }
+
+    Part oPart;
+    std::swap(oPart.aoRings, aoRings_);
+    oPart.nValue = nPolygonCellValue;
+    oPart.iBottomRightRow = poPolygon->iBottomRightRow;
+    oPart.iBottomRightCol = poPolygon->iBottomRightCol;
+    oPart.bTop = bTop;
+    oPart.bBottom = bBottom;
+    aoParts.push_back(std::move(oPart));
+}
+
 }  // namespace polygonizer
 }  // namespace gdal
 
@@ -38,6 +38,7 @@
 #include <vector>
 #include <limits>
 #include <map>
+#include <utility>
 
 #include "cpl_error.h"
 #include "ogr_api.h"
@@ -50,6 +51,7 @@ namespace polygonizer
 using IndexType = std::uint32_t;
 using Point = std::array<IndexType, 2>;
 using Arc = std::vector<Point>;
+using Ring = std::vector<Point>;
 
 struct IndexedArc
 {
@@ -96,6 +98,13 @@ struct RPolygon
      * update the bottom-right most cell index of the current polygon
      */
     void updateBottomRightPos(IndexType iRow, IndexType iCol);
+
+    /**
+     * get the rings of the polygon, as lists of pixel corners without the
+     * closing point. The exterior ring comes first, and each ring starts at
+     * its top-left most corner.
+     */
+    void getRings(std::vector<Ring> &aoRings) const;
 };
 
 /**
@@ -181,6 +190,22 @@ template <typename PolyIdType, typename DataType> class Polygonizer
                      IndexType nCols);
 };
 
+/**
+ * Stitch the rings of the parts of a polygon that have been traced
+ * separately on horizontal strips of nStripYSize lines of the raster.
+ * On input, aoRings contains the rings of all the parts. On output, it
+ * contains the rings of the polygon, as RPolygon::getRings() would return
+ * them if the polygon had been traced on the whole raster.
+ */
+void StitchRings(std::vector<Ring> &aoRings, IndexType nStripYSize);
+
+/**
+ * Create an OGR polygon, in georeferenced coordinates, from rings of pixel
+ * corners.
+ */
+OGRGeometryH CreateOGRPolygon(const std::vector<Ring> &aoRings,
+                              const double *padfGeoTransform);
+
 /**
  * Write raster polygon object to OGR layer.
  */
@@ -190,6 +215,7 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
     OGRLayerH hOutLayer_;
     int iPixValField_;
     double *padfGeoTransform_;
+    std::vector<Ring> aoRings_{};
 
     CPLErr eErr_{CE_None};
 
@@ -206,12 +232,65 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
 
     void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
 
+    /**
+     * write a polygon created by CreateOGRPolygon(), taking its ownership
+     */
+    void write(OGRGeometryH hPolygon, DataType nPolygonCellValue);
+
     inline CPLErr getErr()
     {
         return eErr_;
     }
 };
 
+/**
+ * Collect the polygons traced on a horizontal strip of the raster.
+ * Polygons inside the strip are converted to OGR polygons. Polygons that
+ * touch the top or bottom line of the strip, where another strip is
+ * traced, are only parts of raster polygons: they are kept as rings, to be
+ * stitched with the parts traced on the other strips.
+ */
+template <typename DataType>
+class StripPolygonCollector : public PolygonReceiver<DataType>
+{
+  public:
+    struct Part
+    {
+        std::vector<Ring> aoRings{};
+        DataType nValue{};
+        IndexType iBottomRightRow{0};
+        IndexType iBottomRightCol{0};
+        // does the part touch the top or bottom line of the strip
+        bool bTop{false};
+        bool bBottom{false};
+    };
+
+  private:
+    IndexType nYOff_;
+    IndexType nYSize_;
+    bool bTopSeam_;
+    bool bBottomSeam_;
+    const double *padfGeoTransform_;
+    std::vector<Ring> aoRings_{};
+
+  public:
+    // polygons inside the strip, and their cell value
+    std::vector<std::pair<OGRGeometryH, DataType>> aoPolygons{};
+    std::vector<Part> aoParts{};
+
+    StripPolygonCollector(IndexType nYOff, IndexType nYSize, bool bTopSeam,
+                          bool bBottomSeam, const double *padfGeoTransform);
+
+    StripPolygonCollector(const StripPolygonCollector<DataType> &) = delete;
+
+    ~StripPolygonCollector() override;
+
+    StripPolygonCollector<DataType> &
+    operator=(const StripPolygonCollector<DataType> &) = delete;
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override;
+};
+
 }  // namespace polygonizer
 }  // namespace gdal
 
@@ -13,5 +13,9 @@ template class OGRPolygonWriter<std::int64_t>;
 
 template class OGRPolygonWriter<float>;
 
+template class StripPolygonCollector<std::int64_t>;
+
+template class StripPolygonCollector<float>;
+
 }  // namespace polygonizer
 }  // namespace gdal
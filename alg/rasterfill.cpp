@@ -35,104 +35,185 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2_OPTIM
+#include "gdalsse_priv.h"
+#endif
 
 /************************************************************************/
-/*                           GDALFilterLine()                           */
+/*                          GDALFilterPixel()                           */
 /*                                                                      */
-/*      Apply 3x3 filtering one one scanline with masking for which     */
-/*      pixels are to be interpolated (ThisFMask) and which window      */
-/*      pixels are valid to include in the interpolation (TMask).       */
+/*      Apply 3x3 filtering on one pixel of a scanline.                 */
 /************************************************************************/
 
-static void GDALFilterLine(const float *pafLastLine, const float *pafThisLine,
-                           const float *pafNextLine, float *pafOutLine,
-                           const GByte *pabyLastTMask,
-                           const GByte *pabyThisTMask,
-                           const GByte *pabyNextTMask,
-                           const GByte *pabyThisFMask, int nXSize)
+static inline void
+GDALFilterPixel(const float *pafLastLine, const float *pafThisLine,
+                const float *pafNextLine, float *pafOutLine,
+                const GByte *pabyLastTMask, const GByte *pabyThisTMask,
+                const GByte *pabyNextTMask, const GByte *pabyThisFMask, int iX,
+                int nXSize)
 
 {
-    for (int iX = 0; iX < nXSize; iX++)
+    if (!pabyThisFMask[iX])
     {
-        if (!pabyThisFMask[iX])
-        {
-            pafOutLine[iX] = pafThisLine[iX];
-            continue;
-        }
+        pafOutLine[iX] = pafThisLine[iX];
+        return;
+    }
 
-        CPLAssert(pabyThisTMask[iX]);
+    CPLAssert(pabyThisTMask[iX]);
 
-        double dfValSum = 0.0;
-        double dfWeightSum = 0.0;
+    double dfValSum = 0.0;
+    double dfWeightSum = 0.0;
 
-        // Previous line.
-        if (pafLastLine != nullptr)
+    // Previous line.
+    if (pafLastLine != nullptr)
+    {
+        if (iX > 0 && pabyLastTMask[iX - 1])
         {
-            if (iX > 0 && pabyLastTMask[iX - 1])
-            {
-                dfValSum += pafLastLine[iX - 1];
-                dfWeightSum += 1.0;
-            }
-            if (pabyLastTMask[iX])
-            {
-                dfValSum += pafLastLine[iX];
-                dfWeightSum += 1.0;
-            }
-            if (iX < nXSize - 1 && pabyLastTMask[iX + 1])
-            {
-                dfValSum += pafLastLine[iX + 1];
-                dfWeightSum += 1.0;
-            }
+            dfValSum += pafLastLine[iX - 1];
+            dfWeightSum += 1.0;
+        }
+        if (pabyLastTMask[iX])
+        {
+            dfValSum += pafLastLine[iX];
+            dfWeightSum += 1.0;
         }
+        if (iX < nXSize - 1 && pabyLastTMask[iX + 1])
+        {
+            dfValSum += pafLastLine[iX + 1];
+            dfWeightSum += 1.0;
+        }
+    }
+
+    // Current Line.
+    if (iX > 0 && pabyThisTMask[iX - 1])
+    {
+        dfValSum += pafThisLine[iX - 1];
+        dfWeightSum += 1.0;
+    }
+    if (pabyThisTMask[iX])
+    {
+        dfValSum += pafThisLine[iX];
+        dfWeightSum += 1.0;
+    }
+    if (iX < nXSize - 1 && pabyThisTMask[iX + 1])
+    {
+        dfValSum += pafThisLine[iX + 1];
+        dfWeightSum += 1.0;
+    }
 
-        // Current Line.
-        if (iX > 0 && pabyThisTMask[iX - 1])
+    // Next line.
+    if (pafNextLine != nullptr)
+    {
+        if (iX > 0 && pabyNextTMask[iX - 1])
         {
-            dfValSum += pafThisLine[iX - 1];
+            dfValSum += pafNextLine[iX - 1];
             dfWeightSum += 1.0;
         }
-        if (pabyThisTMask[iX])
+        if (pabyNextTMask[iX])
         {
-            dfValSum += pafThisLine[iX];
+            dfValSum += pafNextLine[iX];
             dfWeightSum += 1.0;
         }
-        if (iX < nXSize - 1 && pabyThisTMask[iX + 1])
+        if (iX < nXSize - 1 && pabyNextTMask[iX + 1])
         {
-            dfValSum += pafThisLine[iX + 1];
+            dfValSum += pafNextLine[iX + 1];
             dfWeightSum += 1.0;
         }
+    }
 
-        // Next line.
-        if (pafNextLine != nullptr)
+    pafOutLine[iX] = static_cast<float>(dfValSum / dfWeightSum);
+}
+
+/************************************************************************/
+/*                           GDALFilterLine()                           */
+/*                                                                      */
+/*      Apply 3x3 filtering one one scanline with masking for which     */
+/*      pixels are to be interpolated (ThisFMask) and which window      */
+/*      pixels are valid to include in the interpolation (TMask).       */
+/************************************************************************/
+
+static void GDALFilterLine(const float *pafLastLine, const float *pafThisLine,
+                           const float *pafNextLine, float *pafOutLine,
+                           const GByte *pabyLastTMask,
+                           const GByte *pabyThisTMask,
+                           const GByte *pabyNextTMask,
+                           const GByte *pabyThisFMask, int nXSize)
+
+{
+    int iX = 0;
+#ifdef USE_SSE2_OPTIM
+    // Process 4 pixels at a time away from the left and right edges. Masked
+    // out contributions are set to zero, and summed in the same order as in
+    // GDALFilterPixel(), so that results are identical.
+    if (pafLastLine != nullptr && pafNextLine != nullptr && nXSize > 5)
+    {
+        GDALFilterPixel(pafLastLine, pafThisLine, pafNextLine, pafOutLine,
+                        pabyLastTMask, pabyThisTMask, pabyNextTMask,
+                        pabyThisFMask, 0, nXSize);
+
+        const auto zero = XMMReg4Double::Zero();
+        const double dfOne = 1.0;
+        const auto one = XMMReg4Double::Load1ValHighAndLow(&dfOne);
+        const auto AddLine = [&zero, &one](const float *pafLine,
+                                           const GByte *pabyTMask,
+                                           XMMReg4Double &valSum,
+                                           XMMReg4Double &weightSum)
         {
-            if (iX > 0 && pabyNextTMask[iX - 1])
+            for (int iOff = -1; iOff <= 1; ++iOff)
             {
-                dfValSum += pafNextLine[iX - 1];
-                dfWeightSum += 1.0;
+                const auto valid = XMMReg4Double::NotEquals(
+                    XMMReg4Double::Load4Val(pabyTMask + iOff), zero);
+                valSum += XMMReg4Double::Ternary(
+                    valid, XMMReg4Double::Load4Val(pafLine + iOff), zero);
+                weightSum += XMMReg4Double::And(valid, one);
             }
-            if (pabyNextTMask[iX])
-            {
-                dfValSum += pafNextLine[iX];
-                dfWeightSum += 1.0;
-            }
-            if (iX < nXSize - 1 && pabyNextTMask[iX + 1])
+        };
+
+        for (iX = 1; iX + 4 < nXSize; iX += 4)
+        {
+            if (!(pabyThisFMask[iX] | pabyThisFMask[iX + 1] |
+                  pabyThisFMask[iX + 2] | pabyThisFMask[iX + 3]))
             {
-                dfValSum += pafNextLine[iX + 1];
-                dfWeightSum += 1.0;
+                memcpy(pafOutLine + iX, pafThisLine + iX, 4 * sizeof(float));
+                continue;
             }
+
+            auto valSum = zero;
+            auto weightSum = zero;
+            AddLine(pafLastLine + iX, pabyLastTMask + iX, valSum, weightSum);
+            AddLine(pafThisLine + iX, pabyThisTMask + iX, valSum, weightSum);
+            AddLine(pafNextLine + iX, pabyNextTMask + iX, valSum, weightSum);
+
+            const auto filtered = XMMReg4Double::NotEquals(
+                XMMReg4Double::Load4Val(pabyThisFMask + iX), zero);
+            XMMReg4Double::Ternary(filtered, valSum / weightSum,
+                                   XMMReg4Double::Load4Val(pafThisLine + iX))
+                .Store4Val(pafOutLine + iX);
         }
+    }
+#endif
 
-        pafOutLine[iX] = static_cast<float>(dfValSum / dfWeightSum);
+    for (; iX < nXSize; iX++)
+    {
+        GDALFilterPixel(pafLastLine, pafThisLine, pafNextLine, pafOutLine,
+                        pabyLastTMask, pabyThisTMask, pabyNextTMask,
+                        pabyThisFMask, iX, nXSize);
     }
 }
 
@@ -360,6 +441,450 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
     }
 }
 
+namespace
+{
+
+/************************************************************************/
+/*                        GDALFillNodataContext                         */
+/************************************************************************/
+
+struct GDALFillNodataContext
+{
+    int nXSize = 0;
+    double dfMaxSearchDist = 0.0;
+    int nMaxSearchDist = 0;
+    GUInt32 nNoDataVal = 0;
+    bool bNearest = false;
+    bool bHasNoData = false;
+    float fNoData = 0.0f;
+};
+
+/************************************************************************/
+/*                          GDALFillNodataJob                           */
+/************************************************************************/
+
+struct GDALFillNodataJob
+{
+    const GDALFillNodataContext *psCtxt = nullptr;
+    // Raster line of the first line of the batch.
+    int nYOff = 0;
+    // Lines of the batch processed by this job.
+    int iLineStart = 0;
+    int iLineEnd = 0;
+    // Top to bottom search info of the lines of the batch.
+    const GUInt32 *panTopDownY = nullptr;
+    const float *pafTopDownValue = nullptr;
+    // Bottom to top search info of the lines of the batch, and of the line
+    // below the batch.
+    const GUInt32 *panBottomUpY = nullptr;
+    const float *pafBottomUpValue = nullptr;
+    GByte *pabyMask = nullptr;
+    float *pafScanline = nullptr;
+    GByte *pabyFiltMask = nullptr;
+};
+
+}  // namespace
+
+/************************************************************************/
+/*                         GDALFillNodataLine()                         */
+/*                                                                      */
+/*      Interpolate the nodata pixels of a line from the top to         */
+/*      bottom search info of the line (TopDown), and the bottom to     */
+/*      top search info of the line below (Last).                       */
+/************************************************************************/
+
+static void GDALFillNodataLine(const GDALFillNodataContext &sCtxt, int iY,
+                               const GUInt32 *panTopDownY,
+                               const float *pafTopDownValue,
+                               const GUInt32 *panLastY,
+                               const float *pafLastValue, GByte *pabyMask,
+                               float *pafScanline, GByte *pabyFiltMask)
+{
+    const int nXSize = sCtxt.nXSize;
+    const double dfMaxSearchDist = sCtxt.dfMaxSearchDist;
+    const int nMaxSearchDist = sCtxt.nMaxSearchDist;
+    const GUInt32 nNoDataVal = sCtxt.nNoDataVal;
+    const bool bNearest = sCtxt.bNearest;
+    const bool bHasNoData = sCtxt.bHasNoData;
+    const float fNoData = sCtxt.fNoData;
+
+    memset(pabyFiltMask, 0, nXSize);
+    for (int iX = 0; iX < nXSize; iX++)
+    {
+        int nThisMaxSearchDist = nMaxSearchDist;
+
+        // If this was a valid target - no change.
+        if (pabyMask[iX])
+            continue;
+
+        enum Quadrants
+        {
+            QUAD_TOP_LEFT = 0,
+            QUAD_BOTTOM_LEFT = 1,
+            QUAD_TOP_RIGHT = 2,
+            QUAD_BOTTOM_RIGHT = 3,
+        };
+
+        constexpr int QUAD_COUNT = 4;
+        double adfQuadDist[QUAD_COUNT] = {};
+        float afQuadValue[QUAD_COUNT] = {};
+
+        for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+        {
+            adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
+            afQuadValue[iQuad] = 0.0;
+        }
+
+        // Step left and right by one pixel searching for the closest
+        // target value for each quadrant.
+        for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
+        {
+            const int iLeftX = std::max(0, iX - iStep);
+            const int iRightX = std::min(nXSize - 1, iX + iStep);
+
+            // Top left includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
+                       afQuadValue[QUAD_TOP_LEFT], iLeftX,
+                       panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
+                       nNoDataVal);
+
+            // Bottom left.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
+                       afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
+                       panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
+                       nNoDataVal);
+
+            // Top right and bottom right do no include center pixel.
+            if (iStep == 0)
+                continue;
+
+            // Top right includes current line.
+            QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
+                       afQuadValue[QUAD_TOP_RIGHT], iRightX,
+                       panTopDownY[iRightX], iX, iY,
+                       pafTopDownValue[iRightX], nNoDataVal);
+
+            // Bottom right.
+            QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
+                       afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
+                       panLastY[iRightX], iX, iY, pafLastValue[iRightX],
+                       nNoDataVal);
+
+            // Every four steps, recompute maximum distance.
+            if ((iStep & 0x3) == 0)
+                nThisMaxSearchDist = static_cast<int>(floor(
+                    std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
+                             std::max(adfQuadDist[2], adfQuadDist[3]))));
+        }
+
+        bool bHasSrcValues = false;
+        if (bNearest)
+        {
+            double dfNearestDist = dfMaxSearchDist + 1;
+            float fNearestValue = 0.0f;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] < dfNearestDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        fNearestValue = afQuadValue[iQuad];
+                        dfNearestDist = adfQuadDist[iQuad];
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfNearestDist <= dfMaxSearchDist)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] = fNearestValue;
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+        else
+        {
+            double dfWeightSum = 0.0;
+            double dfValueSum = 0.0;
+
+            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
+            {
+                if (adfQuadDist[iQuad] <= dfMaxSearchDist)
+                {
+                    bHasSrcValues = true;
+                    if (!bHasNoData || afQuadValue[iQuad] != fNoData)
+                    {
+                        const double dfWeight = 1.0 / adfQuadDist[iQuad];
+                        dfWeightSum += dfWeight;
+                        dfValueSum += afQuadValue[iQuad] * dfWeight;
+                    }
+                }
+            }
+
+            if (bHasSrcValues)
+            {
+                pabyFiltMask[iX] = 255;
+                if (dfWeightSum > 0.0)
+                {
+                    pabyMask[iX] = 255;
+                    pafScanline[iX] =
+                        static_cast<float>(dfValueSum / dfWeightSum);
+                }
+                else
+                    pafScanline[iX] = fNoData;
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                        GDALFillNodataJobFunc()                       */
+/************************************************************************/
+
+static void GDALFillNodataJobFunc(void *pData)
+{
+    const GDALFillNodataJob *psJob = static_cast<GDALFillNodataJob *>(pData);
+    const size_t nXSize = static_cast<size_t>(psJob->psCtxt->nXSize);
+    for (int iLine = psJob->iLineStart; iLine < psJob->iLineEnd; iLine++)
+    {
+        const size_t nOffset = iLine * nXSize;
+        GDALFillNodataLine(*(psJob->psCtxt), psJob->nYOff + iLine,
+                           psJob->panTopDownY + nOffset,
+                           psJob->pafTopDownValue + nOffset,
+                           psJob->panBottomUpY + nOffset + nXSize,
+                           psJob->pafBottomUpValue + nOffset + nXSize,
+                           psJob->pabyMask + nOffset,
+                           psJob->pafScanline + nOffset,
+                           psJob->pabyFiltMask + nOffset);
+    }
+}
+
+/************************************************************************/
+/*                       GDALFillNodataBottomUp()                       */
+/*                                                                      */
+/*      Collect the "last known value" for each column from bottom      */
+/*      to top, and use it in combination with the top to bottom        */
+/*      search info to interpolate.  Lines are processed by batches,    */
+/*      and the lines of a batch are interpolated in parallel.          */
+/************************************************************************/
+
+static CPLErr GDALFillNodataBottomUp(
+    const GDALFillNodataContext &sCtxt, int nYSize, GDALRasterBandH hTargetBand,
+    GDALRasterBandH hMaskBand, bool bUpdateMaskBand, GDALRasterBandH hYBand,
+    GDALRasterBandH hValBand, GDALRasterBandH hFiltMaskBand, int nThreads,
+    double dfProgressRatio, GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    const int nXSize = sCtxt.nXSize;
+    const double dfMaxSearchDist = sCtxt.dfMaxSearchDist;
+    const GUInt32 nNoDataVal = sCtxt.nNoDataVal;
+
+    // Mask, scanline, top down and bottom up search info and filter mask.
+    constexpr int BYTES_PER_PIXEL = static_cast<int>(
+        2 * sizeof(GByte) + 3 * sizeof(float) + 2 * sizeof(GUInt32));
+    // GDAL_FILLNODATA_MAX_MEMORY is mostly for testing batches of a few
+    // lines.
+    const char *pszMaxMemory =
+        CPLGetConfigOption("GDAL_FILLNODATA_MAX_MEMORY", nullptr);
+    const GIntBig nMaxMemory =
+        pszMaxMemory ? std::max(static_cast<GIntBig>(1),
+                                CPLAtoGIntBig(pszMaxMemory))
+                     : std::max(static_cast<GIntBig>(10 * 1024 * 1024),
+                                GDALGetCacheMax64() / 10);
+    const int nBatchYSize = static_cast<int>(
+        std::max(static_cast<GIntBig>(1),
+                 std::min(static_cast<GIntBig>(nYSize),
+                          nMaxMemory / (static_cast<GIntBig>(nXSize) *
+                                        BYTES_PER_PIXEL))));
+
+    const size_t nBatchPixels = static_cast<size_t>(nXSize) * nBatchYSize;
+    std::vector<GByte> abyMask;
+    std::vector<float> afScanline;
+    std::vector<GUInt32> anTopDownY;
+    std::vector<float> afTopDownValue;
+    std::vector<GUInt32> anBottomUpY;
+    std::vector<float> afBottomUpValue;
+    std::vector<GByte> abyFiltMask;
+    try
+    {
+        abyMask.resize(nBatchPixels);
+        afScanline.resize(nBatchPixels);
+        anTopDownY.resize(nBatchPixels);
+        afTopDownValue.resize(nBatchPixels);
+        anBottomUpY.resize(nBatchPixels + nXSize);
+        afBottomUpValue.resize(nBatchPixels + nXSize);
+        abyFiltMask.resize(nBatchPixels);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALFillNodata()");
+        return CE_Failure;
+    }
+
+    // Bottom up search info of the line below the current batch.
+    std::vector<GUInt32> anBelowY(nXSize, nNoDataVal);
+    std::vector<float> afBelowValue(nXSize);
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
+    }
+    std::vector<GDALFillNodataJob> asJobs;
+
+    CPLErr eErr = CE_None;
+    for (int nYEnd = nYSize; nYEnd > 0 && eErr == CE_None;
+         nYEnd -= nBatchYSize)
+    {
+        const int nYOff = std::max(0, nYEnd - nBatchYSize);
+        const int nLines = nYEnd - nYOff;
+
+        /* ---------------------------------------------------------------- */
+        /*      Read data and mask, and the top down search info.           */
+        /* ---------------------------------------------------------------- */
+        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, nYOff, nXSize, nLines,
+                            abyMask.data(), nXSize, nLines, GDT_Byte, 0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hTargetBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                afScanline.data(), nXSize, nLines, GDT_Float32,
+                                0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hYBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                anTopDownY.data(), nXSize, nLines, GDT_UInt32,
+                                0, 0);
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hValBand, GF_Read, 0, nYOff, nXSize, nLines,
+                                afTopDownValue.data(), nXSize, nLines,
+                                GDT_Float32, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        /* ---------------------------------------------------------------- */
+        /*      Figure out the most recent pixel for each column, from      */
+        /*      the bottom line of the batch.                               */
+        /* ---------------------------------------------------------------- */
+        const size_t nBelowOffset = static_cast<size_t>(nLines) * nXSize;
+        std::copy(anBelowY.begin(), anBelowY.end(),
+                  anBottomUpY.begin() + nBelowOffset);
+        std::copy(afBelowValue.begin(), afBelowValue.end(),
+                  afBottomUpValue.begin() + nBelowOffset);
+
+        for (int iLine = nLines - 1; iLine >= 0; iLine--)
+        {
+            const int iY = nYOff + iLine;
+            const size_t nOffset = static_cast<size_t>(iLine) * nXSize;
+            const GByte *pabyMask = abyMask.data() + nOffset;
+            const float *pafScanline = afScanline.data() + nOffset;
+            const GUInt32 *panLastY = anBottomUpY.data() + nOffset + nXSize;
+            const float *pafLastValue =
+                afBottomUpValue.data() + nOffset + nXSize;
+            GUInt32 *panThisY = anBottomUpY.data() + nOffset;
+            float *pafThisValue = afBottomUpValue.data() + nOffset;
+
+            for (int iX = 0; iX < nXSize; iX++)
+            {
+                if (pabyMask[iX])
+                {
+                    pafThisValue[iX] = pafScanline[iX];
+                    panThisY[iX] = iY;
+                }
+                else if (panLastY[iX] - iY <= dfMaxSearchDist)
+                {
+                    pafThisValue[iX] = pafLastValue[iX];
+                    panThisY[iX] = panLastY[iX];
+                }
+                else
+                {
+                    panThisY[iX] = nNoDataVal;
+                }
+            }
+        }
+
+        std::copy(anBottomUpY.begin(), anBottomUpY.begin() + nXSize,
+                  anBelowY.begin());
+        std::copy(afBottomUpValue.begin(), afBottomUpValue.begin() + nXSize,
+                  afBelowValue.begin());
+
+        /* ---------------------------------------------------------------- */
+        /*      Attempt to interpolate any pixels that are nodata.          */
+        /* ---------------------------------------------------------------- */
+        const int nJobs = std::min(nThreads, nLines);
+        asJobs.resize(nJobs);
+        for (int i = 0; i < nJobs; i++)
+        {
+            GDALFillNodataJob &sJob = asJobs[i];
+            sJob.psCtxt = &sCtxt;
+            sJob.nYOff = nYOff;
+            sJob.iLineStart = static_cast<int>(
+                static_cast<GIntBig>(nLines) * i / nJobs);
+            sJob.iLineEnd = static_cast<int>(
+                static_cast<GIntBig>(nLines) * (i + 1) / nJobs);
+            sJob.panTopDownY = anTopDownY.data();
+            sJob.pafTopDownValue = afTopDownValue.data();
+            sJob.panBottomUpY = anBottomUpY.data();
+            sJob.pafBottomUpValue = afBottomUpValue.data();
+            sJob.pabyMask = abyMask.data();
+            sJob.pafScanline = afScanline.data();
+            sJob.pabyFiltMask = abyFiltMask.data();
+        }
+        if (poJobQueue && nJobs > 1)
+        {
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob(GDALFillNodataJobFunc, &sJob);
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (auto &sJob : asJobs)
+                GDALFillNodataJobFunc(&sJob);
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Write out the updated data and mask information.            */
+        /* ---------------------------------------------------------------- */
+        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, nYOff, nXSize, nLines,
+                            afScanline.data(), nXSize, nLines, GDT_Float32, 0,
+                            0);
+
+        if (eErr == CE_None && bUpdateMaskBand)
+        {
+            // Update (copy of) mask band when it has been provided by the
+            // user
+            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, nYOff, nXSize, nLines,
+                                abyMask.data(), nXSize, nLines, GDT_Byte, 0,
+                                0);
+        }
+
+        if (eErr == CE_None)
+            eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, nYOff, nXSize,
+                                nLines, abyFiltMask.data(), nXSize, nLines,
+                                GDT_Byte, 0, 0);
+
+        /* ---------------------------------------------------------------- */
+        /*      report progress.                                            */
+        /* ---------------------------------------------------------------- */
+        if (eErr == CE_None &&
+            !pfnProgress(dfProgressRatio *
+                             (0.5 + 0.5 * (nYSize - nYOff) /
+                                        static_cast<double>(nYSize)),
+                         "Filling...", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                           GDALFillNodata()                           */
 /************************************************************************/
@@ -393,7 +918,13 @@ inline void QUAD_CHECK(double &dfQuadDist, float &fQuadValue, int target_x,
  * run (0 or more).
  * @param papszOptions additional name=value options in a string list.
  * <ul>
- * <li>TEMP_FILE_DRIVER=gdal_driver_name. For example MEM.</li>
+ * <li>TEMP_FILE_DRIVER=gdal_driver_name. For example MEM. Since GDAL 3.10,
+ * defaults to MEM when the temporary work files fit in half of the GDAL block
+ * cache size (GDAL_CACHEMAX), or 100 MB if that is larger, and to GTiff
+ * otherwise. Before, defaulted to GTiff.</li>
+ * <li>NUM_THREADS=number_of_threads/ALL_CPUS (GDAL >= 3.10). Number of threads
+ * used to interpolate lines. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1.</li>
  * <li>NODATA=value (starting with GDAL 2.4).
  * Source pixels at that value will be ignored by the interpolator. Warning:
  * currently this will not be honored by smoothing passes.</li>
@@ -447,11 +978,38 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         nNoDataVal = 4000002;
     }
 
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS",
+                             CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(
+        1, std::min(128, EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+
     /* -------------------------------------------------------------------- */
-    /*      Determine format driver for temp work files.                    */
+    /*      Determine format driver for temp work files.  By default,       */
+    /*      keep them in memory when they fit.                              */
     /* -------------------------------------------------------------------- */
-    CPLString osTmpFileDriver =
-        CSLFetchNameValueDef(papszOptions, "TEMP_FILE_DRIVER", "GTiff");
+    CPLString osTmpFileDriver;
+    if (const char *pszTmpFileDriver =
+            CSLFetchNameValue(papszOptions, "TEMP_FILE_DRIVER"))
+    {
+        osTmpFileDriver = pszTmpFileDriver;
+    }
+    else
+    {
+        // Y index, XY value, filter mask, and copy of the mask.
+        const GIntBig nWorkFilesSize =
+            static_cast<GIntBig>(nXSize) * nYSize *
+            (GDALGetDataTypeSizeBytes(eType) +
+             GDALGetDataTypeSizeBytes(GDALGetRasterDataType(hTargetBand)) + 2);
+        const GIntBig nMaxMemory =
+            std::max(static_cast<GIntBig>(100 * 1000 * 1000),
+                     GDALGetCacheMax64() / 2);
+        osTmpFileDriver =
+            nWorkFilesSize <= nMaxMemory && GDALGetDriverByName("MEM")
+                ? "MEM"
+                : "GTiff";
+    }
     GDALDriverH hDriver = GDALGetDriverByName(osTmpFileDriver.c_str());
 
     if (hDriver == nullptr)
@@ -610,25 +1168,19 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     GUInt32 *panThisY =
         static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
-    GUInt32 *panTopDownY =
-        static_cast<GUInt32 *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(GUInt32)));
     float *pafLastValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafThisValue =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
-    float *pafTopDownValue =
-        static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     float *pafScanline =
         static_cast<float *>(VSI_CALLOC_VERBOSE(nXSize, sizeof(float)));
     GByte *pabyMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
-    GByte *pabyFiltMask = static_cast<GByte *>(VSI_CALLOC_VERBOSE(nXSize, 1));
 
     CPLErr eErr = CE_None;
 
-    if (panLastY == nullptr || panThisY == nullptr || panTopDownY == nullptr ||
+    if (panLastY == nullptr || panThisY == nullptr ||
         pafLastValue == nullptr || pafThisValue == nullptr ||
-        pafTopDownValue == nullptr || pafScanline == nullptr ||
-        pabyMask == nullptr || pabyFiltMask == nullptr)
+        pafScanline == nullptr || pabyMask == nullptr)
     {
         eErr = CE_Failure;
         goto end;
@@ -725,260 +1277,26 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
         }
     }
 
-    for (int iX = 0; iX < nXSize; iX++)
-    {
-        panLastY[iX] = nNoDataVal;
-    }
-
     /* ==================================================================== */
     /*      Now we will do collect similar this/last information from       */
     /*      bottom to top and use it in combination with the top to         */
     /*      bottom search info to interpolate.                              */
     /* ==================================================================== */
-    for (int iY = nYSize - 1; iY >= 0 && eErr == CE_None; iY--)
+    if (eErr == CE_None)
     {
-        eErr = GDALRasterIO(hMaskBand, GF_Read, 0, iY, nXSize, 1, pabyMask,
-                            nXSize, 1, GDT_Byte, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        eErr = GDALRasterIO(hTargetBand, GF_Read, 0, iY, nXSize, 1, pafScanline,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the most recent pixel for each column. */
-        /* --------------------------------------------------------------------
-         */
-
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            if (pabyMask[iX])
-            {
-                pafThisValue[iX] = pafScanline[iX];
-                panThisY[iX] = iY;
-            }
-            else if (panLastY[iX] - iY <= dfMaxSearchDist)
-            {
-                pafThisValue[iX] = pafLastValue[iX];
-                panThisY[iX] = panLastY[iX];
-            }
-            else
-            {
-                panThisY[iX] = nNoDataVal;
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Load the last y and corresponding value from the top down pass.
-         */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hYBand, GF_Read, 0, iY, nXSize, 1, panTopDownY,
-                            nXSize, 1, GDT_UInt32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        eErr = GDALRasterIO(hValBand, GF_Read, 0, iY, nXSize, 1,
-                            pafTopDownValue, nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Attempt to interpolate any pixels that are nodata. */
-        /* --------------------------------------------------------------------
-         */
-        memset(pabyFiltMask, 0, nXSize);
-        for (int iX = 0; iX < nXSize; iX++)
-        {
-            int nThisMaxSearchDist = nMaxSearchDist;
-
-            // If this was a valid target - no change.
-            if (pabyMask[iX])
-                continue;
-
-            enum Quadrants
-            {
-                QUAD_TOP_LEFT = 0,
-                QUAD_BOTTOM_LEFT = 1,
-                QUAD_TOP_RIGHT = 2,
-                QUAD_BOTTOM_RIGHT = 3,
-            };
-
-            constexpr int QUAD_COUNT = 4;
-            double adfQuadDist[QUAD_COUNT] = {};
-            float afQuadValue[QUAD_COUNT] = {};
-
-            for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-            {
-                adfQuadDist[iQuad] = dfMaxSearchDist + 1.0;
-                afQuadValue[iQuad] = 0.0;
-            }
-
-            // Step left and right by one pixel searching for the closest
-            // target value for each quadrant.
-            for (int iStep = 0; iStep <= nThisMaxSearchDist; iStep++)
-            {
-                const int iLeftX = std::max(0, iX - iStep);
-                const int iRightX = std::min(nXSize - 1, iX + iStep);
-
-                // Top left includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_LEFT],
-                           afQuadValue[QUAD_TOP_LEFT], iLeftX,
-                           panTopDownY[iLeftX], iX, iY, pafTopDownValue[iLeftX],
-                           nNoDataVal);
-
-                // Bottom left.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_LEFT],
-                           afQuadValue[QUAD_BOTTOM_LEFT], iLeftX,
-                           panLastY[iLeftX], iX, iY, pafLastValue[iLeftX],
-                           nNoDataVal);
-
-                // Top right and bottom right do no include center pixel.
-                if (iStep == 0)
-                    continue;
-
-                // Top right includes current line.
-                QUAD_CHECK(adfQuadDist[QUAD_TOP_RIGHT],
-                           afQuadValue[QUAD_TOP_RIGHT], iRightX,
-                           panTopDownY[iRightX], iX, iY,
-                           pafTopDownValue[iRightX], nNoDataVal);
-
-                // Bottom right.
-                QUAD_CHECK(adfQuadDist[QUAD_BOTTOM_RIGHT],
-                           afQuadValue[QUAD_BOTTOM_RIGHT], iRightX,
-                           panLastY[iRightX], iX, iY, pafLastValue[iRightX],
-                           nNoDataVal);
-
-                // Every four steps, recompute maximum distance.
-                if ((iStep & 0x3) == 0)
-                    nThisMaxSearchDist = static_cast<int>(floor(
-                        std::max(std::max(adfQuadDist[0], adfQuadDist[1]),
-                                 std::max(adfQuadDist[2], adfQuadDist[3]))));
-            }
-
-            bool bHasSrcValues = false;
-            if (bNearest)
-            {
-                double dfNearestDist = dfMaxSearchDist + 1;
-                float fNearestValue = 0.0f;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] < dfNearestDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            fNearestValue = afQuadValue[iQuad];
-                            dfNearestDist = adfQuadDist[iQuad];
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfNearestDist <= dfMaxSearchDist)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] = fNearestValue;
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-            else
-            {
-                double dfWeightSum = 0.0;
-                double dfValueSum = 0.0;
-
-                for (int iQuad = 0; iQuad < QUAD_COUNT; iQuad++)
-                {
-                    if (adfQuadDist[iQuad] <= dfMaxSearchDist)
-                    {
-                        bHasSrcValues = true;
-                        if (!bHasNoData || afQuadValue[iQuad] != fNoData)
-                        {
-                            const double dfWeight = 1.0 / adfQuadDist[iQuad];
-                            dfWeightSum += dfWeight;
-                            dfValueSum += afQuadValue[iQuad] * dfWeight;
-                        }
-                    }
-                }
-
-                if (bHasSrcValues)
-                {
-                    pabyFiltMask[iX] = 255;
-                    if (dfWeightSum > 0.0)
-                    {
-                        pabyMask[iX] = 255;
-                        pafScanline[iX] =
-                            static_cast<float>(dfValueSum / dfWeightSum);
-                    }
-                    else
-                        pafScanline[iX] = fNoData;
-                }
-            }
-        }
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Write out the updated data and mask information. */
-        /* --------------------------------------------------------------------
-         */
-        eErr = GDALRasterIO(hTargetBand, GF_Write, 0, iY, nXSize, 1,
-                            pafScanline, nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        if (poTmpMaskDS != nullptr)
-        {
-            // Update (copy of) mask band when it has been provided by the
-            // user
-            eErr = GDALRasterIO(hMaskBand, GF_Write, 0, iY, nXSize, 1, pabyMask,
-                                nXSize, 1, GDT_Byte, 0, 0);
-
-            if (eErr != CE_None)
-                break;
-        }
-
-        eErr = GDALRasterIO(hFiltMaskBand, GF_Write, 0, iY, nXSize, 1,
-                            pabyFiltMask, nXSize, 1, GDT_Byte, 0, 0);
-
-        if (eErr != CE_None)
-            break;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Flip this/last buffers. */
-        /* --------------------------------------------------------------------
-         */
-        std::swap(pafThisValue, pafLastValue);
-        std::swap(panThisY, panLastY);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      report progress. */
-        /* --------------------------------------------------------------------
-         */
-        if (!pfnProgress(
-                dfProgressRatio *
-                    (0.5 + 0.5 * (nYSize - iY) / static_cast<double>(nYSize)),
-                "Filling...", pProgressArg))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
-        }
+        GDALFillNodataContext sCtxt;
+        sCtxt.nXSize = nXSize;
+        sCtxt.dfMaxSearchDist = dfMaxSearchDist;
+        sCtxt.nMaxSearchDist = nMaxSearchDist;
+        sCtxt.nNoDataVal = nNoDataVal;
+        sCtxt.bNearest = bNearest;
+        sCtxt.bHasNoData = bHasNoData;
+        sCtxt.fNoData = fNoData;
+
+        eErr = GDALFillNodataBottomUp(
+            sCtxt, nYSize, hTargetBand, hMaskBand, poTmpMaskDS != nullptr,
+            hYBand, hValBand, hFiltMaskBand, nThreads, dfProgressRatio,
+            pfnProgress, pProgressArg);
     }
 
     /* ==================================================================== */
@@ -1012,13 +1330,10 @@ CPLErr CPL_STDCALL GDALFillNodata(GDALRasterBandH hTargetBand,
 end:
     CPLFree(panLastY);
     CPLFree(panThisY);
-    CPLFree(panTopDownY);
     CPLFree(pafLastValue);
     CPLFree(pafThisValue);
-    CPLFree(pafTopDownValue);
     CPLFree(pafScanline);
     CPLFree(pabyMask);
-    CPLFree(pabyFiltMask);
 
     return eErr;
 }
@@ -280,6 +280,8 @@ static inline double VizGeorefSpline2DBase_func(const double x1,
  * to produce the hexadecimal values shown.
  */
 
+#include <emmintrin.h>
+
 typedef double V2DF __attribute__((__vector_size__(16)));
 
 typedef union
@@ -288,12 +290,6 @@ typedef union
     double d[2];
 } v2dfunion;
 
-typedef union
-{
-    int i[2];
-    long long li;
-} i64union;
-
 static const V2DF v2_ln2_div_2pow20 = {6.93147180559945286e-01 / 1048576,
                                        6.93147180559945286e-01 / 1048576};
 static const V2DF v2_Lg1 = {6.666666666666735130e-01, 6.666666666666735130e-01};
@@ -307,49 +303,41 @@ static const V2DF v2_one = {1.0, 1.0};
 static const V2DF v2_const1023_mul_2pow20 = {1023.0 * 1048576,
                                              1023.0 * 1048576};
 
-#define GET_HIGH_WORD(hx, x) memcpy(&hx, reinterpret_cast<char *>(&x) + 4, 4)
-#define SET_HIGH_WORD(x, hx) memcpy(reinterpret_cast<char *>(&x) + 4, &hx, 4)
-
 #define MAKE_WIDE_CST(x) (((static_cast<long long>(x)) << 32) | (x))
 constexpr long long cst_expmask = MAKE_WIDE_CST(0xfff00000);
 constexpr long long cst_0x95f64 = MAKE_WIDE_CST(0x00095f64);
 constexpr long long cst_0x100000 = MAKE_WIDE_CST(0x00100000);
 constexpr long long cst_0x3ff00000 = MAKE_WIDE_CST(0x3ff00000);
 
+// Argument reduction of __ieee754_log() for 2 values: normalize x in
+// [sqrt(2)/2, sqrt(2)] and return the 2 exponents k (multiplied by 2^20 and
+// biased). The high words of the values are processed in SSE2 registers
+// instead of going through memory.
+static CPL_INLINE V2DF FastApproxLogReduce(V2DF &x)
+{
+    const __m128i bits = _mm_castpd_si128(x);
+    // High words of x in the low 32 bits of each 64-bit lane.
+    const __m128i hx = _mm_srli_epi64(bits, 32);
+    const __m128i k = _mm_and_si128(hx, _mm_set1_epi64x(cst_expmask));
+    const __m128i hxMant = _mm_andnot_si128(_mm_set1_epi64x(cst_expmask), hx);
+    const __m128i i =
+        _mm_and_si128(_mm_add_epi32(hxMant, _mm_set1_epi64x(cst_0x95f64)),
+                      _mm_set1_epi64x(cst_0x100000));
+    const __m128i hxNormalized = _mm_or_si128(
+        hxMant, _mm_xor_si128(i, _mm_set1_epi64x(cst_0x3ff00000)));
+    x = _mm_castsi128_pd(
+        _mm_or_si128(_mm_slli_epi64(hxNormalized, 32),
+                     _mm_and_si128(bits, _mm_set1_epi64x(0xffffffff))));
+    return _mm_cvtepi32_pd(_mm_shuffle_epi32(_mm_add_epi32(k, i),
+                                             _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
 // Modified version of __ieee754_log(), less precise than log() but a bit
 // faster, and computing 4 log() at a time. Assumes that the values are > 0.
 static void FastApproxLog4Val(v2dfunion *x)
 {
-    i64union hx[2] = {};
-    i64union k[2] = {};
-    i64union i[2] = {};
-    GET_HIGH_WORD(hx[0].i[0], x[0].d[0]);
-    GET_HIGH_WORD(hx[0].i[1], x[0].d[1]);
-
-    // coverity[uninit_use]
-    k[0].li = hx[0].li & cst_expmask;
-    hx[0].li &= ~cst_expmask;
-    i[0].li = (hx[0].li + cst_0x95f64) & cst_0x100000;
-    hx[0].li |= i[0].li ^ cst_0x3ff00000;
-    SET_HIGH_WORD(x[0].d[0], hx[0].i[0]);  // Normalize x or x/2.
-    SET_HIGH_WORD(x[0].d[1], hx[0].i[1]);  // Normalize x or x/2.
-    k[0].li += i[0].li;
-
-    v2dfunion dk[2] = {};
-    dk[0].d[0] = static_cast<double>(k[0].i[0]);
-    dk[0].d[1] = static_cast<double>(k[0].i[1]);
-
-    GET_HIGH_WORD(hx[1].i[0], x[1].d[0]);
-    GET_HIGH_WORD(hx[1].i[1], x[1].d[1]);
-    k[1].li = hx[1].li & cst_expmask;
-    hx[1].li &= ~cst_expmask;
-    i[1].li = (hx[1].li + cst_0x95f64) & cst_0x100000;
-    hx[1].li |= i[1].li ^ cst_0x3ff00000;
-    SET_HIGH_WORD(x[1].d[0], hx[1].i[0]);  // Normalize x or x/2.
-    SET_HIGH_WORD(x[1].d[1], hx[1].i[1]);  // Normalize x or x/2.
-    k[1].li += i[1].li;
-    dk[1].d[0] = static_cast<double>(k[1].i[0]);
-    dk[1].d[1] = static_cast<double>(k[1].i[1]);
+    const V2DF dk0 = FastApproxLogReduce(x[0].v2);
+    const V2DF dk1 = FastApproxLogReduce(x[1].v2);
 
     V2DF f[2] = {};
     f[0] = x[0].v2 - v2_one;
@@ -371,7 +359,7 @@ static void FastApproxLog4Val(v2dfunion *x)
 
     V2DF R[2] = {};
     R[0] = t2[0] + t1[0];
-    x[0].v2 = (dk[0].v2 - v2_const1023_mul_2pow20) * v2_ln2_div_2pow20 -
+    x[0].v2 = (dk0 - v2_const1023_mul_2pow20) * v2_ln2_div_2pow20 -
               (s[0] * (f[0] - R[0]) - f[0]);
 
     f[1] = x[1].v2 - v2_one;
@@ -384,12 +372,19 @@ static void FastApproxLog4Val(v2dfunion *x)
     t2[1] =
         z[1] * (v2_Lg1 + w[1] * (v2_Lg3 + w[1] * (v2_Lg5 /*+w[1]*v2_Lg7*/)));
     R[1] = t2[1] + t1[1];
-    x[1].v2 = (dk[1].v2 - v2_const1023_mul_2pow20) * v2_ln2_div_2pow20 -
+    x[1].v2 = (dk1 - v2_const1023_mul_2pow20) * v2_ln2_div_2pow20 -
               (s[1] * (f[1] - R[1]) - f[1]);
 }
 
-static CPL_INLINE void VizGeorefSpline2DBase_func4(double *res,
-                                                   const double *pxy,
+static inline V2DF LoadV2DF(const double *p)
+{
+    V2DF v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Compute the basis functions of 4 control points, in 2 vectors of 2 values.
+static CPL_INLINE void VizGeorefSpline2DBase_func4(V2DF *res, const double *pxy,
                                                    const double *xr,
                                                    const double *yr)
 {
@@ -414,12 +409,8 @@ static CPL_INLINE void VizGeorefSpline2DBase_func4(double *res,
     dist[1].v2 = SQ(xv[1].v2 - x1v.v2) + SQ(yv[1].v2 - y1v.v2);
     v2dfunion resv[2] = {dist[0], dist[1]};
     FastApproxLog4Val(dist);
-    resv[0].v2 *= dist[0].v2;
-    resv[1].v2 *= dist[1].v2;
-    res[0] = resv[0].d[0];
-    res[1] = resv[0].d[1];
-    res[2] = resv[1].d[0];
-    res[3] = resv[1].d[1];
+    res[0] = resv[0].v2 * dist[0].v2;
+    res[1] = resv[1].v2 * dist[1].v2;
 }
 #else   // defined(USE_OPTIMIZED_VizGeorefSpline2DBase_func4)
 static void VizGeorefSpline2DBase_func4(double *res, const double *pxy,
@@ -436,7 +427,7 @@ static void VizGeorefSpline2DBase_func4(double *res, const double *pxy,
 }
 #endif  // defined(USE_OPTIMIZED_VizGeorefSpline2DBase_func4)
 
-int VizGeorefSpline2D::solve()
+int VizGeorefSpline2D::solve(int nThreads)
 {
     // No points at all.
     if (_nof_points < 1)
@@ -612,7 +603,7 @@ int VizGeorefSpline2D::solve()
 
     GDALMatrix Coef(_nof_eqs, _nof_vars);
 
-    if (!GDALLinearSystemSolve(A, RHS, Coef))
+    if (!GDALLinearSystemSolve(A, RHS, Coef, nThreads))
     {
         return 0;
     }
@@ -687,6 +678,26 @@ int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
                     coef[v][0] + coef[v][1] * Pxy[0] + coef[v][2] * Pxy[1];
 
             int r = 0;  // Used after for.
+#if defined(USE_OPTIMIZED_VizGeorefSpline2DBase_func4) && !defined(CPPCHECK)
+            // Accumulate the weighted basis functions in vectors, and only
+            // add their lanes together at the end.
+            V2DF sums[VIZGEOREF_MAX_VARS][2] = {};
+            for (; r < (_nof_points & (~3)); r += 4)
+            {
+                V2DF tmp[2];
+                VizGeorefSpline2DBase_func4(tmp, Pxy, &x[r], &y[r]);
+                for (int v = 0; v < _nof_vars; v++)
+                {
+                    sums[v][0] += LoadV2DF(&coef[v][r + 3]) * tmp[0];
+                    sums[v][1] += LoadV2DF(&coef[v][r + 3 + 2]) * tmp[1];
+                }
+            }
+            for (int v = 0; v < _nof_vars; v++)
+            {
+                const V2DF sum = sums[v][0] + sums[v][1];
+                vars[v] += sum[0] + sum[1];
+            }
+#else
             for (; r < (_nof_points & (~3)); r += 4)
             {
                 double dfTmp[4] = {};
@@ -697,6 +708,7 @@ int VizGeorefSpline2D::get_point(const double Px, const double Py, double *vars)
                                coef[v][r + 3 + 2] * dfTmp[2] +
                                coef[v][r + 3 + 3] * dfTmp[3];
             }
+#endif
             for (; r < _nof_points; r++)
             {
                 const double tmp =
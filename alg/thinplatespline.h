@@ -148,7 +148,7 @@ class VizGeorefSpline2D
     bool change_point(int index, double x, double y, double* Pvars);
     void reset(void) { _nof_points = 0; }
 #endif
-    int solve(void);
+    int solve(int nThreads = 1);
 
   private:
     vizGeorefInterType type;
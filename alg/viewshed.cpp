@@ -31,8 +31,10 @@
 #include <cassert>
 #include <future>
 
+#include "cpl_worker_thread_pool.h"
 #include "gdal_alg.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 #include "viewshed.h"
 
@@ -220,7 +222,8 @@ namespace
 // Calculate the height adjustment factor.
 double CalcHeightAdjFactor(const GDALDataset *poDataset, double dfCurveCoeff)
 {
-    const OGRSpatialReference *poDstSRS = poDataset->GetSpatialRef();
+    const OGRSpatialReference *poDstSRS =
+        poDataset ? poDataset->GetSpatialRef() : nullptr;
 
     if (poDstSRS)
     {
@@ -340,6 +343,14 @@ bool Viewshed::calcOutputExtent(int nX, int nY)
 /// @return  Success or failure.
 bool Viewshed::readLine(int nLine, double *data)
 {
+    if (pdfDEM)
+    {
+        const size_t nDEMXSize = GDALGetRasterBandXSize(pSrcBand);
+        std::copy_n(pdfDEM + nLine * nDEMXSize + oOutExtent.xStart,
+                    oOutExtent.xSize(), data);
+        return true;
+    }
+
     std::lock_guard g(iMutex);
 
     if (GDALRasterIO(pSrcBand, GF_Read, oOutExtent.xStart, nLine,
@@ -355,37 +366,60 @@ bool Viewshed::readLine(int nLine, double *data)
     return true;
 }
 
-/// Write an output line of either visibility or height data.
+/// Write the cells [nStart, nStop) of an output line of either visibility or
+/// height data.
 ///
 /// @param  nLine  Line number being written.
 /// @param vResult  Result line to write.
+/// @param nStart  First cell to write.
+/// @param nStop  One past the last cell to write.
 /// @return  True on success, false otherwise.
-bool Viewshed::writeLine(int nLine, std::vector<double> &vResult)
+bool Viewshed::writeLine(int nLine, std::vector<double> &vResult, int nStart,
+                         int nStop)
 {
+    if (nStart >= nStop)
+        return true;
+
+    if (panVisibleCount)
+    {
+        const size_t nDEMXSize = GDALGetRasterBandXSize(pSrcBand);
+        std::atomic<uint32_t> *panCount =
+            panVisibleCount + nLine * nDEMXSize + oOutExtent.xStart;
+        for (int i = nStart; i < nStop; ++i)
+        {
+            if (vResult[i] == oOpts.visibleVal)
+                panCount[i].fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
     // GDALRasterIO isn't thread-safe.
     std::lock_guard g(oMutex);
 
-    if (GDALRasterIO(pDstBand, GF_Write, 0, nLine - oOutExtent.yStart,
-                     oOutExtent.xSize(), 1, vResult.data(), oOutExtent.xSize(),
-                     1, GDT_Float64, 0, 0))
+    if (GDALRasterIO(pDstBand, GF_Write, nStart, nLine - oOutExtent.yStart,
+                     nStop - nStart, 1, vResult.data() + nStart,
+                     nStop - nStart, 1, GDT_Float64, 0, 0))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "RasterIO error when writing target raster at position "
                  "(%d,%d), size (%d,%d)",
-                 0, nLine - oOutExtent.yStart, oOutExtent.xSize(), 1);
+                 nStart, nLine - oOutExtent.yStart, nStop - nStart, 1);
         return false;
     }
     return true;
 }
 
-/// Emit progress information saying that a line has been written to output.
+/// Emit progress information saying that lines, or halves of lines, have
+/// been written to output.
 ///
+/// @param nHalfLines  Number of halves of lines written.
 /// @return  True on success, false otherwise.
-bool Viewshed::lineProgress()
+bool Viewshed::lineProgress(int nHalfLines)
 {
-    if (nLineCount < oCurExtent.ySize())
-        nLineCount++;
-    return emitProgress(nLineCount / static_cast<double>(oCurExtent.ySize()));
+    std::lock_guard g(pMutex);
+
+    nLineCount = std::min(nLineCount + nHalfLines, 2 * oCurExtent.ySize());
+    return emitProgress(nLineCount / (2.0 * oCurExtent.ySize()));
 }
 
 /// Emit progress information saying that a fraction of work has been completed.
@@ -814,7 +848,10 @@ bool Viewshed::processFirstLine(int nX, int nY,
         if (oOpts.outputMode == OutputMode::Normal)
             vResult[nX] = oOpts.visibleVal;
     }
-    dfHeightAdjFactor = CalcHeightAdjFactor(poDstDS.get(), oOpts.curveCoeff);
+    if (!pdfDEM)
+        dfHeightAdjFactor = CalcHeightAdjFactor(
+            GDALDataset::FromHandle(GDALGetBandDataset(pSrcBand)),
+            oOpts.curveCoeff);
 
     // In DEM mode the base is the pre-adjustment value.  In ground mode the base is zero.
     if (oOpts.outputMode == OutputMode::DEM)
@@ -825,6 +862,11 @@ bool Viewshed::processFirstLine(int nX, int nY,
 
     if (!oCurExtent.containsY(nY))
         processFirstLineTopOrBottom(iLeft, iRight, vResult, vThisLineVal);
+    else if (!bParallel)
+    {
+        processFirstLineLeft(nX, nX - 1, iLeft - 1, vResult, vThisLineVal);
+        processFirstLineRight(nX, nX + 1, iRight, vResult, vThisLineVal);
+    }
     else
     {
         auto t1 = std::async(std::launch::async,
@@ -846,10 +888,10 @@ bool Viewshed::processFirstLine(int nX, int nY,
     vLastLineVal = std::move(vThisLineVal);
 
     // Create the output writer.
-    if (!writeLine(nLine, vResult))
+    if (!writeLine(nLine, vResult, 0, oCurExtent.xSize()))
         return false;
 
-    if (!lineProgress())
+    if (!lineProgress(2))
         return false;
     return true;
 }
@@ -885,9 +927,14 @@ void Viewshed::processFirstLineTopOrBottom(int iLeft, int iRight,
 /// @param nLine  Line number being processed.
 /// @param vLastLineVal  Vector in which to store the read line. Becomes the last line
 ///    in further processing.
+/// @param bLeft  Whether to process and write the part of the line to the
+///    left of the observer.
+/// @param bRight  Whether to process and write the part of the line to the
+///    right of the observer, including the cell below or above it.
 /// @return True on success, false otherwise.
 bool Viewshed::processLine(int nX, int nY, int nLine,
-                           std::vector<double> &vLastLineVal)
+                           std::vector<double> &vLastLineVal, bool bLeft,
+                           bool bRight)
 {
     int nYOffset = nLine - nY;
     std::vector<double> vResult(oOutExtent.xSize());
@@ -920,36 +967,87 @@ bool Viewshed::processLine(int nX, int nY, int nLine,
             vResult[nX] = oOpts.outOfRangeVal;
     }
 
-    // process left half then right half of line
-    auto t1 =
-        std::async(std::launch::async,
-                   [&, left = iLeft]()
-                   {
-                       processLineLeft(nX, nYOffset, nX - 1, left - 1, vResult,
-                                       vThisLineVal, vLastLineVal);
-                   });
-
-    auto t2 =
-        std::async(std::launch::async,
-                   [&, right = iRight]()
-                   {
-                       processLineRight(nX, nYOffset, nX + 1, right, vResult,
-                                        vThisLineVal, vLastLineVal);
-                   });
-    t1.wait();
-    t2.wait();
+    // The left and right halves of the line only depend on the cell below or
+    // above the observer, which is computed above.
+    if (bLeft)
+        processLineLeft(nX, nYOffset, nX - 1, iLeft - 1, vResult, vThisLineVal,
+                        vLastLineVal);
+    if (bRight)
+        processLineRight(nX, nYOffset, nX + 1, iRight, vResult, vThisLineVal,
+                         vLastLineVal);
 
     // Make the current line the last line.
     vLastLineVal = std::move(vThisLineVal);
 
-    if (!writeLine(nLine, vResult))
+    const int nSplit = std::clamp(nX, 0, oCurExtent.xSize());
+    if (!writeLine(nLine, vResult, bLeft ? 0 : nSplit,
+                   bRight ? oCurExtent.xSize() : nSplit))
         return false;
 
-    if (!lineProgress())
+    if (!lineProgress(bLeft && bRight ? 2 : 1))
         return false;
     return true;
 }
 
+/// Process the lines above or below the observer line, from the observer
+/// outwards.
+///
+/// @param nX  X location of the observer
+/// @param nY  Y location of the observer
+/// @param bUp  Whether to process the lines above the observer line, or below.
+/// @param bLeft  Whether to process the left part of the lines.
+/// @param bRight  Whether to process the right part of the lines.
+/// @param vFirstLineVal  Observable heights of the observer line.
+/// @param err  Error flag, shared with the other parts being processed.
+/// @return True on success, false otherwise.
+bool Viewshed::processLines(int nX, int nY, bool bUp, bool bLeft, bool bRight,
+                            const std::vector<double> &vFirstLineVal,
+                            std::atomic<bool> &err)
+{
+    std::vector<double> vLastLineVal = vFirstLineVal;
+    const int yStart = oCurExtent.clampY(nY);
+
+    if (bUp)
+    {
+        for (int nLine = yStart - 1; nLine >= oCurExtent.yStart && !err;
+             nLine--)
+            if (!processLine(nX, nY, nLine, vLastLineVal, bLeft, bRight))
+                err = true;
+    }
+    else
+    {
+        for (int nLine = yStart + 1; nLine < oCurExtent.yStop && !err; nLine++)
+            if (!processLine(nX, nY, nLine, vLastLineVal, bLeft, bRight))
+                err = true;
+    }
+    return !err;
+}
+
+/// Calculate the position of the observer in raster coordinates.
+///
+/// @param nX  Set to the X position of the observer.
+/// @param nY  Set to the Y position of the observer.
+/// @return  False if the position is out of range.
+bool Viewshed::calcObserverPosition(int &nX, int &nY)
+{
+    double dfX, dfY;
+    GDALApplyGeoTransform(adfInvTransform.data(), oOpts.observer.x,
+                          oOpts.observer.y, &dfX, &dfY);
+    if (!GDALIsValueInRange<int>(dfX))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Observer X value out of range");
+        return false;
+    }
+    if (!GDALIsValueInRange<int>(dfY))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Observer Y value out of range");
+        return false;
+    }
+    nX = static_cast<int>(dfX);
+    nY = static_cast<int>(dfY);
+    return true;
+}
+
 /// Compute the viewshed of a raster band.
 ///
 /// @param band  Pointer to the raster band to be processed.
@@ -969,9 +1067,9 @@ bool Viewshed::run(GDALRasterBandH band, GDALProgressFunc pfnProgress,
     if (!emitProgress(0))
         return false;
 
-    // set up geotransformation
+    // set up geotransformation (already done by runCumulative())
     GDALDatasetH hSrcDS = GDALGetBandDataset(pSrcBand);
-    if (hSrcDS != nullptr)
+    if (hSrcDS != nullptr && !pdfDEM)
         GDALGetGeoTransform(hSrcDS, adfTransform.data());
 
     if (!GDALInvGeoTransform(adfTransform.data(), adfInvTransform.data()))
@@ -981,21 +1079,9 @@ bool Viewshed::run(GDALRasterBandH band, GDALProgressFunc pfnProgress,
     }
 
     // calculate observer position
-    double dfX, dfY;
-    GDALApplyGeoTransform(adfInvTransform.data(), oOpts.observer.x,
-                          oOpts.observer.y, &dfX, &dfY);
-    if (!GDALIsValueInRange<int>(dfX))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Observer X value out of range");
-        return false;
-    }
-    if (!GDALIsValueInRange<int>(dfY))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Observer Y value out of range");
+    int nX, nY;
+    if (!calcObserverPosition(nX, nY))
         return false;
-    }
-    int nX = static_cast<int>(dfX);
-    int nY = static_cast<int>(dfY);
 
     // calculate the area of interest
     if (!calcOutputExtent(nX, nY))
@@ -1007,8 +1093,8 @@ bool Viewshed::run(GDALRasterBandH band, GDALProgressFunc pfnProgress,
     oCurExtent.shiftX(-oOutExtent.xStart);
     nX -= oOutExtent.xStart;
 
-    // create the output dataset
-    if (!createOutputDataset())
+    // create the output dataset, unless visible cells are counted
+    if (!panVisibleCount && !createOutputDataset())
         return false;
 
     std::vector<double> vFirstLineVal(oCurExtent.xSize());
@@ -1025,35 +1111,36 @@ bool Viewshed::run(GDALRasterBandH band, GDALProgressFunc pfnProgress,
     else if (oOpts.cellMode == CellMode::Max)
         oZcalc = doMax;
 
-    // scan upwards
-    int yStart = oCurExtent.clampY(nY);
     std::atomic<bool> err(false);
-    auto tUp = std::async(std::launch::async,
-                          [&]()
-                          {
-                              std::vector<double> vLastLineVal = vFirstLineVal;
-
-                              for (int nLine = yStart - 1;
-                                   nLine >= oCurExtent.yStart && !err; nLine--)
-                                  if (!processLine(nX, nY, nLine, vLastLineVal))
-                                      err = true;
-                          });
-
-    // scan downwards
-    auto tDown =
-        std::async(std::launch::async,
-                   [&]()
-                   {
-                       std::vector<double> vLastLineVal = vFirstLineVal;
-
-                       for (int nLine = yStart + 1;
-                            nLine < oCurExtent.yStop && !err; nLine++)
-                           if (!processLine(nX, nY, nLine, vLastLineVal))
-                               err = true;
-                   });
-
-    tUp.wait();
-    tDown.wait();
+    if (bParallel)
+    {
+        // Scan the four quadrants around the observer in parallel. Each of
+        // them keeps its own copy of the previous line.
+        std::array<std::future<bool>, 4> aoQuadrants;
+        for (int i = 0; i < 4; ++i)
+        {
+            const bool bUp = i < 2;
+            const bool bLeft = (i % 2) == 0;
+            aoQuadrants[i] =
+                std::async(std::launch::async,
+                           [&, bUp, bLeft]()
+                           {
+                               return processLines(nX, nY, bUp, bLeft, !bLeft,
+                                                   vFirstLineVal, err);
+                           });
+        }
+        for (auto &oQuadrant : aoQuadrants)
+            oQuadrant.wait();
+    }
+    else
+    {
+        // scan upwards, then downwards
+        processLines(nX, nY, true, true, true, vFirstLineVal, err);
+        processLines(nX, nY, false, true, true, vFirstLineVal, err);
+    }
+
+    if (err)
+        return false;
 
     if (!emitProgress(1))
         return false;
@@ -1061,4 +1148,262 @@ bool Viewshed::run(GDALRasterBandH band, GDALProgressFunc pfnProgress,
     return true;
 }
 
+namespace
+{
+
+// Viewshed of one observer, computed by runCumulative().
+struct CumulativeViewshedJob
+{
+    const Viewshed::Options *psOpts = nullptr;
+    Viewshed::Point sObserver{0, 0, 0};
+    GDALRasterBandH hBand = nullptr;
+    const std::array<double, 6> *padfTransform = nullptr;
+    double dfHeightAdjFactor = 0;
+    const double *pdfDEM = nullptr;
+    std::atomic<uint32_t> *panVisibleCount = nullptr;
+    std::atomic<bool> *pbStop = nullptr;
+    std::atomic<bool> *pbErr = nullptr;
+};
+
+}  // unnamed namespace
+
+/// Run the viewshed of one observer of runCumulative().
+///
+/// @param pData  Pointer to a CumulativeViewshedJob.
+void Viewshed::cumulativeJob(void *pData)
+{
+    const auto psJob = static_cast<const CumulativeViewshedJob *>(pData);
+    if (*psJob->pbStop || *psJob->pbErr)
+        return;
+
+    Options oOpts = *psJob->psOpts;
+    oOpts.observer = psJob->sObserver;
+
+    Viewshed oViewshed(oOpts);
+    oViewshed.pdfDEM = psJob->pdfDEM;
+    oViewshed.panVisibleCount = psJob->panVisibleCount;
+    oViewshed.adfTransform = *psJob->padfTransform;
+    oViewshed.dfHeightAdjFactor = psJob->dfHeightAdjFactor;
+    // Observers are already processed in parallel.
+    oViewshed.bParallel = false;
+    if (!oViewshed.run(psJob->hBand))
+        *psJob->pbErr = true;
+}
+
+/// Compute the cumulative viewshed of several observers: the number of
+/// observers from which each cell of the DEM is visible.
+///
+/// The DEM is read once and shared by the viewsheds of all observers, which
+/// are computed in parallel. The output dataset has the extent and
+/// georeferencing of the DEM, and a single band of type UInt32.
+///
+/// @param opts  Options to use when calculating the viewsheds. The observer,
+///    the output mode and the output values are ignored.
+/// @param observers  X, Y and Z (height above the DEM) of the observers, in
+///    georeferenced coordinates. Observers whose viewshed cannot be computed,
+///    for example because their maximum distance doesn't reach the DEM, are
+///    skipped with a warning.
+/// @param hBand  The band to read the DEM data from.
+/// @param nThreads  Number of threads to use.
+/// @param pfnProgress  Pointer to the progress function. Can be null.
+/// @param pProgressArg  Argument passed to the progress function
+/// @return  The cumulative viewshed dataset, or null in case of error.
+/// @since GDAL 3.10
+std::unique_ptr<GDALDataset> Viewshed::runCumulative(
+    const Options &opts, const std::vector<Point> &observers,
+    GDALRasterBandH hBand, int nThreads, GDALProgressFunc pfnProgress,
+    void *pProgressArg)
+{
+    if (!pfnProgress)
+        pfnProgress = GDALDummyProgress;
+    if (!pfnProgress(0, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+
+    GDALRasterBand *poSrcBand = GDALRasterBand::FromHandle(hBand);
+    const int nXSize = poSrcBand->GetXSize();
+    const int nYSize = poSrcBand->GetYSize();
+    const size_t nCells = static_cast<size_t>(nXSize) * nYSize;
+
+    // Read the whole DEM once.
+    std::vector<double> adfDEM;
+    std::vector<std::atomic<uint32_t>> anVisibleCount;
+    try
+    {
+        adfDEM.resize(nCells);
+        anVisibleCount = std::vector<std::atomic<uint32_t>>(nCells);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate memory for cumulative viewshed");
+        return nullptr;
+    }
+    if (poSrcBand->RasterIO(GF_Read, 0, 0, nXSize, nYSize, adfDEM.data(),
+                            nXSize, nYSize, GDT_Float64, 0, 0,
+                            nullptr) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "RasterIO error when reading DEM");
+        return nullptr;
+    }
+
+    // Fetch the georeferencing once, as it isn't thread-safe.
+    GDALDataset *poSrcDS = poSrcBand->GetDataset();
+    std::array<double, 6> adfTransform{0, 1, 0, 0, 0, 1};
+    if (poSrcDS)
+        poSrcDS->GetGeoTransform(adfTransform.data());
+    const double dfHeightAdjFactor =
+        CalcHeightAdjFactor(poSrcDS, opts.curveCoeff);
+
+    Options oOpts = opts;
+    oOpts.outputMode = OutputMode::Normal;
+    oOpts.visibleVal = 1;
+    oOpts.invisibleVal = 0;
+    oOpts.outOfRangeVal = 0;
+
+    std::array<double, 6> adfInvTransform{};
+    if (!GDALInvGeoTransform(adfTransform.data(), adfInvTransform.data()))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot invert geotransform");
+        return nullptr;
+    }
+
+    std::atomic<bool> bStop(false);
+    std::atomic<bool> bErr(false);
+    std::vector<CumulativeViewshedJob> asJobs;
+    asJobs.reserve(observers.size());
+    for (size_t i = 0; i < observers.size(); ++i)
+    {
+        // Skip the observers for which run() would fail, so that they don't
+        // fail the whole computation.
+        Options oObserverOpts = oOpts;
+        oObserverOpts.observer = observers[i];
+        Viewshed oViewshed(oObserverOpts);
+        oViewshed.pSrcBand = poSrcBand;
+        oViewshed.adfInvTransform = adfInvTransform;
+        std::string osReason;
+        {
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            int nX = 0;
+            int nY = 0;
+            if (!oViewshed.calcObserverPosition(nX, nY) ||
+                !oViewshed.calcOutputExtent(nX, nY))
+                osReason = CPLGetLastErrorMsg();
+        }
+        if (!osReason.empty())
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Skipping observer %d at (%g, %g): %s",
+                     static_cast<int>(i), observers[i].x, observers[i].y,
+                     osReason.c_str());
+            continue;
+        }
+
+        asJobs.emplace_back();
+        auto &sJob = asJobs.back();
+        sJob.psOpts = &oOpts;
+        sJob.sObserver = observers[i];
+        sJob.hBand = hBand;
+        sJob.padfTransform = &adfTransform;
+        sJob.dfHeightAdjFactor = dfHeightAdjFactor;
+        sJob.pdfDEM = adfDEM.data();
+        sJob.panVisibleCount = anVisibleCount.data();
+        sJob.pbStop = &bStop;
+        sJob.pbErr = &bErr;
+    }
+
+    const int nJobs = static_cast<int>(asJobs.size());
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nJobs > 1 ? GDALGetGlobalThreadPool(nThreads)
+                                  : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if (poJobQueue)
+    {
+        for (auto &sJob : asJobs)
+        {
+            if (!poJobQueue->SubmitJob(cumulativeJob, &sJob))
+            {
+                bErr = true;
+                break;
+            }
+        }
+        for (int nRemaining = nJobs - 1; nRemaining >= 0 && !bStop;
+             --nRemaining)
+        {
+            poJobQueue->WaitCompletion(nRemaining);
+            if (!bErr && !pfnProgress(0.95 * (nJobs - nRemaining) / nJobs, "",
+                                      pProgressArg))
+                bStop = true;
+        }
+        poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        for (int i = 0; i < nJobs && !bStop && !bErr; ++i)
+        {
+            cumulativeJob(&asJobs[i]);
+            if (!pfnProgress(0.95 * (i + 1) / nJobs, "", pProgressArg))
+                bStop = true;
+        }
+    }
+
+    if (bStop)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+    if (bErr)
+        return nullptr;
+
+    // Create the output dataset.
+    GDALDriver *poDriver = GetGDALDriverManager()->GetDriverByName(
+        oOpts.outputFormat.c_str());
+    if (!poDriver)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot get driver");
+        return nullptr;
+    }
+    std::unique_ptr<GDALDataset> poDstDS(poDriver->Create(
+        oOpts.outputFilename.c_str(), nXSize, nYSize, 1, GDT_UInt32,
+        const_cast<char **>(oOpts.creationOpts.List())));
+    if (!poDstDS)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Cannot create dataset for %s",
+                 oOpts.outputFilename.c_str());
+        return nullptr;
+    }
+    if (poSrcDS)
+        poDstDS->SetSpatialRef(poSrcDS->GetSpatialRef());
+    poDstDS->SetGeoTransform(adfTransform.data());
+
+    std::vector<uint32_t> anLine(nXSize);
+    GDALRasterBand *poDstBand = poDstDS->GetRasterBand(1);
+    for (int nLine = 0; nLine < nYSize; ++nLine)
+    {
+        const auto *panCount =
+            anVisibleCount.data() + static_cast<size_t>(nLine) * nXSize;
+        for (int i = 0; i < nXSize; ++i)
+            anLine[i] = panCount[i].load(std::memory_order_relaxed);
+        if (poDstBand->RasterIO(GF_Write, 0, nLine, nXSize, 1, anLine.data(),
+                                nXSize, 1, GDT_UInt32, 0, 0,
+                                nullptr) != CE_None)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "RasterIO error when writing target raster at line %d",
+                     nLine);
+            return nullptr;
+        }
+    }
+
+    if (!pfnProgress(1, "", pProgressArg))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return nullptr;
+    }
+    return poDstDS;
+}
+
 }  // namespace gdal
@@ -27,12 +27,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "cpl_progress.h"
 #include "gdal_priv.h"
@@ -184,7 +186,8 @@ class Viewshed
           dfMaxDistance2{opts.maxDistance * opts.maxDistance},
           dfZObserver{0}, poDstDS{}, pSrcBand{}, pDstBand{},
           dfHeightAdjFactor{0}, nLineCount{0}, adfTransform{0, 1, 0, 0, 0, 1},
-          adfInvTransform{}, oProgress{}, oZcalc{}, oMutex{}, iMutex{}
+          adfInvTransform{}, oProgress{}, oZcalc{}, oMutex{}, iMutex{},
+          pMutex{}
     {
         if (dfMaxDistance2 == 0)
             dfMaxDistance2 = std::numeric_limits<double>::max();
@@ -197,6 +200,12 @@ class Viewshed
                      GDALProgressFunc pfnProgress = GDALDummyProgress,
                      void *pProgressArg = nullptr);
 
+    CPL_DLL static std::unique_ptr<GDALDataset>
+    runCumulative(const Options &opts, const std::vector<Point> &observers,
+                  GDALRasterBandH hBand, int nThreads,
+                  GDALProgressFunc pfnProgress = GDALDummyProgress,
+                  void *pProgressArg = nullptr);
+
     /**
      * Fetch a pointer to the created raster band.
      *
@@ -226,13 +235,29 @@ class Viewshed
     ZCalc oZcalc;
     std::mutex oMutex;
     std::mutex iMutex;
+    std::mutex pMutex;
+
+    // When set, the DEM of the whole source band, read once by
+    // runCumulative() and shared by the viewsheds of all observers.
+    const double *pdfDEM{};
+    // When set, the visible cells are counted there (one counter per cell of
+    // the source band) instead of being written to an output dataset.
+    std::atomic<uint32_t> *panVisibleCount{};
+    // Whether the quadrants around the observer are processed in parallel.
+    bool bParallel{true};
 
+    static void cumulativeJob(void *pData);
     void setOutput(double &dfResult, double &dfCellVal, double dfZ);
     double calcHeight(double dfZ, double dfZ2);
     bool readLine(int nLine, double *data);
-    bool writeLine(int nLine, std::vector<double> &vResult);
+    bool writeLine(int nLine, std::vector<double> &vResult, int nStart,
+                   int nStop);
     bool processLine(int nX, int nY, int nLine,
-                     std::vector<double> &vLastLineVal);
+                     std::vector<double> &vLastLineVal, bool bLeft,
+                     bool bRight);
+    bool processLines(int nX, int nY, bool bUp, bool bLeft, bool bRight,
+                      const std::vector<double> &vFirstLineVal,
+                      std::atomic<bool> &err);
     bool processFirstLine(int nX, int nY, std::vector<double> &vLastLineVal);
     void processFirstLineLeft(int nX, int iStart, int iEnd,
                               std::vector<double> &vResult,
@@ -253,9 +278,10 @@ class Viewshed
                           std::vector<double> &vLastLineVal);
     std::pair<int, int> adjustHeight(int iLine, int nX,
                                      std::vector<double> &thisLineVal);
+    bool calcObserverPosition(int &nX, int &nY);
     bool calcOutputExtent(int nX, int nY);
     bool createOutputDataset();
-    bool lineProgress();
+    bool lineProgress(int nHalfLines);
     bool emitProgress(double fraction);
 };
 
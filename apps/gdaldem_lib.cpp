@@ -111,13 +111,17 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 
 #if defined(__SSE2__) || defined(_M_X64)
 #define HAVE_16_SSE_REG
@@ -295,95 +299,44 @@ GInt32 INTERPOL(GInt32 a, GInt32 b, int bSrcHasNoData, GInt32 fSrcNoDataValue)
 }
 
 /************************************************************************/
-/*                  GDALGeneric3x3Processing()                          */
+/*                   GDALGeneric3x3ProcessingLines()                    */
 /************************************************************************/
 
-template <class T>
-static CPLErr GDALGeneric3x3Processing(
-    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
-    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
-    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
-        pfnAlg_multisample,
-    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
-    void *pProgressData)
+template <class T> struct GDALGeneric3x3ProcessingParams
 {
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
-
-    /* -------------------------------------------------------------------- */
-    /*      Initialize progress counter.                                    */
-    /* -------------------------------------------------------------------- */
-    if (!pfnProgress(0.0, nullptr, pProgressData))
-    {
-        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
-    }
-
-    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
-
-    // 1 line destination buffer.
-    float *pafOutputBuf =
-        static_cast<float *>(VSI_MALLOC2_VERBOSE(sizeof(float), nXSize));
-    // 3 line rotating source buffer.
-    T *pafThreeLineWin =
-        static_cast<T *>(VSI_MALLOC2_VERBOSE(3 * sizeof(T), nXSize + 1));
-    if (pafOutputBuf == nullptr || pafThreeLineWin == nullptr)
-    {
-        VSIFree(pafOutputBuf);
-        VSIFree(pafThreeLineWin);
-        return CE_Failure;
-    }
-
-    GDALDataType eReadDT;
-    int bSrcHasNoData = FALSE;
-    const double dfNoDataValue =
-        GDALGetRasterNoDataValue(hSrcBand, &bSrcHasNoData);
-
-    int bIsSrcNoDataNan = FALSE;
+    int nXSize = 0;
+    int nYSize = 0;
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg = nullptr;
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample = nullptr;
+    void *pData = nullptr;
+    bool bComputeAtEdges = false;
+    bool bSrcHasNoData = false;
+    bool bIsSrcNoDataNan = false;
     T fSrcNoDataValue = 0;
-    if (std::numeric_limits<T>::is_integer)
-    {
-        eReadDT = GDT_Int32;
-        if (bSrcHasNoData)
-        {
-            GDALDataType eSrcDT = GDALGetRasterDataType(hSrcBand);
-            CPLAssert(eSrcDT == GDT_Byte || eSrcDT == GDT_UInt16 ||
-                      eSrcDT == GDT_Int16);
-            const int nMinVal = (eSrcDT == GDT_Byte)     ? 0
-                                : (eSrcDT == GDT_UInt16) ? 0
-                                                         : -32768;
-            const int nMaxVal = (eSrcDT == GDT_Byte)     ? 255
-                                : (eSrcDT == GDT_UInt16) ? 65535
-                                                         : 32767;
-
-            if (fabs(dfNoDataValue - floor(dfNoDataValue + 0.5)) < 1e-2 &&
-                dfNoDataValue >= nMinVal && dfNoDataValue <= nMaxVal)
-            {
-                fSrcNoDataValue = static_cast<T>(floor(dfNoDataValue + 0.5));
-            }
-            else
-            {
-                bSrcHasNoData = FALSE;
-            }
-        }
-    }
-    else
-    {
-        eReadDT = GDT_Float32;
-        fSrcNoDataValue = static_cast<T>(dfNoDataValue);
-        bIsSrcNoDataNan = bSrcHasNoData && CPLIsNan(dfNoDataValue);
-    }
-
-    int bDstHasNoData = FALSE;
-    float fDstNoDataValue =
-        static_cast<float>(GDALGetRasterNoDataValue(hDstBand, &bDstHasNoData));
-    if (!bDstHasNoData)
-        fDstNoDataValue = 0.0;
+    float fDstNoDataValue = 0;
+};
 
-    int nLine1Off = 0;
-    int nLine2Off = nXSize;
-    int nLine3Off = 2 * nXSize;
+// Compute the output lines [iYStart, iYEnd[ into pafOutputBuf, from the
+// source lines [iSrcYOff, ...[ stored in pafSrcBuf, which must include the
+// lines just above and below the output lines when they exist.
+// pabyLineHasNoData[i] tells whether source line iSrcYOff + i has nodata
+// values.
+template <class T>
+static void GDALGeneric3x3ProcessingLines(
+    const GDALGeneric3x3ProcessingParams<T> &sParams, const T *pafSrcBuf,
+    const GByte *pabyLineHasNoData, int iSrcYOff, int iYStart, int iYEnd,
+    float *pafOutputBuf)
+{
+    const int nXSize = sParams.nXSize;
+    const int nYSize = sParams.nYSize;
+    const auto pfnAlg = sParams.pfnAlg;
+    void *const pData = sParams.pData;
+    const bool bComputeAtEdges = sParams.bComputeAtEdges;
+    const bool bSrcHasNoData = sParams.bSrcHasNoData;
+    const bool bIsSrcNoDataNan = sParams.bIsSrcNoDataNan;
+    const T fSrcNoDataValue = sParams.fSrcNoDataValue;
+    const float fDstNoDataValue = sParams.fDstNoDataValue;
 
     // Move a 3x3 pafWindow over each cell
     // (where the cell in question is #4)
@@ -392,143 +345,91 @@ static CPLErr GDALGeneric3x3Processing(
     //      3 4 5
     //      6 7 8
 
-    /* Preload the first 2 lines */
-
-    bool abLineHasNoDataValue[3] = {CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData),
-                                    CPL_TO_BOOL(bSrcHasNoData)};
-
-    // Create an extra scope for VC12 to ignore i.
+    for (int i = iYStart; i < iYEnd; ++i, pafOutputBuf += nXSize)
     {
-        for (int i = 0; i < 2 && i < nYSize; i++)
+        if (i == 0 || i == nYSize - 1)
         {
-            if (GDALRasterIO(hSrcBand, GF_Read, 0, i, nXSize, 1,
-                             pafThreeLineWin + i * nXSize, nXSize, 1, eReadDT,
-                             0, 0) != CE_None)
+            if (!(bComputeAtEdges && nXSize >= 2 && nYSize >= 2))
             {
-                CPLFree(pafOutputBuf);
-                CPLFree(pafThreeLineWin);
-
-                return CE_Failure;
-            }
-            if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-            {
-                abLineHasNoDataValue[i] = false;
-                for (int iX = 0; iX < nXSize; iX++)
+                // Exclude the edges
+                for (int j = 0; j < nXSize; j++)
                 {
-                    if (pafThreeLineWin[i * nXSize + iX] == fSrcNoDataValue)
-                    {
-                        abLineHasNoDataValue[i] = true;
-                        break;
-                    }
+                    pafOutputBuf[j] = fDstNoDataValue;
                 }
             }
-        }
-    }  // End extra scope for VC12
-
-    CPLErr eErr = CE_None;
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
-    {
-        for (int j = 0; j < nXSize; j++)
-        {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                INTERPOL(pafThreeLineWin[jmin], pafThreeLineWin[nXSize + jmin],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[j], pafThreeLineWin[nXSize + j],
-                         bSrcHasNoData, fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[jmax], pafThreeLineWin[nXSize + jmax],
-                         bSrcHasNoData, fSrcNoDataValue),
-                pafThreeLineWin[jmin],
-                pafThreeLineWin[j],
-                pafThreeLineWin[jmax],
-                pafThreeLineWin[nXSize + jmin],
-                pafThreeLineWin[nXSize + j],
-                pafThreeLineWin[nXSize + jmax]};
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-    }
-    else
-    {
-        // Exclude the edges
-        for (int j = 0; j < nXSize; j++)
-        {
-            pafOutputBuf[j] = fDstNoDataValue;
-        }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, 0, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-
-        if (eErr == CE_None && nYSize > 1)
-        {
-            eErr = GDALRasterIO(hDstBand, GF_Write, 0, nYSize - 1, nXSize, 1,
-                                pafOutputBuf, nXSize, 1, GDT_Float32, 0, 0);
-        }
-    }
-    if (eErr != CE_None)
-    {
-        CPLFree(pafOutputBuf);
-        CPLFree(pafThreeLineWin);
-
-        return eErr;
-    }
-
-    int i = 1;  // Used after for.
-    for (; i < nYSize - 1; i++)
-    {
-        /* Read third line of the line buffer */
-        eErr =
-            GDALRasterIO(hSrcBand, GF_Read, 0, i + 1, nXSize, 1,
-                         pafThreeLineWin + nLine3Off, nXSize, 1, eReadDT, 0, 0);
-        if (eErr != CE_None)
-        {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
-
-            return eErr;
-        }
-
-        // In case none of the 3 lines have nodata values, then no need to
-        // check it in ComputeVal()
-        bool bOneOfThreeLinesHasNoData = CPL_TO_BOOL(bSrcHasNoData);
-        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
-        {
-            bool bLastLineHasNoDataValue = false;
-            int iX = 0;
-            for (; iX + 3 < nXSize; iX += 4)
+            else if (i == 0)
             {
-                if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 1] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 2] == fSrcNoDataValue ||
-                    pafThreeLineWin[nLine3Off + iX + 3] == fSrcNoDataValue)
+                const T *pafLine2 = pafSrcBuf;
+                const T *pafLine3 = pafSrcBuf + nXSize;
+                for (int j = 0; j < nXSize; j++)
                 {
-                    bLastLineHasNoDataValue = true;
-                    break;
+                    int jmin = (j == 0) ? j : j - 1;
+                    int jmax = (j == nXSize - 1) ? j : j + 1;
+
+                    T afWin[9] = {
+                        INTERPOL(pafLine2[jmin], pafLine3[jmin], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                        INTERPOL(pafLine2[j], pafLine3[j], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                        INTERPOL(pafLine2[jmax], pafLine3[jmax], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                        pafLine2[jmin],
+                        pafLine2[j],
+                        pafLine2[jmax],
+                        pafLine3[jmin],
+                        pafLine3[j],
+                        pafLine3[jmax]};
+                    pafOutputBuf[j] = ComputeVal(
+                        bSrcHasNoData, fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                        fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
                 }
             }
-            if (!bLastLineHasNoDataValue)
+            else
             {
-                for (; iX < nXSize; iX++)
+                const T *pafLine1 =
+                    pafSrcBuf + static_cast<size_t>(i - 1 - iSrcYOff) * nXSize;
+                const T *pafLine2 = pafLine1 + nXSize;
+                for (int j = 0; j < nXSize; j++)
                 {
-                    if (pafThreeLineWin[nLine3Off + iX] == fSrcNoDataValue)
-                    {
-                        bLastLineHasNoDataValue = true;
-                    }
+                    int jmin = (j == 0) ? j : j - 1;
+                    int jmax = (j == nXSize - 1) ? j : j + 1;
+
+                    T afWin[9] = {
+                        pafLine1[jmin],
+                        pafLine1[j],
+                        pafLine1[jmax],
+                        pafLine2[jmin],
+                        pafLine2[j],
+                        pafLine2[jmax],
+                        INTERPOL(pafLine2[jmin], pafLine1[jmin], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                        INTERPOL(pafLine2[j], pafLine1[j], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                        INTERPOL(pafLine2[jmax], pafLine1[jmax], bSrcHasNoData,
+                                 fSrcNoDataValue),
+                    };
+
+                    pafOutputBuf[j] = ComputeVal(
+                        bSrcHasNoData, fSrcNoDataValue, bIsSrcNoDataNan, afWin,
+                        fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
                 }
             }
-            abLineHasNoDataValue[nLine3Off / nXSize] = bLastLineHasNoDataValue;
-
-            bOneOfThreeLinesHasNoData = abLineHasNoDataValue[0] ||
-                                        abLineHasNoDataValue[1] ||
-                                        abLineHasNoDataValue[2];
+            continue;
         }
 
+        const T *pafThreeLineWin =
+            pafSrcBuf + static_cast<size_t>(i - 1 - iSrcYOff) * nXSize;
+        constexpr int nLine1Off = 0;
+        const int nLine2Off = nXSize;
+        const int nLine3Off = 2 * nXSize;
+
+        // In case none of the 3 lines have nodata values, then no need to
+        // check it in ComputeVal()
+        const bool bOneOfThreeLinesHasNoData =
+            bSrcHasNoData && (pabyLineHasNoData[i - 1 - iSrcYOff] ||
+                              pabyLineHasNoData[i - iSrcYOff] ||
+                              pabyLineHasNoData[i + 1 - iSrcYOff]);
+
         if (bComputeAtEdges && nXSize >= 2)
         {
             int j = 0;
@@ -548,10 +449,9 @@ static CPLErr GDALGeneric3x3Processing(
                           pafThreeLineWin[nLine3Off + j],
                           pafThreeLineWin[nLine3Off + j + 1]};
 
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            pafOutputBuf[j] = ComputeVal(
+                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
+                afWin, fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
         }
         else
         {
@@ -560,10 +460,11 @@ static CPLErr GDALGeneric3x3Processing(
         }
 
         int j = 1;
-        if (pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
+        if (sParams.pfnAlg_multisample && !bOneOfThreeLinesHasNoData)
         {
-            j = pfnAlg_multisample(pafThreeLineWin, nLine1Off, nLine2Off,
-                                   nLine3Off, nXSize, pData, pafOutputBuf);
+            j = sParams.pfnAlg_multisample(pafThreeLineWin, nLine1Off,
+                                           nLine2Off, nLine3Off, nXSize, pData,
+                                           pafOutputBuf);
         }
 
         for (; j < nXSize - 1; j++)
@@ -578,10 +479,9 @@ static CPLErr GDALGeneric3x3Processing(
                           pafThreeLineWin[nLine3Off + j],
                           pafThreeLineWin[nLine3Off + j + 1]};
 
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            pafOutputBuf[j] = ComputeVal(
+                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
+                afWin, fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
         }
 
         if (bComputeAtEdges && nXSize >= 2)
@@ -604,10 +504,9 @@ static CPLErr GDALGeneric3x3Processing(
                                    pafThreeLineWin[nLine3Off + j - 1],
                                    bSrcHasNoData, fSrcNoDataValue)};
 
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bOneOfThreeLinesHasNoData),
-                           fSrcNoDataValue, CPL_TO_BOOL(bIsSrcNoDataNan), afWin,
-                           fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
+            pafOutputBuf[j] = ComputeVal(
+                bOneOfThreeLinesHasNoData, fSrcNoDataValue, bIsSrcNoDataNan,
+                afWin, fDstNoDataValue, pfnAlg, pData, bComputeAtEdges);
         }
         else
         {
@@ -615,83 +514,280 @@ static CPLErr GDALGeneric3x3Processing(
             if (nXSize > 1)
                 pafOutputBuf[nXSize - 1] = fDstNoDataValue;
         }
+    }
+}
 
-        /* -----------------------------------------
-         * Write Line to Raster
-         */
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
+/************************************************************************/
+/*                  GDALGeneric3x3Processing()                          */
+/************************************************************************/
+
+// The raster is processed by batches of horizontal strips. The source lines
+// of a batch, including the line above and below it, are read in a single
+// request, then each strip is computed by a worker thread (when
+// GDAL_NUM_THREADS is set), and the output lines of the batch are written in
+// a single request. The height of strips is a multiple of the block height
+// of the output band whenever memory allows it.
+template <class T>
+static CPLErr GDALGeneric3x3Processing(
+    GDALRasterBandH hSrcBand, GDALRasterBandH hDstBand,
+    typename GDALGeneric3x3ProcessingAlg<T>::type pfnAlg,
+    typename GDALGeneric3x3ProcessingAlg_multisample<T>::type
+        pfnAlg_multisample,
+    void *pData, bool bComputeAtEdges, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    /* -------------------------------------------------------------------- */
+    /*      Initialize progress counter.                                    */
+    /* -------------------------------------------------------------------- */
+    if (!pfnProgress(0.0, nullptr, pProgressData))
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+
+    GDALDataType eReadDT;
+    int bSrcHasNoData = FALSE;
+    const double dfNoDataValue =
+        GDALGetRasterNoDataValue(hSrcBand, &bSrcHasNoData);
+
+    int bIsSrcNoDataNan = FALSE;
+    T fSrcNoDataValue = 0;
+    if (std::numeric_limits<T>::is_integer)
+    {
+        eReadDT = GDT_Int32;
+        if (bSrcHasNoData)
         {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
+            GDALDataType eSrcDT = GDALGetRasterDataType(hSrcBand);
+            CPLAssert(eSrcDT == GDT_Byte || eSrcDT == GDT_UInt16 ||
+                      eSrcDT == GDT_Int16);
+            const int nMinVal = (eSrcDT == GDT_Byte)     ? 0
+                                : (eSrcDT == GDT_UInt16) ? 0
+                                                         : -32768;
+            const int nMaxVal = (eSrcDT == GDT_Byte)     ? 255
+                                : (eSrcDT == GDT_UInt16) ? 65535
+                                                         : 32767;
 
-            return eErr;
+            if (fabs(dfNoDataValue - floor(dfNoDataValue + 0.5)) < 1e-2 &&
+                dfNoDataValue >= nMinVal && dfNoDataValue <= nMaxVal)
+            {
+                fSrcNoDataValue = static_cast<T>(floor(dfNoDataValue + 0.5));
+            }
+            else
+            {
+                bSrcHasNoData = FALSE;
+            }
         }
+    }
+    else
+    {
+        eReadDT = GDT_Float32;
+        fSrcNoDataValue = static_cast<T>(dfNoDataValue);
+        bIsSrcNoDataNan = bSrcHasNoData && CPLIsNan(dfNoDataValue);
+    }
 
-        if (!pfnProgress(1.0 * (i + 1) / nYSize, nullptr, pProgressData))
-        {
-            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-            eErr = CE_Failure;
+    int bDstHasNoData = FALSE;
+    float fDstNoDataValue =
+        static_cast<float>(GDALGetRasterNoDataValue(hDstBand, &bDstHasNoData));
+    if (!bDstHasNoData)
+        fDstNoDataValue = 0.0;
 
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
+    GDALGeneric3x3ProcessingParams<T> sParams;
+    sParams.nXSize = nXSize;
+    sParams.nYSize = nYSize;
+    sParams.pfnAlg = pfnAlg;
+    sParams.pfnAlg_multisample = pfnAlg_multisample;
+    sParams.pData = pData;
+    sParams.bComputeAtEdges = bComputeAtEdges;
+    sParams.bSrcHasNoData = CPL_TO_BOOL(bSrcHasNoData);
+    sParams.bIsSrcNoDataNan = CPL_TO_BOOL(bIsSrcNoDataNan);
+    sParams.fSrcNoDataValue = fSrcNoDataValue;
+    sParams.fDstNoDataValue = fDstNoDataValue;
 
-            return eErr;
-        }
+    /* -------------------------------------------------------------------- */
+    /*      Determine the strip and batch heights.                          */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                 ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads)));
+
+    int nDstBlockXSize = 0;
+    int nDstBlockYSize = 0;
+    GDALGetBlockSize(hDstBand, &nDstBlockXSize, &nDstBlockYSize);
+    nDstBlockYSize = std::max(1, nDstBlockYSize);
+
+    // Memory used by each strip, for its source and output lines.
+    const GIntBig nLineSize =
+        static_cast<GIntBig>(nXSize) * (sizeof(T) + sizeof(float));
+    const GIntBig nMaxStripSize =
+        std::max(static_cast<GIntBig>(10 * 1000 * 1000),
+                 GDALGetCacheMax64() / 10) /
+        nThreads;
+    // Aim at a few dozen lines per strip so that the two extra source lines
+    // of each batch and the synchronization cost are negligible.
+    constexpr int MIN_STRIP_HEIGHT = 32;
+    int nStripHeight = static_cast<int>(
+        std::min(static_cast<GIntBig>(std::max(nYSize, 1)),
+                 std::max(static_cast<GIntBig>(1), nMaxStripSize / nLineSize)));
+    if (nStripHeight >= nDstBlockYSize)
+    {
+        nStripHeight = std::min(
+            nStripHeight / nDstBlockYSize,
+            DIV_ROUND_UP(MIN_STRIP_HEIGHT, nDstBlockYSize)) *
+            nDstBlockYSize;
+    }
+    else
+    {
+        nStripHeight = std::min(nStripHeight, MIN_STRIP_HEIGHT);
+    }
+    nThreads =
+        std::max(1, std::min(nThreads, DIV_ROUND_UP(nYSize, nStripHeight)));
+    const int nBatchHeight = nStripHeight * nThreads;
+
+    // Source lines of a batch, plus one line above and below.
+    T *pafSrcBuf = static_cast<T *>(VSI_MALLOC3_VERBOSE(
+        sizeof(T), nBatchHeight + 2, static_cast<size_t>(nXSize) + 1));
+    float *pafOutputBuf = static_cast<float *>(
+        VSI_MALLOC3_VERBOSE(sizeof(float), nBatchHeight, nXSize));
+    std::vector<GByte> abyLineHasNoData;
+    if (pafSrcBuf == nullptr || pafOutputBuf == nullptr)
+    {
+        VSIFree(pafSrcBuf);
+        VSIFree(pafOutputBuf);
+        return CE_Failure;
+    }
+    try
+    {
+        abyLineHasNoData.resize(nBatchHeight + 2, bSrcHasNoData);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in GDALGeneric3x3Processing()");
+        VSIFree(pafSrcBuf);
+        VSIFree(pafOutputBuf);
+        return CE_Failure;
+    }
 
-        const int nTemp = nLine1Off;
-        nLine1Off = nLine2Off;
-        nLine2Off = nLine3Off;
-        nLine3Off = nTemp;
+    struct Job
+    {
+        const GDALGeneric3x3ProcessingParams<T> *psParams = nullptr;
+        const T *pafSrcBuf = nullptr;
+        const GByte *pabyLineHasNoData = nullptr;
+        int iSrcYOff = 0;
+        int iYStart = 0;
+        int iYEnd = 0;
+        float *pafOutputBuf = nullptr;
+    };
+
+    const auto ProcessJob = [](void *pJob)
+    {
+        const Job *psJob = static_cast<const Job *>(pJob);
+        GDALGeneric3x3ProcessingLines(*(psJob->psParams), psJob->pafSrcBuf,
+                                      psJob->pabyLineHasNoData, psJob->iSrcYOff,
+                                      psJob->iYStart, psJob->iYEnd,
+                                      psJob->pafOutputBuf);
+    };
+
+    std::unique_ptr<CPLJobQueue> poJobQueue;
+    if (nThreads > 1)
+    {
+        CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nThreads);
+        if (poThreadPool)
+            poJobQueue = poThreadPool->CreateJobQueue();
     }
+    std::vector<Job> asJobs(nThreads);
 
-    if (bComputeAtEdges && nXSize >= 2 && nYSize >= 2)
+    CPLErr eErr = CE_None;
+    for (int iBatchStart = 0; iBatchStart < nYSize && eErr == CE_None;
+         iBatchStart += nBatchHeight)
     {
-        for (int j = 0; j < nXSize; j++)
+        const int iBatchEnd = std::min(nYSize, iBatchStart + nBatchHeight);
+        const int iSrcYOff = std::max(0, iBatchStart - 1);
+        const int nSrcLines = std::min(nYSize, iBatchEnd + 1) - iSrcYOff;
+
+        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iSrcYOff, nXSize, nSrcLines,
+                            pafSrcBuf, nXSize, nSrcLines, eReadDT, 0, 0);
+        if (eErr != CE_None)
+            break;
+
+        if (std::numeric_limits<T>::is_integer && bSrcHasNoData)
+        {
+            for (int i = 0; i < nSrcLines; ++i)
+            {
+                const T *pafLine = pafSrcBuf + static_cast<size_t>(i) * nXSize;
+                bool bLineHasNoDataValue = false;
+                int iX = 0;
+                for (; iX + 3 < nXSize; iX += 4)
+                {
+                    if (pafLine[iX] == fSrcNoDataValue ||
+                        pafLine[iX + 1] == fSrcNoDataValue ||
+                        pafLine[iX + 2] == fSrcNoDataValue ||
+                        pafLine[iX + 3] == fSrcNoDataValue)
+                    {
+                        bLineHasNoDataValue = true;
+                        break;
+                    }
+                }
+                for (; !bLineHasNoDataValue && iX < nXSize; iX++)
+                {
+                    if (pafLine[iX] == fSrcNoDataValue)
+                        bLineHasNoDataValue = true;
+                }
+                abyLineHasNoData[i] = bLineHasNoDataValue;
+            }
+        }
+
+        int nJobs = 0;
+        for (int iYStart = iBatchStart; iYStart < iBatchEnd;
+             iYStart += nStripHeight)
         {
-            int jmin = (j == 0) ? j : j - 1;
-            int jmax = (j == nXSize - 1) ? j : j + 1;
-
-            T afWin[9] = {
-                pafThreeLineWin[nLine1Off + jmin],
-                pafThreeLineWin[nLine1Off + j],
-                pafThreeLineWin[nLine1Off + jmax],
-                pafThreeLineWin[nLine2Off + jmin],
-                pafThreeLineWin[nLine2Off + j],
-                pafThreeLineWin[nLine2Off + jmax],
-                INTERPOL(pafThreeLineWin[nLine2Off + jmin],
-                         pafThreeLineWin[nLine1Off + jmin], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + j],
-                         pafThreeLineWin[nLine1Off + j], bSrcHasNoData,
-                         fSrcNoDataValue),
-                INTERPOL(pafThreeLineWin[nLine2Off + jmax],
-                         pafThreeLineWin[nLine1Off + jmax], bSrcHasNoData,
-                         fSrcNoDataValue),
-            };
-
-            pafOutputBuf[j] =
-                ComputeVal(CPL_TO_BOOL(bSrcHasNoData), fSrcNoDataValue,
-                           CPL_TO_BOOL(bIsSrcNoDataNan), afWin, fDstNoDataValue,
-                           pfnAlg, pData, bComputeAtEdges);
+            Job &sJob = asJobs[nJobs++];
+            sJob.psParams = &sParams;
+            sJob.pafSrcBuf = pafSrcBuf;
+            sJob.pabyLineHasNoData = abyLineHasNoData.data();
+            sJob.iSrcYOff = iSrcYOff;
+            sJob.iYStart = iYStart;
+            sJob.iYEnd = std::min(iBatchEnd, iYStart + nStripHeight);
+            sJob.pafOutputBuf =
+                pafOutputBuf +
+                static_cast<size_t>(iYStart - iBatchStart) * nXSize;
         }
-        eErr = GDALRasterIO(hDstBand, GF_Write, 0, i, nXSize, 1, pafOutputBuf,
-                            nXSize, 1, GDT_Float32, 0, 0);
-        if (eErr != CE_None)
+        if (poJobQueue && nJobs > 1)
         {
-            CPLFree(pafOutputBuf);
-            CPLFree(pafThreeLineWin);
+            for (int iJob = 0; iJob < nJobs; ++iJob)
+                poJobQueue->SubmitJob(ProcessJob, &asJobs[iJob]);
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (int iJob = 0; iJob < nJobs; ++iJob)
+                ProcessJob(&asJobs[iJob]);
+        }
 
-            return eErr;
+        /* -----------------------------------------
+         * Write Lines to Raster
+         */
+        eErr = GDALRasterIO(hDstBand, GF_Write, 0, iBatchStart, nXSize,
+                            iBatchEnd - iBatchStart, pafOutputBuf, nXSize,
+                            iBatchEnd - iBatchStart, GDT_Float32, 0, 0);
+
+        if (eErr == CE_None &&
+            !pfnProgress(1.0 * iBatchEnd / nYSize, nullptr, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
         }
     }
 
-    pfnProgress(1.0, nullptr, pProgressData);
-    eErr = CE_None;
-
     CPLFree(pafOutputBuf);
-    CPLFree(pafThreeLineWin);
+    CPLFree(pafSrcBuf);
 
     return eErr;
 }
@@ -976,15 +1072,16 @@ static float GDALHillshadeAlg_same_res(const T *afWin,
 }
 
 #ifdef HAVE_16_SSE_REG
-template <class T>
-static int
-GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
-                                      int nLine2Off, int nLine3Off, int nXSize,
-                                      void *pData, float *pafOutputBuf)
-{
-    // Only valid for T == int
 
-    GDALHillshadeAlgData *psData = static_cast<GDALHillshadeAlgData *>(pData);
+// Shade values of 4 consecutive cells from their x and y gradients, as
+// computed by GDALHillshadeAlg_same_res() (before adding 1 and clamping).
+static inline void
+GDALHillshadeAlg_same_res_4values(const GDALHillshadeAlgData *psData,
+                                  __m128d reg_x0, __m128d reg_x1,
+                                  __m128d reg_y0, __m128d reg_y1,
+                                  __m128d &reg_numerator0,
+                                  __m128d &reg_numerator1)
+{
     const __m128d reg_fact_x =
         _mm_load1_pd(&(psData->sin_az_mul_cos_alt_mul_z_mul_254_mul_inv_res));
     const __m128d reg_fact_y =
@@ -995,6 +1092,53 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
         _mm_load1_pd(&(psData->square_z_mul_square_inv_res));
     const __m128d reg_half = _mm_set1_pd(0.5);
     const __m128d reg_one = _mm_add_pd(reg_half, reg_half);
+
+    __m128d reg_xx_plus_yy0 =
+        _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0), _mm_mul_pd(reg_y0, reg_y0));
+    __m128d reg_xx_plus_yy1 =
+        _mm_add_pd(_mm_mul_pd(reg_x1, reg_x1), _mm_mul_pd(reg_y1, reg_y1));
+
+    reg_numerator0 = _mm_add_pd(reg_constant_num,
+                                _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x0),
+                                           _mm_mul_pd(reg_fact_y, reg_y0)));
+    reg_numerator1 = _mm_add_pd(reg_constant_num,
+                                _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x1),
+                                           _mm_mul_pd(reg_fact_y, reg_y1)));
+    __m128d reg_denominator0 =
+        _mm_add_pd(reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy0));
+    __m128d reg_denominator1 =
+        _mm_add_pd(reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy1));
+
+    __m128d regB0 = reg_denominator0;
+    __m128d regB1 = reg_denominator1;
+    __m128d regB0_half = _mm_mul_pd(regB0, reg_half);
+    __m128d regB1_half = _mm_mul_pd(regB1, reg_half);
+    // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
+    regB0 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB0)));
+    regB1 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB1)));
+    // And perform one step of Newton-Raphson approximation to improve it
+    // approx_inv_sqrt_x = approx_inv_sqrt_x*(1.5 -
+    //                            0.5*x*approx_inv_sqrt_x*approx_inv_sqrt_x);
+    const __m128d reg_one_and_a_half = _mm_add_pd(reg_one, reg_half);
+    regB0 = _mm_mul_pd(
+        regB0, _mm_sub_pd(reg_one_and_a_half,
+                          _mm_mul_pd(regB0_half, _mm_mul_pd(regB0, regB0))));
+    regB1 = _mm_mul_pd(
+        regB1, _mm_sub_pd(reg_one_and_a_half,
+                          _mm_mul_pd(regB1_half, _mm_mul_pd(regB1, regB1))));
+    reg_numerator0 = _mm_mul_pd(reg_numerator0, regB0);
+    reg_numerator1 = _mm_mul_pd(reg_numerator1, regB1);
+}
+
+template <class T>
+static int
+GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
+                                      int nLine2Off, int nLine3Off, int nXSize,
+                                      void *pData, float *pafOutputBuf)
+{
+    // Only valid for T == int
+
+    GDALHillshadeAlgData *psData = static_cast<GDALHillshadeAlgData *>(pData);
     const __m128 reg_one_float = _mm_set1_ps(1);
 
     int j = 1;  // Used after for.
@@ -1030,47 +1174,13 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
         accX = _mm_add_epi32(accX, six_minus_two);
         accY = _mm_sub_epi32(accY, six_minus_two);
 
-        __m128d reg_x0 = _mm_cvtepi32_pd(accX);
-        __m128d reg_x1 = _mm_cvtepi32_pd(_mm_srli_si128(accX, 8));
-        __m128d reg_y0 = _mm_cvtepi32_pd(accY);
-        __m128d reg_y1 = _mm_cvtepi32_pd(_mm_srli_si128(accY, 8));
-        __m128d reg_xx_plus_yy0 =
-            _mm_add_pd(_mm_mul_pd(reg_x0, reg_x0), _mm_mul_pd(reg_y0, reg_y0));
-        __m128d reg_xx_plus_yy1 =
-            _mm_add_pd(_mm_mul_pd(reg_x1, reg_x1), _mm_mul_pd(reg_y1, reg_y1));
-
-        __m128d reg_numerator0 = _mm_add_pd(
-            reg_constant_num, _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x0),
-                                         _mm_mul_pd(reg_fact_y, reg_y0)));
-        __m128d reg_numerator1 = _mm_add_pd(
-            reg_constant_num, _mm_add_pd(_mm_mul_pd(reg_fact_x, reg_x1),
-                                         _mm_mul_pd(reg_fact_y, reg_y1)));
-        __m128d reg_denominator0 = _mm_add_pd(
-            reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy0));
-        __m128d reg_denominator1 = _mm_add_pd(
-            reg_one, _mm_mul_pd(reg_constant_denom, reg_xx_plus_yy1));
-
-        __m128d regB0 = reg_denominator0;
-        __m128d regB1 = reg_denominator1;
-        __m128d regB0_half = _mm_mul_pd(regB0, reg_half);
-        __m128d regB1_half = _mm_mul_pd(regB1, reg_half);
-        // Compute rough approximation of 1 / sqrt(b) with _mm_rsqrt_ps
-        regB0 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB0)));
-        regB1 = _mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(regB1)));
-        // And perform one step of Newton-Raphson approximation to improve it
-        // approx_inv_sqrt_x = approx_inv_sqrt_x*(1.5 -
-        //                            0.5*x*approx_inv_sqrt_x*approx_inv_sqrt_x);
-        const __m128d reg_one_and_a_half = _mm_add_pd(reg_one, reg_half);
-        regB0 = _mm_mul_pd(
-            regB0,
-            _mm_sub_pd(reg_one_and_a_half,
-                       _mm_mul_pd(regB0_half, _mm_mul_pd(regB0, regB0))));
-        regB1 = _mm_mul_pd(
-            regB1,
-            _mm_sub_pd(reg_one_and_a_half,
-                       _mm_mul_pd(regB1_half, _mm_mul_pd(regB1, regB1))));
-        reg_numerator0 = _mm_mul_pd(reg_numerator0, regB0);
-        reg_numerator1 = _mm_mul_pd(reg_numerator1, regB1);
+        __m128d reg_numerator0;
+        __m128d reg_numerator1;
+        GDALHillshadeAlg_same_res_4values(
+            psData, _mm_cvtepi32_pd(accX),
+            _mm_cvtepi32_pd(_mm_srli_si128(accX, 8)), _mm_cvtepi32_pd(accY),
+            _mm_cvtepi32_pd(_mm_srli_si128(accY, 8)), reg_numerator0,
+            reg_numerator1);
 
         __m128 res = _mm_castsi128_ps(
             _mm_unpacklo_epi64(_mm_castps_si128(_mm_cvtpd_ps(reg_numerator0)),
@@ -1082,6 +1192,67 @@ GDALHillshadeAlg_same_res_multisample(const T *pafThreeLineWin, int nLine1Off,
     }
     return j;
 }
+
+template <>
+int GDALHillshadeAlg_same_res_multisample<float>(
+    const float *pafThreeLineWin, int nLine1Off, int nLine2Off, int nLine3Off,
+    int nXSize, void *pData, float *pafOutputBuf)
+{
+    // Same computations as GDALHillshadeAlg_same_res<float>(), so that
+    // results are identical.
+
+    GDALHillshadeAlgData *psData = static_cast<GDALHillshadeAlgData *>(pData);
+    const __m128d reg_one = _mm_set1_pd(1.0);
+
+    int j = 1;  // Used after for.
+    for (; j < nXSize - 4; j += 4)
+    {
+        const float *firstLine = pafThreeLineWin + nLine1Off + j - 1;
+        const float *secondLine = pafThreeLineWin + nLine2Off + j - 1;
+        const float *thirdLine = pafThreeLineWin + nLine3Off + j - 1;
+
+        __m128 accX =
+            _mm_sub_ps(_mm_loadu_ps(firstLine), _mm_loadu_ps(thirdLine + 2));
+        const __m128 six_minus_two =
+            _mm_sub_ps(_mm_loadu_ps(thirdLine), _mm_loadu_ps(firstLine + 2));
+        __m128 accY = accX;
+        const __m128 three_minus_five =
+            _mm_sub_ps(_mm_loadu_ps(secondLine), _mm_loadu_ps(secondLine + 2));
+        const __m128 one_minus_seven = _mm_sub_ps(_mm_loadu_ps(firstLine + 1),
+                                                  _mm_loadu_ps(thirdLine + 1));
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, three_minus_five);
+        accY = _mm_add_ps(accY, one_minus_seven);
+        accX = _mm_add_ps(accX, six_minus_two);
+        accY = _mm_sub_ps(accY, six_minus_two);
+
+        __m128d reg_numerator0;
+        __m128d reg_numerator1;
+        GDALHillshadeAlg_same_res_4values(
+            psData, _mm_cvtps_pd(accX), _mm_cvtps_pd(_mm_movehl_ps(accX, accX)),
+            _mm_cvtps_pd(accY), _mm_cvtps_pd(_mm_movehl_ps(accY, accY)),
+            reg_numerator0, reg_numerator1);
+
+        // cang = cang_mul_254 <= 0.0 ? 1.0 : 1.0 + cang_mul_254, computed
+        // in double precision
+        const __m128d reg_le_zero0 =
+            _mm_cmple_pd(reg_numerator0, _mm_setzero_pd());
+        const __m128d reg_le_zero1 =
+            _mm_cmple_pd(reg_numerator1, _mm_setzero_pd());
+        const __m128d reg_cang0 = _mm_or_pd(
+            _mm_and_pd(reg_le_zero0, reg_one),
+            _mm_andnot_pd(reg_le_zero0, _mm_add_pd(reg_one, reg_numerator0)));
+        const __m128d reg_cang1 = _mm_or_pd(
+            _mm_and_pd(reg_le_zero1, reg_one),
+            _mm_andnot_pd(reg_le_zero1, _mm_add_pd(reg_one, reg_numerator1)));
+
+        _mm_storeu_ps(pafOutputBuf + j,
+                      _mm_movelh_ps(_mm_cvtpd_ps(reg_cang0),
+                                    _mm_cvtpd_ps(reg_cang1)));
+    }
+    return j;
+}
 #endif
 
 static const double INV_SQUARE_OF_HALF_PI = 1.0 / ((M_PI * M_PI) / 4);
@@ -3820,6 +3991,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
     void *pData = nullptr;
     GDALGeneric3x3ProcessingAlg<float>::type pfnAlgFloat = nullptr;
     GDALGeneric3x3ProcessingAlg<GInt32>::type pfnAlgInt32 = nullptr;
+    GDALGeneric3x3ProcessingAlg_multisample<float>::type
+        pfnAlgFloat_multisample = nullptr;
     GDALGeneric3x3ProcessingAlg_multisample<GInt32>::type
         pfnAlgInt32_multisample = nullptr;
 
@@ -3901,6 +4074,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
                     pfnAlgFloat = GDALHillshadeAlg_same_res<float>;
                     pfnAlgInt32 = GDALHillshadeAlg_same_res<GInt32>;
 #ifdef HAVE_16_SSE_REG
+                    pfnAlgFloat_multisample =
+                        GDALHillshadeAlg_same_res_multisample<float>;
                     pfnAlgInt32_multisample =
                         GDALHillshadeAlg_same_res_multisample<GInt32>;
 #endif
@@ -4166,8 +4341,8 @@ GDALDatasetH GDALDEMProcessing(const char *pszDest, GDALDatasetH hSrcDataset,
         else
         {
             GDALGeneric3x3Processing<float>(
-                hSrcBand, hDstBand, pfnAlgFloat, nullptr, pData,
-                psOptions->bComputeAtEdges, pfnProgress, pProgressData);
+                hSrcBand, hDstBand, pfnAlgFloat, pfnAlgFloat_multisample,
+                pData, psOptions->bComputeAtEdges, pfnProgress, pProgressData);
         }
     }
 
@@ -458,3 +458,143 @@ cellsize     1
     f = lyr.GetNextFeature()
     assert f["ELEV"] == 3
     ogrtest.check_feature_geometry(f, "LINESTRING (1.5 0.0,1.5 0.5,1.5 1.5,1.5 2.0)")
+
+
+###############################################################################
+# Test that multi-threaded generation, by strips, gives the same contours
+
+
+@pytest.mark.parametrize("polygonize", [False, True])
+def test_contour_num_threads(polygonize):
+
+    import math
+
+    xsize = 101
+    ysize = 77
+    src_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 1, gdal.GDT_Float32
+    )
+    values = []
+    seed = 1
+    for y in range(ysize):
+        for x in range(xsize):
+            seed = (seed * 1103515245 + 12345) % (1 << 31)
+            if seed % 23 == 0:
+                values.append(-9999)
+            else:
+                values.append(
+                    100 * math.sin(x * 0.11) * math.cos(y * 0.07) + (seed % 1000) / 100
+                )
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("f" * len(values), *values)
+    )
+
+    def get_contours(num_threads):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        lyr = ogr_ds.CreateLayer("contour")
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("elev", ogr.OFTReal))
+        lyr.CreateField(ogr.FieldDefn("elevMax", ogr.OFTReal))
+        options = [
+            "LEVEL_INTERVAL=10",
+            "LEVEL_BASE=0.5",
+            "NODATA=-9999",
+            "ID_FIELD=0",
+            "NUM_THREADS=" + num_threads,
+        ]
+        if polygonize:
+            options += ["ELEV_FIELD_MIN=1", "ELEV_FIELD_MAX=2", "POLYGONIZE=YES"]
+        else:
+            options += ["ELEV_FIELD=1"]
+        gdal.ContourGenerateEx(src_ds.GetRasterBand(1), lyr, options=options)
+
+        ret = []
+        for f in lyr:
+            g = f.GetGeometryRef()
+            if polygonize:
+                # Rings may start at different points
+                ret.append(
+                    (
+                        f["elev"],
+                        f["elevMax"],
+                        round(g.GetArea(), 6),
+                        g.GetEnvelope(),
+                        sum(
+                            g.GetGeometryRef(i).GetGeometryRef(j).GetPointCount()
+                            for i in range(g.GetGeometryCount())
+                            for j in range(g.GetGeometryRef(i).GetGeometryCount())
+                        ),
+                    )
+                )
+            else:
+                # Lines may be oriented differently, and rings may start at
+                # different points
+                points = g.GetPoints()
+                if points[0] == points[-1]:
+                    points = points[0:-1]
+                    rotated = [
+                        p[i:] + p[0:i]
+                        for p in (points, points[::-1])
+                        for i in range(len(p))
+                    ]
+                    points = min(rotated)
+                    points.append(points[0])
+                else:
+                    points = min(points, points[::-1])
+                ret.append((f["elev"], points))
+        return sorted(ret)
+
+    ref = get_contours("1")
+    assert len(ref) > 10
+    assert get_contours("3") == ref
+    assert get_contours("ALL_CPUS") == ref
+
+
+###############################################################################
+# Test multi-threaded generation against the exact contours of a plane, which
+# must not be split at strip boundaries
+
+
+@pytest.mark.parametrize("num_threads", ["1", "3"])
+def test_contour_num_threads_plane(num_threads):
+
+    xsize = 40
+    ysize = 60
+    src_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 1, gdal.GDT_Float32
+    )
+    src_ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+    # The value at pixel center (x + 0.5, y + 0.5) is x + 2 * y
+    values = [x + 2 * y for y in range(ysize) for x in range(xsize)]
+    src_ds.GetRasterBand(1).WriteRaster(
+        0, 0, xsize, ysize, struct.pack("f" * len(values), *values)
+    )
+
+    ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ogr_ds.CreateLayer("contour")
+    lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("elev", ogr.OFTReal))
+    gdal.ContourGenerateEx(
+        src_ds.GetRasterBand(1),
+        lyr,
+        options=[
+            "LEVEL_INTERVAL=7",
+            "LEVEL_BASE=0.25",
+            "ID_FIELD=0",
+            "ELEV_FIELD=1",
+            "NUM_THREADS=" + num_threads,
+        ],
+    )
+
+    max_value = (xsize - 1) + 2 * (ysize - 1)
+    expected_levels = [0.25 + 7 * i for i in range(int((max_value - 0.25) / 7) + 1)]
+    got_levels = []
+    for f in lyr:
+        level = f["elev"]
+        got_levels.append(level)
+        # Points between pixel centers are linearly interpolated, so they
+        # are exactly on the plane.
+        for x, y in f.GetGeometryRef().GetPoints():
+            if 0.5 <= x <= xsize - 0.5 and 0.5 <= y <= ysize - 0.5:
+                assert (x - 0.5) + 2 * (y - 0.5) == pytest.approx(level, abs=1e-6)
+    assert sorted(got_levels) == expected_levels
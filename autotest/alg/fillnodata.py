@@ -403,3 +403,126 @@ def test_fillnodata_nearest(
         for i in range(height)
     ]
     assert got == expected
+
+
+###############################################################################
+# Test that the result does not depend on the batches of lines of the
+# quadrant search, the number of threads or the driver of the work files.
+# Expected results were computed before lines were processed by batches.
+
+
+fillnodata_batches_input = [
+    [10, 17, 24, 31, 38, 45, 0, 59, 66, 73],
+    [23, 0, 37, 0, 51, 58, 0, 0, 0, 86],
+    [36, 0, 50, 0, 64, 0, 0, 85, 0, 0],
+    [49, 56, 0, 0, 0, 0, 0, 0, 15, 22],
+    [62, 0, 0, 0, 0, 0, 0, 21, 28, 35],
+    [75, 0, 0, 0, 0, 0, 0, 34, 0, 0],
+    [0, 95, 0, 0, 0, 0, 0, 47, 0, 61],
+    [11, 18, 0, 0, 0, 0, 0, 60, 67, 74],
+    [24, 31, 0, 0, 0, 0, 0, 0, 80, 0],
+    [37, 44, 0, 58, 65, 72, 0, 0, 0, 10],
+    [0, 57, 64, 71, 78, 85, 92, 99, 0, 23],
+    [63, 70, 0, 84, 0, 98, 15, 22, 29, 36],
+]
+
+fillnodata_batches_tests = {
+    "inv_dist": (
+        "INV_DIST",
+        0,
+        [
+            [10, 17, 24, 31, 38, 45, 58, 59, 66, 73],
+            [23, 34, 37, 48, 51, 58, 66, 63, 70, 86],
+            [36, 47, 50, 54, 64, 58, 62, 85, 52, 54],
+            [49, 56, 56, 53, 56, 62, 56, 38, 15, 22],
+            [62, 61, 64, 64, 53, 47, 33, 21, 28, 35],
+            [75, 78, 79, 72, 60, 50, 46, 34, 41, 48],
+            [52, 95, 62, 58, 67, 64, 56, 47, 61, 61],
+            [11, 18, 33, 48, 56, 61, 63, 60, 67, 74],
+            [24, 31, 43, 55, 62, 69, 70, 66, 80, 42],
+            [37, 44, 58, 58, 65, 72, 86, 74, 52, 10],
+            [56, 57, 64, 71, 78, 85, 92, 99, 48, 23],
+            [63, 70, 74, 84, 88, 98, 15, 22, 29, 36],
+        ],
+    ),
+    "inv_dist_smoothing": (
+        "INV_DIST",
+        1,
+        [
+            [10, 17, 24, 31, 38, 45, 58, 59, 66, 73],
+            [23, 31, 37, 44, 51, 58, 62, 65, 68, 86],
+            [36, 43, 50, 52, 64, 59, 61, 85, 54, 50],
+            [49, 56, 56, 57, 57, 55, 51, 43, 15, 22],
+            [62, 64, 65, 62, 57, 51, 43, 21, 28, 35],
+            [75, 70, 70, 64, 59, 53, 44, 34, 42, 46],
+            [55, 95, 60, 59, 60, 58, 53, 47, 55, 61],
+            [11, 18, 49, 54, 60, 63, 62, 60, 67, 74],
+            [24, 31, 43, 53, 61, 67, 69, 69, 80, 54],
+            [37, 44, 53, 58, 65, 72, 79, 74, 55, 10],
+            [55, 57, 64, 71, 78, 85, 92, 99, 44, 23],
+            [63, 70, 74, 84, 88, 98, 15, 22, 29, 36],
+        ],
+    ),
+    "nearest": (
+        "NEAREST",
+        0,
+        [
+            [10, 17, 24, 31, 38, 45, 45, 59, 66, 73],
+            [23, 17, 37, 31, 51, 58, 58, 59, 66, 86],
+            [36, 36, 50, 50, 64, 58, 85, 85, 85, 86],
+            [49, 56, 50, 50, 64, 64, 85, 85, 15, 22],
+            [62, 56, 56, 56, 64, 21, 21, 21, 28, 35],
+            [75, 75, 95, 95, 64, 34, 34, 34, 28, 35],
+            [75, 95, 95, 95, 95, 47, 47, 47, 47, 61],
+            [11, 18, 18, 18, 65, 72, 60, 60, 67, 74],
+            [24, 31, 31, 58, 65, 72, 72, 60, 80, 74],
+            [37, 44, 44, 58, 65, 72, 72, 99, 80, 10],
+            [37, 57, 64, 71, 78, 85, 92, 99, 99, 23],
+            [63, 70, 64, 84, 78, 98, 15, 22, 29, 36],
+        ],
+    ),
+}
+
+
+@pytest.mark.parametrize(
+    "interpolation,smoothingIterations,expected",
+    fillnodata_batches_tests.values(),
+    ids=fillnodata_batches_tests.keys(),
+)
+@pytest.mark.parametrize(
+    "options,max_memory",
+    [
+        (["NUM_THREADS=1", "TEMP_FILE_DRIVER=GTiff"], None),
+        (["NUM_THREADS=1"], None),
+        # Batches of one line
+        (["NUM_THREADS=1"], "1"),
+        (["NUM_THREADS=3"], "1"),
+        # Batches of 5 lines
+        (["NUM_THREADS=3"], str(10 * 22 * 5)),
+        (["NUM_THREADS=ALL_CPUS"], str(10 * 22 * 5)),
+    ],
+)
+@pytest.mark.require_driver("GTiff")
+def test_fillnodata_batches(
+    interpolation, smoothingIterations, expected, options, max_memory
+):
+
+    height = len(fillnodata_batches_input)
+    width = len(fillnodata_batches_input[0])
+    ds = gdal.GetDriverByName("MEM").Create("", width, height)
+    ds.GetRasterBand(1).SetNoDataValue(0)
+    ar = b"".join([array.array("B", row) for row in fillnodata_batches_input])
+    ds.WriteRaster(0, 0, width, height, ar)
+    with gdal.config_option("GDAL_FILLNODATA_MAX_MEMORY", max_memory):
+        gdal.FillNodata(
+            targetBand=ds.GetRasterBand(1),
+            maxSearchDist=5,
+            maskBand=None,
+            smoothingIterations=smoothingIterations,
+            options=["INTERPOLATION=" + interpolation] + options,
+        )
+    got = [
+        [x for x in struct.unpack("B" * width, ds.ReadRaster(0, i, width, 1))]
+        for i in range(height)
+    ]
+    assert got == expected
@@ -30,6 +30,7 @@
 ###############################################################################
 
 
+import random
 import struct
 from collections import defaultdict
 
@@ -444,3 +445,54 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test that tracing strips in parallel, and stitching the polygons crossing
+# strips, gives the same polygons as tracing the whole raster.
+
+
+@pytest.mark.parametrize("is_int_polygonize", [True, False])
+@pytest.mark.parametrize("options", [[], ["8CONNECTED=8"]])
+@pytest.mark.parametrize("max_memory", ["1", "10000"])
+def test_polygonize_num_threads(is_int_polygonize, options, max_memory):
+
+    rng = random.Random(0)
+    xsize = 41
+    ysize = 67
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Float32)
+    src_ds.SetGeoTransform([10, 0.5, 0, 20, 0, -0.5])
+    src_band = src_ds.GetRasterBand(1)
+    values = []
+    for y in range(ysize):
+        for x in range(xsize):
+            if x % 7 == 0 or y % 9 == 0:
+                # Frame crossing all strips, with holes
+                values.append(1.5)
+            else:
+                values.append(rng.choice([0, 1.5, 2.5, 3.5]))
+    src_band.WriteRaster(0, 0, xsize, ysize, struct.pack("f" * len(values), *values))
+    src_band.SetNoDataValue(0)
+
+    polygonize = gdal.Polygonize if is_int_polygonize else gdal.FPolygonize
+
+    def run(num_threads):
+        mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("out")
+        mem_layer = mem_ds.CreateLayer("poly", None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTReal))
+        with gdal.config_option("GDAL_POLYGONIZE_MAX_MEMORY", max_memory):
+            assert (
+                polygonize(
+                    src_band,
+                    src_band.GetMaskBand(),
+                    mem_layer,
+                    0,
+                    options + ["NUM_THREADS=%d" % num_threads],
+                )
+                == 0
+            )
+        return sorted((f["DN"], f.GetGeometryRef().ExportToWkt()) for f in mem_layer)
+
+    expected = run(1)
+    assert len(expected) > 100
+    assert run(4) == expected
@@ -29,6 +29,9 @@
 ###############################################################################
 
 
+import math
+import struct
+
 import pytest
 
 from osgeo import gdal
@@ -126,3 +129,72 @@ def test_proximity_3():
     if cs != cs_expected:
         print("Got: ", cs)
         pytest.fail("got wrong checksum")
+
+
+###############################################################################
+# Test ALGORITHM=EXACT against a brute force computation, in memory and with
+# a temporary file, with one and several threads.
+
+
+@pytest.mark.parametrize("max_memory", [None, "1000"])
+@pytest.mark.parametrize("num_threads", ["1", "3"])
+def test_proximity_exact(max_memory, num_threads):
+
+    src_ds = gdal.Open("data/pat.tif")
+    src_band = src_ds.GetRasterBand(1)
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+    src = struct.unpack(
+        "i" * (xsize * ysize), src_band.ReadRaster(buf_type=gdal.GDT_Int32)
+    )
+
+    dst_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 1, gdal.GDT_Float32
+    )
+    dst_band = dst_ds.GetRasterBand(1)
+
+    maxdist = 7
+    with gdal.config_option("GDAL_PROXIMITY_EDT_MAX_MEMORY", max_memory):
+        gdal.ComputeProximity(
+            src_band,
+            dst_band,
+            options=[
+                "ALGORITHM=EXACT",
+                "VALUES=65,64",
+                f"MAXDIST={maxdist}",
+                "NODATA=-1",
+                f"NUM_THREADS={num_threads}",
+            ],
+        )
+    got = struct.unpack(
+        "f" * (xsize * ysize), dst_band.ReadRaster(buf_type=gdal.GDT_Float32)
+    )
+
+    targets = [
+        (x, y)
+        for y in range(ysize)
+        for x in range(xsize)
+        if src[y * xsize + x] in (64, 65)
+    ]
+    assert targets
+    for y in range(ysize):
+        for x in range(xsize):
+            dist = min(math.hypot(x - tx, y - ty) for tx, ty in targets)
+            expected = dist if dist <= maxdist else -1
+            assert got[y * xsize + x] == pytest.approx(expected, abs=1e-5), (x, y)
+
+
+###############################################################################
+# Test invalid ALGORITHM
+
+
+def test_proximity_invalid_algorithm():
+
+    src_ds = gdal.Open("data/pat.tif")
+    dst_ds = gdal.GetDriverByName("MEM").Create("", 25, 25, 1, gdal.GDT_Byte)
+    with pytest.raises(Exception, match="Unrecognized ALGORITHM"):
+        gdal.ComputeProximity(
+            src_ds.GetRasterBand(1),
+            dst_ds.GetRasterBand(1),
+            options=["ALGORITHM=FOO"],
+        )
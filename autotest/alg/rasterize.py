@@ -1011,3 +1011,89 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Check NUM_THREADS, with several chunks and several batches of features,
+# against a brute-force rasterization of axis-aligned rectangles.
+
+
+@pytest.mark.parametrize("merge_alg", ["REPLACE", "ADD"])
+@pytest.mark.parametrize("all_touched", [False, True])
+@pytest.mark.parametrize("num_threads", ["1", "3", "ALL_CPUS"])
+def test_rasterize_num_threads(merge_alg, all_touched, num_threads):
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    rast_ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("wrk")
+    rast_mem_lyr = rast_ogr_ds.CreateLayer("poly", srs=sr)
+    rast_mem_lyr.CreateField(ogr.FieldDefn("val", ogr.OFTReal))
+
+    xsize = 100
+    ysize = 80
+    # Rectangles with edges at 0.25 or 0.75 of a pixel, so that neither
+    # pixel centers nor pixel boundaries are on an edge. Some of them
+    # extend outside of the raster.
+    rects = []
+    for i in range(60):
+        x0 = (i * 37) % 110 - 5 + 0.25
+        y0 = (i * 23) % 90 - 5 + 0.75
+        x1 = x0 + 1 + (i * 13) % 30 + 0.5
+        y1 = y0 + 1 + (i * 7) % 25 - 0.5
+        rects.append((x0, y0, x1, y1, i % 7 + 1))
+    for x0, y0, x1, y1, val in rects:
+        feat = ogr.Feature(rast_mem_lyr.GetLayerDefn())
+        feat["val"] = val
+        feat.SetGeometryDirectly(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON((%f %f,%f %f,%f %f,%f %f,%f %f))"
+                % (x0, y0, x1, y0, x1, y1, x0, y1, x0, y0)
+            )
+        )
+        rast_mem_lyr.CreateFeature(feat)
+
+    expected = [0] * (xsize * ysize)
+    for x0, y0, x1, y1, val in rects:
+        for y in range(ysize):
+            if all_touched:
+                inside = y < y1 and y + 1 > y0
+            else:
+                inside = y0 < y + 0.5 < y1
+            if not inside:
+                continue
+            for x in range(xsize):
+                if all_touched:
+                    inside = x < x1 and x + 1 > x0
+                else:
+                    inside = x0 < x + 0.5 < x1
+                if inside:
+                    if merge_alg == "ADD":
+                        expected[y * xsize + x] += val
+                    else:
+                        expected[y * xsize + x] = val
+
+    target_ds = gdal.GetDriverByName("MEM").Create(
+        "", xsize, ysize, 2, gdal.GDT_Float32
+    )
+    target_ds.SetGeoTransform((0, 1, 0, 0, 0, 1))
+    target_ds.SetProjection(sr_wkt)
+    options = [
+        "ATTRIBUTE=val",
+        "MERGE_ALG=" + merge_alg,
+        "CHUNKYSIZE=17",
+        "NUM_THREADS=" + num_threads,
+    ]
+    if all_touched:
+        options.append("ALL_TOUCHED=TRUE")
+    with gdal.config_option("GDAL_RASTERIZE_MAX_MEMORY", "10000"):
+        assert (
+            gdal.RasterizeLayer(target_ds, [1, 2], rast_mem_lyr, options=options)
+            == 0
+        )
+
+    for i in range(2):
+        got = struct.unpack(
+            "f" * (xsize * ysize), target_ds.GetRasterBand(i + 1).ReadRaster()
+        )
+        assert list(got) == expected
@@ -356,3 +356,156 @@ def test_sieve_all_masked():
     gdal.SieveFilter(src_band, mask_band, src_band, 4, 4)
 
     assert src_band.Checksum() == expected_cs
+
+
+###############################################################################
+# Brute force implementation of the sieve filter, used as a reference
+
+
+def sieve_reference(data, mask, width, height, threshold, connectedness):
+
+    # Label the polygons.
+    label = [-1] * (width * height)
+    sizes = []
+    values = []
+    if connectedness == 8:
+        offsets = [(dx, dy) for dy in (-1, 0, 1) for dx in (-1, 0, 1) if dx or dy]
+    else:
+        offsets = [(0, -1), (-1, 0), (1, 0), (0, 1)]
+    for start in range(width * height):
+        if label[start] >= 0 or (mask and mask[start] == 0):
+            continue
+        poly = len(sizes)
+        label[start] = poly
+        stack = [start]
+        size = 0
+        while stack:
+            i = stack.pop()
+            size += 1
+            x, y = i % width, i // width
+            for dx, dy in offsets:
+                nx, ny = x + dx, y + dy
+                if 0 <= nx < width and 0 <= ny < height:
+                    j = ny * width + nx
+                    if (
+                        label[j] < 0
+                        and (not mask or mask[j] != 0)
+                        and data[j] == data[start]
+                    ):
+                        label[j] = poly
+                        stack.append(j)
+        sizes.append(size)
+        values.append(data[start])
+
+    # Largest neighbour of each polygon: the first one met in raster order
+    # in case of ties.
+    biggest = [-1] * len(sizes)
+
+    def compare(a, b):
+        if a < 0 or b < 0 or a == b:
+            return
+        if biggest[a] < 0 or sizes[biggest[a]] < sizes[b]:
+            biggest[a] = b
+        if biggest[b] < 0 or sizes[biggest[b]] < sizes[a]:
+            biggest[b] = a
+
+    for y in range(height):
+        for x in range(width):
+            i = y * width + x
+            if y > 0:
+                compare(label[i], label[i - width])
+                if connectedness == 8 and x > 0:
+                    compare(label[i], label[i - width - 1])
+                if connectedness == 8 and x < width - 1:
+                    compare(label[i], label[i - width + 1])
+            if x > 0:
+                compare(label[i], label[i - 1])
+
+    # Follow the largest neighbours of small polygons until a polygon
+    # large enough is found.
+    target = list(range(len(sizes)))
+    for poly in range(len(sizes)):
+        if sizes[poly] >= threshold:
+            continue
+        visited = {poly}
+        cur = poly
+        while True:
+            cur = biggest[cur]
+            if cur < 0 or cur in visited:
+                break
+            if sizes[cur] >= threshold:
+                target[poly] = cur
+                break
+            visited.add(cur)
+
+    return bytes(
+        values[target[label[i]]] if label[i] >= 0 else data[i]
+        for i in range(width * height)
+    )
+
+
+###############################################################################
+# Test that processing the raster by strips, with several threads, gives the
+# same result as a brute force implementation.
+
+
+@pytest.mark.parametrize("connectedness", [4, 8])
+@pytest.mark.parametrize("use_mask", [False, True])
+def test_sieve_strips_and_threads(connectedness, use_mask):
+
+    width = 97
+    height = 131
+    drv = gdal.GetDriverByName("MEM")
+    src_ds = drv.Create("", width, height, gdal.GDT_Byte)
+    src_band = src_ds.GetRasterBand(1)
+    mask_ds = drv.Create("", width, height, gdal.GDT_Byte)
+    mask_band = mask_ds.GetRasterBand(1)
+
+    # Blocky classes with noise, so that polygons of all sizes cross strip
+    # boundaries.
+    seed = 1
+    src_data = bytearray(width * height)
+    mask_data = bytearray(width * height)
+    for y in range(height):
+        for x in range(width):
+            seed = (seed * 1103515245 + 12345) % (1 << 31)
+            if seed % 5 == 0:
+                val = (seed >> 8) % 4
+            else:
+                val = (x // 9 + y // 13 + (x * y) // 300) % 4
+            src_data[y * width + x] = val
+            mask_data[y * width + x] = 0 if (seed >> 4) % 17 == 0 else 255
+    src_band.WriteRaster(0, 0, width, height, bytes(src_data))
+    mask_band.WriteRaster(0, 0, width, height, bytes(mask_data))
+    if not use_mask:
+        mask_band = None
+
+    def sieve(max_memory, num_threads):
+        dst_ds = drv.Create("", width, height, gdal.GDT_Byte)
+        dst_band = dst_ds.GetRasterBand(1)
+        with gdal.config_option("GDAL_SIEVE_MAX_MEMORY", max_memory):
+            gdal.SieveFilter(
+                src_band,
+                mask_band,
+                dst_band,
+                30,
+                connectedness,
+                options=["NUM_THREADS=" + str(num_threads)],
+            )
+        return dst_band.ReadRaster()
+
+    ref_data = sieve_reference(
+        src_data,
+        mask_data if use_mask else None,
+        width,
+        height,
+        30,
+        connectedness,
+    )
+    assert ref_data != bytes(src_data)
+    assert sieve(None, 1) == ref_data
+
+    # Strips of one line, and of a few lines.
+    for max_memory in (100 * width, 1000 * width):
+        for num_threads in (1, 3):
+            assert sieve(str(max_memory), num_threads) == ref_data
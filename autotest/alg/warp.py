@@ -1853,3 +1853,62 @@ def test_warp_average_NODATA_VALUES_PCT_THRESHOLD():
         options="-of MEM -ts 1 1 -r average -wo NODATA_VALUES_PCT_THRESHOLD=25",
     )
     assert struct.unpack("B", out_ds.ReadRaster())[0] == 20
+
+
+###############################################################################
+# Test ADVISE_READ_CHUNKS, and the prefetching of the source windows of the
+# next chunks with the multithreaded warper. VRT reads do not go through the
+# block cache of the VRT bands, so they are not prefetched.
+
+
+@pytest.mark.parametrize("multithread", [False, True])
+@pytest.mark.parametrize("src_format", ["GTiff", "VRT"])
+def test_warp_advise_read_chunks(tmp_vsimem, multithread, src_format):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    gdal.Translate(
+        src_filename,
+        "../gcore/data/byte.tif",
+        width=1000,
+        height=1000,
+        resampleAlg="bilinear",
+        creationOptions=["TILED=YES"],
+    )
+    if src_format == "VRT":
+        gdal.Translate(str(tmp_vsimem / "src.vrt"), src_filename, format="VRT")
+        src_filename = str(tmp_vsimem / "src.vrt")
+
+    def warp(advise_read_chunks):
+        messages = []
+
+        def handler(err_type, err_no, msg):
+            if err_type == gdal.CE_Debug:
+                messages.append(msg)
+
+        # The prefetching is done in a separate thread, hence the global
+        # error handler and configuration option.
+        prev_debug = gdal.GetConfigOption("CPL_DEBUG")
+        try:
+            gdal.SetErrorHandler(handler)
+            gdal.SetConfigOption("CPL_DEBUG", "ON")
+            ds = gdal.Warp(
+                "",
+                src_filename,
+                format="MEM",
+                dstSRS="EPSG:4326",
+                multithread=multithread,
+                warpMemoryLimit=100000,
+                warpOptions=["ADVISE_READ_CHUNKS=" + advise_read_chunks],
+            )
+        finally:
+            gdal.SetErrorHandler("CPLDefaultErrorHandler")
+            gdal.SetConfigOption("CPL_DEBUG", prev_debug)
+        return ds.GetRasterBand(1).Checksum(), messages
+
+    cs_no, messages = warp("NO")
+    assert not any("Prefetching source window" in msg for msg in messages)
+    cs_yes, messages = warp("YES")
+    assert cs_yes == cs_no
+    assert any("Prefetching source window" in msg for msg in messages) == (
+        multithread and src_format == "GTiff"
+    )
@@ -36,6 +36,7 @@
 #include "gdal_alg.h"
 #include "gdalwarper.h"
 #include "gdal_priv.h"
+#include "ogr_spatialref.h"
 
 #include "gtest_include.h"
 
@@ -490,4 +491,421 @@ TEST_F(test_alg, GDALIsLineOfSightVisible_through_mountain)
                                          nullptr, nullptr, nullptr));
 }
 
+// Test that the per-data-type resampling path used by GWKRealCase() when the
+// source has nodata gives the same result as the generic one
+TEST_F(test_alg, GDALWarpKernel_nodata_typed_vs_general_case)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    constexpr int SRC_SIZE = 64;
+    for (const GDALDataType eDT :
+         {GDT_Byte, GDT_UInt16, GDT_Int16, GDT_Float64})
+    {
+        GDALDatasetUniquePtr poSrcDS(
+            poDriver->Create("", SRC_SIZE, SRC_SIZE, 1, eDT, nullptr));
+        double adfSrcGT[6] = {0, 1, 0, SRC_SIZE, 0, -1};
+        poSrcDS->SetGeoTransform(adfSrcGT);
+        std::vector<double> adfSrc(SRC_SIZE * SRC_SIZE);
+        for (size_t i = 0; i < adfSrc.size(); ++i)
+            adfSrc[i] =
+                ((i * 7) % 17) == 0 ? 0 : 1 + static_cast<int>(i * 37) % 200;
+        ASSERT_EQ(poSrcDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, SRC_SIZE, SRC_SIZE, adfSrc.data(),
+                      SRC_SIZE, SRC_SIZE, GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+        poSrcDS->GetRasterBand(1)->SetNoDataValue(0);
+
+        for (const GDALResampleAlg eResampleAlg :
+             {GRA_Bilinear, GRA_Cubic, GRA_Lanczos})
+        {
+            // Downsampling and upsampling, to go through both the generic
+            // and the 4-sample resampling functions. The strong
+            // downsampling gives kernel rows of more than 32 pixels.
+            for (const int nDstSize : {8, 48, 80})
+            {
+                std::vector<double> adfDst[2];
+                for (int iRun = 0; iRun < 2; ++iRun)
+                {
+                    GDALDatasetUniquePtr poDstDS(poDriver->Create(
+                        "", nDstSize, nDstSize, 1, eDT, nullptr));
+                    double adfDstGT[6] = {0, double(SRC_SIZE) / nDstSize,
+                                          0, SRC_SIZE,
+                                          0, -double(SRC_SIZE) / nDstSize};
+                    poDstDS->SetGeoTransform(adfDstGT);
+
+                    GDALWarpOptions *psWO = GDALCreateWarpOptions();
+                    psWO->hSrcDS = GDALDataset::ToHandle(poSrcDS.get());
+                    psWO->hDstDS = GDALDataset::ToHandle(poDstDS.get());
+                    psWO->eResampleAlg = eResampleAlg;
+                    psWO->nBandCount = 1;
+                    psWO->panSrcBands =
+                        static_cast<int *>(CPLMalloc(sizeof(int)));
+                    psWO->panSrcBands[0] = 1;
+                    psWO->panDstBands =
+                        static_cast<int *>(CPLMalloc(sizeof(int)));
+                    psWO->panDstBands[0] = 1;
+                    psWO->padfSrcNoDataReal =
+                        static_cast<double *>(CPLCalloc(1, sizeof(double)));
+                    if (iRun == 1)
+                        psWO->papszWarpOptions = CSLSetNameValue(
+                            psWO->papszWarpOptions, "USE_GENERAL_CASE", "YES");
+                    psWO->pfnTransformer = GDALGenImgProjTransform;
+                    psWO->pTransformerArg = GDALCreateGenImgProjTransformer2(
+                        psWO->hSrcDS, psWO->hDstDS, nullptr);
+
+                    {
+                        GDALWarpOperation oWO;
+                        ASSERT_EQ(oWO.Initialize(psWO), CE_None);
+                        ASSERT_EQ(oWO.ChunkAndWarpImage(0, 0, nDstSize,
+                                                        nDstSize),
+                                  CE_None);
+                    }
+                    GDALDestroyGenImgProjTransformer(psWO->pTransformerArg);
+                    GDALDestroyWarpOptions(psWO);
+
+                    adfDst[iRun].resize(nDstSize * nDstSize);
+                    ASSERT_EQ(poDstDS->GetRasterBand(1)->RasterIO(
+                                  GF_Read, 0, 0, nDstSize, nDstSize,
+                                  adfDst[iRun].data(), nDstSize, nDstSize,
+                                  GDT_Float64, 0, 0, nullptr),
+                              CE_None);
+                }
+                EXPECT_EQ(adfDst[0], adfDst[1])
+                    << GDALGetDataTypeName(eDT) << " "
+                    << static_cast<int>(eResampleAlg) << " "
+                    << nDstSize;
+            }
+        }
+    }
+}
+
+// Test that warping through a warp plan transformer gives the same result
+// as the base transformer, and that the plan is shared between transformers
+// of the same geometry
+TEST_F(test_alg, GDALWarpPlanTransformer)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    constexpr int SRC_SIZE = 32;
+    constexpr int DST_SIZE = 20;
+    GDALDatasetUniquePtr poSrcDS(
+        poDriver->Create("", SRC_SIZE, SRC_SIZE, 1, GDT_Byte, nullptr));
+    double adfSrcGT[6] = {0, 1, 0, SRC_SIZE, 0, -1};
+    poSrcDS->SetGeoTransform(adfSrcGT);
+    std::vector<GByte> abySrc(SRC_SIZE * SRC_SIZE);
+    for (size_t i = 0; i < abySrc.size(); ++i)
+        abySrc[i] = static_cast<GByte>(i * 37);
+    ASSERT_EQ(poSrcDS->GetRasterBand(1)->RasterIO(
+                  GF_Write, 0, 0, SRC_SIZE, SRC_SIZE, abySrc.data(), SRC_SIZE,
+                  SRC_SIZE, GDT_Byte, 0, 0, nullptr),
+              CE_None);
+
+    GDALClearWarpPlanCache();
+
+    std::vector<GByte> abyDst[3];
+    for (int iRun = 0; iRun < 3; ++iRun)
+    {
+        GDALDatasetUniquePtr poDstDS(
+            poDriver->Create("", DST_SIZE, DST_SIZE, 1, GDT_Byte, nullptr));
+        double adfDstGT[6] = {1.5, 1.3, 0.1, SRC_SIZE - 2, 0.05, -1.2};
+        poDstDS->SetGeoTransform(adfDstGT);
+
+        GDALWarpOptions *psWO = GDALCreateWarpOptions();
+        psWO->hSrcDS = GDALDataset::ToHandle(poSrcDS.get());
+        psWO->hDstDS = GDALDataset::ToHandle(poDstDS.get());
+        psWO->eResampleAlg = GRA_Bilinear;
+        psWO->nBandCount = 1;
+        psWO->panSrcBands = static_cast<int *>(CPLMalloc(sizeof(int)));
+        psWO->panSrcBands[0] = 1;
+        psWO->panDstBands = static_cast<int *>(CPLMalloc(sizeof(int)));
+        psWO->panDstBands[0] = 1;
+        void *pBaseTransformerArg = GDALCreateGenImgProjTransformer2(
+            psWO->hSrcDS, psWO->hDstDS, nullptr);
+        ASSERT_TRUE(pBaseTransformerArg != nullptr);
+        if (iRun == 0)
+        {
+            psWO->pfnTransformer = GDALGenImgProjTransform;
+            psWO->pTransformerArg = pBaseTransformerArg;
+        }
+        else
+        {
+            psWO->pfnTransformer = GDALWarpPlanTransform;
+            psWO->pTransformerArg = GDALCreateWarpPlanTransformer(
+                GDALGenImgProjTransform, pBaseTransformerArg, TRUE);
+        }
+
+        {
+            GDALWarpOperation oWO;
+            ASSERT_EQ(oWO.Initialize(psWO), CE_None);
+            ASSERT_EQ(oWO.ChunkAndWarpImage(0, 0, DST_SIZE, DST_SIZE),
+                      CE_None);
+        }
+        GDALDestroyTransformer(psWO->pTransformerArg);
+        GDALDestroyWarpOptions(psWO);
+
+        abyDst[iRun].resize(DST_SIZE * DST_SIZE);
+        ASSERT_EQ(poDstDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, DST_SIZE, DST_SIZE, abyDst[iRun].data(),
+                      DST_SIZE, DST_SIZE, GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+    }
+    EXPECT_EQ(abyDst[0], abyDst[1]);
+    EXPECT_EQ(abyDst[0], abyDst[2]);
+
+    // The plan recorded by the previous warps must be reused: transforming
+    // a scanline already seen must not reach the base transformer.
+    struct CountingTransformer
+    {
+        int nCalls = 0;
+        void *pBaseTransformerArg = nullptr;
+
+        static int Transform(void *pTransformArg, int bDstToSrc,
+                             int nPointCount, double *x, double *y, double *z,
+                             int *panSuccess)
+        {
+            auto psThis = static_cast<CountingTransformer *>(pTransformArg);
+            psThis->nCalls++;
+            return GDALGenImgProjTransform(psThis->pBaseTransformerArg,
+                                           bDstToSrc, nPointCount, x, y, z,
+                                           panSuccess);
+        }
+    };
+
+    CountingTransformer oCounting;
+    oCounting.pBaseTransformerArg = GDALCreateGenImgProjTransformer2(
+        GDALDataset::ToHandle(poSrcDS.get()), nullptr, nullptr);
+    // Not serializable: gets a private plan
+    void *pTransformerArg = GDALCreateWarpPlanTransformer(
+        CountingTransformer::Transform, &oCounting, FALSE);
+    double adfX[2] = {0.5, 3.5};
+    double adfY[2] = {0.5, 7.5};
+    double adfZ[2] = {0, 0};
+    int anSuccess[2] = {0, 0};
+    for (int i = 0; i < 2; ++i)
+    {
+        double adfXTmp[2] = {adfX[0], adfX[1]};
+        double adfYTmp[2] = {adfY[0], adfY[1]};
+        double adfZTmp[2] = {adfZ[0], adfZ[1]};
+        EXPECT_TRUE(GDALWarpPlanTransform(pTransformerArg, FALSE, 2, adfXTmp,
+                                          adfYTmp, adfZTmp, anSuccess));
+        EXPECT_TRUE(anSuccess[0] && anSuccess[1]);
+        EXPECT_EQ(adfXTmp[1], 3.5);
+        EXPECT_EQ(adfYTmp[1], SRC_SIZE - 7.5);
+    }
+    EXPECT_EQ(oCounting.nCalls, 1);
+    {
+        // Same direction, point count and first point, different inputs
+        double adfXTmp[2] = {adfX[0], adfX[1] + 1};
+        double adfYTmp[2] = {adfY[0], adfY[1]};
+        double adfZTmp[2] = {adfZ[0], adfZ[1]};
+        EXPECT_TRUE(GDALWarpPlanTransform(pTransformerArg, FALSE, 2, adfXTmp,
+                                          adfYTmp, adfZTmp, anSuccess));
+        EXPECT_EQ(adfXTmp[1], 4.5);
+        EXPECT_EQ(adfYTmp[1], SRC_SIZE - 7.5);
+    }
+    EXPECT_EQ(oCounting.nCalls, 2);
+    GDALDestroyWarpPlanTransformer(pTransformerArg);
+    GDALDestroyGenImgProjTransformer(oCounting.pBaseTransformerArg);
+
+    // WARP_PLAN=YES warp option: a second warp of the same region by the
+    // same operation must not reach the base transformer.
+    {
+        GDALDatasetUniquePtr poDstDS(
+            poDriver->Create("", DST_SIZE, DST_SIZE, 1, GDT_Byte, nullptr));
+        double adfDstGT[6] = {1.5, 1.3, 0.1, SRC_SIZE - 2, 0.05, -1.2};
+        poDstDS->SetGeoTransform(adfDstGT);
+
+        GDALWarpOptions *psWO = GDALCreateWarpOptions();
+        psWO->hSrcDS = GDALDataset::ToHandle(poSrcDS.get());
+        psWO->hDstDS = GDALDataset::ToHandle(poDstDS.get());
+        psWO->eResampleAlg = GRA_Bilinear;
+        psWO->nBandCount = 1;
+        psWO->panSrcBands = static_cast<int *>(CPLMalloc(sizeof(int)));
+        psWO->panSrcBands[0] = 1;
+        psWO->panDstBands = static_cast<int *>(CPLMalloc(sizeof(int)));
+        psWO->panDstBands[0] = 1;
+        psWO->papszWarpOptions =
+            CSLSetNameValue(psWO->papszWarpOptions, "WARP_PLAN", "YES");
+        CountingTransformer oCountingWarp;
+        oCountingWarp.pBaseTransformerArg = GDALCreateGenImgProjTransformer2(
+            psWO->hSrcDS, psWO->hDstDS, nullptr);
+        ASSERT_TRUE(oCountingWarp.pBaseTransformerArg != nullptr);
+        psWO->pfnTransformer = CountingTransformer::Transform;
+        psWO->pTransformerArg = &oCountingWarp;
+
+        {
+            GDALWarpOperation oWO;
+            ASSERT_EQ(oWO.Initialize(psWO), CE_None);
+            EXPECT_EQ(oWO.GetOptions()->pfnTransformer, GDALWarpPlanTransform);
+            ASSERT_EQ(oWO.ChunkAndWarpImage(0, 0, DST_SIZE, DST_SIZE),
+                      CE_None);
+            const int nCalls = oCountingWarp.nCalls;
+            EXPECT_GT(nCalls, 0);
+            ASSERT_EQ(oWO.ChunkAndWarpImage(0, 0, DST_SIZE, DST_SIZE),
+                      CE_None);
+            EXPECT_EQ(oCountingWarp.nCalls, nCalls);
+        }
+        GDALDestroyGenImgProjTransformer(oCountingWarp.pBaseTransformerArg);
+        GDALDestroyWarpOptions(psWO);
+
+        std::vector<GByte> abyDstWarpPlan(DST_SIZE * DST_SIZE);
+        ASSERT_EQ(poDstDS->GetRasterBand(1)->RasterIO(
+                      GF_Read, 0, 0, DST_SIZE, DST_SIZE, abyDstWarpPlan.data(),
+                      DST_SIZE, DST_SIZE, GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(abyDst[0], abyDstWarpPlan);
+    }
+
+    // Changing the destination geotransform of the base transformer after
+    // the creation of the plan transformer must not return stale results.
+    {
+        void *pBaseTransformerArg = GDALCreateGenImgProjTransformer2(
+            GDALDataset::ToHandle(poSrcDS.get()), nullptr, nullptr);
+        ASSERT_TRUE(pBaseTransformerArg != nullptr);
+        pTransformerArg = GDALCreateWarpPlanTransformer(
+            GDALGenImgProjTransform, pBaseTransformerArg, TRUE);
+        for (int i = 0; i < 2; ++i)
+        {
+            if (i == 1)
+            {
+                const double adfDstGT[6] = {10, 2, 0, 100, 0, -2};
+                // Forwarded to the base transformer
+                GDALSetTransformerDstGeoTransform(pTransformerArg, adfDstGT);
+            }
+            double adfXTmp[1] = {1.5};
+            double adfYTmp[1] = {2.5};
+            double adfZTmp[1] = {0};
+            EXPECT_TRUE(GDALWarpPlanTransform(pTransformerArg, FALSE, 1,
+                                              adfXTmp, adfYTmp, adfZTmp,
+                                              anSuccess));
+            EXPECT_TRUE(anSuccess[0]);
+            if (i == 0)
+            {
+                EXPECT_EQ(adfXTmp[0], 1.5);
+                EXPECT_EQ(adfYTmp[0], SRC_SIZE - 2.5);
+            }
+            else
+            {
+                // Source georeferenced coordinates converted to pixel
+                // coordinates of the new destination grid
+                EXPECT_EQ(adfXTmp[0], (1.5 - 10) / 2);
+                EXPECT_EQ(adfYTmp[0], (100 - (SRC_SIZE - 2.5)) / 2);
+            }
+        }
+        GDALDestroyWarpPlanTransformer(pTransformerArg);
+    }
+
+    GDALClearWarpPlanCache();
+}
+
+// Test GDALGenImgProjTransform() and GDALApproxTransform() on batches of
+// points of various sizes, so that both their vectorized code paths and
+// their scalar tails are used.
+TEST_F(test_alg, GDALApproxTransform_batches)
+{
+    auto poDriver = GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    // Geographic source grid and UTM destination grid, so that the
+    // transformation of a line is not linear.
+    constexpr int SRC_SIZE = 600;
+    GDALDatasetUniquePtr poSrcDS(
+        poDriver->Create("", SRC_SIZE, SRC_SIZE, 1, GDT_Byte, nullptr));
+    const double adfSrcGT[6] = {0, 0.01, 0, 46, 0, -0.01};
+    poSrcDS->SetGeoTransform(const_cast<double *>(adfSrcGT));
+    poSrcDS->SetProjection(SRS_WKT_WGS84_LAT_LONG);
+    constexpr int DST_XSIZE = 500;
+    constexpr int DST_YSIZE = 700;
+    GDALDatasetUniquePtr poDstDS(
+        poDriver->Create("", DST_XSIZE, DST_YSIZE, 1, GDT_Byte, nullptr));
+    const double adfDstGT[6] = {250000, 1000, 0, 5100000, 0, -1000};
+    poDstDS->SetGeoTransform(const_cast<double *>(adfDstGT));
+    OGRSpatialReference oSrcSRS;
+    oSrcSRS.importFromEPSG(4326);
+    oSrcSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    OGRSpatialReference oDstSRS;
+    oDstSRS.importFromEPSG(32631);
+    oDstSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    poDstDS->SetSpatialRef(&oDstSRS);
+
+    void *pExactArg = GDALCreateGenImgProjTransformer2(
+        GDALDataset::ToHandle(poSrcDS.get()),
+        GDALDataset::ToHandle(poDstDS.get()), nullptr);
+    ASSERT_TRUE(pExactArg != nullptr);
+    constexpr double MAX_ERROR = 0.125;
+    void *pApproxArg = GDALCreateApproxTransformer(GDALGenImgProjTransform,
+                                                   pExactArg, MAX_ERROR);
+    ASSERT_TRUE(pApproxArg != nullptr);
+    auto poCT = std::unique_ptr<OGRCoordinateTransformation>(
+        OGRCreateCoordinateTransformation(&oSrcSRS, &oDstSRS));
+    ASSERT_TRUE(poCT != nullptr);
+    auto poInvCT = std::unique_ptr<OGRCoordinateTransformation>(
+        poCT->GetInverse());
+    ASSERT_TRUE(poInvCT != nullptr);
+
+    double adfDstInvGT[6];
+    ASSERT_TRUE(GDALInvGeoTransform(adfDstGT, adfDstInvGT));
+    double adfSrcInvGT[6];
+    ASSERT_TRUE(GDALInvGeoTransform(adfSrcGT, adfSrcInvGT));
+
+    for (int nPoints :
+         {1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 16, 17, 31, 32, 33, 100, 255, 1000})
+    {
+        for (int bDstToSrc = FALSE; bDstToSrc <= TRUE; ++bDstToSrc)
+        {
+            // Points of a line, as GDALWarpOperation transforms them
+            const double dfXSize = bDstToSrc ? DST_XSIZE : SRC_SIZE;
+            const double dfY = bDstToSrc ? 123.5 : 321.5;
+            std::vector<double> adfX(nPoints);
+            std::vector<double> adfY(nPoints, dfY);
+            for (int i = 0; i < nPoints; ++i)
+                adfX[i] = 0.5 + i * (dfXSize - 1) / std::max(1, nPoints - 1);
+
+            std::vector<double> adfXExact(adfX);
+            std::vector<double> adfYExact(adfY);
+            std::vector<double> adfZExact(nPoints, 0);
+            std::vector<int> anSuccessExact(nPoints, FALSE);
+            GDALGenImgProjTransform(pExactArg, bDstToSrc, nPoints,
+                                    adfXExact.data(), adfYExact.data(),
+                                    adfZExact.data(), anSuccessExact.data());
+
+            std::vector<double> adfXApprox(adfX);
+            std::vector<double> adfYApprox(adfY);
+            std::vector<double> adfZApprox(nPoints, 0);
+            std::vector<int> anSuccessApprox(nPoints, FALSE);
+            GDALApproxTransform(pApproxArg, bDstToSrc, nPoints,
+                                adfXApprox.data(), adfYApprox.data(),
+                                adfZApprox.data(), anSuccessApprox.data());
+
+            for (int i = 0; i < nPoints; ++i)
+            {
+                ASSERT_TRUE(anSuccessExact[i])
+                    << nPoints << " " << bDstToSrc << " " << i;
+                ASSERT_TRUE(anSuccessApprox[i])
+                    << nPoints << " " << bDstToSrc << " " << i;
+
+                // Reference computed with the scalar geotransform code
+                double dfGeoX = 0;
+                double dfGeoY = 0;
+                GDALApplyGeoTransform(bDstToSrc ? adfDstGT : adfSrcGT,
+                                      adfX[i], adfY[i], &dfGeoX, &dfGeoY);
+                (bDstToSrc ? poInvCT : poCT)->Transform(1, &dfGeoX, &dfGeoY);
+                double dfExpectedX = 0;
+                double dfExpectedY = 0;
+                GDALApplyGeoTransform(bDstToSrc ? adfSrcInvGT : adfDstInvGT,
+                                      dfGeoX, dfGeoY, &dfExpectedX,
+                                      &dfExpectedY);
+                EXPECT_NEAR(adfXExact[i], dfExpectedX, 1e-6)
+                    << nPoints << " " << bDstToSrc << " " << i;
+                EXPECT_NEAR(adfYExact[i], dfExpectedY, 1e-6)
+                    << nPoints << " " << bDstToSrc << " " << i;
+
+                EXPECT_NEAR(adfXApprox[i], adfXExact[i], MAX_ERROR)
+                    << nPoints << " " << bDstToSrc << " " << i;
+                EXPECT_NEAR(adfYApprox[i], adfYExact[i], MAX_ERROR)
+                    << nPoints << " " << bDstToSrc << " " << i;
+            }
+        }
+    }
+
+    GDALDestroyApproxTransformer(pApproxArg);
+    GDALDestroyGenImgProjTransformer(pExactArg);
+}
+
 }  // namespace
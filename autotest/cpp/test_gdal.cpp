@@ -36,8 +36,10 @@
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <thread>
 
 #include "test_data.h"
 
@@ -4021,4 +4023,715 @@ TEST_F(test_gdal, gdal_gcp_class)
     }
 }
 
+// Test GDAL_OF_THREAD_SAFE
+TEST_F(test_gdal, open_thread_safe)
+{
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(GDALDataset::Open(GCORE_DATA_DIR "byte.tif",
+                                    GDAL_OF_THREAD_SAFE | GDAL_OF_UPDATE |
+                                        GDAL_OF_RASTER),
+                  nullptr);
+        EXPECT_EQ(GDALDataset::Open(GCORE_DATA_DIR "byte.tif",
+                                    GDAL_OF_THREAD_SAFE | GDAL_OF_VECTOR),
+                  nullptr);
+    }
+
+    auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+        GCORE_DATA_DIR "byte.tif", GDAL_OF_THREAD_SAFE | GDAL_OF_RASTER));
+    ASSERT_NE(poDS, nullptr);
+    ASSERT_EQ(poDS->GetRasterCount(), 1);
+    double adfGT[6] = {0};
+    EXPECT_EQ(poDS->GetGeoTransform(adfGT), CE_None);
+    EXPECT_EQ(adfGT[0], 440720.0);
+    EXPECT_NE(poDS->GetSpatialRef(), nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    EXPECT_EQ(poBand->GetRasterDataType(), GDT_Byte);
+    ASSERT_NE(poBand->GetMaskBand(), nullptr);
+    EXPECT_EQ(poBand->GetMaskFlags(), GMF_ALL_VALID);
+
+    std::vector<std::thread> aoThreads;
+    std::vector<int> anChecksums(4);
+    for (int i = 0; i < static_cast<int>(anChecksums.size()); ++i)
+    {
+        aoThreads.emplace_back(
+            [poBand, &anChecksums, i]()
+            {
+                int nChecksum = 0;
+                for (int iIter = 0; iIter < 20; ++iIter)
+                    nChecksum = GDALChecksumImage(poBand, 0, 0, 20, 20);
+                anChecksums[i] = nChecksum;
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    for (const int nChecksum : anChecksums)
+        EXPECT_EQ(nChecksum, 4672);
+
+    std::vector<GByte> abyBuffer(20 * 20);
+    EXPECT_EQ(poDS->GetRasterBand(1)->GetMaskBand()->RasterIO(
+                  GF_Read, 0, 0, 20, 20, abyBuffer.data(), 20, 20, GDT_Byte, 0,
+                  0, nullptr),
+              CE_None);
+    EXPECT_EQ(abyBuffer[0], 255);
+}
+
+// Test that multi-threaded prefetching of blocks in RasterIO() gives the same
+// result as the single-threaded code path
+TEST_F(test_gdal, RasterIO_prefetch_blocks_multithreaded)
+{
+    GDALDriver *poGTiffDriver =
+        GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poGTiffDriver)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+    EXPECT_TRUE(CPLTestBool(poGTiffDriver->GetMetadataItem(
+        GDAL_DCAP_CONCURRENT_BLOCK_READ)));
+
+    const char *pszFilename =
+        "/vsimem/RasterIO_prefetch_blocks_multithreaded.tif";
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", "16");
+        aosOptions.SetNameValue("BLOCKYSIZE", "16");
+        aosOptions.SetNameValue("COMPRESS", "DEFLATE");
+        auto poDS = std::unique_ptr<GDALDataset>(poGTiffDriver->Create(
+            pszFilename, 100, 50, 2, GDT_UInt16, aosOptions.List()));
+        ASSERT_NE(poDS, nullptr);
+        std::vector<GUInt16> anValues(100 * 50 * 2);
+        for (size_t i = 0; i < anValues.size(); ++i)
+            anValues[i] = static_cast<GUInt16>(i);
+        ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, 100, 50, anValues.data(), 100,
+                                 50, GDT_UInt16, 2, nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+    }
+
+    // Upsampling requests go through the generic block-based code path
+    const auto ReadUpsampled = [pszFilename]()
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            GDALDataset::Open(pszFilename, GDAL_OF_RASTER));
+        std::vector<GUInt16> anOut(200 * 100 * 2);
+        if (!poDS)
+        {
+            ADD_FAILURE() << "cannot open " << pszFilename;
+            return anOut;
+        }
+        EXPECT_EQ(poDS->RasterIO(GF_Read, 0, 0, 100, 50, anOut.data(), 200,
+                                 100, GDT_UInt16, 2, nullptr, 0, 0, 0,
+                                 nullptr),
+                  CE_None);
+        poDS->FlushCache(false);
+        std::vector<GUInt16> anOutBand(200 * 100);
+        EXPECT_EQ(poDS->GetRasterBand(2)->RasterIO(
+                      GF_Read, 0, 0, 100, 50, anOutBand.data(), 200, 100,
+                      GDT_UInt16, 0, 0, nullptr),
+                  CE_None);
+        anOut.insert(anOut.end(), anOutBand.begin(), anOutBand.end());
+        return anOut;
+    };
+
+    const auto anExpected = ReadUpsampled();
+    {
+        // The number of threads is determined on the first read of each
+        // dataset, so it must be set before reading a freshly opened one.
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+        EXPECT_EQ(ReadUpsampled(), anExpected);
+    }
+    EXPECT_EQ(anExpected[200 * 100 + 2 * 200 + 2], 100 * 50 + 100 + 1);
+    VSIUnlink(pszFilename);
+}
+
+// Test GDALDataset::ReadRasterBatch()
+TEST_F(test_gdal, ReadRasterBatch)
+{
+    for (const unsigned nFlags : {0U, static_cast<unsigned>(GDAL_OF_THREAD_SAFE)})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+            GCORE_DATA_DIR "byte.tif", GDAL_OF_RASTER | nFlags));
+        ASSERT_NE(poDS, nullptr);
+
+        std::vector<GByte> abyRef(20 * 20);
+        ASSERT_EQ(poDS->RasterIO(GF_Read, 0, 0, 20, 20, abyRef.data(), 20, 20,
+                                 GDT_Byte, 1, nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+
+        std::vector<GByte> abyTiles(4 * 10 * 10);
+        std::vector<GDALRasterIOWindow> asWindows;
+        for (int i = 0; i < 4; ++i)
+        {
+            GDALRasterIOWindow sWindow;
+            memset(&sWindow, 0, sizeof(sWindow));
+            sWindow.nXOff = (i % 2) * 10;
+            sWindow.nYOff = (i / 2) * 10;
+            sWindow.nXSize = 10;
+            sWindow.nYSize = 10;
+            sWindow.pData = abyTiles.data() + i * 10 * 10;
+            sWindow.nBufXSize = 10;
+            sWindow.nBufYSize = 10;
+            sWindow.eBufType = GDT_Byte;
+            sWindow.nBandCount = 1;
+            asWindows.push_back(sWindow);
+        }
+
+        struct Ctxt
+        {
+            std::vector<int> anCompleted{};
+            int nMaxCalls = 0;
+        };
+
+        const auto Completed = [](int iWindow, CPLErr eErr, void *pUserData)
+        {
+            auto psCtxt = static_cast<Ctxt *>(pUserData);
+            EXPECT_EQ(eErr, CE_None);
+            psCtxt->anCompleted.push_back(iWindow);
+            return static_cast<int>(psCtxt->anCompleted.size()) <
+                           psCtxt->nMaxCalls
+                       ? TRUE
+                       : FALSE;
+        };
+
+        {
+            Ctxt sCtxt;
+            sCtxt.nMaxCalls = 4;
+            const char *const apszOptions[] = {"NUM_THREADS=4", nullptr};
+            EXPECT_EQ(poDS->ReadRasterBatch(4, asWindows.data(), Completed,
+                                            &sCtxt, apszOptions),
+                      CE_None);
+            std::sort(sCtxt.anCompleted.begin(), sCtxt.anCompleted.end());
+            EXPECT_EQ(sCtxt.anCompleted, std::vector<int>({0, 1, 2, 3}));
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int y = 0; y < 10; ++y)
+                {
+                    for (int x = 0; x < 10; ++x)
+                    {
+                        EXPECT_EQ(abyTiles[i * 100 + y * 10 + x],
+                                  abyRef[((i / 2) * 10 + y) * 20 +
+                                         (i % 2) * 10 + x]);
+                    }
+                }
+            }
+        }
+
+        // Cancellation
+        if (nFlags == 0)
+        {
+            Ctxt sCtxt;
+            sCtxt.nMaxCalls = 2;
+            CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+            EXPECT_EQ(poDS->ReadRasterBatch(4, asWindows.data(), Completed,
+                                            &sCtxt, nullptr),
+                      CE_Failure);
+            EXPECT_EQ(sCtxt.anCompleted, std::vector<int>({0, 1}));
+        }
+    }
+}
+
+// Test that GDALRegenerateOverviewsMultiBand(), which computes overview
+// levels in an interleaved way, gives the same result as computing each
+// level from the previous one in a separate pass.
+TEST_F(test_gdal, GDALRegenerateOverviewsMultiBand_interleaved_levels)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    auto poSrcDS = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", 201, 103, 2, GDT_Byte, nullptr));
+    ASSERT_NE(poSrcDS, nullptr);
+    std::vector<GByte> abyValues(201 * 103 * 2);
+    for (size_t i = 0; i < abyValues.size(); ++i)
+        abyValues[i] = static_cast<GByte>((i * 7) % 251);
+    ASSERT_EQ(poSrcDS->RasterIO(GF_Write, 0, 0, 201, 103, abyValues.data(),
+                                201, 103, GDT_Byte, 2, nullptr, 0, 0, 0,
+                                nullptr),
+              CE_None);
+
+    constexpr int N_LEVELS = 3;
+    const auto CreateLevels = [poMEMDriver]()
+    {
+        std::vector<std::unique_ptr<GDALDataset>> apoLevels;
+        int nXSize = 201;
+        int nYSize = 103;
+        for (int i = 0; i < N_LEVELS; ++i)
+        {
+            nXSize = (nXSize + 1) / 2;
+            nYSize = (nYSize + 1) / 2;
+            apoLevels.emplace_back(
+                poMEMDriver->Create("", nXSize, nYSize, 2, GDT_Byte, nullptr));
+        }
+        return apoLevels;
+    };
+
+    const auto ReadLevels =
+        [](const std::vector<std::unique_ptr<GDALDataset>> &apoLevels)
+    {
+        std::vector<GByte> abyOut;
+        for (const auto &poDS : apoLevels)
+        {
+            const int nXSize = poDS->GetRasterXSize();
+            const int nYSize = poDS->GetRasterYSize();
+            std::vector<GByte> abyLevel(nXSize * nYSize * 2);
+            EXPECT_EQ(poDS->RasterIO(GF_Read, 0, 0, nXSize, nYSize,
+                                     abyLevel.data(), nXSize, nYSize, GDT_Byte,
+                                     2, nullptr, 0, 0, 0, nullptr),
+                      CE_None);
+            abyOut.insert(abyOut.end(), abyLevel.begin(), abyLevel.end());
+        }
+        return abyOut;
+    };
+
+    for (const char *pszResampling : {"AVERAGE", "CUBIC", "MODE"})
+    {
+        // Reference: one call per overview level
+        auto apoRefLevels = CreateLevels();
+        for (int i = 0; i < N_LEVELS; ++i)
+        {
+            GDALDataset *poSrcLevelDS =
+                i == 0 ? poSrcDS.get() : apoRefLevels[i - 1].get();
+            std::vector<GDALRasterBand *> apoSrcBands;
+            std::vector<std::vector<GDALRasterBand *>> aapoOvrBands;
+            for (int iBand = 1; iBand <= 2; ++iBand)
+            {
+                apoSrcBands.push_back(poSrcLevelDS->GetRasterBand(iBand));
+                aapoOvrBands.push_back(
+                    {apoRefLevels[i]->GetRasterBand(iBand)});
+            }
+            ASSERT_EQ(GDALRegenerateOverviewsMultiBand(
+                          apoSrcBands, aapoOvrBands, pszResampling, nullptr,
+                          nullptr, nullptr),
+                      CE_None);
+        }
+        const auto abyExpected = ReadLevels(apoRefLevels);
+
+        for (const char *pszThreads : {"1", "4"})
+        {
+            CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads,
+                                          false);
+            auto apoLevels = CreateLevels();
+            std::vector<GDALRasterBand *> apoSrcBands;
+            std::vector<std::vector<GDALRasterBand *>> aapoOvrBands(2);
+            for (int iBand = 1; iBand <= 2; ++iBand)
+            {
+                apoSrcBands.push_back(poSrcDS->GetRasterBand(iBand));
+                for (const auto &poLevelDS : apoLevels)
+                    aapoOvrBands[iBand - 1].push_back(
+                        poLevelDS->GetRasterBand(iBand));
+            }
+            ASSERT_EQ(GDALRegenerateOverviewsMultiBand(
+                          apoSrcBands, aapoOvrBands, pszResampling, nullptr,
+                          nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(ReadLevels(apoLevels), abyExpected)
+                << pszResampling << " " << pszThreads;
+        }
+    }
+}
+
+// Test ComputeStatistics() and ComputeRasterMinMax() on all numeric data
+// types, with nodata and NaN values, and with several threads.
+TEST_F(test_gdal, ComputeStatistics_all_types)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    for (GDALDataType eDT :
+         {GDT_Byte, GDT_Int8, GDT_UInt16, GDT_Int16, GDT_UInt32, GDT_Int32,
+          GDT_UInt64, GDT_Int64, GDT_Float32, GDT_Float64, GDT_CInt16,
+          GDT_CFloat64})
+    {
+        // 3 values per line: 10, 20 and the nodata value 0, plus a NaN on
+        // the first line for floating point types.
+        auto poDS = std::unique_ptr<GDALDataset>(
+            poMEMDriver->Create("", 3, 100, 1, eDT, nullptr));
+        ASSERT_NE(poDS, nullptr);
+        auto poBand = poDS->GetRasterBand(1);
+        std::vector<double> adfLine = {10, 20, 0};
+        for (int iY = 0; iY < 100; ++iY)
+        {
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 0, iY, 3, 1, adfLine.data(),
+                                       3, 1, GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+        }
+        if (GDALDataTypeIsFloating(eDT))
+        {
+            const double dfNaN = std::numeric_limits<double>::quiet_NaN();
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 2, 0, 1, 1,
+                                       const_cast<double *>(&dfNaN), 1, 1,
+                                       GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+        }
+        poBand->SetNoDataValue(0);
+
+        for (const char *pszThreads : {"1", "4"})
+        {
+            CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads,
+                                          false);
+            double dfMin = 0;
+            double dfMax = 0;
+            double dfMean = 0;
+            double dfStdDev = 0;
+            EXPECT_EQ(poBand->ComputeStatistics(false, &dfMin, &dfMax, &dfMean,
+                                                &dfStdDev, nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(dfMin, 10) << GDALGetDataTypeName(eDT);
+            EXPECT_EQ(dfMax, 20) << GDALGetDataTypeName(eDT);
+            EXPECT_NEAR(dfMean, 15, 1e-10) << GDALGetDataTypeName(eDT);
+            EXPECT_NEAR(dfStdDev, 5, 1e-10) << GDALGetDataTypeName(eDT);
+
+            double adfMinMax[2] = {0, 0};
+            EXPECT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax), CE_None);
+            EXPECT_EQ(adfMinMax[0], 10) << GDALGetDataTypeName(eDT);
+            EXPECT_EQ(adfMinMax[1], 20) << GDALGetDataTypeName(eDT);
+        }
+    }
+}
+
+// Test ComputeStatistics() and ComputeRasterMinMax() on Int16 and Int32
+// bands against a scalar computation, with values spanning the whole range
+// of the data type, and a width that is not a multiple of the number of
+// values per SIMD register.
+TEST_F(test_gdal, ComputeStatistics_int16_int32)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 37;
+    constexpr int nYSize = 29;
+    constexpr double dfNoData = -9999;
+    for (GDALDataType eDT : {GDT_Int16, GDT_Int32})
+    {
+        const double dfTypeMin = eDT == GDT_Int16 ? -32768 : INT_MIN;
+        const double dfTypeMax = eDT == GDT_Int16 ? 32767 : INT_MAX;
+        std::vector<double> adfValues(nXSize * nYSize);
+        std::vector<GByte> abyMask(adfValues.size());
+        for (size_t i = 0; i < adfValues.size(); ++i)
+        {
+            // Pseudo-random values, with nodata values and masked pixels
+            const double dfFrac =
+                static_cast<double>((i * 2654435761U) % 4294967296U) /
+                4294967296.0;
+            adfValues[i] =
+                std::floor(dfTypeMin + dfFrac * (dfTypeMax - dfTypeMin + 1));
+            if ((i % 7) == 3)
+                adfValues[i] = dfNoData;
+            abyMask[i] = (i % 5) == 1 ? 0 : 255;
+        }
+        adfValues[10] = dfTypeMin;
+        adfValues[20] = dfTypeMax;
+
+        // 0: all pixels valid, 1: nodata value, 2: mask band
+        for (int iMode = 0; iMode < 3; ++iMode)
+        {
+            auto poDS = std::unique_ptr<GDALDataset>(
+                poMEMDriver->Create("", nXSize, nYSize, 1, eDT, nullptr));
+            ASSERT_NE(poDS, nullptr);
+            auto poBand = poDS->GetRasterBand(1);
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                                       adfValues.data(), nXSize, nYSize,
+                                       GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+            if (iMode == 1)
+            {
+                poBand->SetNoDataValue(dfNoData);
+            }
+            else if (iMode == 2)
+            {
+                ASSERT_EQ(poBand->CreateMaskBand(0), CE_None);
+                ASSERT_EQ(poBand->GetMaskBand()->RasterIO(
+                              GF_Write, 0, 0, nXSize, nYSize, abyMask.data(),
+                              nXSize, nYSize, GDT_Byte, 0, 0, nullptr),
+                          CE_None);
+            }
+
+            GUIntBig nCount = 0;
+            double dfExpectedMin = std::numeric_limits<double>::max();
+            double dfExpectedMax = -std::numeric_limits<double>::max();
+            double dfSum = 0;
+            const auto IsValid = [iMode, &adfValues, &abyMask](size_t i)
+            {
+                if (iMode == 1 && ARE_REAL_EQUAL(adfValues[i], dfNoData))
+                    return false;
+                return !(iMode == 2 && abyMask[i] == 0);
+            };
+            for (size_t i = 0; i < adfValues.size(); ++i)
+            {
+                if (!IsValid(i))
+                    continue;
+                ++nCount;
+                dfExpectedMin = std::min(dfExpectedMin, adfValues[i]);
+                dfExpectedMax = std::max(dfExpectedMax, adfValues[i]);
+                dfSum += adfValues[i];
+            }
+            const double dfExpectedMean = dfSum / static_cast<double>(nCount);
+            double dfM2 = 0;
+            for (size_t i = 0; i < adfValues.size(); ++i)
+            {
+                if (IsValid(i))
+                    dfM2 += (adfValues[i] - dfExpectedMean) *
+                            (adfValues[i] - dfExpectedMean);
+            }
+            const double dfExpectedStdDev =
+                sqrt(dfM2 / static_cast<double>(nCount));
+
+            double dfMin = 0;
+            double dfMax = 0;
+            double dfMean = 0;
+            double dfStdDev = 0;
+            EXPECT_EQ(poBand->ComputeStatistics(false, &dfMin, &dfMax, &dfMean,
+                                                &dfStdDev, nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(dfMin, dfExpectedMin)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+            EXPECT_EQ(dfMax, dfExpectedMax)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+            EXPECT_NEAR(dfMean, dfExpectedMean, 1e-10 * dfTypeMax)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+            EXPECT_NEAR(dfStdDev, dfExpectedStdDev, 1e-10 * dfTypeMax)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+
+            double adfMinMax[2] = {0, 0};
+            EXPECT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax), CE_None);
+            EXPECT_EQ(adfMinMax[0], dfExpectedMin)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+            EXPECT_EQ(adfMinMax[1], dfExpectedMax)
+                << GDALGetDataTypeName(eDT) << " " << iMode;
+        }
+    }
+}
+
+// Test GDALQuantileSketch
+TEST_F(test_gdal, GDALQuantileSketch)
+{
+    GDALQuantileSketch oEmpty;
+    EXPECT_TRUE(std::isnan(oEmpty.GetQuantile(0.5)));
+
+    // Values 0 to 99999, split in two sketches
+    GDALQuantileSketch oSketch1;
+    GDALQuantileSketch oSketch2;
+    for (int i = 0; i < 100000; ++i)
+    {
+        // Pseudo-random order
+        const int nVal = static_cast<int>((i * 7919LL) % 100000);
+        (nVal % 3 ? oSketch1 : oSketch2).Add(nVal);
+    }
+    oSketch1.Merge(oSketch2);
+    EXPECT_EQ(oSketch1.GetCount(), 100000);
+    EXPECT_EQ(oSketch1.GetQuantile(0), 0);
+    EXPECT_EQ(oSketch1.GetQuantile(1), 99999);
+    for (double dfProb : {0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999})
+    {
+        EXPECT_NEAR(oSketch1.GetQuantile(dfProb), dfProb * 100000, 100)
+            << dfProb;
+    }
+
+    GDALQuantileSketch oSketch3;
+    EXPECT_TRUE(oSketch3.Deserialize(oSketch1.Serialize().c_str()));
+    EXPECT_EQ(oSketch3.GetCount(), 100000);
+    EXPECT_EQ(oSketch3.GetQuantile(0.5), oSketch1.GetQuantile(0.5));
+    EXPECT_FALSE(oSketch3.Deserialize("invalid"));
+    EXPECT_FALSE(oSketch3.Deserialize("1 100 2 0 1 1 0.5 1"));
+    EXPECT_FALSE(oSketch3.Deserialize("1 100 2 0 1 2147483647 0.5 1"));
+    EXPECT_FALSE(oSketch3.Deserialize("1 100 2 0 1 1073741824 0.5 1"));
+    EXPECT_EQ(oSketch3.GetCount(), 100000);
+}
+
+// Test GDALRasterBand::GetQuantiles()
+TEST_F(test_gdal, GetQuantiles)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    for (GDALDataType eDT : {GDT_Byte, GDT_Int16, GDT_Float32, GDT_Float64})
+    {
+        // Values 1 to 100 on each line, and the nodata value 0
+        auto poDS = std::unique_ptr<GDALDataset>(
+            poMEMDriver->Create("", 101, 50, 1, eDT, nullptr));
+        ASSERT_NE(poDS, nullptr);
+        auto poBand = poDS->GetRasterBand(1);
+        std::vector<double> adfLine(101);
+        for (int i = 0; i < 101; ++i)
+            adfLine[i] = i;
+        for (int iY = 0; iY < 50; ++iY)
+        {
+            ASSERT_EQ(poBand->RasterIO(GF_Write, 0, iY, 101, 1, adfLine.data(),
+                                       101, 1, GDT_Float64, 0, 0, nullptr),
+                      CE_None);
+        }
+        poBand->SetNoDataValue(0);
+
+        const double adfProbs[] = {0, 0.5, 1};
+        double adfValues[3] = {0, 0, 0};
+        EXPECT_EQ(poBand->GetQuantiles(false, false, 3, adfProbs, adfValues,
+                                       nullptr, nullptr),
+                  CE_Warning);
+        {
+            CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+            EXPECT_EQ(poBand->GetQuantiles(false, true, 3, adfProbs,
+                                           adfValues, nullptr, nullptr),
+                      CE_None);
+        }
+        EXPECT_EQ(adfValues[0], 1) << GDALGetDataTypeName(eDT);
+        EXPECT_NEAR(adfValues[1], 50.5, 1) << GDALGetDataTypeName(eDT);
+        EXPECT_EQ(adfValues[2], 100) << GDALGetDataTypeName(eDT);
+        EXPECT_NE(poBand->GetMetadataItem("SKETCH", "QUANTILE_SKETCH"),
+                  nullptr);
+
+        // Cached sketch
+        EXPECT_EQ(poBand->GetQuantiles(false, false, 3, adfProbs, adfValues,
+                                       nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(adfValues[2], 100) << GDALGetDataTypeName(eDT);
+    }
+}
+
+// Test GDALChecksumImageEx()
+TEST_F(test_gdal, GDALChecksumImageEx)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    constexpr int nXSize = 257;
+    constexpr int nYSize = 123;
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", nXSize, nYSize, 1, GDT_Int16, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    std::vector<GInt16> anValues(nXSize * nYSize);
+    for (size_t i = 0; i < anValues.size(); ++i)
+        anValues[i] = static_cast<GInt16>((i * 7919) % 65536 - 32768);
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nXSize, nYSize,
+                               anValues.data(), nXSize, nYSize, GDT_Int16, 0,
+                               0, nullptr),
+              CE_None);
+
+    // Reference implementation, value by value
+    const auto ReferenceChecksum =
+        [&anValues](int nXOff, int nYOff, int nXWin, int nYWin)
+    {
+        const int anPrimes[11] = {7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43};
+        int nChecksum = 0;
+        int iPrime = 0;
+        for (int iY = nYOff; iY < nYOff + nYWin; ++iY)
+        {
+            for (int iX = nXOff; iX < nXOff + nXWin; ++iX)
+            {
+                nChecksum += anValues[iY * nXSize + iX] % anPrimes[iPrime++];
+                if (iPrime > 10)
+                    iPrime = 0;
+                nChecksum &= 0xffff;
+            }
+        }
+        return nChecksum;
+    };
+
+    std::string osRefHash;
+    for (const char *pszThreads : {"1", "4"})
+    {
+        const CPLStringList aosOptions(std::vector<std::string>{
+            "HASH=SHA256", std::string("NUM_THREADS=").append(pszThreads)});
+        char *pszHash = nullptr;
+        EXPECT_EQ(GDALChecksumImageEx(poBand, 0, 0, nXSize, nYSize,
+                                      aosOptions.List(), &pszHash),
+                  ReferenceChecksum(0, 0, nXSize, nYSize));
+        ASSERT_NE(pszHash, nullptr);
+        EXPECT_EQ(strlen(pszHash), 64U);
+        if (osRefHash.empty())
+            osRefHash = pszHash;
+        else
+            EXPECT_STREQ(pszHash, osRefHash.c_str());
+        CPLFree(pszHash);
+
+        EXPECT_EQ(GDALChecksumImageEx(poBand, 3, 5, 100, 50, aosOptions.List(),
+                                      nullptr),
+                  ReferenceChecksum(3, 5, 100, 50));
+    }
+
+    // Changing a single pixel changes the hash
+    const GInt16 nVal = static_cast<GInt16>(anValues[0] + 1);
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, 1, 1,
+                               const_cast<GInt16 *>(&nVal), 1, 1, GDT_Int16,
+                               0, 0, nullptr),
+              CE_None);
+    const char *const apszOptions[] = {"HASH=SHA256", nullptr};
+    char *pszHash = nullptr;
+    EXPECT_GE(GDALChecksumImageEx(poBand, 0, 0, nXSize, nYSize, apszOptions,
+                                  &pszHash),
+              0);
+    ASSERT_NE(pszHash, nullptr);
+    EXPECT_STRNE(pszHash, osRefHash.c_str());
+    CPLFree(pszHash);
+}
+
+// Test GDALRasterBand::BorrowBlock()
+TEST_F(test_gdal, BorrowBlock)
+{
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poMEMDriver)
+    {
+        GTEST_SKIP() << "MEM driver missing";
+    }
+
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poMEMDriver->Create("", 10, 3, 1, GDT_UInt16, nullptr));
+    ASSERT_NE(poDS, nullptr);
+    auto poBand = poDS->GetRasterBand(1);
+    std::vector<GUInt16> anValues(30);
+    for (int i = 0; i < 30; ++i)
+        anValues[i] = static_cast<GUInt16>(i);
+    ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, 10, 3, anValues.data(), 10, 3,
+                               GDT_UInt16, 0, 0, nullptr),
+              CE_None);
+
+    {
+        auto oBlock = poBand->BorrowBlock(0, 1);
+        ASSERT_TRUE(oBlock);
+        EXPECT_EQ(oBlock.GetDataType(), GDT_UInt16);
+        EXPECT_EQ(oBlock.GetBlockXSize(), 10);
+        EXPECT_EQ(oBlock.GetBlockYSize(), 1);
+        const GUInt16 *panData = static_cast<const GUInt16 *>(oBlock.GetData());
+        EXPECT_EQ(panData[0], 10);
+        EXPECT_EQ(panData[9], 19);
+
+        // Copies share the same buffer
+        auto oBlockCopy = oBlock;
+        oBlock.Release();
+        EXPECT_FALSE(oBlock);
+        EXPECT_EQ(oBlockCopy.GetData(), panData);
+
+        // Borrowing the same block again returns the same buffer
+        auto oBlock2 = poBand->BorrowBlock(0, 1);
+        EXPECT_EQ(oBlock2.GetData(), panData);
+    }
+
+    {
+        CPLErrorHandlerPusher oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_FALSE(poBand->BorrowBlock(0, 3));
+    }
+
+    GDALBorrowedBlockH hBlock =
+        GDALRasterBandBorrowBlock(GDALRasterBand::ToHandle(poBand), 0, 2);
+    ASSERT_NE(hBlock, nullptr);
+    EXPECT_EQ(static_cast<const GUInt16 *>(GDALBorrowedBlockGetData(hBlock))[0],
+              20);
+    GDALBorrowedBlockRelease(hBlock);
+}
+
 }  // namespace
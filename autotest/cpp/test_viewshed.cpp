@@ -493,4 +493,75 @@ TEST(Viewshed, oor_below)
     }
 }
 
+// Cumulative viewshed of several observers.
+TEST(Viewshed, cumulative)
+{
+    // clang-format off
+    const int xlen = 5;
+    const int ylen = 5;
+    std::array<int8_t, xlen * ylen> in
+    {
+        -1, 0, 1, 0, -1,
+        -1, 2, 0, 4, -1,
+        -1, 1, 0, -1, -1,
+         0, 3, 0, 2, 0,
+        -1, 0, 0, 3, -1
+    };
+    // clang-format on
+    const std::array<Coord, 4> observers{Coord{2, 2}, Coord{0, 0},
+                                         Coord{4, 1}, Coord{6, 2}};
+
+    // The cumulative viewshed counts, for each cell, the observers from which
+    // it is visible.
+    std::array<uint32_t, xlen * ylen> expected{};
+    std::vector<Viewshed::Point> points;
+    for (const Coord &observer : observers)
+    {
+        Viewshed::Options opts = stdOptions(observer);
+        points.push_back(opts.observer);
+
+        DatasetPtr output = runViewshed(in.data(), xlen, ylen, opts);
+        std::array<uint8_t, xlen * ylen> out;
+        GDALRasterBand *band = output->GetRasterBand(1);
+        CPLErr err = band->RasterIO(GF_Read, 0, 0, xlen, ylen, out.data(), xlen,
+                                    ylen, GDT_Byte, 0, 0, nullptr);
+        EXPECT_EQ(err, CE_None);
+        for (size_t i = 0; i < out.size(); ++i)
+            expected[i] += out[i] == opts.visibleVal ? 1 : 0;
+    }
+
+    GDALDriver *driver = (GDALDriver *)GDALGetDriverByName("MEM");
+    DatasetPtr dataset(driver->Create("", xlen, ylen, 1, GDT_Int8, nullptr));
+    ASSERT_TRUE(dataset);
+    dataset->SetGeoTransform(identity.data());
+    GDALRasterBand *band = dataset->GetRasterBand(1);
+    CPLErr err = band->RasterIO(GF_Write, 0, 0, xlen, ylen, in.data(), xlen,
+                                ylen, GDT_Int8, 0, 0, nullptr);
+    EXPECT_EQ(err, CE_None);
+
+    // An observer whose position is out of range is skipped with a warning.
+    points.push_back(Viewshed::Point{1e12, 2, 0});
+
+    for (int nThreads : {1, 4})
+    {
+        SCOPED_TRACE(nThreads);
+        CPLErrorReset();
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        DatasetPtr output = Viewshed::runCumulative(
+            stdOptions(0, 0), points, GDALRasterBand::ToHandle(band),
+            nThreads);
+        CPLPopErrorHandler();
+        ASSERT_TRUE(output);
+        EXPECT_EQ(CPLGetLastErrorType(), CE_Warning);
+        EXPECT_EQ(output->GetRasterBand(1)->GetRasterDataType(), GDT_UInt32);
+
+        std::array<uint32_t, xlen * ylen> out;
+        err = output->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, xlen, ylen,
+                                                 out.data(), xlen, ylen,
+                                                 GDT_UInt32, 0, 0, nullptr);
+        EXPECT_EQ(err, CE_None);
+        EXPECT_EQ(expected, out);
+    }
+}
+
 }  // namespace gdal
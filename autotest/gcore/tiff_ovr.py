@@ -2346,6 +2346,56 @@ def test_tiff_ovr_multithreading_multiband():
 ###############################################################################
 
 
+# Test that lossy compressed overviews computed by
+# GDALRegenerateOverviewsMultiBand() do not depend on the block cache size
+
+
+@pytest.mark.parametrize("compression", ["JPEG", "WEBP"])
+def test_tiff_ovr_multiband_lossy_cache_size_independent(tmp_vsimem, compression):
+
+    if compression not in gdal.GetDriverByName("GTiff").GetMetadataItem(
+        "DMD_CREATIONOPTIONLIST"
+    ):
+        pytest.skip(f"{compression} compression not available")
+
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        format="MEM",
+        bandList=[1, 2, 3],
+        width=1024,
+        height=1024,
+        resampleAlg="bilinear",
+    )
+
+    def build_overviews(cache_max):
+        filename = str(tmp_vsimem / f"test_{cache_max}.tif")
+        gdal.Translate(
+            filename,
+            src_ds,
+            creationOptions=[
+                "COMPRESS=" + compression,
+                "INTERLEAVE=PIXEL",
+                "TILED=YES",
+            ],
+        )
+        with gdaltest.SetCacheMax(cache_max):
+            ds = gdal.Open(filename, gdal.GA_Update)
+            ds.BuildOverviews("AVERAGE", [2, 4, 8])
+            ds = None
+        ds = gdal.Open(filename)
+        return [
+            ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+            for i in range(3)
+            for j in range(3)
+        ]
+
+    assert build_overviews(1024 * 1024) == build_overviews(256 * 1024 * 1024)
+
+
+###############################################################################
+
+
 def test_tiff_ovr_multithreading_singleband():
 
     # Test multithreading through GDALRegenerateOverviews
@@ -32,6 +32,7 @@
 
 
 import math
+import struct
 
 import gdaltest
 import pytest
@@ -360,6 +361,53 @@ def test_transformer_5():
     gdal.Unlink("/vsimem/dem.tif")
 
 
+###############################################################################
+# Test that transforming several points at once with the RPC transformer
+# gives the same results as transforming them one by one.
+
+
+def test_transformer_rpc_several_points():
+
+    ds = gdal.Open("data/rpc.vrt")
+
+    ds_dem = gdal.GetDriverByName("GTiff").Create(
+        "/vsimem/dem_several_points.tif", 100, 100, 1, gdal.GDT_Float32
+    )
+    sr = osr.SpatialReference()
+    sr.ImportFromEPSG(32652)
+    ds_dem.SetProjection(sr.ExportToWkt())
+    ds_dem.SetGeoTransform([213300, 200, 0, 4418700, 0, -200])
+    heights = [10 + (i % 100) + (i // 100) for i in range(100 * 100)]
+    ds_dem.GetRasterBand(1).WriteRaster(
+        0, 0, 100, 100, struct.pack("f" * len(heights), *heights)
+    )
+    ds_dem = None
+
+    try:
+        for options in (
+            ["METHOD=RPC"],
+            ["METHOD=RPC", "RPC_DEM=/vsimem/dem_several_points.tif"],
+        ):
+            tr = gdal.Transformer(ds, None, options)
+            pixels = [(20.5 + i, 10.5 + 0.5 * i, 0) for i in range(10)]
+
+            fwd, fwd_success = tr.TransformPoints(0, pixels)
+            for i, pnt in enumerate(pixels):
+                success, ref = tr.TransformPoint(0, *pnt)
+                assert fwd_success[i] == success
+                assert fwd[i] == pytest.approx(ref, abs=1e-10)
+
+            inv, inv_success = tr.TransformPoints(1, fwd)
+            for i, pnt in enumerate(fwd):
+                success, ref = tr.TransformPoint(1, *pnt)
+                assert inv_success[i] == success
+                assert inv[i] == pytest.approx(ref, abs=1e-10)
+                assert inv[i][0] == pytest.approx(pixels[i][0], abs=0.05)
+                assert inv[i][1] == pytest.approx(pixels[i][1], abs=0.05)
+    finally:
+        gdal.Unlink("/vsimem/dem_several_points.tif")
+
+
 ###############################################################################
 # Test RPC convergence bug (bug # 5395)
 
@@ -730,6 +778,47 @@ def test_transformer_12():
         assert gdal.GetLastErrorMsg() != ""
 
 
+###############################################################################
+# Test TPS transformer with enough GCPs and points to use several threads
+
+
+def test_transformer_tps_multithreaded():
+
+    ds = gdal.GetDriverByName("MEM").Create("", 200, 200)
+    gcps = []
+    for j in range(15):
+        for i in range(15):
+            pixel = i * 200.0 / 14
+            line = j * 200.0 / 14
+            gcp = gdal.GCP()
+            gcp.GCPPixel = pixel
+            gcp.GCPLine = line
+            gcp.GCPX = 1000 + 2 * pixel + 0.01 * line * line
+            gcp.GCPY = 2000 - 2 * line + 0.005 * pixel * line
+            gcps.append(gcp)
+    ds.SetGCPs(gcps, "")
+
+    pixels = [(0.5 + i % 100 * 2, 0.5 + i // 100 * 2, 0) for i in range(10000)]
+
+    tr = gdal.Transformer(ds, None, ["METHOD=GCP_TPS", "NUM_THREADS=1"])
+    fwd_ref, success = tr.TransformPoints(0, pixels)
+    assert all(success)
+    inv_ref, success = tr.TransformPoints(1, fwd_ref)
+    assert all(success)
+
+    tr = gdal.Transformer(ds, None, ["METHOD=GCP_TPS", "NUM_THREADS=4"])
+    fwd, success = tr.TransformPoints(0, pixels)
+    assert all(success)
+    assert fwd == fwd_ref
+    inv, success = tr.TransformPoints(1, fwd)
+    assert all(success)
+    assert inv == inv_ref
+
+    for i in range(0, 10000, 997):
+        assert inv[i][0] == pytest.approx(pixels[i][0], abs=1e-3)
+        assert inv[i][1] == pytest.approx(pixels[i][1], abs=1e-3)
+
+
 ###############################################################################
 # Test inverse RPC transform at DEM edge (#6377)
 
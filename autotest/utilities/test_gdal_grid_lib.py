@@ -31,6 +31,7 @@
 
 import array
 import collections
+import math
 import struct
 
 import gdaltest
@@ -1055,6 +1056,167 @@ def test_gdal_grid_lib_dict_arguments():
     assert opt[ind : ind + 4] == ["-co", "COMPRESS=DEFLATE", "-co", "LEVEL=4"]
 
 
+###############################################################################
+# Test processing by tiles, and multi-threading, against a brute-force
+# evaluation of each grid node
+
+
+def _gdal_grid_lib_reference_value(alg_name, params, points, cx, cy):
+
+    r1 = params.get("radius1", params.get("radius", 0))
+    r2 = params.get("radius2", r1)
+    r = max(r1, r2)
+    # Points in the square searched in the quadtree
+    cand = [
+        (x - cx, y - cy, z)
+        for (x, y, z) in points
+        if abs(x - cx) <= r and abs(y - cy) <= r
+    ]
+
+    if alg_name == "nearest":
+        best = None
+        for dx, dy, z in cand:
+            r2_pt = dx * dx + dy * dy
+            if best is None or r2_pt <= best[0]:
+                best = (r2_pt, z)
+        return best[1] if best else 0.0
+
+    if alg_name == "invdistnn":
+        sel = sorted(
+            (dx * dx + dy * dy, dx, dy, z)
+            for dx, dy, z in cand
+            if dx * dx + dy * dy <= r * r
+        )
+        max_points = int(params.get("max_points", 12))
+        min_per_quadrant = int(params.get("min_points_per_quadrant", 0))
+        max_per_quadrant = int(params.get("max_points_per_quadrant", 0))
+        if min_per_quadrant or max_per_quadrant:
+            # Take the nearest point of each quadrant in turn
+            quadrants = [[], [], [], []]
+            for d2, dx, dy, z in sel:
+                quadrants[(dx >= 0) | ((dy >= 0) << 1)].append((d2, z))
+            taken = [0] * 4
+            used = []
+            while len(used) < max_points:
+                progress = False
+                for q in range(4):
+                    if taken[q] < len(quadrants[q]) and (
+                        not max_per_quadrant or taken[q] < max_per_quadrant
+                    ):
+                        used.append(quadrants[q][taken[q]])
+                        taken[q] += 1
+                        progress = True
+                        if len(used) == max_points:
+                            break
+                if not progress:
+                    break
+            if min(taken) < min_per_quadrant:
+                return 0.0
+        else:
+            used = [(d2, z) for d2, _, _, z in sel[:max_points]]
+        nominator = 0.0
+        denominator = 0.0
+        for d2, z in used:
+            nominator += (1.0 / d2) * z
+            denominator += 1.0 / d2
+        return nominator / denominator if denominator else 0.0
+
+    inside = [
+        (dx, dy, z)
+        for dx, dy, z in cand
+        if r2 * r2 * dx * dx + r1 * r1 * dy * dy <= r1 * r1 * r2 * r2
+    ]
+    min_per_quadrant = int(params.get("min_points_per_quadrant", 0))
+    if min_per_quadrant:
+        counts = [0] * 4
+        for dx, dy, _ in inside:
+            counts[(dx >= 0) | ((dy >= 0) << 1)] += 1
+        if min(counts) < min_per_quadrant:
+            return 0.0
+    if not inside:
+        return 0.0
+    values = [z for _, _, z in inside]
+    if alg_name == "average":
+        return sum(values) / len(values)
+    if alg_name == "minimum":
+        return min(values)
+    if alg_name == "range":
+        return max(values) - min(values)
+    if alg_name == "count":
+        return float(len(values))
+    assert alg_name == "average_distance"
+    return sum(math.sqrt(dx * dx + dy * dy) for dx, dy, _ in inside) / len(inside)
+
+
+@pytest.mark.parametrize(
+    "alg",
+    [
+        "invdistnn:radius=7:max_points=12",
+        "invdistnn:radius=7:min_points_per_quadrant=1:max_points_per_quadrant=3",
+        "average:radius1=7:radius2=5",
+        "nearest:radius1=6:radius2=6",
+        "minimum:radius1=6:radius2=6",
+        "range:radius1=6:radius2=6:min_points_per_quadrant=1",
+        "count:radius1=6:radius2=6",
+        "average_distance:radius1=6:radius2=6",
+    ],
+)
+def test_gdal_grid_lib_tiles_and_threads(alg):
+
+    # Evenly spread points, without two points at the same distance of a
+    # grid node
+    points = []
+    for i in range(500):
+        x = math.fmod(i * 0.6180339887498949, 1.0) * 100
+        y = math.fmod(i * 0.7548776662466927 + 0.1234, 1.0) * 80
+        points.append((x, y, float(i % 97)))
+
+    mem_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = mem_ds.CreateLayer("test")
+    for x, y, z in points:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%.17g %.17g %.17g)" % (x, y, z)))
+        lyr.CreateFeature(f)
+
+    width = 40
+    height = 30
+    alg_name = alg.split(":")[0]
+    params = {k: float(v) for k, v in (item.split("=") for item in alg.split(":")[1:])}
+    delta_x = 100.0 / width
+    delta_y = -80.0 / height
+    expected = [
+        _gdal_grid_lib_reference_value(
+            alg_name,
+            params,
+            points,
+            (i + 0.5) * delta_x,
+            80 + (j + 0.5) * delta_y,
+        )
+        for j in range(height)
+        for i in range(width)
+    ]
+
+    for env in [
+        {"GDAL_NUM_THREADS": "1", "GDAL_GRID_TILE_SIZE": "0"},
+        {"GDAL_NUM_THREADS": "1"},
+        {"GDAL_NUM_THREADS": "1", "GDAL_GRID_TILE_SIZE": "3"},
+        {"GDAL_NUM_THREADS": "4"},
+    ]:
+        with gdal.config_options(env):
+            ds = gdal.Grid(
+                "",
+                mem_ds,
+                format="MEM",
+                outputBounds=[0, 0, 100, 80],
+                width=width,
+                height=height,
+                outputType=gdal.GDT_Float64,
+                algorithm=alg,
+            )
+        got = struct.unpack("d" * (width * height), ds.ReadRaster())
+        assert list(got) == pytest.approx(expected, rel=1e-12), env
+
+
 ###############################################################################
 # Test various error conditions
 
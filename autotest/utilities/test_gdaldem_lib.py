@@ -293,6 +293,44 @@ def test_gdaldem_lib_hillshade_compute_edges_float():
     ds = None
 
 
+###############################################################################
+# Test that multi-threaded processing gives the same result as single-threaded
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Int16, gdal.GDT_Float32])
+@pytest.mark.parametrize("processing", ["hillshade", "slope", "TRI"])
+@pytest.mark.parametrize("computeEdges", [False, True])
+def test_gdaldem_lib_multithreaded(datatype, processing, computeEdges):
+
+    src_ds = gdal.Translate(
+        "",
+        gdal.Open("../gdrivers/data/n43.tif"),
+        format="MEM",
+        outputType=datatype,
+    )
+    src_ds.GetRasterBand(1).SetNoDataValue(0)
+    src_ds.GetRasterBand(1).WriteRaster(
+        10, 50, 1, 1, struct.pack("f", 0), buf_type=gdal.GDT_Float32
+    )
+
+    def compute():
+        ds = gdal.DEMProcessing(
+            "",
+            src_ds,
+            processing,
+            format="MEM",
+            computeEdges=computeEdges,
+            scale=111120,
+        )
+        assert ds is not None
+        return ds.GetRasterBand(1).ReadRaster()
+
+    with gdal.config_option("GDAL_NUM_THREADS", "1"):
+        ref = compute()
+    with gdal.config_option("GDAL_NUM_THREADS", "3"):
+        assert compute() == ref
+
+
 ###############################################################################
 # Test gdaldem hillshade with -az parameter
 
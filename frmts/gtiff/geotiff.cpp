@@ -1617,6 +1617,7 @@ void GDALRegister_GTiff()
 #endif
 
     poDriver->SetMetadataItem(GDAL_DCAP_COORDINATE_EPOCH, "YES");
+    poDriver->SetMetadataItem(GDAL_DCAP_CONCURRENT_BLOCK_READ, "YES");
 
     poDriver->pfnOpen = GTiffDataset::Open;
     poDriver->pfnCreate = GTiffDataset::Create;
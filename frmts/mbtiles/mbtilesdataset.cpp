@@ -3717,6 +3717,7 @@ void GDALRegister_MBTiles()
 
     poDriver->SetDescription("MBTiles");
     poDriver->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+    poDriver->SetMetadataItem(GDAL_DCAP_CONCURRENT_BLOCK_READ, "YES");
     poDriver->SetMetadataItem(GDAL_DCAP_VECTOR, "YES");
     poDriver->SetMetadataItem(GDAL_DMD_LONGNAME, "MBTiles");
     poDriver->SetMetadataItem(GDAL_DMD_HELPTOPIC,
@@ -882,6 +882,10 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
                                      double *pdfStdDev,
                                      GDALProgressFunc pfnProgress,
                                      void *pProgressData) override;
+    virtual CPLErr ComputeQuantileSketch(int bApproxOK,
+                                         GDALQuantileSketch &oSketch,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressData) override;
     virtual CPLErr GetHistogram(double dfMin, double dfMax, int nBuckets,
                                 GUIntBig *panHistogram, int bIncludeOutOfRange,
                                 int bApproxOK, GDALProgressFunc pfnProgress,
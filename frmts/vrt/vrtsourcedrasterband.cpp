@@ -1668,6 +1668,105 @@ CPLErr VRTSourcedRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
     }
 }
 
+/************************************************************************/
+/*                       ComputeQuantileSketch()                        */
+/************************************************************************/
+
+CPLErr VRTSourcedRasterBand::ComputeQuantileSketch(int bApproxOK,
+                                                   GDALQuantileSketch &oSketch,
+                                                   GDALProgressFunc pfnProgress,
+                                                   void *pProgressData)
+{
+    const std::string osFctId("VRTSourcedRasterBand::ComputeQuantileSketch");
+    GDALAntiRecursionGuard oGuard(osFctId);
+    if (oGuard.GetCallDepth() >= 32)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Recursion detected");
+        return CE_Failure;
+    }
+
+    GDALAntiRecursionGuard oGuard2(oGuard, poDS->GetDescription());
+    if (oGuard2.GetCallDepth() >= 2)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Recursion detected");
+        return CE_Failure;
+    }
+
+    // For a mosaic of sources fully covering the raster, without any
+    // nodata or mask, the sketch is the merge of the sketches of the
+    // sources, which may have been cached by GetQuantiles().
+    // In approximate mode, sources are sampled at different rates, so the
+    // weights of their sketches would not reflect their share of the raster.
+    bool bMergeSources =
+        !bApproxOK && !m_bNoDataValueSet &&
+        IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
+            /*bAllowMaxValAdjustment = */ false);
+    uint64_t nTotalPixelsOfSources = 0;
+    for (int i = 0; bMergeSources && i < nSources; ++i)
+    {
+        auto poSimpleSourceBand =
+            cpl::down_cast<VRTSimpleSource *>(papoSources[i])->GetRasterBand();
+        int bHasNoData = FALSE;
+        CPL_IGNORE_RET_VAL(poSimpleSourceBand->GetNoDataValue(&bHasNoData));
+        if (bHasNoData || poSimpleSourceBand->GetMaskFlags() != GMF_ALL_VALID)
+            bMergeSources = false;
+        nTotalPixelsOfSources +=
+            static_cast<uint64_t>(poSimpleSourceBand->GetXSize()) *
+            poSimpleSourceBand->GetYSize();
+    }
+    if (!bMergeSources || nTotalPixelsOfSources !=
+                              static_cast<uint64_t>(nRasterXSize) * nRasterYSize)
+    {
+        return GDALRasterBand::ComputeQuantileSketch(bApproxOK, oSketch,
+                                                     pfnProgress, pProgressData);
+    }
+
+    CPLDebugOnly("VRT",
+                 "ComputeQuantileSketch(): use optimized code path for mosaic");
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+    uint64_t nPixelsDone = 0;
+    for (int i = 0; i < nSources; ++i)
+    {
+        auto poSimpleSourceBand =
+            cpl::down_cast<VRTSimpleSource *>(papoSources[i])->GetRasterBand();
+        const uint64_t nPixelCount =
+            static_cast<uint64_t>(poSimpleSourceBand->GetXSize()) *
+            poSimpleSourceBand->GetYSize();
+
+        GDALQuantileSketch oSourceSketch;
+        const char *pszSketch =
+            poSimpleSourceBand->GetMetadataItem("SKETCH", "QUANTILE_SKETCH");
+        if (pszSketch == nullptr ||
+            poSimpleSourceBand->GetMetadataItem("APPROXIMATE",
+                                                "QUANTILE_SKETCH") != nullptr ||
+            !oSourceSketch.Deserialize(pszSketch))
+        {
+            void *pScaledProgress = GDALCreateScaledProgress(
+                static_cast<double>(nPixelsDone) / nTotalPixelsOfSources,
+                static_cast<double>(nPixelsDone + nPixelCount) /
+                    nTotalPixelsOfSources,
+                pfnProgress, pProgressData);
+            const CPLErr eErr = poSimpleSourceBand->ComputeQuantileSketch(
+                FALSE, oSourceSketch,
+                pScaledProgress ? GDALScaledProgress : nullptr,
+                pScaledProgress);
+            GDALDestroyScaledProgress(pScaledProgress);
+            if (eErr != CE_None)
+                return eErr;
+        }
+        oSketch.Merge(oSourceSketch);
+        nPixelsDone += nPixelCount;
+    }
+
+    if (!pfnProgress(1.0, "", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
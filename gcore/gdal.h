@@ -350,6 +350,8 @@ typedef struct GDALMDArrayHS *GDALMDArrayH;
 typedef struct GDALAttributeHS *GDALAttributeH;
 /** Opaque type for C++ GDALDimension */
 typedef struct GDALDimensionHS *GDALDimensionH;
+/** Opaque type for C++ GDALBorrowedBlock */
+typedef struct GDALBorrowedBlockHS *GDALBorrowedBlockH;
 
 /* ==================================================================== */
 /*      Registration/driver related.                                    */
@@ -543,6 +545,18 @@ typedef struct GDALDimensionHS *GDALDimensionH;
  * API. */
 #define GDAL_DCAP_VIRTUALIO "DCAP_VIRTUALIO"
 
+/** Capability set by a driver for which several instances of the same
+ * read-only dataset can be opened and read independently, so that the blocks
+ * of a dataset can be read in parallel, each thread using its own instance.
+ * GDALRasterBand::IRasterIO() and GDALDataset::BlockBasedRasterIO() will then
+ * read the uncached blocks of a request in parallel, with the number of
+ * threads given by GDAL_NUM_THREADS. This option is read once per dataset,
+ * the first time such a request is issued on it.
+ * The driver does not need to be thread-safe.
+ * @since GDAL 3.10
+ */
+#define GDAL_DCAP_CONCURRENT_BLOCK_READ "DCAP_CONCURRENT_BLOCK_READ"
+
 /** Capability set by a driver having raster capability.
  * @since GDAL 2.0
  */
@@ -1030,6 +1044,17 @@ GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenShared(const char *, GDALAccess)
 #define GDAL_OF_FROM_GDALOPEN 0x400
 #endif
 
+/** Open in thread-safe mode. The returned dataset can be used concurrently
+ * from several threads for read operations. Only compatible with
+ * GDAL_OF_RASTER, and not with GDAL_OF_UPDATE or GDAL_OF_SHARED.
+ * Pixel requests are served by other instances of the dataset, each with its
+ * own block cache, so cached blocks are not shared between threads.
+ *
+ * Used by GDALOpenEx().
+ * @since GDAL 3.10
+ */
+#define GDAL_OF_THREAD_SAFE 0x800
+
 GDALDatasetH CPL_DLL CPL_STDCALL GDALOpenEx(
     const char *pszFilename, unsigned int nOpenFlags,
     const char *const *papszAllowedDrivers, const char *const *papszOpenOptions,
@@ -1170,6 +1195,62 @@ CPLErr CPL_DLL CPL_STDCALL GDALDatasetAdviseRead(
     int nBXSize, int nBYSize, GDALDataType eBDataType, int nBandCount,
     int *panBandCount, CSLConstList papszOptions);
 
+/** Description of one window of a batch of read requests.
+ *
+ * Members have the same meaning as the parameters of GDALDatasetRasterIOEx().
+ * panBandMap may be NULL to select the nBandCount first bands.
+ *
+ * @see GDALDatasetReadRasterBatch()
+ * @since GDAL 3.10
+ */
+typedef struct
+{
+    /*! Pixel offset to the top left corner of the region to read */
+    int nXOff;
+    /*! Line offset to the top left corner of the region to read */
+    int nYOff;
+    /*! Width of the region to read */
+    int nXSize;
+    /*! Height of the region to read */
+    int nYSize;
+    /*! Buffer into which to read the region */
+    void *pData;
+    /*! Width of the buffer */
+    int nBufXSize;
+    /*! Height of the buffer */
+    int nBufYSize;
+    /*! Data type of the buffer */
+    GDALDataType eBufType;
+    /*! Number of bands to read */
+    int nBandCount;
+    /*! List of bands to read (1-based), or NULL */
+    const int *panBandMap;
+    /*! Byte offset between two pixels in pData, or 0 for default */
+    GSpacing nPixelSpace;
+    /*! Byte offset between two lines in pData, or 0 for default */
+    GSpacing nLineSpace;
+    /*! Byte offset between two bands in pData, or 0 for default */
+    GSpacing nBandSpace;
+} GDALRasterIOWindow;
+
+/** Callback invoked by GDALDatasetReadRasterBatch() each time a window has
+ * been read.
+ *
+ * @param iWindow Index of the window in the batch.
+ * @param eErr CE_None if the window has been successfully read.
+ * @param pUserData User data passed to GDALDatasetReadRasterBatch().
+ * @return TRUE to continue, FALSE to cancel the reading of the windows that
+ * have not been started yet.
+ * @since GDAL 3.10
+ */
+typedef int (*GDALRasterIOWindowCompletedFunc)(int iWindow, CPLErr eErr,
+                                               void *pUserData);
+
+CPLErr CPL_DLL GDALDatasetReadRasterBatch(
+    GDALDatasetH hDS, int nWindowCount, const GDALRasterIOWindow *pasWindows,
+    GDALRasterIOWindowCompletedFunc pfnCompleted, void *pUserData,
+    CSLConstList papszOptions);
+
 char CPL_DLL **
 GDALDatasetGetCompressionFormats(GDALDatasetH hDS, int nXOff, int nYOff,
                                  int nXSize, int nYSize, int nBandCount,
@@ -1511,6 +1592,11 @@ CPLErr CPL_DLL CPL_STDCALL GDALReadBlock(GDALRasterBandH, int, int,
                                          void *) CPL_WARN_UNUSED_RESULT;
 CPLErr CPL_DLL CPL_STDCALL GDALWriteBlock(GDALRasterBandH, int, int,
                                           void *) CPL_WARN_UNUSED_RESULT;
+GDALBorrowedBlockH CPL_DLL
+GDALRasterBandBorrowBlock(GDALRasterBandH hBand, int nXBlockOff,
+                          int nYBlockOff) CPL_WARN_UNUSED_RESULT;
+const void CPL_DLL *GDALBorrowedBlockGetData(GDALBorrowedBlockH hBlock);
+void CPL_DLL GDALBorrowedBlockRelease(GDALBorrowedBlockH hBlock);
 int CPL_DLL CPL_STDCALL GDALGetRasterBandXSize(GDALRasterBandH);
 int CPL_DLL CPL_STDCALL GDALGetRasterBandYSize(GDALRasterBandH);
 GDALAccess CPL_DLL CPL_STDCALL GDALGetRasterAccess(GDALRasterBandH);
@@ -1556,6 +1642,12 @@ CPLErr CPL_DLL CPL_STDCALL GDALSetRasterStatistics(GDALRasterBandH hBand,
                                                    double dfMin, double dfMax,
                                                    double dfMean,
                                                    double dfStdDev);
+CPLErr CPL_DLL GDALGetRasterQuantiles(GDALRasterBandH hBand, int bApproxOK,
+                                      int bForce, int nCount,
+                                      const double *padfProbabilities,
+                                      double *padfValues,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressData);
 
 GDALMDArrayH
     CPL_DLL GDALRasterBandAsMDArray(GDALRasterBandH) CPL_WARN_UNUSED_RESULT;
@@ -70,6 +70,7 @@ class GDALRelationship;
 
 #include <stdarg.h>
 
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <iterator>
@@ -528,6 +529,11 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                                           CPLErr eErrClass, CPLErrorNum err_no,
                                           const char *fmt, va_list args);
 
+    CPL_INTERNAL int GetConcurrentBlockReadThreads();
+    CPL_INTERNAL std::unique_ptr<GDALDataset> AcquireConcurrentBlockReader();
+    CPL_INTERNAL void
+    ReleaseConcurrentBlockReader(std::unique_ptr<GDALDataset> poReaderDS);
+
   protected:
     //! @cond Doxygen_Suppress
     GDALDriver *poDriver = nullptr;
@@ -754,6 +760,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                      int nLineSpace, int nBandSpace, char **papszOptions);
     virtual void EndAsyncReader(GDALAsyncReader *poARIO);
 
+    virtual CPLErr ReadRasterBatch(int nWindowCount,
+                                   const GDALRasterIOWindow *pasWindows,
+                                   GDALRasterIOWindowCompletedFunc pfnCompleted,
+                                   void *pUserData, CSLConstList papszOptions);
+
+    virtual bool IsThreadSafe() const;
+
     //! @cond Doxygen_Suppress
     struct RawBinaryLayout
     {
@@ -1217,6 +1230,13 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Value of the touch counter of its LRU list when the block was last
+    // moved to the head of that list.
+    std::atomic<unsigned> nTouchSerial{0};
+
+    // Index of the shard of the LRU list the block belongs to.
+    int nLRUShard = 0;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
 
@@ -1345,6 +1365,82 @@ class CPL_DLL GDALRasterBlock
     CPL_DISALLOW_COPY_ASSIGN(GDALRasterBlock)
 };
 
+/* ******************************************************************** */
+/*                          GDALBorrowedBlock                           */
+/* ******************************************************************** */
+
+/** Read-only view of a block of the block cache, returned by
+ * GDALRasterBand::BorrowBlock().
+ *
+ * The block is locked in the block cache as long as a GDALBorrowedBlock
+ * referencing it exists, so that its buffer can be accessed without being
+ * copied. Copies of a GDALBorrowedBlock share the same buffer, and each
+ * holds a lock on the block.
+ *
+ * All borrowed blocks of a band must be released before its cache is flushed
+ * or its dataset closed.
+ *
+ * @since GDAL 3.10
+ */
+class CPL_DLL GDALBorrowedBlock
+{
+  public:
+    /** Construct an empty (invalid) object. */
+    GDALBorrowedBlock() = default;
+    ~GDALBorrowedBlock();
+
+    GDALBorrowedBlock(const GDALBorrowedBlock &oOther);
+    GDALBorrowedBlock &operator=(const GDALBorrowedBlock &oOther);
+    GDALBorrowedBlock(GDALBorrowedBlock &&oOther) noexcept;
+    GDALBorrowedBlock &operator=(GDALBorrowedBlock &&oOther) noexcept;
+
+    /** Return whether the object references a block. */
+    explicit operator bool() const
+    {
+        return m_poBlock != nullptr;
+    }
+
+    /** Return the data buffer of the block, of GetBlockXSize() *
+     * GetBlockYSize() pixels of type GetDataType(), or nullptr.
+     * Only the top-left GDALRasterBand::GetActualBlockSize() pixels are
+     * meaningful for blocks at the right or bottom edge of the raster.
+     */
+    const void *GetData() const
+    {
+        return m_poBlock ? m_poBlock->GetDataRef() : nullptr;
+    }
+
+    /** Return the data type of the block. */
+    GDALDataType GetDataType() const
+    {
+        return m_poBlock ? m_poBlock->GetDataType() : GDT_Unknown;
+    }
+
+    /** Return the width of the block, in pixels. */
+    int GetBlockXSize() const
+    {
+        return m_poBlock ? m_poBlock->GetXSize() : 0;
+    }
+
+    /** Return the height of the block, in pixels. */
+    int GetBlockYSize() const
+    {
+        return m_poBlock ? m_poBlock->GetYSize() : 0;
+    }
+
+    void Release();
+
+  private:
+    friend class GDALRasterBand;
+
+    GDALRasterBlock *m_poBlock = nullptr;
+
+    // Takes ownership of the lock held on poBlock
+    explicit GDALBorrowedBlock(GDALRasterBlock *poBlock) : m_poBlock(poBlock)
+    {
+    }
+};
+
 /* ******************************************************************** */
 /*                             GDALColorTable                           */
 /* ******************************************************************** */
@@ -1471,6 +1567,73 @@ GDALHashSetBandBlockCacheCreate(GDALRasterBand *poBand);
 
 //! @endcond
 
+/* ******************************************************************** */
+/*                          GDALQuantileSketch                          */
+/* ******************************************************************** */
+
+/** Approximate quantile sketch (merging t-digest).
+ *
+ * Values are summarized in a bounded number of centroids, more numerous
+ * near the tails of the distribution, so that extreme percentiles are more
+ * accurate than median ones. The minimum and maximum values are exact.
+ * Sketches built on disjoint sets of values (blocks, overview levels, tiles
+ * of a mosaic) can be merged.
+ *
+ * @since GDAL 3.10
+ */
+class CPL_DLL GDALQuantileSketch
+{
+  public:
+    /** Default value of the compression parameter. */
+    static constexpr double DEFAULT_COMPRESSION = 100;
+
+    explicit GDALQuantileSketch(double dfCompression = DEFAULT_COMPRESSION);
+
+    void Add(double dfValue, double dfWeight = 1);
+    void Merge(const GDALQuantileSketch &oOther);
+
+    /** Return the number (total weight) of values added to the sketch. */
+    double GetCount() const
+    {
+        return m_dfTotalWeight;
+    }
+
+    /** Return the minimum value added to the sketch. */
+    double GetMin() const
+    {
+        return m_dfMin;
+    }
+
+    /** Return the maximum value added to the sketch. */
+    double GetMax() const
+    {
+        return m_dfMax;
+    }
+
+    double GetQuantile(double dfProbability) const;
+
+    std::string Serialize() const;
+    bool Deserialize(const char *pszSerialized);
+
+  private:
+    struct Centroid
+    {
+        double dfMean;
+        double dfWeight;
+    };
+
+    double m_dfCompression = DEFAULT_COMPRESSION;
+    double m_dfTotalWeight = 0;
+    double m_dfMin = std::numeric_limits<double>::infinity();
+    double m_dfMax = -std::numeric_limits<double>::infinity();
+    // Compressed centroids, sorted by mean
+    mutable std::vector<Centroid> m_aoCentroids{};
+    // Values not yet merged into m_aoCentroids
+    mutable std::vector<Centroid> m_aoBuffer{};
+
+    void Compress() const;
+};
+
 /* ******************************************************************** */
 /*                            GDALRasterBand                            */
 /* ******************************************************************** */
@@ -1610,6 +1773,10 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     void InitRWLock();
     void SetValidPercent(GUIntBig nSampleCount, GUIntBig nValidCount);
 
+    static void PrefetchBlocksMultiThreaded(GDALRasterBand *const *papoBands,
+                                            int nBandCount, int nXOff,
+                                            int nYOff, int nXSize, int nYSize);
+
     //! @endcond
 
   protected:
@@ -1702,6 +1869,8 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
                       int bJustInitialize = FALSE) CPL_WARN_UNUSED_RESULT;
     GDALRasterBlock *TryGetLockedBlockRef(int nXBlockOff, int nYBlockYOff)
         CPL_WARN_UNUSED_RESULT;
+    GDALBorrowedBlock BorrowBlock(int nXBlockOff,
+                                  int nYBlockOff) CPL_WARN_UNUSED_RESULT;
     CPLErr FlushBlock(int nXBlockOff, int nYBlockOff,
                       int bWriteDirtyBlock = TRUE);
 
@@ -1748,6 +1917,13 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     virtual CPLErr SetStatistics(double dfMin, double dfMax, double dfMean,
                                  double dfStdDev);
     virtual CPLErr ComputeRasterMinMax(int bApproxOK, double *adfMinMax);
+    virtual CPLErr ComputeQuantileSketch(int bApproxOK,
+                                         GDALQuantileSketch &oSketch,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressData);
+    CPLErr GetQuantiles(int bApproxOK, int bForce, int nCount,
+                        const double *padfProbabilities, double *padfValues,
+                        GDALProgressFunc pfnProgress, void *pProgressData);
 
 // Only defined when Doxygen enabled
 #ifdef DOXYGEN_SKIP
@@ -4384,6 +4560,11 @@ void GDALRasterIOExtraArgSetResampleAlg(GDALRasterIOExtraArg *psExtraArg,
 GDALDataset *GDALCreateOverviewDataset(GDALDataset *poDS, int nOvrLevel,
                                        bool bThisLevelOnly);
 
+GDALDataset *GDALCreateThreadSafeDataset(std::unique_ptr<GDALDataset> poDS,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszAllowedDrivers,
+                                         CSLConstList papszOpenOptions);
+
 // Should cover particular cases of #3573, #4183, #4506, #6578
 // Behavior is undefined if fVal1 or fVal2 are NaN (should be tested before
 // calling this function)
@@ -37,7 +37,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <new>
 #include <set>
 #include <string>
@@ -51,6 +53,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -123,8 +126,13 @@ class GDALDataset::Private
 
     bool m_bOverviewsEnabled = true;
 
-    std::vector<int>
-        m_anBandMap{};  // used by RasterIO(). Values are 1, 2, etc.
+    // Other instances of the dataset, used by
+    // GDALRasterBand::PrefetchBlocksMultiThreaded() to read blocks
+    // concurrently.
+    std::mutex m_oBlockReadersMutex{};
+    std::vector<std::unique_ptr<GDALDataset>> m_apoIdleBlockReaders{};
+    // Number of threads to use, or -1 if not determined yet.
+    std::atomic<int> m_nBlockReaderThreads{-1};
 
     Private() = default;
 };
@@ -319,6 +327,9 @@ GDALDataset::~GDALDataset()
         }
     }
 
+    if (m_poPrivate != nullptr)
+        m_poPrivate->m_apoIdleBlockReaders.clear();
+
     /* -------------------------------------------------------------------- */
     /*      Remove dataset from the "open" dataset list.                    */
     /* -------------------------------------------------------------------- */
@@ -2777,18 +2788,15 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         nBandSpace = nLineSpace * nBufYSize;
     }
 
+    // Local band map, so that RasterIO() can be called concurrently, for
+    // example by ReadRasterBatch() on a thread-safe dataset.
+    std::vector<int> anBandMap;
     if (panBandMap == nullptr)
     {
-        if (!m_poPrivate)
-            return CE_Failure;
-        const int nOldBandMapSize =
-            static_cast<int>(m_poPrivate->m_anBandMap.size());
-        if (nOldBandMapSize < nBandCount)
-        {
-            for (int i = nOldBandMapSize; i < nBandCount; ++i)
-                m_poPrivate->m_anBandMap.push_back(i + 1);
-        }
-        panBandMap = m_poPrivate->m_anBandMap.data();
+        anBandMap.resize(nBandCount);
+        for (int i = 0; i < nBandCount; ++i)
+            anBandMap[i] = i + 1;
+        panBandMap = anBandMap.data();
     }
 
     int bCallLeaveReadWrite = EnterReadWrite(eRWFlag);
@@ -3397,7 +3405,8 @@ CPLErr CPL_STDCALL GDALCreateDatasetMaskBand(GDALDatasetH hDS, int nFlags)
  * <ul>
  * <li>If you open a dataset object with GA_Update access, it is not recommended
  * to open a new dataset on the same underlying file.</li>
- * <li>The returned dataset should only be accessed by one thread at a time. If
+ * <li>Unless GDAL_OF_THREAD_SAFE is specified, the returned dataset should
+ * only be accessed by one thread at a time. If
  * you want to use it from different threads, you must add all necessary code
  * (mutexes, etc.)  to avoid concurrent use of the object. (Some drivers, such
  * as GeoTIFF, maintain internal state variables that are updated each time a
@@ -3536,6 +3545,12 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * from the same thread.</li> <li>Verbose error: GDAL_OF_VERBOSE_ERROR. If set,
  * a failed attempt to open the file will lead to an error message to be
  * reported.</li>
+ * <li>Thread-safe mode: GDAL_OF_THREAD_SAFE (since GDAL 3.10). If set, the
+ * returned dataset can be used concurrently from several threads for read
+ * operations. Only compatible with GDAL_OF_RASTER, and not with
+ * GDAL_OF_UPDATE or GDAL_OF_SHARED. Pixel requests are forwarded to other
+ * instances of the dataset, opened on demand, while metadata and
+ * georeferencing are served from a single shared instance.</li>
  * </ul>
  *
  * @param papszAllowedDrivers NULL to consider all candidate drivers, or a NULL
@@ -3574,6 +3589,33 @@ GDALDatasetH CPL_STDCALL GDALOpenEx(const char *pszFilename,
 {
     VALIDATE_POINTER1(pszFilename, "GDALOpen", nullptr);
 
+    if (nOpenFlags & GDAL_OF_THREAD_SAFE)
+    {
+        if ((nOpenFlags & GDAL_OF_KIND_MASK) != GDAL_OF_RASTER)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is only compatible with "
+                     "GDAL_OF_RASTER");
+            return nullptr;
+        }
+        if (nOpenFlags & (GDAL_OF_UPDATE | GDAL_OF_SHARED))
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "GDAL_OF_THREAD_SAFE is not compatible with "
+                     "GDAL_OF_UPDATE or GDAL_OF_SHARED");
+            return nullptr;
+        }
+        auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::FromHandle(
+            GDALOpenEx(pszFilename, nOpenFlags & ~GDAL_OF_THREAD_SAFE,
+                       papszAllowedDrivers, papszOpenOptions,
+                       papszSiblingFiles)));
+        if (!poDS)
+            return nullptr;
+        return GDALDataset::ToHandle(GDALCreateThreadSafeDataset(
+            std::move(poDS), nOpenFlags, papszAllowedDrivers,
+            papszOpenOptions));
+    }
+
     // If no driver kind is specified, assume all are to be probed.
     if ((nOpenFlags & GDAL_OF_KIND_MASK) == 0)
         nOpenFlags |= GDAL_OF_KIND_MASK & ~GDAL_OF_MULTIDIM_RASTER;
@@ -4478,6 +4520,375 @@ void CPL_STDCALL GDALEndAsyncReader(GDALDatasetH hDS,
         static_cast<GDALAsyncReader *>(hAsyncReaderH));
 }
 
+/************************************************************************/
+/*                            IsThreadSafe()                            */
+/************************************************************************/
+
+/**
+ * \brief Return whether the dataset can be used concurrently from several
+ * threads for read operations.
+ *
+ * This is the case for datasets opened with GDAL_OF_THREAD_SAFE.
+ *
+ * @return true if read operations can be issued concurrently.
+ * @since GDAL 3.10
+ */
+
+bool GDALDataset::IsThreadSafe() const
+{
+    return false;
+}
+
+/************************************************************************/
+/*                   GetConcurrentBlockReadThreads()                    */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/**
+ * Return the number of threads that
+ * GDALRasterBand::PrefetchBlocksMultiThreaded() may use to read blocks of
+ * this dataset, or a value lower than 2 if blocks must not be read
+ * concurrently.
+ *
+ * This is only possible for datasets opened read-only by GDALOpenEx() with a
+ * driver advertising GDAL_DCAP_CONCURRENT_BLOCK_READ. Datasets instantiated
+ * by drivers for overviews or masks are excluded, since opening their
+ * description again would not give access to the same bands.
+ * GDAL_NUM_THREADS is read the first time this method is called.
+ */
+int GDALDataset::GetConcurrentBlockReadThreads()
+{
+    if (m_poPrivate == nullptr)
+        return 0;
+    int nThreads = m_poPrivate->m_nBlockReaderThreads.load();
+    if (nThreads < 0)
+    {
+        nThreads = 0;
+        if (eAccess == GA_ReadOnly && nOpenFlags != OPEN_FLAGS_CLOSED &&
+            (nOpenFlags & GDAL_OF_RASTER) != 0 &&
+            (nOpenFlags & GDAL_OF_THREAD_SAFE) == 0 && poDriver &&
+            GetDescription()[0] != '\0' &&
+            CPLFetchBool(poDriver->GetMetadata(),
+                         GDAL_DCAP_CONCURRENT_BLOCK_READ, false))
+        {
+            const char *pszThreads =
+                CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+            nThreads = std::max(
+                0, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                     ? CPLGetNumCPUs()
+                                     : atoi(pszThreads)));
+        }
+        m_poPrivate->m_nBlockReaderThreads = nThreads;
+    }
+    return nThreads;
+}
+
+/************************************************************************/
+/*                    AcquireConcurrentBlockReader()                    */
+/************************************************************************/
+
+/**
+ * Return another instance of this dataset, to read blocks concurrently with
+ * other threads. Instances are opened on demand, and are recycled with
+ * ReleaseConcurrentBlockReader() until this dataset is closed.
+ *
+ * @return nullptr if another instance cannot be opened.
+ */
+std::unique_ptr<GDALDataset> GDALDataset::AcquireConcurrentBlockReader()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_poPrivate->m_oBlockReadersMutex);
+        if (!m_poPrivate->m_apoIdleBlockReaders.empty())
+        {
+            auto poReaderDS =
+                std::move(m_poPrivate->m_apoIdleBlockReaders.back());
+            m_poPrivate->m_apoIdleBlockReaders.pop_back();
+            return poReaderDS;
+        }
+    }
+
+    const char *const apszAllowedDrivers[] = {poDriver->GetDescription(),
+                                              nullptr};
+    std::unique_ptr<GDALDataset> poReaderDS;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        poReaderDS.reset(GDALDataset::Open(
+            GetDescription(),
+            GDAL_OF_RASTER | GDAL_OF_READONLY | GDAL_OF_INTERNAL,
+            apszAllowedDrivers, papszOpenOptions, nullptr));
+    }
+    bool bCompatible = poReaderDS != nullptr &&
+                       poReaderDS->GetRasterXSize() == nRasterXSize &&
+                       poReaderDS->GetRasterYSize() == nRasterYSize &&
+                       poReaderDS->GetRasterCount() == nBands;
+    for (int i = 0; bCompatible && i < nBands; ++i)
+    {
+        GDALRasterBand *poBand = papoBands[i];
+        GDALRasterBand *poReaderBand = poReaderDS->papoBands[i];
+        bCompatible = poReaderBand->eDataType == poBand->eDataType &&
+                      poReaderBand->nBlockXSize == poBand->nBlockXSize &&
+                      poReaderBand->nBlockYSize == poBand->nBlockYSize;
+    }
+    if (!bCompatible)
+    {
+        CPLDebug("GDAL",
+                 "Cannot open another instance of %s. Its blocks will not be "
+                 "read concurrently",
+                 GetDescription());
+        m_poPrivate->m_nBlockReaderThreads = 0;
+        poReaderDS.reset();
+    }
+    return poReaderDS;
+}
+
+/************************************************************************/
+/*                    ReleaseConcurrentBlockReader()                    */
+/************************************************************************/
+
+/** Give back an instance returned by AcquireConcurrentBlockReader(). */
+void GDALDataset::ReleaseConcurrentBlockReader(
+    std::unique_ptr<GDALDataset> poReaderDS)
+{
+    std::lock_guard<std::mutex> oLock(m_poPrivate->m_oBlockReadersMutex);
+    m_poPrivate->m_apoIdleBlockReaders.push_back(std::move(poReaderDS));
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                          ReadRasterBatch()                           */
+/************************************************************************/
+
+/**
+ * \brief Read a batch of windows.
+ *
+ * This method reads several windows of the dataset, and invokes the
+ * pfnCompleted callback each time a window has been read. This is typically
+ * used to read all the tiles needed to render a map request in one call, so
+ * that the network fetches, decompression and the caller's processing of
+ * completed windows can overlap.
+ *
+ * The default implementation:
+ * <ul>
+ * <li>emits AdviseRead() calls, so that drivers that support it (such as
+ * GTiff on /vsicurl/ and derived file systems) can fetch the needed data with
+ * a minimum number of (parallel) requests. If the windows are mostly
+ * contiguous and share the same band list, a single AdviseRead() over their
+ * bounding box is issued; otherwise one AdviseRead() is issued per window,
+ * just before reading it.</li>
+ * <li>if the dataset is thread-safe (see IsThreadSafe(), typically opened with
+ * GDAL_OF_THREAD_SAFE) and several threads are allowed, reads the windows
+ * in parallel on the global thread pool. Otherwise, windows are read
+ * sequentially, in the order of pasWindows.</li>
+ * </ul>
+ *
+ * The callback may be invoked from a thread different from the calling
+ * thread, but calls are serialized. It is guaranteed to have been invoked
+ * for all the windows that have been read when this method returns.
+ *
+ * This method is the same as the C GDALDatasetReadRasterBatch() function.
+ *
+ * @param nWindowCount Number of windows.
+ * @param pasWindows Array of nWindowCount windows.
+ * @param pfnCompleted Callback invoked when a window has been read, or NULL.
+ * @param pUserData User data passed to pfnCompleted.
+ * @param papszOptions NULL-terminated list of options, or NULL. Currently
+ * supported options are:
+ * <ul>
+ * <li>NUM_THREADS=integer or ALL_CPUS: maximum number of threads used to
+ * read windows concurrently. Defaults to the value of the GDAL_NUM_THREADS
+ * configuration option, or 1.</li>
+ * </ul>
+ *
+ * @return CE_None if all windows (that have not been cancelled) have been
+ * successfully read.
+ * @since GDAL 3.10
+ */
+
+CPLErr GDALDataset::ReadRasterBatch(
+    int nWindowCount, const GDALRasterIOWindow *pasWindows,
+    GDALRasterIOWindowCompletedFunc pfnCompleted, void *pUserData,
+    CSLConstList papszOptions)
+{
+    if (nWindowCount <= 0)
+        return CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      Determine if a single AdviseRead() over the bounding box of     */
+    /*      all windows is worth it.                                        */
+    /* -------------------------------------------------------------------- */
+    const auto IsSameBandList = [](const GDALRasterIOWindow &sA,
+                                   const GDALRasterIOWindow &sB)
+    {
+        if (sA.nBandCount != sB.nBandCount)
+            return false;
+        for (int i = 0; i < sA.nBandCount; ++i)
+        {
+            if ((sA.panBandMap ? sA.panBandMap[i] : i + 1) !=
+                (sB.panBandMap ? sB.panBandMap[i] : i + 1))
+                return false;
+        }
+        return true;
+    };
+
+    bool bAdviseReadBoundingBox = nWindowCount > 1;
+    int nMinX = pasWindows[0].nXOff;
+    int nMinY = pasWindows[0].nYOff;
+    int nMaxX = pasWindows[0].nXOff + pasWindows[0].nXSize;
+    int nMaxY = pasWindows[0].nYOff + pasWindows[0].nYSize;
+    double dfSumArea = 0;
+    for (int i = 0; i < nWindowCount && bAdviseReadBoundingBox; ++i)
+    {
+        const GDALRasterIOWindow &sWindow = pasWindows[i];
+        if (sWindow.nXSize != sWindow.nBufXSize ||
+            sWindow.nYSize != sWindow.nBufYSize ||
+            !IsSameBandList(sWindow, pasWindows[0]))
+        {
+            bAdviseReadBoundingBox = false;
+        }
+        nMinX = std::min(nMinX, sWindow.nXOff);
+        nMinY = std::min(nMinY, sWindow.nYOff);
+        nMaxX = std::max(nMaxX, sWindow.nXOff + sWindow.nXSize);
+        nMaxY = std::max(nMaxY, sWindow.nYOff + sWindow.nYSize);
+        dfSumArea += static_cast<double>(sWindow.nXSize) * sWindow.nYSize;
+    }
+    if (bAdviseReadBoundingBox &&
+        static_cast<double>(nMaxX - nMinX) * (nMaxY - nMinY) > 2 * dfSumArea)
+    {
+        bAdviseReadBoundingBox = false;
+    }
+    if (bAdviseReadBoundingBox)
+    {
+        CPL_IGNORE_RET_VAL(AdviseRead(
+            nMinX, nMinY, nMaxX - nMinX, nMaxY - nMinY, nMaxX - nMinX,
+            nMaxY - nMinY, pasWindows[0].eBufType, pasWindows[0].nBandCount,
+            const_cast<int *>(pasWindows[0].panBandMap), nullptr));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read windows.                                                   */
+    /* -------------------------------------------------------------------- */
+    struct BatchContext
+    {
+        GDALDataset *poDS = nullptr;
+        const GDALRasterIOWindow *pasWindows = nullptr;
+        GDALRasterIOWindowCompletedFunc pfnCompleted = nullptr;
+        void *pUserData = nullptr;
+        bool bAdviseReadEachWindow = false;
+        std::mutex oMutex{};
+        bool bCancelled = false;
+        bool bError = false;
+    };
+
+    struct WindowJob
+    {
+        BatchContext *psCtxt;
+        int iWindow;
+    };
+
+    BatchContext sCtxt;
+    sCtxt.poDS = this;
+    sCtxt.pasWindows = pasWindows;
+    sCtxt.pfnCompleted = pfnCompleted;
+    sCtxt.pUserData = pUserData;
+    sCtxt.bAdviseReadEachWindow = !bAdviseReadBoundingBox;
+
+    const auto ReadWindow = [](void *pData)
+    {
+        const WindowJob *psJob = static_cast<const WindowJob *>(pData);
+        BatchContext *psCtxt = psJob->psCtxt;
+        {
+            std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+            if (psCtxt->bCancelled)
+                return;
+        }
+
+        const GDALRasterIOWindow &sWindow =
+            psCtxt->pasWindows[psJob->iWindow];
+        if (psCtxt->bAdviseReadEachWindow)
+        {
+            CPL_IGNORE_RET_VAL(psCtxt->poDS->AdviseRead(
+                sWindow.nXOff, sWindow.nYOff, sWindow.nXSize, sWindow.nYSize,
+                sWindow.nBufXSize, sWindow.nBufYSize, sWindow.eBufType,
+                sWindow.nBandCount, const_cast<int *>(sWindow.panBandMap),
+                nullptr));
+        }
+        const CPLErr eErr = psCtxt->poDS->RasterIO(
+            GF_Read, sWindow.nXOff, sWindow.nYOff, sWindow.nXSize,
+            sWindow.nYSize, sWindow.pData, sWindow.nBufXSize,
+            sWindow.nBufYSize, sWindow.eBufType, sWindow.nBandCount,
+            sWindow.panBandMap, sWindow.nPixelSpace, sWindow.nLineSpace,
+            sWindow.nBandSpace, nullptr);
+
+        std::lock_guard<std::mutex> oLock(psCtxt->oMutex);
+        if (eErr != CE_None)
+            psCtxt->bError = true;
+        if (psCtxt->pfnCompleted &&
+            !psCtxt->pfnCompleted(psJob->iWindow, eErr, psCtxt->pUserData))
+        {
+            psCtxt->bCancelled = true;
+        }
+    };
+
+    std::vector<WindowJob> asJobs;
+    for (int i = 0; i < nWindowCount; ++i)
+        asJobs.push_back(WindowJob{&sCtxt, i});
+
+    const char *pszThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 && nWindowCount > 1 && IsThreadSafe()
+            ? GDALGetGlobalThreadPool(nThreads)
+            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    for (auto &sJob : asJobs)
+    {
+        if (!poJobQueue || !poJobQueue->SubmitJob(ReadWindow, &sJob))
+            ReadWindow(&sJob);
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    if (sCtxt.bCancelled)
+    {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+    return sCtxt.bError ? CE_Failure : CE_None;
+}
+
+/************************************************************************/
+/*                      GDALDatasetReadRasterBatch()                    */
+/************************************************************************/
+
+/**
+ * \brief Read a batch of windows.
+ *
+ * @see GDALDataset::ReadRasterBatch()
+ * @since GDAL 3.10
+ */
+
+CPLErr GDALDatasetReadRasterBatch(GDALDatasetH hDS, int nWindowCount,
+                                  const GDALRasterIOWindow *pasWindows,
+                                  GDALRasterIOWindowCompletedFunc pfnCompleted,
+                                  void *pUserData, CSLConstList papszOptions)
+{
+    VALIDATE_POINTER1(hDS, "GDALDatasetReadRasterBatch", CE_Failure);
+    if (nWindowCount > 0)
+    {
+        VALIDATE_POINTER1(pasWindows, "GDALDatasetReadRasterBatch",
+                          CE_Failure);
+    }
+
+    return GDALDataset::FromHandle(hDS)->ReadRasterBatch(
+        nWindowCount, pasWindows, pfnCompleted, pUserData, papszOptions);
+}
+
 /************************************************************************/
 /*                       CloseDependentDatasets()                       */
 /************************************************************************/
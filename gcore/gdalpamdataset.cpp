@@ -1818,6 +1818,11 @@ void GDALPamDataset::ClearStatistics()
         {
             poBand->SetMetadata(aosNewMD.List());
         }
+        if (poBand->GetMetadata("QUANTILE_SKETCH") != nullptr)
+        {
+            MarkPamDirty();
+            poBand->SetMetadata(nullptr, "QUANTILE_SKETCH");
+        }
     }
 
     GDALDataset::ClearStatistics();
@@ -0,0 +1,303 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  GDALQuantileSketch class: mergeable approximate quantiles
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+/* This is a "merging t-digest" (T. Dunning, O. Ertl, "Computing Extremely
+ * Accurate Quantiles Using t-Digests", 2019), using the k1 scale function
+ * k(q) = compression / (2 * pi) * asin(2 * q - 1).
+ *
+ * Incoming values are appended to a buffer. When the buffer is full, it is
+ * sorted and merged with the existing centroids in a single pass, where
+ * adjacent centroids are combined as long as the resulting centroid does not
+ * span more than one unit of k. The number of centroids is thus bounded by
+ * about the compression parameter, and centroids near q=0 and q=1 are
+ * small.
+ */
+
+#include "gdal_priv.h"
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+constexpr int SERIALIZATION_VERSION = 1;
+
+/************************************************************************/
+/*                         GDALQuantileSketch()                         */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param dfCompression Compression parameter. The number of centroids kept
+ * is of the order of this value. Larger values give more accurate quantiles,
+ * at the expense of memory and computation time.
+ */
+GDALQuantileSketch::GDALQuantileSketch(double dfCompression)
+    : m_dfCompression(std::max(10.0, dfCompression))
+{
+}
+
+/************************************************************************/
+/*                                Add()                                 */
+/************************************************************************/
+
+/** Add a value to the sketch.
+ *
+ * NaN values, and values with a non-positive weight, are ignored.
+ *
+ * @param dfValue Value.
+ * @param dfWeight Weight of the value (number of occurrences).
+ */
+void GDALQuantileSketch::Add(double dfValue, double dfWeight)
+{
+    if (std::isnan(dfValue) || !(dfWeight > 0))
+        return;
+    m_dfTotalWeight += dfWeight;
+    m_dfMin = std::min(m_dfMin, dfValue);
+    m_dfMax = std::max(m_dfMax, dfValue);
+    m_aoBuffer.push_back(Centroid{dfValue, dfWeight});
+    if (m_aoBuffer.size() >= static_cast<size_t>(5 * m_dfCompression))
+        Compress();
+}
+
+/************************************************************************/
+/*                               Merge()                                */
+/************************************************************************/
+
+/** Merge another sketch into this one.
+ *
+ * The result is a summary of the union of the values of both sketches.
+ * The compression parameter of this sketch is kept.
+ */
+void GDALQuantileSketch::Merge(const GDALQuantileSketch &oOther)
+{
+    if (oOther.m_dfTotalWeight == 0)
+        return;
+    m_dfTotalWeight += oOther.m_dfTotalWeight;
+    m_dfMin = std::min(m_dfMin, oOther.m_dfMin);
+    m_dfMax = std::max(m_dfMax, oOther.m_dfMax);
+    m_aoBuffer.insert(m_aoBuffer.end(), oOther.m_aoCentroids.begin(),
+                      oOther.m_aoCentroids.end());
+    m_aoBuffer.insert(m_aoBuffer.end(), oOther.m_aoBuffer.begin(),
+                      oOther.m_aoBuffer.end());
+    if (m_aoBuffer.size() >= static_cast<size_t>(5 * m_dfCompression))
+        Compress();
+}
+
+/************************************************************************/
+/*                              Compress()                              */
+/************************************************************************/
+
+void GDALQuantileSketch::Compress() const
+{
+    if (m_aoBuffer.empty())
+        return;
+
+    const auto lessMean = [](const Centroid &a, const Centroid &b)
+    { return a.dfMean < b.dfMean; };
+    std::sort(m_aoBuffer.begin(), m_aoBuffer.end(), lessMean);
+
+    std::vector<Centroid> aoSorted;
+    aoSorted.reserve(m_aoCentroids.size() + m_aoBuffer.size());
+    std::merge(m_aoCentroids.begin(), m_aoCentroids.end(), m_aoBuffer.begin(),
+               m_aoBuffer.end(), std::back_inserter(aoSorted), lessMean);
+    m_aoBuffer.clear();
+
+    const double dfTotalWeight = m_dfTotalWeight;
+    const double dfNormalizer = m_dfCompression / (2 * M_PI);
+    // Maximum cumulated weight (normalized) of the centroid starting at dfQ
+    const auto GetQLimit = [dfNormalizer](double dfQ)
+    {
+        const double dfK =
+            dfNormalizer * std::asin(std::clamp(2 * dfQ - 1, -1.0, 1.0));
+        const double dfKNext = dfK + 1;
+        if (dfKNext >= dfNormalizer * M_PI / 2)
+            return 1.0;
+        return (std::sin(dfKNext / dfNormalizer) + 1) / 2;
+    };
+
+    m_aoCentroids.clear();
+    Centroid oCur = aoSorted[0];
+    double dfWeightSoFar = 0;
+    double dfWeightLimit = dfTotalWeight * GetQLimit(0);
+    for (size_t i = 1; i < aoSorted.size(); ++i)
+    {
+        const Centroid &oNext = aoSorted[i];
+        if (dfWeightSoFar + oCur.dfWeight + oNext.dfWeight <= dfWeightLimit)
+        {
+            oCur.dfWeight += oNext.dfWeight;
+            oCur.dfMean +=
+                (oNext.dfMean - oCur.dfMean) * oNext.dfWeight / oCur.dfWeight;
+        }
+        else
+        {
+            dfWeightSoFar += oCur.dfWeight;
+            m_aoCentroids.push_back(oCur);
+            dfWeightLimit =
+                dfTotalWeight * GetQLimit(dfWeightSoFar / dfTotalWeight);
+            oCur = oNext;
+        }
+    }
+    m_aoCentroids.push_back(oCur);
+}
+
+/************************************************************************/
+/*                            GetQuantile()                             */
+/************************************************************************/
+
+/** Return an estimate of the value at the given quantile.
+ *
+ * The estimate is a linear interpolation between the centroids, and the
+ * exact minimum and maximum values.
+ *
+ * @param dfProbability Quantile, between 0 and 1 (0.5 for the median).
+ * @return the estimated value, or NaN if the sketch is empty.
+ */
+double GDALQuantileSketch::GetQuantile(double dfProbability) const
+{
+    if (m_dfTotalWeight == 0 || std::isnan(dfProbability))
+        return std::numeric_limits<double>::quiet_NaN();
+    if (dfProbability <= 0)
+        return m_dfMin;
+    if (dfProbability >= 1)
+        return m_dfMax;
+
+    Compress();
+
+    const double dfTarget = dfProbability * m_dfTotalWeight;
+    // Previous interpolation anchor: (cumulated weight, value)
+    double dfPrevPos = 0;
+    double dfPrevValue = m_dfMin;
+    double dfWeightSoFar = 0;
+    for (const auto &oCentroid : m_aoCentroids)
+    {
+        const double dfPos = dfWeightSoFar + oCentroid.dfWeight / 2;
+        if (dfTarget < dfPos)
+        {
+            // A centroid of unit weight represents a single exact value.
+            if (oCentroid.dfWeight == 1 && dfTarget >= dfWeightSoFar)
+                return oCentroid.dfMean;
+            const double dfRatio =
+                dfPos > dfPrevPos ? (dfTarget - dfPrevPos) / (dfPos - dfPrevPos)
+                                  : 0;
+            return dfPrevValue + dfRatio * (oCentroid.dfMean - dfPrevValue);
+        }
+        dfWeightSoFar += oCentroid.dfWeight;
+        if (oCentroid.dfWeight == 1 && dfTarget < dfWeightSoFar)
+            return oCentroid.dfMean;
+        dfPrevPos = dfPos;
+        dfPrevValue = oCentroid.dfMean;
+    }
+    const double dfRatio = m_dfTotalWeight > dfPrevPos
+                               ? (dfTarget - dfPrevPos) /
+                                     (m_dfTotalWeight - dfPrevPos)
+                               : 0;
+    return dfPrevValue + dfRatio * (m_dfMax - dfPrevValue);
+}
+
+/************************************************************************/
+/*                             Serialize()                              */
+/************************************************************************/
+
+/** Return a text representation of the sketch, that can be read back with
+ * Deserialize().
+ */
+std::string GDALQuantileSketch::Serialize() const
+{
+    Compress();
+
+    std::string osRet(CPLSPrintf("%d %.17g %.17g %.17g %.17g %d",
+                                 SERIALIZATION_VERSION, m_dfCompression,
+                                 m_dfTotalWeight, m_dfMin, m_dfMax,
+                                 static_cast<int>(m_aoCentroids.size())));
+    for (const auto &oCentroid : m_aoCentroids)
+    {
+        osRet += CPLSPrintf(" %.17g %.17g", oCentroid.dfMean,
+                            oCentroid.dfWeight);
+    }
+    return osRet;
+}
+
+/************************************************************************/
+/*                            Deserialize()                             */
+/************************************************************************/
+
+/** Initialize the sketch from a string returned by Serialize().
+ *
+ * @return true in case of success. In case of failure, the sketch is left
+ * unmodified.
+ */
+bool GDALQuantileSketch::Deserialize(const char *pszSerialized)
+{
+    const CPLStringList aosTokens(
+        CSLTokenizeString2(pszSerialized, " ", CSLT_HONOURSTRINGS));
+    if (aosTokens.size() < 6 || atoi(aosTokens[0]) != SERIALIZATION_VERSION)
+        return false;
+    const int nCentroids = atoi(aosTokens[5]);
+    if (nCentroids < 0 || nCentroids > (aosTokens.size() - 6) / 2 ||
+        static_cast<size_t>(aosTokens.size()) !=
+            6 + 2 * static_cast<size_t>(nCentroids))
+    {
+        return false;
+    }
+
+    const double dfCompression = CPLAtof(aosTokens[1]);
+    const double dfTotalWeight = CPLAtof(aosTokens[2]);
+    if (!(dfCompression > 0) || !(dfTotalWeight >= 0))
+        return false;
+
+    std::vector<Centroid> aoCentroids;
+    aoCentroids.reserve(nCentroids);
+    double dfSumWeights = 0;
+    for (int i = 0; i < nCentroids; ++i)
+    {
+        const Centroid oCentroid{CPLAtof(aosTokens[6 + 2 * i]),
+                                 CPLAtof(aosTokens[6 + 2 * i + 1])};
+        if (!(oCentroid.dfWeight > 0) || std::isnan(oCentroid.dfMean) ||
+            (!aoCentroids.empty() &&
+             oCentroid.dfMean < aoCentroids.back().dfMean))
+        {
+            return false;
+        }
+        dfSumWeights += oCentroid.dfWeight;
+        aoCentroids.push_back(oCentroid);
+    }
+    if (std::fabs(dfSumWeights - dfTotalWeight) > 1e-6 * dfTotalWeight)
+        return false;
+
+    m_dfCompression = std::max(10.0, dfCompression);
+    m_dfTotalWeight = dfTotalWeight;
+    m_dfMin = nCentroids ? CPLAtof(aosTokens[3])
+                         : std::numeric_limits<double>::infinity();
+    m_dfMax = nCentroids ? CPLAtof(aosTokens[4])
+                         : -std::numeric_limits<double>::infinity();
+    m_aoCentroids = std::move(aoCentroids);
+    m_aoBuffer.clear();
+    return true;
+}
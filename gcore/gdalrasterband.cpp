@@ -53,6 +53,7 @@
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -1530,6 +1531,282 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
     return poBlock;
 }
 
+/************************************************************************/
+/*                            BorrowBlock()                             */
+/************************************************************************/
+
+/**
+ * \brief Return a read-only view of a block of the block cache.
+ *
+ * The block is read from the driver if it is not already in the block
+ * cache, as with GetLockedBlockRef(). Contrary to ReadBlock() or RasterIO(),
+ * the data is not copied into a caller buffer: the returned object gives
+ * access to the buffer of the cached block, which stays locked in the cache
+ * until the object (and all its copies) is destroyed or released.
+ *
+ * The content of the buffer must not be modified. It reflects subsequent
+ * writes to the block, if any.
+ *
+ * All borrowed blocks of a band must be released before its cache is flushed
+ * or its dataset closed. Borrowing many blocks at once may exceed the block
+ * cache size, as locked blocks cannot be evicted.
+ *
+ * This method is the same as the C function GDALRasterBandBorrowBlock().
+ *
+ * @param nXBlockOff the horizontal block offset, with zero indicating
+ * the left most block, 1 the next block and so forth.
+ *
+ * @param nYBlockOff the vertical block offset, with zero indicating
+ * the top most block, 1 the next block and so forth.
+ *
+ * @return a borrowed block, that evaluates to false in case of failure.
+ * @since GDAL 3.10
+ */
+
+GDALBorrowedBlock GDALRasterBand::BorrowBlock(int nXBlockOff, int nYBlockOff)
+{
+    return GDALBorrowedBlock(GetLockedBlockRef(nXBlockOff, nYBlockOff));
+}
+
+/************************************************************************/
+/*                     GDALRasterBandBorrowBlock()                      */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+struct GDALBorrowedBlockHS
+{
+    GDALBorrowedBlock oBlock{};
+};
+
+//! @endcond
+
+/**
+ * \brief Return a read-only view of a block of the block cache.
+ *
+ * The returned handle must be released with GDALBorrowedBlockRelease().
+ *
+ * @see GDALRasterBand::BorrowBlock()
+ * @return a handle, or NULL in case of failure.
+ * @since GDAL 3.10
+ */
+
+GDALBorrowedBlockH GDALRasterBandBorrowBlock(GDALRasterBandH hBand,
+                                             int nXBlockOff, int nYBlockOff)
+{
+    VALIDATE_POINTER1(hBand, "GDALRasterBandBorrowBlock", nullptr);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    auto oBlock = poBand->BorrowBlock(nXBlockOff, nYBlockOff);
+    if (!oBlock)
+        return nullptr;
+    auto hBlock = new GDALBorrowedBlockHS();
+    hBlock->oBlock = std::move(oBlock);
+    return hBlock;
+}
+
+/************************************************************************/
+/*                      GDALBorrowedBlockGetData()                      */
+/************************************************************************/
+
+/**
+ * \brief Return the data buffer of a borrowed block.
+ *
+ * @see GDALBorrowedBlock::GetData()
+ * @since GDAL 3.10
+ */
+
+const void *GDALBorrowedBlockGetData(GDALBorrowedBlockH hBlock)
+{
+    VALIDATE_POINTER1(hBlock, "GDALBorrowedBlockGetData", nullptr);
+    return hBlock->oBlock.GetData();
+}
+
+/************************************************************************/
+/*                      GDALBorrowedBlockRelease()                      */
+/************************************************************************/
+
+/**
+ * \brief Release a block returned by GDALRasterBandBorrowBlock().
+ *
+ * @param hBlock Handle, or NULL.
+ * @since GDAL 3.10
+ */
+
+void GDALBorrowedBlockRelease(GDALBorrowedBlockH hBlock)
+{
+    delete hBlock;
+}
+
+/************************************************************************/
+/*                    PrefetchBlocksMultiThreaded()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/**
+ * Read in parallel the blocks of the passed bands that intersect the
+ * specified window and are not yet in the block cache.
+ *
+ * This is only done for bands of a dataset for which
+ * GDALDataset::GetConcurrentBlockReadThreads() returns a value greater than
+ * 1. Drivers are not required to be thread-safe: each thread reads the
+ * blocks through its own instance of the dataset, obtained with
+ * GDALDataset::AcquireConcurrentBlockReader(), and the data is copied into
+ * the blocks of the passed bands. Blocks that cannot be read are discarded
+ * silently, so that the subsequent regular block access retries reading them
+ * and reports the error. To avoid the prefetched blocks evicting each other,
+ * at most a quarter of the cache size is prefetched.
+ */
+void GDALRasterBand::PrefetchBlocksMultiThreaded(
+    GDALRasterBand *const *papoBands, int nBandCount, int nXOff, int nYOff,
+    int nXSize, int nYSize)
+{
+    if (nBandCount <= 0 || nXSize <= 0 || nYSize <= 0)
+        return;
+
+    // Cheap checks before querying the dataset.
+    GDALRasterBand *poFirstBand = papoBands[0];
+    const int nBlockXSize = poFirstBand->nBlockXSize;
+    const int nBlockYSize = poFirstBand->nBlockYSize;
+    if (nBlockXSize <= 0 || nBlockYSize <= 0)
+        return;
+    const int nXBlockStart = nXOff / nBlockXSize;
+    const int nXBlockEnd = (nXOff + nXSize - 1) / nBlockXSize;
+    const int nYBlockStart = nYOff / nBlockYSize;
+    const int nYBlockEnd = (nYOff + nYSize - 1) / nBlockYSize;
+    if (nXBlockStart == nXBlockEnd && nYBlockStart == nYBlockEnd)
+        return;
+
+    GDALDataset *poDS = poFirstBand->poDS;
+    if (!poDS)
+        return;
+    const int nThreads = poDS->GetConcurrentBlockReadThreads();
+    if (nThreads <= 1)
+        return;
+    for (int iBand = 0; iBand < nBandCount; ++iBand)
+    {
+        GDALRasterBand *poBand = papoBands[iBand];
+        if (poBand->poDS != poDS ||
+            poDS->GetRasterBand(poBand->nBand) != poBand ||
+            poBand->nBlockXSize != nBlockXSize ||
+            poBand->nBlockYSize != nBlockYSize || !poBand->InitBlockInfo())
+        {
+            return;
+        }
+    }
+
+    // One job per block position, reading the blocks of all the bands
+    // at that position.
+    struct BlockJob
+    {
+        GDALDataset *poDS = nullptr;
+        std::vector<GDALRasterBlock *> apoBlocks{};
+        std::vector<bool> abOK{};
+    };
+
+    std::vector<BlockJob> asJobs;
+    const GIntBig nMaxBytes = GDALGetCacheMax64() / 4;
+    GIntBig nBytes = 0;
+    bool bStop = false;
+    for (int iYBlock = nYBlockStart; iYBlock <= nYBlockEnd && !bStop;
+         ++iYBlock)
+    {
+        for (int iXBlock = nXBlockStart; iXBlock <= nXBlockEnd && !bStop;
+             ++iXBlock)
+        {
+            BlockJob sJob;
+            sJob.poDS = poDS;
+            for (int iBand = 0; iBand < nBandCount; ++iBand)
+            {
+                GDALRasterBand *poBand = papoBands[iBand];
+                GDALRasterBlock *poBlock =
+                    poBand->TryGetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock)
+                {
+                    poBlock->DropLock();
+                    continue;
+                }
+                const GIntBig nBlockBytes =
+                    static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+                    GDALGetDataTypeSizeBytes(poBand->eDataType);
+                if (nBytes + nBlockBytes > nMaxBytes)
+                {
+                    bStop = true;
+                    break;
+                }
+                poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock,
+                                                    /* bJustInitialize = */
+                                                    TRUE);
+                if (!poBlock)
+                {
+                    bStop = true;
+                    break;
+                }
+                nBytes += nBlockBytes;
+                sJob.apoBlocks.push_back(poBlock);
+                sJob.abOK.push_back(false);
+            }
+            if (!sJob.apoBlocks.empty())
+                asJobs.push_back(std::move(sJob));
+        }
+    }
+
+    if (asJobs.empty())
+        return;
+
+    const auto ReadBlockJob = [](void *pData)
+    {
+        BlockJob *psJob = static_cast<BlockJob *>(pData);
+        auto poReaderDS = psJob->poDS->AcquireConcurrentBlockReader();
+        if (!poReaderDS)
+            return;
+        {
+            // Errors will be reported when the block is read again.
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            for (size_t i = 0; i < psJob->apoBlocks.size(); ++i)
+            {
+                GDALRasterBlock *poBlock = psJob->apoBlocks[i];
+                GDALRasterBand *poReaderBand = poReaderDS->GetRasterBand(
+                    poBlock->GetBand()->GetBand());
+                psJob->abOK[i] =
+                    poReaderBand->ReadBlock(poBlock->GetXOff(),
+                                            poBlock->GetYOff(),
+                                            poBlock->GetDataRef()) == CE_None;
+            }
+        }
+        psJob->poDS->ReleaseConcurrentBlockReader(std::move(poReaderDS));
+    };
+
+    CPLWorkerThreadPool *poThreadPool =
+        asJobs.size() > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+    for (auto &sJob : asJobs)
+    {
+        if (!poJobQueue || !poJobQueue->SubmitJob(ReadBlockJob, &sJob))
+            ReadBlockJob(&sJob);
+    }
+    if (poJobQueue)
+        poJobQueue->WaitCompletion();
+
+    for (auto &sJob : asJobs)
+    {
+        for (size_t i = 0; i < sJob.apoBlocks.size(); ++i)
+        {
+            GDALRasterBlock *poBlock = sJob.apoBlocks[i];
+            GDALRasterBand *poBand = poBlock->GetBand();
+            const int nXBlockOff = poBlock->GetXOff();
+            const int nYBlockOff = poBlock->GetYOff();
+            poBlock->DropLock();
+            if (sJob.abOK[i])
+                poBand->nBlockReads++;
+            else
+                poBand->FlushBlock(nXBlockOff, nYBlockOff);
+        }
+    }
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                               Fill()                                 */
 /************************************************************************/
@@ -5513,173 +5790,1264 @@ struct ComputeStatisticsInternal<GUInt16, COMPUTE_OTHER_STATS>
 #endif  // CPL_HAS_GINT64
 
 /************************************************************************/
-/*                          GetPixelValue()                             */
+/*                         GDALBlockStatistics                          */
 /************************************************************************/
 
-static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
-                                   const void *pData, GPtrDiff_t iOffset,
-                                   bool bGotNoDataValue, double dfNoDataValue,
-                                   bool bGotFloatNoDataValue,
-                                   float fNoDataValue, bool &bValid)
+namespace
 {
-    bValid = true;
-    double dfValue = 0;
-    switch (eDataType)
+// Statistics of a set of samples, typically the valid pixels of a block.
+// Statistics of disjoint sets can be merged with Merge(), which implements
+// the parallel variant of the Welford algorithm (Chan et al.)
+struct GDALBlockStatistics
+{
+    GUIntBig nValidCount = 0;
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfMean = 0;
+    // Sum of square of differences to the mean
+    double dfM2 = 0;
+
+    void Merge(const GDALBlockStatistics &other)
     {
-        case GDT_Byte:
-        {
-            if (bSignedByte)
-                dfValue = static_cast<const signed char *>(pData)[iOffset];
-            else
-                dfValue = static_cast<const GByte *>(pData)[iOffset];
-            break;
-        }
-        case GDT_Int8:
-            dfValue = static_cast<const GInt8 *>(pData)[iOffset];
-            break;
-        case GDT_UInt16:
-            dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
-            break;
-        case GDT_Int16:
-            dfValue = static_cast<const GInt16 *>(pData)[iOffset];
-            break;
-        case GDT_UInt32:
-            dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
-            break;
-        case GDT_Int32:
-            dfValue = static_cast<const GInt32 *>(pData)[iOffset];
-            break;
-        case GDT_UInt64:
-            dfValue = static_cast<double>(
-                static_cast<const std::uint64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Int64:
-            dfValue = static_cast<double>(
-                static_cast<const std::int64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Float32:
+        if (other.nValidCount == 0)
+            return;
+        if (nValidCount == 0)
         {
-            const float fValue = static_cast<const float *>(pData)[iOffset];
-            if (CPLIsNan(fValue) ||
-                (bGotFloatNoDataValue && ARE_REAL_EQUAL(fValue, fNoDataValue)))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            dfValue = fValue;
-            return dfValue;
+            *this = other;
+            return;
         }
-        case GDT_Float64:
-            dfValue = static_cast<const double *>(pData)[iOffset];
-            if (CPLIsNan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_CInt16:
-            dfValue = static_cast<const GInt16 *>(pData)[iOffset * 2];
-            break;
-        case GDT_CInt32:
-            dfValue = static_cast<const GInt32 *>(pData)[iOffset * 2];
-            break;
-        case GDT_CFloat32:
-            dfValue = static_cast<const float *>(pData)[iOffset * 2];
-            if (CPLIsNan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_CFloat64:
-            dfValue = static_cast<const double *>(pData)[iOffset * 2];
-            if (CPLIsNan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_Unknown:
-        case GDT_TypeCount:
-            CPLAssert(false);
-            break;
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        const double dfN1 = static_cast<double>(nValidCount);
+        const double dfN2 = static_cast<double>(other.nValidCount);
+        nValidCount += other.nValidCount;
+        const double dfN = static_cast<double>(nValidCount);
+        const double dfDelta = other.dfMean - dfMean;
+        dfMean += dfDelta * dfN2 / dfN;
+        dfM2 += other.dfM2 + dfDelta * dfDelta * dfN1 * dfN2 / dfN;
     }
+};
 
-    if (bGotNoDataValue && ARE_REAL_EQUAL(dfValue, dfNoDataValue))
-    {
-        bValid = false;
-        return 0.0;
-    }
-    return dfValue;
-}
+// Characteristics of the band on which statistics are computed
+struct ComputeBlockStatisticsArgs
+{
+    GDALDataType eDataType = GDT_Unknown;
+    bool bSignedByte = false;
+    bool bGotNoDataValue = false;
+    double dfNoDataValue = 0;
+    bool bGotFloatNoDataValue = false;
+    float fNoDataValue = 0;
+    // If false, only nValidCount, dfMin and dfMax are computed
+    bool bComputeOtherStats = true;
+};
+}  // namespace
 
 /************************************************************************/
-/*                         SetValidPercent()                            */
+/*                     ComputeBlockStatisticsImpl()                     */
 /************************************************************************/
 
-//! @cond Doxygen_Suppress
-/**
- * \brief Set percentage of valid (not nodata) pixels.
- *
- * Stores the percentage of valid pixels in the metadata item
- * STATISTICS_VALID_PERCENT
- *
- * @param nSampleCount Number of sampled pixels.
- *
- * @param nValidCount Number of valid pixels.
- */
-
-void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
-                                     GUIntBig nValidCount)
+// Scalar implementation, for all data types. Nodata values are compared with
+// ARE_REAL_EQUAL(), in single precision for Float32. Mean and M2 are computed
+// in two passes over the block, which is both numerically robust and cheap
+// since the block is hot in the CPU cache.
+// STRIDE = 2 is used for complex types, of which only the real part is
+// taken into account.
+template <class T, int STRIDE, bool HAS_NODATA, bool HAS_MASK>
+static void ComputeBlockStatisticsGeneric(const T *pData, int nXCheck,
+                                          int nYCheck, int nBlockXSize,
+                                          double dfNoDataValue,
+                                          const GByte *pabyMaskData,
+                                          bool bComputeOtherStats,
+                                          GDALBlockStatistics &sStats)
 {
-    if (nValidCount == 0)
+    // Float32 values are compared to the nodata value in single precision
+    using WorkT = typename std::conditional<
+        std::is_same<T, float>::value && STRIDE == 1, float, double>::type;
+    const WorkT noDataValue = static_cast<WorkT>(dfNoDataValue);
+
+    const auto IsValid =
+        [noDataValue, pabyMaskData](WorkT v, GPtrDiff_t iOffset)
     {
-        SetMetadataItem("STATISTICS_VALID_PERCENT", "0");
-    }
-    else if (nValidCount == nSampleCount)
+        if constexpr (HAS_MASK)
+        {
+            if (pabyMaskData[iOffset] == 0)
+                return false;
+        }
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            if (CPLIsNan(v))
+                return false;
+        }
+        if constexpr (HAS_NODATA)
+        {
+            if (ARE_REAL_EQUAL(v, noDataValue))
+                return false;
+        }
+        return true;
+    };
+
+    GUIntBig nValidCount = 0;
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
     {
-        SetMetadataItem("STATISTICS_VALID_PERCENT", "100");
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const WorkT v = static_cast<WorkT>(pData[iOffset * STRIDE]);
+            if (!IsValid(v, iOffset))
+                continue;
+            ++nValidCount;
+            dfMin = std::min(dfMin, static_cast<double>(v));
+            dfMax = std::max(dfMax, static_cast<double>(v));
+            dfSum += static_cast<double>(v);
+        }
     }
-    else /* nValidCount < nSampleCount */
+
+    GDALBlockStatistics sBlockStats;
+    sBlockStats.nValidCount = nValidCount;
+    sBlockStats.dfMin = dfMin;
+    sBlockStats.dfMax = dfMax;
+    if (bComputeOtherStats && nValidCount > 0)
     {
-        char szValue[128] = {0};
+        const double dfMean = dfSum / static_cast<double>(nValidCount);
+        double dfM2 = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t iLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            for (int iX = 0; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const WorkT v = static_cast<WorkT>(pData[iOffset * STRIDE]);
+                if (!IsValid(v, iOffset))
+                    continue;
+                const double dfDelta = static_cast<double>(v) - dfMean;
+                dfM2 += dfDelta * dfDelta;
+            }
+        }
+        sBlockStats.dfMean = dfMean;
+        sBlockStats.dfM2 = dfM2;
+    }
+    sStats.Merge(sBlockStats);
+}
 
-        /* percentage is only an indicator: limit precision */
-        CPLsnprintf(szValue, sizeof(szValue), "%.4g",
-                    100. * static_cast<double>(nValidCount) / nSampleCount);
+#if (defined(__x86_64__) || defined(_M_X64)) &&                                \
+    (defined(__GNUC__) || defined(_MSC_VER))
 
-        if (EQUAL(szValue, "100"))
+#include <emmintrin.h>
+
+// SSE2 implementation for Float32. Lanes are masked out (NaN, nodata,
+// mask band) with comparison masks, so that the inner loop is branch-free.
+// Sums are accumulated in double precision.
+template <bool HAS_NODATA, bool HAS_MASK>
+static void ComputeBlockStatisticsSSE2(const float *pData, int nXCheck,
+                                       int nYCheck, int nBlockXSize,
+                                       float fNoDataValue,
+                                       const GByte *pabyMaskData,
+                                       bool bComputeOtherStats,
+                                       GDALBlockStatistics &sStats)
+{
+    const __m128 vNoData = _mm_set1_ps(fNoDataValue);
+    const __m128 vTwoEps =
+        _mm_set1_ps(2 * std::numeric_limits<float>::epsilon());
+    const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 vPosInf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 vNegInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+    // Returns a mask with all bits set for valid values
+    const auto GetValidMask =
+        [vNoData, vTwoEps, vAbsMask, pabyMaskData](__m128 v, GPtrDiff_t iOffset)
+    {
+        __m128 vValid = _mm_cmpord_ps(v, v);
+        if constexpr (HAS_NODATA)
         {
-            /* don't set 100 percent valid
-             * because some of the sampled pixels were nodata */
-            SetMetadataItem("STATISTICS_VALID_PERCENT", "99.999");
+            // Vectorized version of ARE_REAL_EQUAL()
+            const __m128 vDiff =
+                _mm_and_ps(_mm_sub_ps(v, vNoData), vAbsMask);
+            const __m128 vTol = _mm_mul_ps(
+                vTwoEps, _mm_and_ps(_mm_add_ps(v, vNoData), vAbsMask));
+            const __m128 vEq = _mm_or_ps(_mm_cmpeq_ps(v, vNoData),
+                                         _mm_cmplt_ps(vDiff, vTol));
+            vValid = _mm_andnot_ps(vEq, vValid);
         }
-        else
+        if constexpr (HAS_MASK)
         {
-            SetMetadataItem("STATISTICS_VALID_PERCENT", szValue);
+            const __m128i vMask = _mm_set_epi32(
+                pabyMaskData[iOffset + 3], pabyMaskData[iOffset + 2],
+                pabyMaskData[iOffset + 1], pabyMaskData[iOffset]);
+            vValid = _mm_andnot_ps(
+                _mm_castsi128_ps(_mm_cmpeq_epi32(vMask, _mm_setzero_si128())),
+                vValid);
         }
-    }
-}
+        return vValid;
+    };
 
-//! @endcond
+    const auto IsValid = [fNoDataValue, pabyMaskData](float v,
+                                                       GPtrDiff_t iOffset)
+    {
+        if constexpr (HAS_MASK)
+        {
+            if (pabyMaskData[iOffset] == 0)
+                return false;
+        }
+        if constexpr (HAS_NODATA)
+        {
+            if (ARE_REAL_EQUAL(v, fNoDataValue))
+                return false;
+        }
+        return !CPLIsNan(v);
+    };
 
-/************************************************************************/
-/*                         ComputeStatistics()                          */
-/************************************************************************/
+    __m128 vMin = vPosInf;
+    __m128 vMax = vNegInf;
+    __m128d vSum0 = _mm_setzero_pd();
+    __m128d vSum1 = _mm_setzero_pd();
+    __m128i vCount = _mm_setzero_si128();
+    GUIntBig nValidCount = 0;
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        int iX = 0;
+        for (; iX + 3 < nXCheck; iX += 4)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const __m128 v = _mm_loadu_ps(pData + iOffset);
+            const __m128 vValid = GetValidMask(v, iOffset);
+            const __m128 vValidValues = _mm_and_ps(vValid, v);
+            vMin = _mm_min_ps(
+                vMin, _mm_or_ps(vValidValues, _mm_andnot_ps(vValid, vPosInf)));
+            vMax = _mm_max_ps(
+                vMax, _mm_or_ps(vValidValues, _mm_andnot_ps(vValid, vNegInf)));
+            // Valid lanes are -1 when interpreted as integers
+            vCount = _mm_sub_epi32(vCount, _mm_castps_si128(vValid));
+            vSum0 = _mm_add_pd(vSum0, _mm_cvtps_pd(vValidValues));
+            vSum1 = _mm_add_pd(
+                vSum1,
+                _mm_cvtps_pd(_mm_movehl_ps(vValidValues, vValidValues)));
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const float v = pData[iOffset];
+            if (!IsValid(v, iOffset))
+                continue;
+            ++nValidCount;
+            dfMin = std::min(dfMin, static_cast<double>(v));
+            dfMax = std::max(dfMax, static_cast<double>(v));
+            dfSum += v;
+        }
 
-/**
- * \brief Compute image statistics.
- *
- * Returns the minimum, maximum, mean and standard deviation of all
- * pixel values in this band.  If approximate statistics are sufficient,
- * the bApproxOK flag can be set to true in which case overviews, or a
- * subset of image tiles may be used in computing the statistics.
- *
+        // Flush the 32-bit lane counters at each line so that they cannot
+        // overflow
+        GUInt32 anCount[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), vCount);
+        nValidCount += static_cast<GUIntBig>(anCount[0]) + anCount[1] +
+                       anCount[2] + anCount[3];
+        vCount = _mm_setzero_si128();
+    }
+
+    float afMin[4];
+    float afMax[4];
+    double adfSum[4];
+    _mm_storeu_ps(afMin, vMin);
+    _mm_storeu_ps(afMax, vMax);
+    _mm_storeu_pd(adfSum, vSum0);
+    _mm_storeu_pd(adfSum + 2, vSum1);
+    for (int j = 0; j < 4; ++j)
+    {
+        // Infinite values only come from the neutral elements if there is
+        // no valid value in the lane, in which case they are harmless.
+        dfMin = std::min(dfMin, static_cast<double>(afMin[j]));
+        dfMax = std::max(dfMax, static_cast<double>(afMax[j]));
+    }
+    dfSum += (adfSum[0] + adfSum[1]) + (adfSum[2] + adfSum[3]);
+
+    if (nValidCount == 0)
+        return;
+    GDALBlockStatistics sBlockStats;
+    sBlockStats.nValidCount = nValidCount;
+    sBlockStats.dfMin = dfMin;
+    sBlockStats.dfMax = dfMax;
+    if (bComputeOtherStats)
+    {
+        const double dfMean = dfSum / static_cast<double>(nValidCount);
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        double dfM2 = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t iLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for (; iX + 3 < nXCheck; iX += 4)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const __m128 v = _mm_loadu_ps(pData + iOffset);
+                const __m128 vValid = GetValidMask(v, iOffset);
+                // Widen the 32-bit masks to 64 bits
+                const __m128d vValid0 =
+                    _mm_castps_pd(_mm_unpacklo_ps(vValid, vValid));
+                const __m128d vValid1 =
+                    _mm_castps_pd(_mm_unpackhi_ps(vValid, vValid));
+                const __m128 vValidValues = _mm_and_ps(vValid, v);
+                const __m128d vDelta0 =
+                    _mm_sub_pd(_mm_cvtps_pd(vValidValues), vMean);
+                const __m128d vDelta1 = _mm_sub_pd(
+                    _mm_cvtps_pd(_mm_movehl_ps(vValidValues, vValidValues)),
+                    vMean);
+                vM2 = _mm_add_pd(
+                    vM2, _mm_and_pd(vValid0, _mm_mul_pd(vDelta0, vDelta0)));
+                vM2 = _mm_add_pd(
+                    vM2, _mm_and_pd(vValid1, _mm_mul_pd(vDelta1, vDelta1)));
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const float v = pData[iOffset];
+                if (!IsValid(v, iOffset))
+                    continue;
+                const double dfDelta = static_cast<double>(v) - dfMean;
+                dfM2 += dfDelta * dfDelta;
+            }
+        }
+        double adfM2[2];
+        _mm_storeu_pd(adfM2, vM2);
+        sBlockStats.dfMean = dfMean;
+        sBlockStats.dfM2 = dfM2 + adfM2[0] + adfM2[1];
+    }
+    sStats.Merge(sBlockStats);
+}
+
+// SSE2 implementation for Float64
+template <bool HAS_NODATA, bool HAS_MASK>
+static void ComputeBlockStatisticsSSE2(const double *pData, int nXCheck,
+                                       int nYCheck, int nBlockXSize,
+                                       double dfNoDataValue,
+                                       const GByte *pabyMaskData,
+                                       bool bComputeOtherStats,
+                                       GDALBlockStatistics &sStats)
+{
+    const __m128d vNoData = _mm_set1_pd(dfNoDataValue);
+    const __m128d vTwoEps =
+        _mm_set1_pd(2 * static_cast<double>(
+                            std::numeric_limits<float>::epsilon()));
+    const __m128d vAbsMask =
+        _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m128d vPosInf =
+        _mm_set1_pd(std::numeric_limits<double>::infinity());
+    const __m128d vNegInf =
+        _mm_set1_pd(-std::numeric_limits<double>::infinity());
+
+    // Returns a mask with all bits set for valid values
+    const auto GetValidMask =
+        [vNoData, vTwoEps, vAbsMask,
+         pabyMaskData](__m128d v, GPtrDiff_t iOffset)
+    {
+        __m128d vValid = _mm_cmpord_pd(v, v);
+        if constexpr (HAS_NODATA)
+        {
+            // Vectorized version of ARE_REAL_EQUAL()
+            const __m128d vDiff =
+                _mm_and_pd(_mm_sub_pd(v, vNoData), vAbsMask);
+            const __m128d vTol = _mm_mul_pd(
+                vTwoEps, _mm_and_pd(_mm_add_pd(v, vNoData), vAbsMask));
+            const __m128d vEq = _mm_or_pd(_mm_cmpeq_pd(v, vNoData),
+                                          _mm_cmplt_pd(vDiff, vTol));
+            vValid = _mm_andnot_pd(vEq, vValid);
+        }
+        if constexpr (HAS_MASK)
+        {
+            const __m128i vMask = _mm_set_epi64x(
+                pabyMaskData[iOffset + 1] ? -1 : 0,
+                pabyMaskData[iOffset] ? -1 : 0);
+            vValid = _mm_and_pd(_mm_castsi128_pd(vMask), vValid);
+        }
+        return vValid;
+    };
+
+    const auto IsValid = [dfNoDataValue, pabyMaskData](double v,
+                                                        GPtrDiff_t iOffset)
+    {
+        if constexpr (HAS_MASK)
+        {
+            if (pabyMaskData[iOffset] == 0)
+                return false;
+        }
+        if constexpr (HAS_NODATA)
+        {
+            if (ARE_REAL_EQUAL(v, dfNoDataValue))
+                return false;
+        }
+        return !CPLIsNan(v);
+    };
+
+    __m128d vMin = vPosInf;
+    __m128d vMax = vNegInf;
+    __m128d vSum = _mm_setzero_pd();
+    __m128i vCount = _mm_setzero_si128();
+    GUIntBig nValidCount = 0;
+    double dfMin = std::numeric_limits<double>::max();
+    double dfMax = -std::numeric_limits<double>::max();
+    double dfSum = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        int iX = 0;
+        for (; iX + 1 < nXCheck; iX += 2)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const __m128d v = _mm_loadu_pd(pData + iOffset);
+            const __m128d vValid = GetValidMask(v, iOffset);
+            const __m128d vValidValues = _mm_and_pd(vValid, v);
+            vMin = _mm_min_pd(
+                vMin, _mm_or_pd(vValidValues, _mm_andnot_pd(vValid, vPosInf)));
+            vMax = _mm_max_pd(
+                vMax, _mm_or_pd(vValidValues, _mm_andnot_pd(vValid, vNegInf)));
+            // Valid lanes are -1 when interpreted as integers
+            vCount = _mm_sub_epi64(vCount, _mm_castpd_si128(vValid));
+            vSum = _mm_add_pd(vSum, vValidValues);
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const double v = pData[iOffset];
+            if (!IsValid(v, iOffset))
+                continue;
+            ++nValidCount;
+            dfMin = std::min(dfMin, v);
+            dfMax = std::max(dfMax, v);
+            dfSum += v;
+        }
+    }
+
+    double adfMin[2];
+    double adfMax[2];
+    double adfSum[2];
+    GUIntBig anCount[2];
+    _mm_storeu_pd(adfMin, vMin);
+    _mm_storeu_pd(adfMax, vMax);
+    _mm_storeu_pd(adfSum, vSum);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), vCount);
+    for (int j = 0; j < 2; ++j)
+    {
+        dfMin = std::min(dfMin, adfMin[j]);
+        dfMax = std::max(dfMax, adfMax[j]);
+    }
+    dfSum += adfSum[0] + adfSum[1];
+    nValidCount += anCount[0] + anCount[1];
+
+    if (nValidCount == 0)
+        return;
+    GDALBlockStatistics sBlockStats;
+    sBlockStats.nValidCount = nValidCount;
+    sBlockStats.dfMin = dfMin;
+    sBlockStats.dfMax = dfMax;
+    if (bComputeOtherStats)
+    {
+        const double dfMean = dfSum / static_cast<double>(nValidCount);
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        double dfM2 = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t iLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for (; iX + 1 < nXCheck; iX += 2)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const __m128d v = _mm_loadu_pd(pData + iOffset);
+                const __m128d vValid = GetValidMask(v, iOffset);
+                // Invalid lanes may be NaN or infinite: mask after computing
+                const __m128d vDelta = _mm_sub_pd(v, vMean);
+                vM2 = _mm_add_pd(
+                    vM2, _mm_and_pd(vValid, _mm_mul_pd(vDelta, vDelta)));
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const double v = pData[iOffset];
+                if (!IsValid(v, iOffset))
+                    continue;
+                const double dfDelta = v - dfMean;
+                dfM2 += dfDelta * dfDelta;
+            }
+        }
+        double adfM2[2];
+        _mm_storeu_pd(adfM2, vM2);
+        sBlockStats.dfMean = dfMean;
+        sBlockStats.dfM2 = dfM2 + adfM2[0] + adfM2[1];
+    }
+    sStats.Merge(sBlockStats);
+}
+
+// Range [nLo, nHi] of the integer values of type T that the scalar kernel
+// considers equal to the nodata value with ARE_REAL_EQUAL(). For large
+// magnitudes, this may be more than one value. Returns false if no value
+// of T matches.
+template <class T>
+static bool GetIntegerNoDataRange(double dfNoDataValue, T &nLo, T &nHi)
+{
+    if (CPLIsNan(dfNoDataValue))
+        return false;
+    constexpr double dfTypeMin = std::numeric_limits<T>::lowest();
+    constexpr double dfTypeMax = std::numeric_limits<T>::max();
+    const auto Matches = [dfNoDataValue](double v)
+    { return ARE_REAL_EQUAL(v, dfNoDataValue); };
+    double dfLo =
+        std::floor(std::clamp(dfNoDataValue, dfTypeMin, dfTypeMax));
+    if (!Matches(dfLo))
+    {
+        dfLo += 1;
+        if (dfLo > dfTypeMax || !Matches(dfLo))
+            return false;
+    }
+    double dfHi = dfLo;
+    while (dfLo > dfTypeMin && Matches(dfLo - 1))
+        dfLo -= 1;
+    while (dfHi < dfTypeMax && Matches(dfHi + 1))
+        dfHi += 1;
+    nLo = static_cast<T>(dfLo);
+    nHi = static_cast<T>(dfHi);
+    return true;
+}
+
+// SSE2 implementation for Int16 and Int32. Int16 values are widened to
+// 32 bits, and 32-bit values to 64 bits before being summed, so that the
+// sum is exact. Minimum and maximum are computed on the native type, and
+// the second pass computes M2 in double precision as the scalar kernel.
+template <class T, bool HAS_NODATA, bool HAS_MASK>
+static void ComputeBlockStatisticsSSE2Int(const T *pData, int nXCheck,
+                                          int nYCheck, int nBlockXSize,
+                                          double dfNoDataValue,
+                                          const GByte *pabyMaskData,
+                                          bool bComputeOtherStats,
+                                          GDALBlockStatistics &sStats)
+{
+    static_assert(std::is_same<T, GInt16>::value ||
+                      std::is_same<T, GInt32>::value,
+                  "T must be GInt16 or GInt32");
+    constexpr bool IS_INT16 = std::is_same<T, GInt16>::value;
+    constexpr int VALUES_PER_REG = 16 / static_cast<int>(sizeof(T));
+
+    // If no value of T matches the nodata value, use an empty range, so
+    // that all values are valid.
+    T nNoDataLo = 1;
+    T nNoDataHi = 0;
+    if constexpr (HAS_NODATA)
+    {
+        if (!GetIntegerNoDataRange(dfNoDataValue, nNoDataLo, nNoDataHi))
+        {
+            nNoDataLo = 1;
+            nNoDataHi = 0;
+        }
+    }
+
+    const auto Set1 = [](T v)
+    {
+        if constexpr (IS_INT16)
+            return _mm_set1_epi16(v);
+        else
+            return _mm_set1_epi32(v);
+    };
+    const auto CmpGt = [](__m128i a, __m128i b)
+    {
+        if constexpr (IS_INT16)
+            return _mm_cmpgt_epi16(a, b);
+        else
+            return _mm_cmpgt_epi32(a, b);
+    };
+    const auto Min = [CmpGt](__m128i a, __m128i b)
+    {
+        if constexpr (IS_INT16)
+            return _mm_min_epi16(a, b);
+        else
+        {
+            // _mm_min_epi32() requires SSE4.1
+            const __m128i vGt = CmpGt(a, b);
+            return _mm_or_si128(_mm_and_si128(vGt, b),
+                                _mm_andnot_si128(vGt, a));
+        }
+    };
+    const auto Max = [CmpGt](__m128i a, __m128i b)
+    {
+        if constexpr (IS_INT16)
+            return _mm_max_epi16(a, b);
+        else
+        {
+            const __m128i vGt = CmpGt(a, b);
+            return _mm_or_si128(_mm_and_si128(vGt, a),
+                                _mm_andnot_si128(vGt, b));
+        }
+    };
+
+    const __m128i vZero = _mm_setzero_si128();
+    const __m128i vNoDataLo = Set1(nNoDataLo);
+    const __m128i vNoDataHi = Set1(nNoDataHi);
+    const __m128i vTypeMin = Set1(std::numeric_limits<T>::lowest());
+    const __m128i vTypeMax = Set1(std::numeric_limits<T>::max());
+
+    // Returns a mask with all bits set for valid values
+    const auto GetValidMask =
+        [CmpGt, vZero, vNoDataLo, vNoDataHi,
+         pabyMaskData](__m128i v, GPtrDiff_t iOffset)
+    {
+        __m128i vValid = _mm_cmpeq_epi32(vZero, vZero);
+        if constexpr (HAS_NODATA)
+        {
+            vValid = _mm_or_si128(CmpGt(vNoDataLo, v), CmpGt(v, vNoDataHi));
+        }
+        if constexpr (HAS_MASK)
+        {
+            __m128i vMask;
+            if constexpr (IS_INT16)
+            {
+                vMask = _mm_loadl_epi64(
+                    reinterpret_cast<const __m128i *>(pabyMaskData + iOffset));
+                vMask = _mm_unpacklo_epi8(vMask, vZero);
+                vMask = _mm_cmpeq_epi16(vMask, vZero);
+            }
+            else
+            {
+                GInt32 nMask;
+                memcpy(&nMask, pabyMaskData + iOffset, sizeof(nMask));
+                vMask = _mm_unpacklo_epi8(_mm_cvtsi32_si128(nMask), vZero);
+                vMask = _mm_unpacklo_epi16(vMask, vZero);
+                vMask = _mm_cmpeq_epi32(vMask, vZero);
+            }
+            vValid = _mm_andnot_si128(vMask, vValid);
+        }
+        return vValid;
+    };
+
+    const auto IsValid = [nNoDataLo, nNoDataHi, pabyMaskData](T v,
+                                                             GPtrDiff_t iOffset)
+    {
+        if constexpr (HAS_MASK)
+        {
+            if (pabyMaskData[iOffset] == 0)
+                return false;
+        }
+        if constexpr (HAS_NODATA)
+        {
+            if (v >= nNoDataLo && v <= nNoDataHi)
+                return false;
+        }
+        return true;
+    };
+
+    // Sign-extends the 32-bit lanes of v to 64 bits and adds them to
+    // vSum0 and vSum1
+    const auto AddWidened = [vZero](__m128i v, __m128i &vSum0, __m128i &vSum1)
+    {
+        const __m128i vSign = _mm_cmpgt_epi32(vZero, v);
+        vSum0 = _mm_add_epi64(vSum0, _mm_unpacklo_epi32(v, vSign));
+        vSum1 = _mm_add_epi64(vSum1, _mm_unpackhi_epi32(v, vSign));
+    };
+
+    const __m128i vOnes16 = _mm_set1_epi16(1);
+    __m128i vMin = vTypeMax;
+    __m128i vMax = vTypeMin;
+    __m128i vSum0 = vZero;
+    __m128i vSum1 = vZero;
+    __m128i vCount = vZero;
+    GUIntBig nValidCount = 0;
+    T nMin = std::numeric_limits<T>::max();
+    T nMax = std::numeric_limits<T>::lowest();
+    GInt64 nSum = 0;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        int iX = 0;
+        for (; iX + VALUES_PER_REG - 1 < nXCheck; iX += VALUES_PER_REG)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(pData + iOffset));
+            const __m128i vValid = GetValidMask(v, iOffset);
+            const __m128i vValidValues = _mm_and_si128(vValid, v);
+            vMin = Min(vMin, _mm_or_si128(vValidValues,
+                                          _mm_andnot_si128(vValid, vTypeMax)));
+            vMax = Max(vMax, _mm_or_si128(vValidValues,
+                                          _mm_andnot_si128(vValid, vTypeMin)));
+            if constexpr (IS_INT16)
+            {
+                // Sums of pairs of adjacent values, as 32-bit integers
+                AddWidened(_mm_madd_epi16(vValidValues, vOnes16), vSum0,
+                           vSum1);
+                // Valid lanes are -1, so pairs of lanes add up to -2..0
+                vCount = _mm_sub_epi32(vCount, _mm_madd_epi16(vValid, vOnes16));
+            }
+            else
+            {
+                AddWidened(vValidValues, vSum0, vSum1);
+                // Valid lanes are -1 when interpreted as integers
+                vCount = _mm_sub_epi32(vCount, vValid);
+            }
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            const T v = pData[iOffset];
+            if (!IsValid(v, iOffset))
+                continue;
+            ++nValidCount;
+            nMin = std::min(nMin, v);
+            nMax = std::max(nMax, v);
+            nSum += v;
+        }
+
+        // Flush the 32-bit lane counters at each line so that they cannot
+        // overflow
+        GUInt32 anCount[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(anCount), vCount);
+        nValidCount += static_cast<GUIntBig>(anCount[0]) + anCount[1] +
+                       anCount[2] + anCount[3];
+        vCount = vZero;
+    }
+
+    T anMin[VALUES_PER_REG];
+    T anMax[VALUES_PER_REG];
+    GInt64 anSum[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anMin), vMin);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anMax), vMax);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anSum), vSum0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(anSum + 2), vSum1);
+    for (int j = 0; j < VALUES_PER_REG; ++j)
+    {
+        // Neutral elements are only left in lanes without valid values, in
+        // which case they are harmless.
+        nMin = std::min(nMin, anMin[j]);
+        nMax = std::max(nMax, anMax[j]);
+    }
+    nSum += (anSum[0] + anSum[1]) + (anSum[2] + anSum[3]);
+
+    if (nValidCount == 0)
+        return;
+    GDALBlockStatistics sBlockStats;
+    sBlockStats.nValidCount = nValidCount;
+    sBlockStats.dfMin = nMin;
+    sBlockStats.dfMax = nMax;
+    if (bComputeOtherStats)
+    {
+        const double dfMean =
+            static_cast<double>(nSum) / static_cast<double>(nValidCount);
+        const __m128d vMean = _mm_set1_pd(dfMean);
+        __m128d vM2 = _mm_setzero_pd();
+        // Adds the squared differences to the mean of the valid 32-bit lanes
+        // of v
+        const auto AddM2 = [vMean, &vM2](__m128i v, __m128i vValid)
+        {
+            const __m128d vDelta0 = _mm_sub_pd(_mm_cvtepi32_pd(v), vMean);
+            const __m128d vDelta1 =
+                _mm_sub_pd(_mm_cvtepi32_pd(_mm_srli_si128(v, 8)), vMean);
+            // Widen the 32-bit masks to 64 bits
+            const __m128d vValid0 =
+                _mm_castsi128_pd(_mm_unpacklo_epi32(vValid, vValid));
+            const __m128d vValid1 =
+                _mm_castsi128_pd(_mm_unpackhi_epi32(vValid, vValid));
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(vValid0, _mm_mul_pd(vDelta0, vDelta0)));
+            vM2 = _mm_add_pd(
+                vM2, _mm_and_pd(vValid1, _mm_mul_pd(vDelta1, vDelta1)));
+        };
+        double dfM2 = 0;
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            const GPtrDiff_t iLineOffset =
+                static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            int iX = 0;
+            for (; iX + VALUES_PER_REG - 1 < nXCheck; iX += VALUES_PER_REG)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const __m128i v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(pData + iOffset));
+                const __m128i vValid = GetValidMask(v, iOffset);
+                if constexpr (IS_INT16)
+                {
+                    // Sign-extend the 16-bit values and masks to 32 bits
+                    AddM2(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16),
+                          _mm_unpacklo_epi16(vValid, vValid));
+                    AddM2(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16),
+                          _mm_unpackhi_epi16(vValid, vValid));
+                }
+                else
+                {
+                    AddM2(v, vValid);
+                }
+            }
+            for (; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t iOffset = iLineOffset + iX;
+                const T v = pData[iOffset];
+                if (!IsValid(v, iOffset))
+                    continue;
+                const double dfDelta = static_cast<double>(v) - dfMean;
+                dfM2 += dfDelta * dfDelta;
+            }
+        }
+        double adfM2[2];
+        _mm_storeu_pd(adfM2, vM2);
+        sBlockStats.dfMean = dfMean;
+        sBlockStats.dfM2 = dfM2 + adfM2[0] + adfM2[1];
+    }
+    sStats.Merge(sBlockStats);
+}
+
+#define HAVE_COMPUTE_BLOCK_STATISTICS_SSE2
+#endif
+
+template <class T, int STRIDE, bool HAS_NODATA, bool HAS_MASK>
+static void ComputeBlockStatisticsImpl(const T *pData, int nXCheck,
+                                       int nYCheck, int nBlockXSize,
+                                       double dfNoDataValue,
+                                       const GByte *pabyMaskData,
+                                       bool bComputeOtherStats,
+                                       GDALBlockStatistics &sStats)
+{
+#ifdef HAVE_COMPUTE_BLOCK_STATISTICS_SSE2
+    if constexpr (STRIDE == 1 && std::is_same<T, float>::value)
+    {
+        ComputeBlockStatisticsSSE2<HAS_NODATA, HAS_MASK>(
+            pData, nXCheck, nYCheck, nBlockXSize,
+            static_cast<float>(dfNoDataValue), pabyMaskData,
+            bComputeOtherStats, sStats);
+        return;
+    }
+    else if constexpr (STRIDE == 1 && std::is_same<T, double>::value)
+    {
+        ComputeBlockStatisticsSSE2<HAS_NODATA, HAS_MASK>(
+            pData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue, pabyMaskData,
+            bComputeOtherStats, sStats);
+        return;
+    }
+    else if constexpr (STRIDE == 1 && (std::is_same<T, GInt16>::value ||
+                                       std::is_same<T, GInt32>::value))
+    {
+        ComputeBlockStatisticsSSE2Int<T, HAS_NODATA, HAS_MASK>(
+            pData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue, pabyMaskData,
+            bComputeOtherStats, sStats);
+        return;
+    }
+#endif
+    ComputeBlockStatisticsGeneric<T, STRIDE, HAS_NODATA, HAS_MASK>(
+        pData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue, pabyMaskData,
+        bComputeOtherStats, sStats);
+}
+
+template <class T, int STRIDE = 1>
+static void ComputeBlockStatistics(const void *pData, int nXCheck, int nYCheck,
+                                   int nBlockXSize, bool bHasNoData,
+                                   double dfNoDataValue,
+                                   const GByte *pabyMaskData,
+                                   bool bComputeOtherStats,
+                                   GDALBlockStatistics &sStats)
+{
+    const T *pTData = static_cast<const T *>(pData);
+    if (bHasNoData)
+    {
+        if (pabyMaskData)
+            ComputeBlockStatisticsImpl<T, STRIDE, true, true>(
+                pTData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue,
+                pabyMaskData, bComputeOtherStats, sStats);
+        else
+            ComputeBlockStatisticsImpl<T, STRIDE, true, false>(
+                pTData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue,
+                pabyMaskData, bComputeOtherStats, sStats);
+    }
+    else
+    {
+        if (pabyMaskData)
+            ComputeBlockStatisticsImpl<T, STRIDE, false, true>(
+                pTData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue,
+                pabyMaskData, bComputeOtherStats, sStats);
+        else
+            ComputeBlockStatisticsImpl<T, STRIDE, false, false>(
+                pTData, nXCheck, nYCheck, nBlockXSize, dfNoDataValue,
+                pabyMaskData, bComputeOtherStats, sStats);
+    }
+}
+
+// Add to oSketch the valid values of a block. For 8-bit types, values are
+// counted first, so that the sketch receives at most 256 weighted values.
+template <class T, int STRIDE = 1>
+static void ComputeBlockStatistics(const void *pData, int nXCheck, int nYCheck,
+                                   int nBlockXSize, bool bHasNoData,
+                                   double dfNoDataValue,
+                                   const GByte *pabyMaskData,
+                                   bool /* bComputeOtherStats */,
+                                   GDALQuantileSketch &oSketch)
+{
+    const T *pTData = static_cast<const T *>(pData);
+    // Float32 values are compared to the nodata value in single precision
+    using WorkT = typename std::conditional<
+        std::is_same<T, float>::value && STRIDE == 1, float, double>::type;
+    const WorkT noDataValue = static_cast<WorkT>(dfNoDataValue);
+    constexpr bool bCountValues = sizeof(T) == 1 && STRIDE == 1;
+    GUIntBig anCounts[bCountValues ? 256 : 1] = {0};
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset = iLineOffset + iX;
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+            const WorkT v = static_cast<WorkT>(pTData[iOffset * STRIDE]);
+            if (CPLIsNan(v) || (bHasNoData && ARE_REAL_EQUAL(v, noDataValue)))
+                continue;
+            if constexpr (bCountValues)
+                ++anCounts[static_cast<GByte>(pTData[iOffset])];
+            else
+                oSketch.Add(static_cast<double>(v));
+        }
+    }
+
+    if constexpr (bCountValues)
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            if (anCounts[i])
+                oSketch.Add(static_cast<T>(static_cast<GByte>(i)),
+                            static_cast<double>(anCounts[i]));
+        }
+    }
+}
+
+/************************************************************************/
+/*                       ComputeBlockStatistics()                       */
+/************************************************************************/
+
+// Accumulate in sStats the statistics of the nXCheck x nYCheck valid pixels
+// of pData, a buffer whose lines are nBlockXSize pixels wide.
+// Accumulator is GDALBlockStatistics or GDALQuantileSketch.
+template <class Accumulator>
+static void ComputeBlockStatistics(const ComputeBlockStatisticsArgs &sArgs,
+                                   const void *pData, int nXCheck, int nYCheck,
+                                   int nBlockXSize, const GByte *pabyMaskData,
+                                   Accumulator &sStats)
+{
+    const bool bHasNoData = sArgs.bGotNoDataValue;
+    const double dfNoData = sArgs.dfNoDataValue;
+    const bool bOther = sArgs.bComputeOtherStats;
+    switch (sArgs.eDataType)
+    {
+        case GDT_Byte:
+            if (sArgs.bSignedByte)
+                ComputeBlockStatistics<signed char>(
+                    pData, nXCheck, nYCheck, nBlockXSize, bHasNoData, dfNoData,
+                    pabyMaskData, bOther, sStats);
+            else
+                ComputeBlockStatistics<GByte>(pData, nXCheck, nYCheck,
+                                              nBlockXSize, bHasNoData, dfNoData,
+                                              pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Int8:
+            ComputeBlockStatistics<GInt8>(pData, nXCheck, nYCheck, nBlockXSize,
+                                          bHasNoData, dfNoData, pabyMaskData,
+                                          bOther, sStats);
+            break;
+        case GDT_UInt16:
+            ComputeBlockStatistics<GUInt16>(pData, nXCheck, nYCheck,
+                                            nBlockXSize, bHasNoData, dfNoData,
+                                            pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Int16:
+            ComputeBlockStatistics<GInt16>(pData, nXCheck, nYCheck, nBlockXSize,
+                                           bHasNoData, dfNoData, pabyMaskData,
+                                           bOther, sStats);
+            break;
+        case GDT_UInt32:
+            ComputeBlockStatistics<GUInt32>(pData, nXCheck, nYCheck,
+                                            nBlockXSize, bHasNoData, dfNoData,
+                                            pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Int32:
+            ComputeBlockStatistics<GInt32>(pData, nXCheck, nYCheck, nBlockXSize,
+                                           bHasNoData, dfNoData, pabyMaskData,
+                                           bOther, sStats);
+            break;
+        case GDT_UInt64:
+            ComputeBlockStatistics<std::uint64_t>(
+                pData, nXCheck, nYCheck, nBlockXSize, bHasNoData, dfNoData,
+                pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Int64:
+            ComputeBlockStatistics<std::int64_t>(
+                pData, nXCheck, nYCheck, nBlockXSize, bHasNoData, dfNoData,
+                pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Float32:
+            // A nodata value not representable as a float is ignored
+            ComputeBlockStatistics<float>(
+                pData, nXCheck, nYCheck, nBlockXSize,
+                sArgs.bGotFloatNoDataValue, sArgs.fNoDataValue, pabyMaskData,
+                bOther, sStats);
+            break;
+        case GDT_Float64:
+            ComputeBlockStatistics<double>(pData, nXCheck, nYCheck,
+                                           nBlockXSize, bHasNoData, dfNoData,
+                                           pabyMaskData, bOther, sStats);
+            break;
+        case GDT_CInt16:
+            ComputeBlockStatistics<GInt16, 2>(pData, nXCheck, nYCheck,
+                                              nBlockXSize, bHasNoData, dfNoData,
+                                              pabyMaskData, bOther, sStats);
+            break;
+        case GDT_CInt32:
+            ComputeBlockStatistics<GInt32, 2>(pData, nXCheck, nYCheck,
+                                              nBlockXSize, bHasNoData, dfNoData,
+                                              pabyMaskData, bOther, sStats);
+            break;
+        case GDT_CFloat32:
+            // Real part of CFloat32 is compared to nodata in double precision
+            ComputeBlockStatistics<float, 2>(pData, nXCheck, nYCheck,
+                                             nBlockXSize, bHasNoData, dfNoData,
+                                             pabyMaskData, bOther, sStats);
+            break;
+        case GDT_CFloat64:
+            ComputeBlockStatistics<double, 2>(pData, nXCheck, nYCheck,
+                                              nBlockXSize, bHasNoData, dfNoData,
+                                              pabyMaskData, bOther, sStats);
+            break;
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                    ComputeStatisticsIterBlocks()                     */
+/************************************************************************/
+
+// Accumulate in sStats the statistics of one every nSampleRate blocks of
+// poBand. Blocks are read (and the mask band) in the calling thread, but
+// the statistics of blocks are computed in parallel by GDAL_NUM_THREADS
+// threads. The per-block results are merged in block order, so that the
+// result does not depend on the number of threads.
+template <class Accumulator>
+static bool ComputeStatisticsIterBlocks(GDALRasterBand *poBand,
+                                        const ComputeBlockStatisticsArgs &sArgs,
+                                        GDALRasterBand *poMaskBand,
+                                        int nSampleRate, Accumulator &sStats,
+                                        GUIntBig &nSampleCount,
+                                        GDALProgressFunc pfnProgress,
+                                        void *pProgressData)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const GIntBig nTotalBlocks =
+        static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    auto poThreadPool = nThreads > 1 && nTotalBlocks / nSampleRate > 1
+                            ? GDALGetGlobalThreadPool(nThreads)
+                            : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
+
+    // Number of blocks kept locked while their statistics are computed.
+    // Do not lock more than a fourth of the block cache.
+    const GIntBig nBlockBytes =
+        static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+        GDALGetDataTypeSizeBytes(sArgs.eDataType);
+    const int nBatchSize =
+        poJobQueue ? static_cast<int>(std::max<GIntBig>(
+                         1, std::min<GIntBig>(
+                                4 * nThreads,
+                                GDALGetCacheMax64() / 4 /
+                                    std::max<GIntBig>(1, nBlockBytes))))
+                   : 1;
+
+    struct Job
+    {
+        const ComputeBlockStatisticsArgs *psArgs = nullptr;
+        GDALRasterBlock *poBlock = nullptr;
+        int nXCheck = 0;
+        int nYCheck = 0;
+        int nBlockXSize = 0;
+        std::vector<GByte> abyMask{};
+        Accumulator sStats{};
+    };
+
+    const auto JobFunc = [](void *pData)
+    {
+        Job *psJob = static_cast<Job *>(pData);
+        ComputeBlockStatistics(
+            *(psJob->psArgs), psJob->poBlock->GetDataRef(), psJob->nXCheck,
+            psJob->nYCheck, psJob->nBlockXSize,
+            psJob->abyMask.empty() ? nullptr : psJob->abyMask.data(),
+            psJob->sStats);
+    };
+
+    std::vector<Job> asJobs(nBatchSize);
+    bool bRet = true;
+    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks && bRet;)
+    {
+        // Read a batch of blocks and submit the computation of their
+        // statistics
+        int nJobs = 0;
+        for (; nJobs < nBatchSize && iSampleBlock < nTotalBlocks;
+             ++nJobs, iSampleBlock += nSampleRate)
+        {
+            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
+            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+            Job &sJob = asJobs[nJobs];
+            sJob.psArgs = &sArgs;
+            sJob.sStats = Accumulator();
+            sJob.nBlockXSize = nBlockXSize;
+            sJob.poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (sJob.poBlock == nullptr)
+            {
+                bRet = false;
+                break;
+            }
+
+            poBand->GetActualBlockSize(iXBlock, iYBlock, &sJob.nXCheck,
+                                       &sJob.nYCheck);
+            if (poMaskBand)
+            {
+                sJob.abyMask.resize(static_cast<size_t>(nBlockXSize) *
+                                    nBlockYSize);
+                if (poMaskBand->RasterIO(
+                        GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                        sJob.nXCheck, sJob.nYCheck, sJob.abyMask.data(),
+                        sJob.nXCheck, sJob.nYCheck, GDT_Byte, 0, nBlockXSize,
+                        nullptr) != CE_None)
+                {
+                    sJob.poBlock->DropLock();
+                    bRet = false;
+                    break;
+                }
+            }
+
+            if (poJobQueue)
+                poJobQueue->SubmitJob(JobFunc, &sJob);
+            else
+                JobFunc(&sJob);
+        }
+
+        if (poJobQueue)
+            poJobQueue->WaitCompletion();
+
+        for (int i = 0; i < nJobs; ++i)
+        {
+            Job &sJob = asJobs[i];
+            sJob.poBlock->DropLock();
+            if (bRet)
+            {
+                sStats.Merge(sJob.sStats);
+                nSampleCount +=
+                    static_cast<GUIntBig>(sJob.nXCheck) * sJob.nYCheck;
+            }
+        }
+
+        if (bRet && !pfnProgress(static_cast<double>(iSampleBlock) /
+                                     static_cast<double>(nTotalBlocks),
+                                 "Compute Statistics", pProgressData))
+        {
+            poBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+            bRet = false;
+        }
+    }
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                         SetValidPercent()                            */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/**
+ * \brief Set percentage of valid (not nodata) pixels.
+ *
+ * Stores the percentage of valid pixels in the metadata item
+ * STATISTICS_VALID_PERCENT
+ *
+ * @param nSampleCount Number of sampled pixels.
+ *
+ * @param nValidCount Number of valid pixels.
+ */
+
+void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
+                                     GUIntBig nValidCount)
+{
+    if (nValidCount == 0)
+    {
+        SetMetadataItem("STATISTICS_VALID_PERCENT", "0");
+    }
+    else if (nValidCount == nSampleCount)
+    {
+        SetMetadataItem("STATISTICS_VALID_PERCENT", "100");
+    }
+    else /* nValidCount < nSampleCount */
+    {
+        char szValue[128] = {0};
+
+        /* percentage is only an indicator: limit precision */
+        CPLsnprintf(szValue, sizeof(szValue), "%.4g",
+                    100. * static_cast<double>(nValidCount) / nSampleCount);
+
+        if (EQUAL(szValue, "100"))
+        {
+            /* don't set 100 percent valid
+             * because some of the sampled pixels were nodata */
+            SetMetadataItem("STATISTICS_VALID_PERCENT", "99.999");
+        }
+        else
+        {
+            SetMetadataItem("STATISTICS_VALID_PERCENT", szValue);
+        }
+    }
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+/**
+ * \brief Compute image statistics.
+ *
+ * Returns the minimum, maximum, mean and standard deviation of all
+ * pixel values in this band.  If approximate statistics are sufficient,
+ * the bApproxOK flag can be set to true in which case overviews, or a
+ * subset of image tiles may be used in computing the statistics.
+ *
  * Once computed, the statistics will generally be "set" back on the
  * raster band using SetStatistics().
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.10, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to specify the number of threads to
+ * use to compute the statistics of blocks, once they have been read.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -5756,16 +7124,13 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
     /* -------------------------------------------------------------------- */
     /*      Read actual data and compute statistics.                        */
     /* -------------------------------------------------------------------- */
-    // Using Welford algorithm:
+    // Statistics are computed per block, using the sum of square of
+    // differences to the mean of the block (M2) to compute the standard
+    // deviation in a more numerically robust way than the difference of the
+    // sum of square values with the square of the sum. Per-block statistics
+    // are then merged with the parallel variant of the Welford algorithm:
     // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-    // to compute standard deviation in a more numerically robust way than
-    // the difference of the sum of square values with the square of the sum.
-    // dfMean and dfM2 are updated at each sample.
-    // dfM2 is the sum of square of differences to the current mean.
-    double dfMin = std::numeric_limits<double>::max();
-    double dfMax = -std::numeric_limits<double>::max();
-    double dfMean = 0.0;
-    double dfM2 = 0.0;
+    GDALBlockStatistics sStats;
 
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
@@ -5800,6 +7165,14 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
     }
 
+    ComputeBlockStatisticsArgs sArgs;
+    sArgs.eDataType = eDataType;
+    sArgs.bSignedByte = bSignedByte;
+    sArgs.bGotNoDataValue = CPL_TO_BOOL(bGotNoDataValue);
+    sArgs.dfNoDataValue = dfNoDataValue;
+    sArgs.bGotFloatNoDataValue = bGotFloatNoDataValue;
+    sArgs.fNoDataValue = fNoDataValue;
+
     GUIntBig nSampleCount = 0;
     GUIntBig nValidCount = 0;
 
@@ -5861,32 +7234,8 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             }
         }
 
-        /* this isn't the fastest way to do this, but is easier for now */
-        for (int iY = 0; iY < nYReduced; iY++)
-        {
-            for (int iX = 0; iX < nXReduced; iX++)
-            {
-                const int iOffset = iX + iY * nXReduced;
-                if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                    continue;
-
-                bool bValid = true;
-                double dfValue =
-                    GetPixelValue(eDataType, bSignedByte, pData, iOffset,
-                                  CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                                  bGotFloatNoDataValue, fNoDataValue, bValid);
-                if (!bValid)
-                    continue;
-
-                dfMin = std::min(dfMin, dfValue);
-                dfMax = std::max(dfMax, dfValue);
-
-                nValidCount++;
-                const double dfDelta = dfValue - dfMean;
-                dfMean += dfDelta / nValidCount;
-                dfM2 += dfDelta * (dfValue - dfMean);
-            }
-        }
+        ComputeBlockStatistics(sArgs, pData, nXReduced, nYReduced, nXReduced,
+                               pabyMaskData, sStats);
 
         nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
 
@@ -6016,8 +7365,8 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             /*      Save computed information. */
             /* --------------------------------------------------------------------
              */
-            if (nValidCount)
-                dfMean = static_cast<double>(nSum) / nValidCount;
+            const double dfMean =
+                nValidCount ? static_cast<double>(nSum) / nValidCount : 0.0;
 
             // To avoid potential precision issues when doing the difference,
             // we need to do that computation on 128 bit rather than casting
@@ -6065,100 +7414,18 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 return CE_None;
 
             ReportError(CE_Failure, CPLE_AppDefined,
-                        "Failed to compute statistics, no valid pixels found "
-                        "in sampling.");
-            return CE_Failure;
-        }
-#endif
-
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    bool bValid = true;
-                    double dfValue = GetPixelValue(
-                        eDataType, bSignedByte, pData, iOffset,
-                        CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                        bGotFloatNoDataValue, fNoDataValue, bValid);
-
-                    if (!bValid)
-                        continue;
-
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
-
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
-                }
-            }
-
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
-
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+                        "Failed to compute statistics, no valid pixels found "
+                        "in sampling.");
+            return CE_Failure;
         }
+#endif
 
-        CPLFree(pabyMaskData);
+        if (!ComputeStatisticsIterBlocks(this, sArgs, poMaskBand, nSampleRate,
+                                         sStats, nSampleCount, pfnProgress,
+                                         pProgressData))
+        {
+            return CE_Failure;
+        }
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6170,7 +7437,12 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
     /* -------------------------------------------------------------------- */
     /*      Save computed information.                                      */
     /* -------------------------------------------------------------------- */
-    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
+    nValidCount = sStats.nValidCount;
+    double dfMin = sStats.dfMin;
+    double dfMax = sStats.dfMax;
+    const double dfMean = sStats.dfMean;
+    const double dfStdDev =
+        nValidCount > 0 ? sqrt(sStats.dfM2 / nValidCount) : 0.0;
 
     if (nValidCount > 0)
     {
@@ -6351,202 +7623,6 @@ static void ComputeMinMax(const T *buffer, size_t nElts, T nodataValue, T *pMin,
     *pMax = max;
 }
 
-template <GDALDataType eDataType, bool bSignedByte>
-static void ComputeMinMaxGeneric(const void *pData, int nXCheck, int nYCheck,
-                                 int nBlockXSize, bool bGotNoDataValue,
-                                 double dfNoDataValue,
-                                 bool bGotFloatNoDataValue, float fNoDataValue,
-                                 const GByte *pabyMaskData, double &dfMin,
-                                 double &dfMax)
-{
-    double dfLocalMin = dfMin;
-    double dfLocalMax = dfMax;
-
-    for (int iY = 0; iY < nYCheck; iY++)
-    {
-        for (int iX = 0; iX < nXCheck; iX++)
-        {
-            const GPtrDiff_t iOffset =
-                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-            if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                continue;
-            bool bValid = true;
-            double dfValue = GetPixelValue(
-                eDataType, bSignedByte, pData, iOffset, bGotNoDataValue,
-                dfNoDataValue, bGotFloatNoDataValue, fNoDataValue, bValid);
-            if (!bValid)
-                continue;
-
-            dfLocalMin = std::min(dfLocalMin, dfValue);
-            dfLocalMax = std::max(dfLocalMax, dfValue);
-        }
-    }
-
-    dfMin = dfLocalMin;
-    dfMax = dfLocalMax;
-}
-
-static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
-                                 bool bSignedByte, int nXCheck, int nYCheck,
-                                 int nBlockXSize, bool bGotNoDataValue,
-                                 double dfNoDataValue,
-                                 bool bGotFloatNoDataValue, float fNoDataValue,
-                                 const GByte *pabyMaskData, double &dfMin,
-                                 double &dfMax)
-{
-    switch (eDataType)
-    {
-        case GDT_Unknown:
-            CPLAssert(false);
-            break;
-        case GDT_Byte:
-            if (bSignedByte)
-            {
-                ComputeMinMaxGeneric<GDT_Byte, true>(
-                    pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                    dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            }
-            else
-            {
-                ComputeMinMaxGeneric<GDT_Byte, false>(
-                    pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                    dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            }
-            break;
-        case GDT_Int8:
-            ComputeMinMaxGeneric<GDT_Int8, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_UInt16:
-            ComputeMinMaxGeneric<GDT_UInt16, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_Int16:
-            ComputeMinMaxGeneric<GDT_Int16, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_UInt32:
-            ComputeMinMaxGeneric<GDT_UInt32, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_Int32:
-            ComputeMinMaxGeneric<GDT_Int32, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_UInt64:
-            ComputeMinMaxGeneric<GDT_UInt64, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_Int64:
-            ComputeMinMaxGeneric<GDT_Int64, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_Float32:
-            ComputeMinMaxGeneric<GDT_Float32, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, false, 0,
-                bGotFloatNoDataValue, fNoDataValue, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_Float64:
-            ComputeMinMaxGeneric<GDT_Float64, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_CInt16:
-            ComputeMinMaxGeneric<GDT_CInt16, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_CInt32:
-            ComputeMinMaxGeneric<GDT_CInt32, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_CFloat32:
-            ComputeMinMaxGeneric<GDT_CFloat32, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_CFloat64:
-            ComputeMinMaxGeneric<GDT_CFloat64, false>(
-                pData, nXCheck, nYCheck, nBlockXSize, bGotNoDataValue,
-                dfNoDataValue, false, 0, pabyMaskData, dfMin, dfMax);
-            break;
-        case GDT_TypeCount:
-            CPLAssert(false);
-            break;
-    }
-}
-
-static bool ComputeMinMaxGenericIterBlocks(
-    GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
-    GIntBig nTotalBlocks, int nSampleRate, int nBlocksPerRow,
-    bool bGotNoDataValue, double dfNoDataValue, bool bGotFloatNoDataValue,
-    float fNoDataValue, GDALRasterBand *poMaskBand, double &dfMin,
-    double &dfMax)
-
-{
-    GByte *pabyMaskData = nullptr;
-    int nBlockXSize, nBlockYSize;
-    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-
-    if (poMaskBand)
-    {
-        pabyMaskData =
-            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-        if (!pabyMaskData)
-        {
-            return false;
-        }
-    }
-
-    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate)
-    {
-        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
-        {
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
-                             pabyMaskData, dfMin, dfMax);
-
-        poBlock->DropLock();
-    }
-
-    CPLFree(pabyMaskData);
-    return true;
-}
-
 /**
  * \brief Compute the min/max values for a band.
  *
@@ -6646,10 +7722,16 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
         std::numeric_limits<GInt16>::max();  // used for GInt16 case
     GInt16 nMaxInt16 =
         std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
-    double dfMin =
-        std::numeric_limits<double>::max();  // used for generic code path
-    double dfMax =
-        -std::numeric_limits<double>::max();  // used for generic code path
+    // used for generic code path
+    ComputeBlockStatisticsArgs sArgs;
+    sArgs.eDataType = eDataType;
+    sArgs.bSignedByte = bSignedByte;
+    sArgs.bGotNoDataValue = CPL_TO_BOOL(bGotNoDataValue);
+    sArgs.dfNoDataValue = dfNoDataValue;
+    sArgs.bGotFloatNoDataValue = bGotFloatNoDataValue;
+    sArgs.fNoDataValue = fNoDataValue;
+    sArgs.bComputeOtherStats = false;
+    GDALBlockStatistics sStats;
     const bool bUseOptimizedPath =
         !poMaskBand && ((eDataType == GDT_Byte && !bSignedByte) ||
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
@@ -6781,10 +7863,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
         }
         else
         {
-            ComputeMinMaxGeneric(
-                pData, eDataType, bSignedByte, nXReduced, nYReduced, nXReduced,
-                CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                bGotFloatNoDataValue, fNoDataValue, pabyMaskData, dfMin, dfMax);
+            ComputeBlockStatistics(sArgs, pData, nXReduced, nYReduced,
+                                   nXReduced, pabyMaskData, sStats);
         }
 
         CPLFree(pData);
@@ -6848,19 +7928,18 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-            if (!ComputeMinMaxGenericIterBlocks(
-                    this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
-                    bGotFloatNoDataValue, fNoDataValue, poMaskBand, dfMin,
-                    dfMax))
+            GUIntBig nSampleCount = 0;  // unused
+            if (!ComputeStatisticsIterBlocks(this, sArgs, poMaskBand,
+                                             nSampleRate, sStats, nSampleCount,
+                                             GDALDummyProgress, nullptr))
             {
                 return CE_Failure;
             }
         }
     }
 
+    double dfMin = sStats.dfMin;
+    double dfMax = sStats.dfMax;
     if (bUseOptimizedPath)
     {
         if ((eDataType == GDT_Byte && !bSignedByte) || eDataType == GDT_UInt16)
@@ -6913,6 +7992,266 @@ CPLErr CPL_STDCALL GDALComputeRasterMinMax(GDALRasterBandH hBand, int bApproxOK,
     return poBand->ComputeRasterMinMax(bApproxOK, adfMinMax);
 }
 
+/************************************************************************/
+/*                       ComputeQuantileSketch()                        */
+/************************************************************************/
+
+/**
+ * \brief Compute an approximate quantile sketch of the band values.
+ *
+ * The valid values of the band (that is excluding nodata, masked and NaN
+ * values) are added to oSketch, which is typically empty, but might already
+ * contain values of other bands, for example when computing quantiles over
+ * a mosaic. The sketch is computed in a single pass over the blocks of the
+ * band. As for ComputeStatistics(), the GDAL_NUM_THREADS configuration option
+ * can be set to process several blocks in parallel.
+ *
+ * Most applications will rather use GetQuantiles(), which caches the sketch.
+ *
+ * @param bApproxOK If TRUE the sketch may be computed based on overviews
+ * or a subset of all tiles.
+ *
+ * @param oSketch Sketch to which values are added.
+ *
+ * @param pfnProgress a function to call to report progress, or NULL.
+ *
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, or CE_Failure if an error occurs or processing
+ * is terminated by the user.
+ *
+ * @since GDAL 3.10
+ */
+
+CPLErr GDALRasterBand::ComputeQuantileSketch(int bApproxOK,
+                                             GDALQuantileSketch &oSketch,
+                                             GDALProgressFunc pfnProgress,
+                                             void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        GDALRasterBand *poBand =
+            GetRasterSampleOverview(GDALSTAT_APPROX_NUMSAMPLES);
+        if (poBand != this)
+            return poBand->ComputeQuantileSketch(FALSE, oSketch, pfnProgress,
+                                                 pProgressData);
+    }
+
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    if (!InitBlockInfo())
+        return CE_Failure;
+
+    int bGotNoDataValue = FALSE;
+    const double dfNoDataValue = GetNoDataValue(&bGotNoDataValue);
+    bGotNoDataValue = bGotNoDataValue && !CPLIsNan(dfNoDataValue);
+    bool bGotFloatNoDataValue = false;
+    float fNoDataValue = 0.0f;
+    ComputeFloatNoDataValue(eDataType, dfNoDataValue, bGotNoDataValue,
+                            fNoDataValue, bGotFloatNoDataValue);
+
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!bGotNoDataValue)
+    {
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
+    }
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    ComputeBlockStatisticsArgs sArgs;
+    sArgs.eDataType = eDataType;
+    sArgs.bSignedByte = bSignedByte;
+    sArgs.bGotNoDataValue = CPL_TO_BOOL(bGotNoDataValue);
+    sArgs.dfNoDataValue = dfNoDataValue;
+    sArgs.bGotFloatNoDataValue = bGotFloatNoDataValue;
+    sArgs.fNoDataValue = fNoDataValue;
+
+    int nSampleRate = 1;
+    if (bApproxOK)
+    {
+        nSampleRate = static_cast<int>(std::max(
+            1.0, sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
+        // Avoid probing only the first column of blocks (#6378)
+        if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
+            nSampleRate += 1;
+    }
+
+    GUIntBig nSampleCount = 0;
+    if (!ComputeStatisticsIterBlocks(this, sArgs, poMaskBand, nSampleRate,
+                                     oSketch, nSampleCount, pfnProgress,
+                                     pProgressData))
+    {
+        return CE_Failure;
+    }
+
+    if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                            GetQuantiles()                            */
+/************************************************************************/
+
+/**
+ * \brief Fetch approximate quantiles (percentiles) of the band values.
+ *
+ * The quantiles are estimated from a quantile sketch (see
+ * GDALQuantileSketch) computed with ComputeQuantileSketch(). The sketch is
+ * stored, serialized, as the SKETCH item of the QUANTILE_SKETCH metadata
+ * domain, so that it is saved in the .aux.xml file for formats relying on
+ * PAM, and subsequent calls do not need to read the raster again.
+ * It is removed by GDALDataset::ClearStatistics().
+ *
+ * The minimum (probability 0) and maximum (probability 1) are exact when
+ * the sketch is computed on all pixels. The accuracy of other quantiles is
+ * relative to their rank, and is better towards the tails of the
+ * distribution.
+ *
+ * This method is the same as the C function GDALGetRasterQuantiles().
+ *
+ * @param bApproxOK If TRUE the sketch may be computed based on overviews
+ * or a subset of all tiles, and a previously computed approximate sketch is
+ * acceptable.
+ *
+ * @param bForce If FALSE, only a cached sketch is used, and CE_Warning is
+ * returned if there is none. If TRUE, the sketch is computed if needed.
+ *
+ * @param nCount Number of quantiles to compute.
+ *
+ * @param padfProbabilities Array of nCount probabilities, between 0 and 1
+ * (e.g. 0.02 and 0.98 for the 2nd and 98th percentiles).
+ *
+ * @param padfValues Array of nCount values, that receives the quantiles.
+ *
+ * @param pfnProgress a function to call to report progress, or NULL.
+ *
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, CE_Warning if no cached sketch is available
+ * and bForce is FALSE, or CE_Failure if an error occurs.
+ *
+ * @since GDAL 3.10
+ */
+
+CPLErr GDALRasterBand::GetQuantiles(int bApproxOK, int bForce, int nCount,
+                                    const double *padfProbabilities,
+                                    double *padfValues,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+{
+    if (nCount <= 0 || padfProbabilities == nullptr || padfValues == nullptr)
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "GetQuantiles(): invalid arguments");
+        return CE_Failure;
+    }
+    for (int i = 0; i < nCount; ++i)
+    {
+        if (!(padfProbabilities[i] >= 0 && padfProbabilities[i] <= 1))
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg,
+                        "GetQuantiles(): probabilities must be in [0,1]");
+            return CE_Failure;
+        }
+    }
+
+    constexpr const char *QUANTILE_SKETCH_DOMAIN = "QUANTILE_SKETCH";
+    GDALQuantileSketch oSketch;
+    bool bGotSketch = false;
+    const char *pszSketch = GetMetadataItem("SKETCH", QUANTILE_SKETCH_DOMAIN);
+    if (pszSketch != nullptr &&
+        (bApproxOK ||
+         GetMetadataItem("APPROXIMATE", QUANTILE_SKETCH_DOMAIN) == nullptr))
+    {
+        bGotSketch = oSketch.Deserialize(pszSketch);
+        if (!bGotSketch)
+        {
+            CPLDebug("GDAL", "Invalid serialized quantile sketch: %s",
+                     pszSketch);
+        }
+    }
+
+    if (!bGotSketch)
+    {
+        if (!bForce)
+            return CE_Warning;
+
+        const CPLErr eErr = ComputeQuantileSketch(bApproxOK, oSketch,
+                                                  pfnProgress, pProgressData);
+        if (eErr != CE_None)
+            return eErr;
+
+        if (oSketch.GetCount() > 0)
+        {
+            SetMetadataItem("SKETCH", oSketch.Serialize().c_str(),
+                            QUANTILE_SKETCH_DOMAIN);
+            SetMetadataItem("APPROXIMATE", bApproxOK ? "YES" : nullptr,
+                            QUANTILE_SKETCH_DOMAIN);
+        }
+    }
+
+    if (oSketch.GetCount() == 0)
+    {
+        ReportError(
+            CE_Failure, CPLE_AppDefined,
+            "Failed to compute quantiles, no valid pixels found in sampling.");
+        return CE_Failure;
+    }
+
+    for (int i = 0; i < nCount; ++i)
+        padfValues[i] = oSketch.GetQuantile(padfProbabilities[i]);
+    return CE_None;
+}
+
+/************************************************************************/
+/*                       GDALGetRasterQuantiles()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch approximate quantiles (percentiles) of the band values.
+ *
+ * @see GDALRasterBand::GetQuantiles()
+ * @since GDAL 3.10
+ */
+
+CPLErr GDALGetRasterQuantiles(GDALRasterBandH hBand, int bApproxOK, int bForce,
+                              int nCount, const double *padfProbabilities,
+                              double *padfValues, GDALProgressFunc pfnProgress,
+                              void *pProgressData)
+{
+    VALIDATE_POINTER1(hBand, "GDALGetRasterQuantiles", CE_Failure);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    return poBand->GetQuantiles(bApproxOK, bForce, nCount, padfProbabilities,
+                                padfValues, pfnProgress, pProgressData);
+}
+
 /************************************************************************/
 /*                        SetDefaultHistogram()                         */
 /************************************************************************/
@@ -33,9 +33,18 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -46,21 +55,20 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
-
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+static std::atomic<GIntBig> nCacheUsed{0};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
+static void FreeBlockBuffer(void *pData);
+
 #if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
+typedef CPLMutex GDALRBLock;
+#define INITIALIZE_LOCK(hLock) CPLMutexHolderD(&(hLock))
+#define TAKE_LOCK(hLock) CPLMutexHolderOptionalLockD(hLock)
+#define DESTROY_LOCK(hLock) CPLDestroyMutex(hLock)
 #else
 
-static CPLLock *hRBLock = nullptr;
+typedef CPLLock GDALRBLock;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -91,14 +99,66 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(hLock)                                                 \
+    CPLLockHolderD(&(hLock), GetLockType());                                   \
+    CPLLockSetDebugPerf(hLock, bDebugContention)
+#define TAKE_LOCK(hLock) CPLLockHolderOptionalLockD(hLock)
+#define DESTROY_LOCK(hLock) CPLDestroyLock(hLock)
 
 #endif
 
+namespace
+{
+// The least-recently-used list of cached blocks, split in
+// GDAL_BLOCK_CACHE_SHARDS independent lists, each protected by its own lock,
+// so that threads getting cache misses on different blocks do not serialize
+// on a single lock. A block always goes to the same shard, determined by its
+// band and coordinates. The cache size limit stays global.
+struct GDALRasterBlockLRU
+{
+    GDALRBLock *hLock = nullptr;
+
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+
+    // Incremented each time a block is moved to the head of the list.
+    // Modified under hLock, but read without it by Touch().
+    std::atomic<unsigned> nTouchCounter{0};
+
+    // Number of blocks in the list. Modified under hLock, but read
+    // without it by Touch().
+    std::atomic<unsigned> nBlocks{0};
+};
+
+constexpr int MAX_LRU_SHARDS = 64;
+GDALRasterBlockLRU aoLRU[MAX_LRU_SHARDS];
+
+// Number of shards in use. Set once by GDALGetCacheMax64().
+std::atomic<int> nLRUShards{1};
+
+// Shard where the next FlushCacheBlock() call starts looking for a block.
+std::atomic<unsigned> nNextFlushShard{0};
+}  // namespace
+
+/************************************************************************/
+/*                            GetLRUShard()                             */
+/************************************************************************/
+
+static int GetLRUShard(const GDALRasterBand *poBand, int nXOff, int nYOff)
+{
+    const int nShards = nLRUShards.load(std::memory_order_relaxed);
+    if (nShards == 1)
+        return 0;
+    uint64_t nHash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(poBand));
+    nHash ^= (static_cast<uint64_t>(static_cast<unsigned>(nYOff)) << 32) |
+             static_cast<unsigned>(nXOff);
+    // Finalizer of the splitmix64 generator
+    nHash = (nHash ^ (nHash >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    nHash = (nHash ^ (nHash >> 27)) * UINT64_C(0x94d049bb133111eb);
+    nHash ^= nHash >> 31;
+    return static_cast<int>(nHash % static_cast<unsigned>(nShards));
+}
+
 // #define ENABLE_DEBUG
 
 /************************************************************************/
@@ -241,9 +301,14 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
+            const int nShards = std::clamp(
+                atoi(CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1")), 1,
+                MAX_LRU_SHARDS);
+            for (int i = 0; i < nShards; ++i)
             {
-                INITIALIZE_LOCK;
+                INITIALIZE_LOCK(aoLRU[i].hLock);
             }
+            nLRUShards = nShards;
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -434,11 +499,18 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
-
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Successive calls start with a different shard, so that blocks are
+    // evenly evicted from all of them.
+    const int nShards = nLRUShards.load(std::memory_order_relaxed);
+    const unsigned nFirstShard =
+        nShards == 1 ? 0 : nNextFlushShard.fetch_add(1) % nShards;
+    for (int i = 0; i < nShards && poTarget == nullptr; ++i)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockLRU &oLRU = aoLRU[(nFirstShard + i) % nShards];
+        INITIALIZE_LOCK(oLRU.hLock);
+        poTarget = oLRU.poOldest;
 
         while (poTarget != nullptr)
         {
@@ -452,7 +524,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
         if (bSleepsForBockCacheDebug)
         {
             // coverity[tainted_data]
@@ -466,6 +538,9 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
     if (bSleepsForBockCacheDebug)
     {
         // coverity[tainted_data]
@@ -485,7 +560,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
     }
 
-    VSIFreeAligned(poTarget->pData);
+    FreeBlockBuffer(poTarget->pData);
     poTarget->pData = nullptr;
     poTarget->GetBand()->AddBlockToFreeList(poTarget);
 
@@ -589,6 +664,7 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
+    nLRUShard = GetLRUShard(poBand, nXOff, nYOff);
 }
 
 /************************************************************************/
@@ -638,6 +714,7 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
 
     nXOff = nXOffIn;
     nYOff = nYOffIn;
+    nLRUShard = GetLRUShard(poBand, nXOff, nYOff);
     bMustDetach = true;
 }
 
@@ -658,7 +735,7 @@ GDALRasterBlock::~GDALRasterBlock()
 
     if (pData != nullptr)
     {
-        VSIFreeAligned(pData);
+        FreeBlockBuffer(pData);
     }
 
     CPLAssert(nLockCount <= 0);
@@ -668,6 +745,350 @@ GDALRasterBlock::~GDALRasterBlock()
 #endif
 }
 
+/************************************************************************/
+/*                        GDALBlockSlabAllocator                        */
+/************************************************************************/
+
+namespace
+{
+// Allocator of block buffers, enabled with GDAL_BLOCK_CACHE_ALLOCATOR=SLAB.
+//
+// Buffers are carved out of large slabs (32 MB by default, a multiple of the
+// 2 MB huge page size), dedicated to a size class. Since all blocks of a band
+// have the same size, there are typically few size classes, and freed
+// buffers are reused for blocks of the same size without going through
+// malloc(), which avoids heap fragmentation when the block cache is large.
+// Each size class keeps a list of its slabs that are not full, and buffers
+// are allocated from the first of them, so that a slab is filled before the
+// next one is used. A slab is returned to the system once all its buffers
+// are freed, except for the most recently emptied one, kept as a spare to
+// avoid allocating and releasing a slab repeatedly. At most one slab is thus
+// held without being used by any block.
+class GDALBlockSlabAllocator
+{
+  public:
+    explicit GDALBlockSlabAllocator(bool bHugePages) : m_bHugePages(bHugePages)
+    {
+    }
+
+    static void GetSlabGeometry(size_t nSize, size_t &nClassSize,
+                                size_t &nSlabSize, size_t &nChunks);
+    void *Allocate(size_t nSize);
+    void Free(void *pData);
+
+  private:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    static constexpr size_t TARGET_SLAB_SIZE = 32 * 1024 * 1024;
+
+    struct Slab
+    {
+        GByte *pabyBase = nullptr;
+        size_t nSlabSize = 0;
+        size_t nClassSize = 0;
+        size_t nChunks = 0;
+        size_t nUsed = 0;
+        // Number of chunks at the beginning of the slab that have been
+        // handed out at least once
+        size_t nTouched = 0;
+        // Singly linked list of freed chunks, the pointer to the next one
+        // being stored at the start of each chunk
+        void *pFreeList = nullptr;
+        // Links in the list of non-full slabs of the size class
+        Slab *poPrevNonFull = nullptr;
+        Slab *poNextNonFull = nullptr;
+        bool bInNonFullList = false;
+    };
+
+    // Doubly linked list of the slabs of a size class that have at least
+    // one free chunk and at least one used chunk.
+    struct Pool
+    {
+        Slab *poNonFullHead = nullptr;
+        Slab *poNonFullTail = nullptr;
+    };
+
+    bool m_bHugePages = false;
+    std::mutex m_oMutex{};
+    std::map<size_t, Pool> m_oPools{};
+    // Slabs indexed by their base address
+    std::map<const GByte *, Slab *> m_oSlabs{};
+    // Empty slab kept for reuse, of any size class
+    Slab *m_poSpareSlab = nullptr;
+
+    Slab *CreateSlab(size_t nSize);
+    void DestroySlab(Slab *poSlab);
+    static void AddNonFullSlab(Pool &oPool, Slab *poSlab);
+    static void RemoveNonFullSlab(Pool &oPool, Slab *poSlab);
+    CPL_DISALLOW_COPY_ASSIGN(GDALBlockSlabAllocator)
+};
+
+/************************************************************************/
+/*                          GetSlabGeometry()                           */
+/************************************************************************/
+
+void GDALBlockSlabAllocator::GetSlabGeometry(size_t nSize, size_t &nClassSize,
+                                             size_t &nSlabSize, size_t &nChunks)
+{
+    // Chunks of at least a page are page aligned, others are 64-byte aligned.
+    constexpr size_t PAGE_SIZE = 4096;
+    nClassSize = nSize >= PAGE_SIZE ? DIV_ROUND_UP(nSize, PAGE_SIZE) * PAGE_SIZE
+                                    : DIV_ROUND_UP(std::max<size_t>(nSize, 1),
+                                                   64) *
+                                          64;
+    nChunks = std::max<size_t>(1, TARGET_SLAB_SIZE / nClassSize);
+    nSlabSize = DIV_ROUND_UP(nChunks * nClassSize, HUGE_PAGE_SIZE) *
+                HUGE_PAGE_SIZE;
+    // Use the space left by the rounding to the huge page size
+    nChunks = nSlabSize / nClassSize;
+}
+
+/************************************************************************/
+/*                             CreateSlab()                             */
+/************************************************************************/
+
+GDALBlockSlabAllocator::Slab *GDALBlockSlabAllocator::CreateSlab(size_t nSize)
+{
+    auto poSlab = std::make_unique<Slab>();
+    GetSlabGeometry(nSize, poSlab->nClassSize, poSlab->nSlabSize,
+                    poSlab->nChunks);
+#ifdef HAVE_MMAP
+    // Map one extra huge page to be able to align the slab on a huge page
+    // boundary, which is needed for transparent huge pages to be used.
+    const size_t nMapSize =
+        poSlab->nSlabSize + (m_bHugePages ? HUGE_PAGE_SIZE : 0);
+    void *pMap = mmap(nullptr, nMapSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pMap == MAP_FAILED)
+        return nullptr;
+    GByte *pabyBase = static_cast<GByte *>(pMap);
+    if (m_bHugePages)
+    {
+        const size_t nHead =
+            (HUGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(pabyBase) %
+                                  HUGE_PAGE_SIZE) %
+            HUGE_PAGE_SIZE;
+        if (nHead)
+            munmap(pabyBase, nHead);
+        if (HUGE_PAGE_SIZE - nHead)
+            munmap(pabyBase + nHead + poSlab->nSlabSize,
+                   HUGE_PAGE_SIZE - nHead);
+        pabyBase += nHead;
+#ifdef MADV_HUGEPAGE
+        madvise(pabyBase, poSlab->nSlabSize, MADV_HUGEPAGE);
+#endif
+    }
+    poSlab->pabyBase = pabyBase;
+#else
+    poSlab->pabyBase = static_cast<GByte *>(VSIMallocAligned(
+        m_bHugePages ? HUGE_PAGE_SIZE : 4096, poSlab->nSlabSize));
+    if (poSlab->pabyBase == nullptr)
+        return nullptr;
+#endif
+    CPLDebugOnly("GDAL", "Allocating block slab of %u chunks of %u bytes",
+                 static_cast<unsigned>(poSlab->nChunks),
+                 static_cast<unsigned>(poSlab->nClassSize));
+    m_oSlabs[poSlab->pabyBase] = poSlab.get();
+    return poSlab.release();
+}
+
+/************************************************************************/
+/*                            DestroySlab()                             */
+/************************************************************************/
+
+void GDALBlockSlabAllocator::DestroySlab(Slab *poSlab)
+{
+    m_oSlabs.erase(poSlab->pabyBase);
+#ifdef HAVE_MMAP
+    munmap(poSlab->pabyBase, poSlab->nSlabSize);
+#else
+    VSIFreeAligned(poSlab->pabyBase);
+#endif
+    delete poSlab;
+}
+
+/************************************************************************/
+/*                           AddNonFullSlab()                           */
+/************************************************************************/
+
+void GDALBlockSlabAllocator::AddNonFullSlab(Pool &oPool, Slab *poSlab)
+{
+    CPLAssert(!poSlab->bInNonFullList);
+    poSlab->bInNonFullList = true;
+    poSlab->poPrevNonFull = oPool.poNonFullTail;
+    poSlab->poNextNonFull = nullptr;
+    if (oPool.poNonFullTail)
+        oPool.poNonFullTail->poNextNonFull = poSlab;
+    else
+        oPool.poNonFullHead = poSlab;
+    oPool.poNonFullTail = poSlab;
+}
+
+/************************************************************************/
+/*                         RemoveNonFullSlab()                          */
+/************************************************************************/
+
+void GDALBlockSlabAllocator::RemoveNonFullSlab(Pool &oPool, Slab *poSlab)
+{
+    CPLAssert(poSlab->bInNonFullList);
+    poSlab->bInNonFullList = false;
+    if (poSlab->poPrevNonFull)
+        poSlab->poPrevNonFull->poNextNonFull = poSlab->poNextNonFull;
+    else
+        oPool.poNonFullHead = poSlab->poNextNonFull;
+    if (poSlab->poNextNonFull)
+        poSlab->poNextNonFull->poPrevNonFull = poSlab->poPrevNonFull;
+    else
+        oPool.poNonFullTail = poSlab->poPrevNonFull;
+    poSlab->poPrevNonFull = nullptr;
+    poSlab->poNextNonFull = nullptr;
+}
+
+/************************************************************************/
+/*                              Allocate()                              */
+/************************************************************************/
+
+void *GDALBlockSlabAllocator::Allocate(size_t nSize)
+{
+    size_t nClassSize = 0;
+    size_t nSlabSize = 0;
+    size_t nChunks = 0;
+    GetSlabGeometry(nSize, nClassSize, nSlabSize, nChunks);
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    Pool &oPool = m_oPools[nClassSize];
+
+    // Allocate from the oldest non-full slab, so that it is filled before
+    // the next one is used, and the others have a chance to become empty
+    // and be released.
+    Slab *poSlab = oPool.poNonFullHead;
+    if (poSlab == nullptr)
+    {
+        if (m_poSpareSlab && m_poSpareSlab->nClassSize == nClassSize)
+        {
+            poSlab = m_poSpareSlab;
+            m_poSpareSlab = nullptr;
+        }
+        else
+        {
+            poSlab = CreateSlab(nSize);
+            if (poSlab == nullptr)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate slab of " CPL_FRMT_GUIB " bytes",
+                         static_cast<GUIntBig>(nSlabSize));
+                return nullptr;
+            }
+        }
+        if (poSlab->nChunks > 1)
+            AddNonFullSlab(oPool, poSlab);
+    }
+
+    void *pRet;
+    if (poSlab->pFreeList)
+    {
+        pRet = poSlab->pFreeList;
+        memcpy(&(poSlab->pFreeList), pRet, sizeof(void *));
+    }
+    else
+    {
+        pRet = poSlab->pabyBase + poSlab->nTouched * poSlab->nClassSize;
+        poSlab->nTouched++;
+    }
+    poSlab->nUsed++;
+    if (poSlab->nUsed == poSlab->nChunks && poSlab->bInNonFullList)
+        RemoveNonFullSlab(oPool, poSlab);
+    return pRet;
+}
+
+/************************************************************************/
+/*                                Free()                                */
+/************************************************************************/
+
+void GDALBlockSlabAllocator::Free(void *pData)
+{
+    if (pData == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    auto oIter = m_oSlabs.upper_bound(static_cast<const GByte *>(pData));
+    CPLAssert(oIter != m_oSlabs.begin());
+    --oIter;
+    Slab *poSlab = oIter->second;
+    CPLAssert(static_cast<GByte *>(pData) < poSlab->pabyBase + poSlab->nSlabSize);
+
+    memcpy(pData, &(poSlab->pFreeList), sizeof(void *));
+    poSlab->pFreeList = pData;
+    CPLAssert(poSlab->nUsed > 0);
+    poSlab->nUsed--;
+    Pool &oPool = m_oPools[poSlab->nClassSize];
+    if (poSlab->nUsed == 0)
+    {
+        if (poSlab->bInNonFullList)
+            RemoveNonFullSlab(oPool, poSlab);
+        // Keep the slab that has just been emptied as the spare one, since
+        // its size class is in use.
+        if (m_poSpareSlab)
+        {
+            CPLDebugOnly("GDAL", "Releasing block slab");
+            DestroySlab(m_poSpareSlab);
+        }
+        m_poSpareSlab = poSlab;
+    }
+    else if (!poSlab->bInNonFullList)
+    {
+        AddNonFullSlab(oPool, poSlab);
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                         GetSlabAllocator()                           */
+/************************************************************************/
+
+// The allocator is selected the first time a block is allocated, and is
+// then used for the lifetime of the process, so that buffers are always
+// freed by the allocator that allocated them.
+static GDALBlockSlabAllocator *GetSlabAllocator()
+{
+    static GDALBlockSlabAllocator *const poAllocator =
+        []() -> GDALBlockSlabAllocator *
+    {
+        if (!EQUAL(CPLGetConfigOption("GDAL_BLOCK_CACHE_ALLOCATOR", "MALLOC"),
+                   "SLAB"))
+        {
+            return nullptr;
+        }
+        // Never destroyed, as blocks may be freed late at process exit.
+        return new GDALBlockSlabAllocator(CPLTestBool(
+            CPLGetConfigOption("GDAL_BLOCK_CACHE_HUGE_PAGES", "NO")));
+    }();
+    return poAllocator;
+}
+
+/************************************************************************/
+/*                        AllocateBlockBuffer()                         */
+/************************************************************************/
+
+static void *AllocateBlockBuffer(GPtrDiff_t nSizeInBytes)
+{
+    if (auto poAllocator = GetSlabAllocator())
+        return poAllocator->Allocate(static_cast<size_t>(nSizeInBytes));
+    return VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+}
+
+/************************************************************************/
+/*                          FreeBlockBuffer()                           */
+/************************************************************************/
+
+static void FreeBlockBuffer(void *pData)
+{
+    if (auto poAllocator = GetSlabAllocator())
+        poAllocator->Free(pData);
+    else
+        VSIFreeAligned(pData);
+}
+
 /************************************************************************/
 /*                        GetEffectiveBlockSize()                       */
 /************************************************************************/
@@ -676,11 +1097,26 @@ static size_t GetEffectiveBlockSize(GPtrDiff_t nBlockSize)
 {
     // The real cost of a block allocation is more than just nBlockSize
     // As we allocate with 64-byte alignment, use 64 as a multiple.
+    // With the slab allocator, the size of a chunk of a slab is used, plus
+    // its share of the space lost at the end of the slab.
     // We arbitrarily add 2 * sizeof(GDALRasterBlock) to account for that
+    GUIntBig nAllocSize;
+    if (GetSlabAllocator())
+    {
+        size_t nClassSize = 0;
+        size_t nSlabSize = 0;
+        size_t nChunks = 0;
+        GDALBlockSlabAllocator::GetSlabGeometry(
+            static_cast<size_t>(nBlockSize), nClassSize, nSlabSize, nChunks);
+        nAllocSize = DIV_ROUND_UP(nSlabSize, nChunks);
+    }
+    else
+    {
+        nAllocSize = static_cast<GUIntBig>(DIV_ROUND_UP(nBlockSize, 64)) * 64;
+    }
     return static_cast<size_t>(
         std::min(static_cast<GUIntBig>(UINT_MAX),
-                 static_cast<GUIntBig>(DIV_ROUND_UP(nBlockSize, 64)) * 64 +
-                     2 * sizeof(GDALRasterBlock)));
+                 nAllocSize + 2 * sizeof(GDALRasterBlock)));
 }
 
 /************************************************************************/
@@ -701,19 +1137,23 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(aoLRU[nLRUShard].hLock);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockLRU &oLRU = aoLRU[nLRUShard];
+    if (poPrevious != nullptr || oLRU.poNewest == this)
+        oLRU.nBlocks.fetch_sub(1, std::memory_order_relaxed);
 
-    if (poNewest == this)
+    if (oLRU.poOldest == this)
+        oLRU.poOldest = poPrevious;
+
+    if (oLRU.poNewest == this)
     {
-        poNewest = poNext;
+        oLRU.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -747,26 +1187,30 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (int i = 0; i < nLRUShards; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        const GDALRasterBlockLRU &oLRU = aoLRU[i];
+        TAKE_LOCK(oLRU.hLock);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        CPLAssert((oLRU.poNewest == nullptr && oLRU.poOldest == nullptr) ||
+                  (oLRU.poNewest != nullptr && oLRU.poOldest != nullptr));
+
+        if (oLRU.poNewest != nullptr)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            CPLAssert(oLRU.poNewest->poPrevious == nullptr);
+            CPLAssert(oLRU.poOldest->poNext == nullptr);
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock *poLast = nullptr;
+            for (GDALRasterBlock *poBlock = oLRU.poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                CPLAssert(poBlock->poPrevious == poLast);
+
+                poLast = poBlock;
+            }
 
-        CPLAssert(poOldest == poLast);
+            CPLAssert(oLRU.poOldest == poLast);
+        }
     }
 }
 
@@ -779,24 +1223,27 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int i = 0; i < nLRUShards; ++i)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(aoLRU[i].hLock);
+        for (GDALRasterBlock *poBlock = aoLRU[i].poNewest; poBlock != nullptr;
+             poBlock = poBlock->poNext)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            if (poBlock->GetBand() == poBand)
+            {
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -853,32 +1300,59 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    GDALRasterBlockLRU &oLRU = aoLRU[nLRUShard];
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oLRU.poNewest == this)
+        return;
+
+    // Each Touch_unlocked() call moves a single block in front of this one,
+    // so the number of touches since this block was last moved to the head
+    // is an upper bound of its distance to the head. If the block is
+    // guaranteed to be in the most recently used quarter of the list,
+    // moving it to the head would not change which blocks are evicted next,
+    // so skip taking the lock. This makes cache hits on a working set that
+    // fits in the cache lock-free. Counters are maintained per shard, as the
+    // position of a block only changes relatively to the blocks of its shard.
+    const unsigned nBlocks = oLRU.nBlocks.load(std::memory_order_relaxed);
+    const unsigned nDistance =
+        oLRU.nTouchCounter.load(std::memory_order_relaxed) -
+        nTouchSerial.load(std::memory_order_relaxed);
+    if (nDistance < nBlocks / 4)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(oLRU.hLock);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    GDALRasterBlockLRU &oLRU = aoLRU[nLRUShard];
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oLRU.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    // poNewest != this at this point, so the block is in the list only if
+    // it has a predecessor.
+    if (poPrevious == nullptr)
+        oLRU.nBlocks.fetch_add(1, std::memory_order_relaxed);
+    nTouchSerial.store(
+        oLRU.nTouchCounter.fetch_add(1, std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+
+    if (oLRU.poOldest == this)
+        oLRU.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -887,19 +1361,19 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oLRU.poNewest;
 
-    if (poNewest != nullptr)
+    if (oLRU.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oLRU.poNewest->poPrevious == nullptr);
+        oLRU.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oLRU.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oLRU.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oLRU.poOldest = this;
     }
 #ifdef ENABLE_DEBUG
     Verify();
@@ -928,8 +1402,8 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
-    // only be called if we have go through there.
+    // This call will initialize the locks of the LRU lists. Other call places
+    // can only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
@@ -941,17 +1415,22 @@ CPLErr GDALRasterBlock::Internalize()
     bool bFirstIter = true;
     bool bLoopAgain = false;
     GDALDataset *poThisDS = poBand->GetDataset();
+    const int nShards = nLRUShards.load(std::memory_order_relaxed);
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
-        {
-            TAKE_LOCK;
 
-            if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
+        if (bFirstIter)
+            nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+
+        // Detach from the list of oLRU, whose lock must be held, the blocks
+        // to free to bring the cache size back within the limits.
+        const auto EvictFrom =
+            [&](GDALRasterBlockLRU &oLRU, bool bEvictDirtyBlocksOfOtherDatasets)
+        {
+            GDALRasterBlock *poTarget = oLRU.poOldest;
             while (nCacheUsed > nCurCacheMax)
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
@@ -980,7 +1459,8 @@ CPLErr GDALRasterBlock::Internalize()
                                     &(poTarget->nLockCount), 0, -1))
                                 break;
                         }
-                        else if (poDirtyBlockOtherDataset == nullptr)
+                        else if (bEvictDirtyBlocksOfOtherDatasets &&
+                                 poDirtyBlockOtherDataset == nullptr)
                         {
                             poDirtyBlockOtherDataset = poTarget;
                         }
@@ -998,7 +1478,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oLRU.poOldest;
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -1052,14 +1532,30 @@ CPLErr GDALRasterBlock::Internalize()
                     break;
                 }
             }
+        };
 
-            /* ------------------------------------------------------------------
-             */
-            /*      Add this block to the list. */
-            /* ------------------------------------------------------------------
-             */
-            if (!bLoopAgain)
-                Touch_unlocked();
+        // Evict blocks of the shard of this block first, and then of the
+        // other shards. Dirty blocks of other datasets are only evicted when
+        // no other block can be.
+        for (int iPass = 0;
+             iPass < 2 && !bLoopAgain && nCacheUsed > nCurCacheMax; ++iPass)
+        {
+            for (int i = 0;
+                 i < nShards && !bLoopAgain && nCacheUsed > nCurCacheMax; ++i)
+            {
+                GDALRasterBlockLRU &oLRU = aoLRU[(nLRUShard + i) % nShards];
+                TAKE_LOCK(oLRU.hLock);
+                EvictFrom(oLRU, iPass == 1);
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Add this block to the list.                                 */
+        /* ---------------------------------------------------------------- */
+        if (!bLoopAgain)
+        {
+            TAKE_LOCK(aoLRU[nLRUShard].hLock);
+            Touch_unlocked();
         }
 
         bFirstIter = false;
@@ -1098,7 +1594,7 @@ CPLErr GDALRasterBlock::Internalize()
             }
             else
             {
-                VSIFreeAligned(poBlock->pData);
+                FreeBlockBuffer(poBlock->pData);
             }
             poBlock->pData = nullptr;
 
@@ -1108,7 +1604,7 @@ CPLErr GDALRasterBlock::Internalize()
 
     if (pNewData == nullptr)
     {
-        pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+        pNewData = AllocateBlockBuffer(nSizeInBytes);
         if (pNewData == nullptr)
         {
             return (CE_Failure);
@@ -1167,9 +1663,12 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (GDALRasterBlockLRU &oLRU : aoLRU)
+    {
+        if (oLRU.hLock != nullptr)
+            DESTROY_LOCK(oLRU.hLock);
+        oLRU.hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1248,23 +1747,87 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(aoLRU[nLRUShard].hLock);
 
     return FALSE;
 }
 
+/************************************************************************/
+/*                          GDALBorrowedBlock                           */
+/************************************************************************/
+
+/** Destructor. Releases the lock on the block. */
+GDALBorrowedBlock::~GDALBorrowedBlock()
+{
+    Release();
+}
+
+/** Copy constructor. Takes an additional lock on the block. */
+GDALBorrowedBlock::GDALBorrowedBlock(const GDALBorrowedBlock &oOther)
+    : m_poBlock(oOther.m_poBlock)
+{
+    if (m_poBlock)
+        m_poBlock->AddLock();
+}
+
+/** Copy assignment operator. */
+GDALBorrowedBlock &GDALBorrowedBlock::operator=(const GDALBorrowedBlock &oOther)
+{
+    if (this != &oOther)
+    {
+        if (oOther.m_poBlock)
+            oOther.m_poBlock->AddLock();
+        Release();
+        m_poBlock = oOther.m_poBlock;
+    }
+    return *this;
+}
+
+/** Move constructor. */
+GDALBorrowedBlock::GDALBorrowedBlock(GDALBorrowedBlock &&oOther) noexcept
+    : m_poBlock(oOther.m_poBlock)
+{
+    oOther.m_poBlock = nullptr;
+}
+
+/** Move assignment operator. */
+GDALBorrowedBlock &
+GDALBorrowedBlock::operator=(GDALBorrowedBlock &&oOther) noexcept
+{
+    if (this != &oOther)
+    {
+        Release();
+        m_poBlock = oOther.m_poBlock;
+        oOther.m_poBlock = nullptr;
+    }
+    return *this;
+}
+
+/** Release the lock on the block. The object no longer references it. */
+void GDALBorrowedBlock::Release()
+{
+    if (m_poBlock)
+    {
+        m_poBlock->DropLock();
+        m_poBlock = nullptr;
+    }
+}
+
 #if 0
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int i = 0; i < nLRUShards; ++i )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( GDALRasterBlock *poBlock = aoLRU[i].poNewest;
+             poBlock != nullptr;
+             poBlock = poBlock->poNext )
+        {
+            printf("Block %d\n", iBlock);/*ok*/
+            poBlock->DumpBlock();
+            printf("\n");/*ok*/
+            iBlock++;
+        }
     }
 }
 
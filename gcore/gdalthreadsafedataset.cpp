@@ -0,0 +1,562 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Dataset wrapper that can be used concurrently from several
+ *           threads for read operations (GDAL_OF_THREAD_SAFE)
+ *
+ ******************************************************************************
+ * Copyright (c) 2024, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+/* Design notes:
+ *
+ * The "prototype" dataset is the one opened by GDALOpenEx(). It is used to
+ * answer all metadata, georeferencing, overview and mask queries, under a
+ * (recursive) mutex, so that all threads share the same snapshot of that
+ * information.
+ *
+ * Pixel requests (IRasterIO() and IReadBlock()) are forwarded to "worker"
+ * datasets, which are other instances of the same dataset opened on demand
+ * with the same driver and open options. Idle workers are kept in a pool,
+ * so the number of instances is bounded by the maximum number of threads that
+ * have issued concurrent requests. Each worker has its own band block cache,
+ * but all of them are accounted for in the global GDAL_CACHEMAX. The block
+ * cache is thus not shared between threads: a block read by a worker is not
+ * visible to the others, and may be read and cached once per worker. Sharing
+ * it would require the band block caches to support concurrent insertion,
+ * which they do not.
+ *
+ * If a worker cannot be opened (for example for a dataset that only lives in
+ * memory), pixel requests fall back to the prototype dataset and are thus
+ * serialized.
+ */
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+#include "gdal_proxy.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+//! @cond Doxygen_Suppress
+
+class GDALThreadSafeRasterBand;
+
+/************************************************************************/
+/*                         GDALThreadSafeDataset                        */
+/************************************************************************/
+
+class GDALThreadSafeDataset final : public GDALProxyDataset
+{
+  public:
+    GDALThreadSafeDataset(std::unique_ptr<GDALDataset> poPrototypeDS,
+                          unsigned int nOpenFlagsIn,
+                          CSLConstList papszAllowedDrivers,
+                          CSLConstList papszOpenOptionsIn);
+    ~GDALThreadSafeDataset() override;
+
+    GDALDataset *AcquireWorkerDataset();
+    void ReleaseWorkerDataset(GDALDataset *poWorkerDS);
+
+    std::recursive_mutex &GetPrototypeMutex() const
+    {
+        return m_oPrototypeMutex;
+    }
+
+    GDALDataset *GetPrototypeDataset() const
+    {
+        return m_poPrototypeDS.get();
+    }
+
+    bool IsThreadSafe() const override
+    {
+        return true;
+    }
+
+  protected:
+    GDALDataset *RefUnderlyingDataset() const override;
+    void
+    UnrefUnderlyingDataset(GDALDataset *poUnderlyingDataset) const override;
+
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, int, BANDMAP_TYPE, GSpacing, GSpacing,
+                     GSpacing, GDALRasterIOExtraArg *psExtraArg) override;
+
+  private:
+    std::unique_ptr<GDALDataset> m_poPrototypeDS;
+    const unsigned int m_nWorkerOpenFlags;
+    const CPLStringList m_aosAllowedDrivers;
+    const CPLStringList m_aosOpenOptions;
+
+    // Protects all accesses to m_poPrototypeDS and its bands
+    mutable std::recursive_mutex m_oPrototypeMutex{};
+
+    // Protects m_apoIdleWorkers and m_bWorkersUnavailable
+    std::mutex m_oPoolMutex{};
+    std::vector<std::unique_ptr<GDALDataset>> m_apoIdleWorkers{};
+    bool m_bWorkersUnavailable = false;
+
+    std::unique_ptr<GDALDataset> OpenWorkerDataset() const;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeDataset)
+};
+
+/************************************************************************/
+/*                        GDALThreadSafeWorker                          */
+/************************************************************************/
+
+// RAII helper that borrows a worker dataset for the duration of a pixel
+// request, or falls back to the prototype dataset while holding its mutex.
+class GDALThreadSafeWorker
+{
+  public:
+    explicit GDALThreadSafeWorker(GDALThreadSafeDataset *poTSDS)
+        : m_poTSDS(poTSDS), m_poDS(poTSDS->AcquireWorkerDataset())
+    {
+        if (!m_poDS)
+        {
+            m_oPrototypeLock = std::unique_lock<std::recursive_mutex>(
+                m_poTSDS->GetPrototypeMutex());
+            m_poDS = m_poTSDS->GetPrototypeDataset();
+        }
+    }
+
+    ~GDALThreadSafeWorker()
+    {
+        if (!m_oPrototypeLock.owns_lock())
+            m_poTSDS->ReleaseWorkerDataset(m_poDS);
+    }
+
+    GDALDataset *get() const
+    {
+        return m_poDS;
+    }
+
+  private:
+    GDALThreadSafeDataset *const m_poTSDS;
+    GDALDataset *m_poDS;
+    std::unique_lock<std::recursive_mutex> m_oPrototypeLock{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeWorker)
+};
+
+/************************************************************************/
+/*                       GDALThreadSafeRasterBand                       */
+/************************************************************************/
+
+class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
+{
+  public:
+    GDALThreadSafeRasterBand(GDALThreadSafeDataset *poTSDS,
+                             GDALRasterBand *poPrototypeBand, int nBandIn,
+                             const std::vector<int> &anPath);
+
+    GDALRasterBand *GetMaskBand() override;
+    GDALRasterBand *GetOverview(int) override;
+    GDALRasterBand *GetRasterSampleOverview(GUIntBig) override;
+
+  protected:
+    GDALRasterBand *RefUnderlyingRasterBand(bool bForceOpen) const override;
+    void UnrefUnderlyingRasterBand(
+        GDALRasterBand *poUnderlyingRasterBand) const override;
+
+    CPLErr IReadBlock(int, int, void *) override;
+    CPLErr IRasterIO(GDALRWFlag, int, int, int, int, void *, int, int,
+                     GDALDataType, GSpacing, GSpacing,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
+  private:
+    GDALThreadSafeDataset *const m_poTSDS;
+    GDALRasterBand *const m_poPrototypeBand;
+
+    // How to reach the equivalent band in another dataset instance, starting
+    // from its band nBand: -1 means GetMaskBand(), a positive or zero value
+    // means GetOverview(value).
+    const std::vector<int> m_anPath;
+
+    // Lazily created, under the prototype mutex
+    std::unique_ptr<GDALThreadSafeRasterBand> m_poMaskBand{};
+    std::vector<std::unique_ptr<GDALThreadSafeRasterBand>> m_apoOverviews{};
+
+    GDALRasterBand *GetWorkerBand(GDALDataset *poWorkerDS) const;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALThreadSafeRasterBand)
+};
+
+/************************************************************************/
+/*                        GDALThreadSafeDataset()                       */
+/************************************************************************/
+
+GDALThreadSafeDataset::GDALThreadSafeDataset(
+    std::unique_ptr<GDALDataset> poPrototypeDS, unsigned int nOpenFlagsIn,
+    CSLConstList papszAllowedDrivers, CSLConstList papszOpenOptionsIn)
+    : m_poPrototypeDS(std::move(poPrototypeDS)),
+      m_nWorkerOpenFlags((nOpenFlagsIn &
+                          ~(GDAL_OF_THREAD_SAFE | GDAL_OF_SHARED |
+                            GDAL_OF_VERBOSE_ERROR)) |
+                         GDAL_OF_INTERNAL),
+      m_aosAllowedDrivers(
+          m_poPrototypeDS->GetDriver()
+              ? CPLStringList(std::vector<std::string>{
+                    m_poPrototypeDS->GetDriver()->GetDescription()})
+              : CPLStringList(papszAllowedDrivers)),
+      m_aosOpenOptions(papszOpenOptionsIn)
+{
+    SetDescription(m_poPrototypeDS->GetDescription());
+    nRasterXSize = m_poPrototypeDS->GetRasterXSize();
+    nRasterYSize = m_poPrototypeDS->GetRasterYSize();
+    eAccess = GA_ReadOnly;
+    poDriver = m_poPrototypeDS->GetDriver();
+
+    for (int i = 1; i <= m_poPrototypeDS->GetRasterCount(); ++i)
+    {
+        SetBand(i, new GDALThreadSafeRasterBand(
+                       this, m_poPrototypeDS->GetRasterBand(i), i, {}));
+    }
+}
+
+/************************************************************************/
+/*                       ~GDALThreadSafeDataset()                       */
+/************************************************************************/
+
+GDALThreadSafeDataset::~GDALThreadSafeDataset()
+{
+    // Bands refer to the prototype dataset, so destroy them first.
+    for (int i = 0; i < nBands; ++i)
+    {
+        delete papoBands[i];
+        papoBands[i] = nullptr;
+    }
+    nBands = 0;
+
+    m_apoIdleWorkers.clear();
+    m_poPrototypeDS.reset();
+}
+
+/************************************************************************/
+/*                         RefUnderlyingDataset()                       */
+/************************************************************************/
+
+GDALDataset *GDALThreadSafeDataset::RefUnderlyingDataset() const
+{
+    m_oPrototypeMutex.lock();
+    return m_poPrototypeDS.get();
+}
+
+/************************************************************************/
+/*                        UnrefUnderlyingDataset()                      */
+/************************************************************************/
+
+void GDALThreadSafeDataset::UnrefUnderlyingDataset(GDALDataset *) const
+{
+    m_oPrototypeMutex.unlock();
+}
+
+/************************************************************************/
+/*                          OpenWorkerDataset()                         */
+/************************************************************************/
+
+std::unique_ptr<GDALDataset> GDALThreadSafeDataset::OpenWorkerDataset() const
+{
+    std::unique_ptr<GDALDataset> poWorkerDS;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        poWorkerDS.reset(GDALDataset::Open(
+            GetDescription(), m_nWorkerOpenFlags, m_aosAllowedDrivers.List(),
+            m_aosOpenOptions.List(), nullptr));
+    }
+    if (poWorkerDS && (poWorkerDS->GetRasterXSize() != nRasterXSize ||
+                       poWorkerDS->GetRasterYSize() != nRasterYSize ||
+                       poWorkerDS->GetRasterCount() != nBands))
+    {
+        poWorkerDS.reset();
+    }
+    if (!poWorkerDS)
+    {
+        CPLDebug("GDAL",
+                 "Cannot open another instance of %s. Pixel requests on its "
+                 "thread-safe dataset will be serialized",
+                 GetDescription());
+    }
+    return poWorkerDS;
+}
+
+/************************************************************************/
+/*                        AcquireWorkerDataset()                        */
+/************************************************************************/
+
+GDALDataset *GDALThreadSafeDataset::AcquireWorkerDataset()
+{
+    {
+        std::lock_guard<std::mutex> oLock(m_oPoolMutex);
+        if (!m_apoIdleWorkers.empty())
+        {
+            GDALDataset *poWorkerDS = m_apoIdleWorkers.back().release();
+            m_apoIdleWorkers.pop_back();
+            return poWorkerDS;
+        }
+        if (m_bWorkersUnavailable)
+            return nullptr;
+    }
+
+    // Open outside of the pool lock, as this can be slow.
+    auto poWorkerDS = OpenWorkerDataset();
+    if (!poWorkerDS)
+    {
+        std::lock_guard<std::mutex> oLock(m_oPoolMutex);
+        m_bWorkersUnavailable = true;
+    }
+    return poWorkerDS.release();
+}
+
+/************************************************************************/
+/*                        ReleaseWorkerDataset()                        */
+/************************************************************************/
+
+void GDALThreadSafeDataset::ReleaseWorkerDataset(GDALDataset *poWorkerDS)
+{
+    std::lock_guard<std::mutex> oLock(m_oPoolMutex);
+    m_apoIdleWorkers.emplace_back(poWorkerDS);
+}
+
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeDataset::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, BANDMAP_TYPE panBandMap, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Write operations not supported on a thread-safe dataset");
+        return CE_Failure;
+    }
+
+    GDALThreadSafeWorker oWorker(this);
+    return oWorker.get()->RasterIO(
+        eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+        eBufType, nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+        psExtraArg);
+}
+
+/************************************************************************/
+/*                      GDALThreadSafeRasterBand()                      */
+/************************************************************************/
+
+GDALThreadSafeRasterBand::GDALThreadSafeRasterBand(
+    GDALThreadSafeDataset *poTSDS, GDALRasterBand *poPrototypeBand,
+    int nBandIn, const std::vector<int> &anPath)
+    : m_poTSDS(poTSDS), m_poPrototypeBand(poPrototypeBand), m_anPath(anPath)
+{
+    poDS = poTSDS;
+    nBand = nBandIn;
+    eAccess = GA_ReadOnly;
+    eDataType = poPrototypeBand->GetRasterDataType();
+    nRasterXSize = poPrototypeBand->GetXSize();
+    nRasterYSize = poPrototypeBand->GetYSize();
+    poPrototypeBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+}
+
+/************************************************************************/
+/*                       RefUnderlyingRasterBand()                      */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::RefUnderlyingRasterBand(bool /*bForceOpen*/) const
+{
+    m_poTSDS->GetPrototypeMutex().lock();
+    return m_poPrototypeBand;
+}
+
+/************************************************************************/
+/*                      UnrefUnderlyingRasterBand()                     */
+/************************************************************************/
+
+void GDALThreadSafeRasterBand::UnrefUnderlyingRasterBand(GDALRasterBand *) const
+{
+    m_poTSDS->GetPrototypeMutex().unlock();
+}
+
+/************************************************************************/
+/*                            GetWorkerBand()                           */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetWorkerBand(GDALDataset *poWorkerDS) const
+{
+    GDALRasterBand *poBand = poWorkerDS->GetRasterBand(nBand);
+    for (const int nStep : m_anPath)
+    {
+        if (!poBand)
+            break;
+        poBand = nStep < 0 ? poBand->GetMaskBand() : poBand->GetOverview(nStep);
+    }
+    if (!poBand)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot find band equivalent to band %d in %s", nBand,
+                 poWorkerDS->GetDescription());
+    }
+    return poBand;
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
+                                            void *pImage)
+{
+    GDALThreadSafeWorker oWorker(m_poTSDS);
+    GDALRasterBand *poBand = GetWorkerBand(oWorker.get());
+    if (!poBand)
+        return CE_Failure;
+    return poBand->ReadBlock(nBlockXOff, nBlockYOff, pImage);
+}
+
+/************************************************************************/
+/*                              IRasterIO()                             */
+/************************************************************************/
+
+CPLErr GDALThreadSafeRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (eRWFlag != GF_Read)
+    {
+        ReportError(CE_Failure, CPLE_NotSupported,
+                    "Write operations not supported on a thread-safe dataset");
+        return CE_Failure;
+    }
+
+    GDALThreadSafeWorker oWorker(m_poTSDS);
+    GDALRasterBand *poBand = GetWorkerBand(oWorker.get());
+    if (!poBand)
+        return CE_Failure;
+    return poBand->RasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                            nBufXSize, nBufYSize, eBufType, nPixelSpace,
+                            nLineSpace, psExtraArg);
+}
+
+/************************************************************************/
+/*                             GetMaskBand()                            */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetMaskBand()
+{
+    std::lock_guard<std::recursive_mutex> oLock(m_poTSDS->GetPrototypeMutex());
+    if (!m_poMaskBand)
+    {
+        GDALRasterBand *poPrototypeMaskBand = m_poPrototypeBand->GetMaskBand();
+        if (!poPrototypeMaskBand)
+            return nullptr;
+        auto anPath = m_anPath;
+        anPath.push_back(-1);
+        m_poMaskBand = std::make_unique<GDALThreadSafeRasterBand>(
+            m_poTSDS, poPrototypeMaskBand, nBand, anPath);
+    }
+    return m_poMaskBand.get();
+}
+
+/************************************************************************/
+/*                             GetOverview()                            */
+/************************************************************************/
+
+GDALRasterBand *GDALThreadSafeRasterBand::GetOverview(int iOvr)
+{
+    std::lock_guard<std::recursive_mutex> oLock(m_poTSDS->GetPrototypeMutex());
+    if (iOvr < 0 || iOvr >= m_poPrototypeBand->GetOverviewCount())
+        return nullptr;
+    if (static_cast<size_t>(iOvr) >= m_apoOverviews.size())
+        m_apoOverviews.resize(iOvr + 1);
+    if (!m_apoOverviews[iOvr])
+    {
+        GDALRasterBand *poPrototypeOvrBand =
+            m_poPrototypeBand->GetOverview(iOvr);
+        if (!poPrototypeOvrBand)
+            return nullptr;
+        auto anPath = m_anPath;
+        anPath.push_back(iOvr);
+        m_apoOverviews[iOvr] = std::make_unique<GDALThreadSafeRasterBand>(
+            m_poTSDS, poPrototypeOvrBand, nBand, anPath);
+    }
+    return m_apoOverviews[iOvr].get();
+}
+
+/************************************************************************/
+/*                       GetRasterSampleOverview()                      */
+/************************************************************************/
+
+GDALRasterBand *
+GDALThreadSafeRasterBand::GetRasterSampleOverview(GUIntBig nDesiredSamples)
+{
+    // Use the generic implementation, so that it goes through GetOverview()
+    // and returns a thread-safe band.
+    return GDALRasterBand::GetRasterSampleOverview(nDesiredSamples);
+}
+
+/************************************************************************/
+/*                     GDALCreateThreadSafeDataset()                    */
+/************************************************************************/
+
+/** Wrap a dataset opened in read-only mode into a dataset that can be used
+ * concurrently from several threads for read operations.
+ *
+ * Used by GDALOpenEx() when GDAL_OF_THREAD_SAFE is specified.
+ *
+ * @param poDS Dataset to wrap. Ownership is transferred to the returned
+ *             dataset.
+ * @param nOpenFlags Open flags that were used to open poDS.
+ * @param papszAllowedDrivers Allowed drivers that were used to open poDS.
+ * @param papszOpenOptions Open options that were used to open poDS.
+ * @return a new dataset, or nullptr in case of error.
+ */
+GDALDataset *GDALCreateThreadSafeDataset(std::unique_ptr<GDALDataset> poDS,
+                                         unsigned int nOpenFlags,
+                                         CSLConstList papszAllowedDrivers,
+                                         CSLConstList papszOpenOptions)
+{
+    if (poDS->GetAccess() != GA_ReadOnly)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Only read-only datasets can be made thread-safe");
+        return nullptr;
+    }
+    if (poDS->GetLayerCount() != 0)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Thread-safe mode is not supported on vector datasets");
+        return nullptr;
+    }
+    return new GDALThreadSafeDataset(std::move(poDS), nOpenFlags,
+                                     papszAllowedDrivers, papszOpenOptions);
+}
+
+//! @endcond
@@ -4933,12 +4933,21 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  * It does not support color tables or complex data types.
  *
  * The pseudo-algorithm used by the function is :
- *    for each overview
- *       iterate on lines of the source by a step of deltay
+ *    while there are overview lines to compute
+ *       pick the smallest overview whose next strip of lines only depends
+ *       on already computed lines of its source (the previous overview or the
+ *       full resolution bands)
  *           iterate on columns of the source  by a step of deltax
  *               read the source data of size deltax * deltay for all the bands
  *               generate the corresponding overview block for all the bands
  *
+ * Consequently, overview level N+1 is computed from the lines of level N as
+ * soon as they are available, while they are still in the block cache,
+ * instead of after a full pass on level N. This is not done when the
+ * overviews use a lossy compression method (JPEG, WEBP, JXL, LERC): each
+ * level is then computed and flushed before the next one, so that the result
+ * does not depend on the block cache size.
+ *
  * This function will honour properly NODATA_VALUES tuples (special dataset
  * metadata) so that only a given RGB triplet (in case of a RGB image) will be
  * considered as the nodata value and not each value of the triplet
@@ -5119,13 +5128,125 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     const int nChunkMaxSize =
         atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760"));
 
-    // Second pass to do the real job.
-    double dfCurPixelCount = 0;
-    CPLErr eErr = CE_None;
-    for (int iOverview = 0; iOverview < nOverviews && eErr == CE_None;
-         ++iOverview)
+    // Structure describing a resampling job
+    struct OvrJob
+    {
+        // Buffers to free when job is finished
+        std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
+        std::unique_ptr<PointerHolder> oSrcBufferHolder{};
+        std::unique_ptr<PointerHolder> oDstBufferHolder{};
+
+        GDALRasterBand *poDstBand = nullptr;
+        int iOverview = 0;
+
+        // Input parameters of pfnResampleFn
+        GDALResampleFunction pfnResampleFn = nullptr;
+        GDALOverviewResampleArgs args{};
+        const void *pChunk = nullptr;
+
+        // Output values of resampling function
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+
+        // Synchronization
+        bool bFinished = false;
+        std::mutex mutex{};
+        std::condition_variable cv{};
+    };
+
+    // Thread function to resample
+    const auto JobResampleFunc = [](void *pData)
+    {
+        OvrJob *poJob = static_cast<OvrJob *>(pData);
+
+        poJob->eErr = poJob->pfnResampleFn(poJob->args, poJob->pChunk,
+                                           &(poJob->pDstBuffer),
+                                           &(poJob->eDstBufferDataType));
+
+        poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
+
+        {
+            std::lock_guard<std::mutex> guard(poJob->mutex);
+            poJob->bFinished = true;
+            poJob->cv.notify_one();
+        }
+    };
+
+    // Function to write resample data to target band
+    const auto WriteJobData = [](const OvrJob *poJob)
+    {
+        return poJob->poDstBand->RasterIO(
+            GF_Write, poJob->args.nDstXOff, poJob->args.nDstYOff,
+            poJob->args.nDstXOff2 - poJob->args.nDstXOff,
+            poJob->args.nDstYOff2 - poJob->args.nDstYOff, poJob->pDstBuffer,
+            poJob->args.nDstXOff2 - poJob->args.nDstXOff,
+            poJob->args.nDstYOff2 - poJob->args.nDstYOff,
+            poJob->eDstBufferDataType, 0, 0, nullptr);
+    };
+
+    // Wait for completion of oldest job and serialize it
+    const auto WaitAndFinalizeOldestJob =
+        [WriteJobData](std::list<std::unique_ptr<OvrJob>> &jobList)
+    {
+        auto poOldestJob = jobList.front().get();
+        {
+            std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
+            // coverity[missing_lock:FALSE]
+            while (!poOldestJob->bFinished)
+            {
+                poOldestJob->cv.wait(oGuard);
+            }
+        }
+        CPLErr l_eErr = poOldestJob->eErr;
+        if (l_eErr == CE_None)
+        {
+            l_eErr = WriteJobData(poOldestJob);
+        }
+
+        jobList.pop_front();
+        return l_eErr;
+    };
+
+    // Queue of jobs, shared by all overview levels
+    std::list<std::unique_ptr<OvrJob>> jobList;
+
+    // State of the computation of an overview level
+    struct OvrLevel
     {
         int iSrcOverview = -1;  // -1 means the source bands.
+        int nSrcWidth = 0;
+        int nSrcHeight = 0;
+        int nDstTotalWidth = 0;
+        int nDstTotalHeight = 0;
+        int nDstXOffStart = 0;
+        int nDstXOffEnd = 0;
+        int nDstYOffStart = 0;
+        int nDstYOffEnd = 0;
+        int nDstChunkXSize = 0;
+        int nDstChunkYSize = 0;
+        double dfXRatioDstToSrc = 0;
+        double dfYRatioDstToSrc = 0;
+        int nOvrFactor = 1;
+        int nFullResXChunk = 0;
+        int nFullResXChunkQueried = 0;
+        int nFullResYChunk = 0;
+        int nFullResYChunkQueried = 0;
+
+        // Top line of the next strip to compute
+        int nDstYOff = 0;
+
+        std::vector<void *> apaChunk{};
+        std::vector<GByte *> apabyChunkNoDataMask{};
+
+        // Whether the level has been computed and flushed.
+        bool bFlushed = false;
+    };
+
+    std::vector<OvrLevel> aoLevels(nOverviews);
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        OvrLevel &oLevel = aoLevels[iOverview];
 
         int nDstChunkXSize = 0;
         int nDstChunkYSize = 0;
@@ -5169,7 +5290,7 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         {
             nSrcWidth = papapoOverviewBands[0][iOverview - 1]->GetXSize();
             nSrcHeight = papapoOverviewBands[0][iOverview - 1]->GetYSize();
-            iSrcOverview = iOverview - 1;
+            oLevel.iSrcOverview = iOverview - 1;
         }
 
         const double dfXRatioDstToSrc =
@@ -5214,330 +5335,415 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         const int nFullResXChunkQueried =
             nFullResXChunk + 2 * nKernelRadius * nOvrFactor;
 
-        // Structure describing a resampling job
-        struct OvrJob
-        {
-            // Buffers to free when job is finished
-            std::unique_ptr<PointerHolder> oSrcMaskBufferHolder{};
-            std::unique_ptr<PointerHolder> oSrcBufferHolder{};
-            std::unique_ptr<PointerHolder> oDstBufferHolder{};
-
-            GDALRasterBand *poDstBand = nullptr;
-
-            // Input parameters of pfnResampleFn
-            GDALResampleFunction pfnResampleFn = nullptr;
-            GDALOverviewResampleArgs args{};
-            const void *pChunk = nullptr;
-
-            // Output values of resampling function
-            CPLErr eErr = CE_Failure;
-            void *pDstBuffer = nullptr;
-            GDALDataType eDstBufferDataType = GDT_Unknown;
-
-            // Synchronization
-            bool bFinished = false;
-            std::mutex mutex{};
-            std::condition_variable cv{};
-        };
-
-        // Thread function to resample
-        const auto JobResampleFunc = [](void *pData)
-        {
-            OvrJob *poJob = static_cast<OvrJob *>(pData);
-
-            poJob->eErr = poJob->pfnResampleFn(poJob->args, poJob->pChunk,
-                                               &(poJob->pDstBuffer),
-                                               &(poJob->eDstBufferDataType));
-
-            poJob->oDstBufferHolder.reset(new PointerHolder(poJob->pDstBuffer));
+        oLevel.nSrcWidth = nSrcWidth;
+        oLevel.nSrcHeight = nSrcHeight;
+        oLevel.nDstTotalWidth = nDstTotalWidth;
+        oLevel.nDstTotalHeight = nDstTotalHeight;
+        oLevel.nDstXOffStart = nDstXOffStart;
+        oLevel.nDstXOffEnd = nDstXOffEnd;
+        oLevel.nDstYOffStart = nDstYOffStart;
+        oLevel.nDstYOffEnd = nDstYOffEnd;
+        oLevel.nDstChunkXSize = nDstChunkXSize;
+        oLevel.nDstChunkYSize = nDstChunkYSize;
+        oLevel.dfXRatioDstToSrc = dfXRatioDstToSrc;
+        oLevel.dfYRatioDstToSrc = dfYRatioDstToSrc;
+        oLevel.nOvrFactor = nOvrFactor;
+        oLevel.nFullResXChunk = nFullResXChunk;
+        oLevel.nFullResXChunkQueried = nFullResXChunkQueried;
+        oLevel.nFullResYChunk = nFullResYChunk;
+        oLevel.nFullResYChunkQueried = nFullResYChunkQueried;
+        oLevel.nDstYOff = nDstYOffStart;
+        oLevel.apaChunk.resize(nBands);
+        oLevel.apabyChunkNoDataMask.resize(nBands);
+    }
 
+    // Levels are only interleaved if the overviews are losslessly
+    // compressed. Otherwise, lines of level N could be read back either
+    // from the block cache or after having been through the lossy codec,
+    // depending on the cache size, and the result would not be
+    // deterministic. With a lossy codec, each level is thus entirely
+    // computed and flushed before being used as the source of the next one.
+    bool bInterleaveLevels = true;
+    for (int iOverview = 0; iOverview < nOverviews && bInterleaveLevels;
+         ++iOverview)
+    {
+        GDALRasterBand *poOvrBand = papapoOverviewBands[0][iOverview];
+        GDALDataset *poOvrDS = poOvrBand->GetDataset();
+        for (GDALMajorObject *poObj :
+             {static_cast<GDALMajorObject *>(poOvrBand),
+              static_cast<GDALMajorObject *>(poOvrDS)})
+        {
+            if (!poObj)
+                continue;
+            const char *pszCompression =
+                poObj->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE");
+            const char *pszReversibility = poObj->GetMetadataItem(
+                "COMPRESSION_REVERSIBILITY", "IMAGE_STRUCTURE");
+            if ((pszReversibility &&
+                 STARTS_WITH_CI(pszReversibility, "LOSSY")) ||
+                (pszCompression && (strstr(pszCompression, "JPEG") ||
+                                    STARTS_WITH_CI(pszCompression, "WEBP") ||
+                                    STARTS_WITH_CI(pszCompression, "JXL") ||
+                                    STARTS_WITH_CI(pszCompression, "LERC"))))
             {
-                std::lock_guard<std::mutex> guard(poJob->mutex);
-                poJob->bFinished = true;
-                poJob->cv.notify_one();
+                bInterleaveLevels = false;
             }
-        };
+        }
+    }
 
-        // Function to write resample data to target band
-        const auto WriteJobData = [](const OvrJob *poJob)
+    // Compute the source window (in the source level) of the strip of
+    // the overview level starting at line nDstYOff.
+    const auto GetSrcYWindow =
+        [nKernelRadius](const OvrLevel &oLevel, int nDstYOff,
+                        int &nChunkYOff, int &nYCount, int &nChunkYOffQueried,
+                        int &nChunkYSizeQueried)
+    {
+        const int nDstYCount =
+            std::min(oLevel.nDstChunkYSize, oLevel.nDstYOffEnd - nDstYOff);
+
+        nChunkYOff = static_cast<int>(nDstYOff * oLevel.dfYRatioDstToSrc);
+        int nChunkYOff2 = static_cast<int>(
+            ceil((nDstYOff + nDstYCount) * oLevel.dfYRatioDstToSrc));
+        if (nChunkYOff2 > oLevel.nSrcHeight ||
+            nDstYOff + nDstYCount == oLevel.nDstTotalHeight)
+            nChunkYOff2 = oLevel.nSrcHeight;
+        nYCount = nChunkYOff2 - nChunkYOff;
+
+        nChunkYOffQueried = nChunkYOff - nKernelRadius * oLevel.nOvrFactor;
+        nChunkYSizeQueried = nYCount + 2 * nKernelRadius * oLevel.nOvrFactor;
+        if (nChunkYOffQueried < 0)
         {
-            return poJob->poDstBand->RasterIO(
-                GF_Write, poJob->args.nDstXOff, poJob->args.nDstYOff,
-                poJob->args.nDstXOff2 - poJob->args.nDstXOff,
-                poJob->args.nDstYOff2 - poJob->args.nDstYOff, poJob->pDstBuffer,
-                poJob->args.nDstXOff2 - poJob->args.nDstXOff,
-                poJob->args.nDstYOff2 - poJob->args.nDstYOff,
-                poJob->eDstBufferDataType, 0, 0, nullptr);
-        };
-
-        // Wait for completion of oldest job and serialize it
-        const auto WaitAndFinalizeOldestJob =
-            [WriteJobData](std::list<std::unique_ptr<OvrJob>> &jobList)
+            nChunkYSizeQueried += nChunkYOffQueried;
+            nChunkYOffQueried = 0;
+        }
+        if (nChunkYSizeQueried + nChunkYOffQueried > oLevel.nSrcHeight)
+            nChunkYSizeQueried = oLevel.nSrcHeight - nChunkYOffQueried;
+    };
+
+    // Return the first line of an overview level that has not been
+    // written yet to the overview bands.
+    const auto GetFirstUnwrittenLine = [&aoLevels, &jobList](int iOverview)
+    {
+        // Jobs are queued in order, so the first one of the level is the
+        // one with the smallest nDstYOff.
+        for (const auto &poJob : jobList)
         {
-            auto poOldestJob = jobList.front().get();
+            if (poJob->iOverview == iOverview)
+                return poJob->args.nDstYOff;
+        }
+        return aoLevels[iOverview].nDstYOff;
+    };
+
+    // Whether the next strip of an overview level can be computed, that is
+    // if all the lines it needs from its source level have been written.
+    const auto IsLevelReady = [&aoLevels, &GetSrcYWindow,
+                               &GetFirstUnwrittenLine,
+                               bInterleaveLevels](int iOverview)
+    {
+        const OvrLevel &oLevel = aoLevels[iOverview];
+        if (oLevel.nDstYOff >= oLevel.nDstYOffEnd)
+            return false;
+        if (oLevel.iSrcOverview < 0)
+            return true;
+        if (!bInterleaveLevels)
+            return aoLevels[oLevel.iSrcOverview].bFlushed;
+        int nChunkYOff = 0;
+        int nYCount = 0;
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+        GetSrcYWindow(oLevel, oLevel.nDstYOff, nChunkYOff, nYCount,
+                      nChunkYOffQueried, nChunkYSizeQueried);
+        const OvrLevel &oSrcLevel = aoLevels[oLevel.iSrcOverview];
+        return std::min(nChunkYOffQueried + nChunkYSizeQueried,
+                        oSrcLevel.nDstYOffEnd) <=
+               GetFirstUnwrittenLine(oLevel.iSrcOverview);
+    };
+
+    // Second pass to do the real job.
+    // Instead of computing each overview level in a full pass over its
+    // source level, overview levels are computed in an interleaved way,
+    // strip by strip: a strip of level N+1 is computed as soon as the
+    // strips of level N it depends on have been written, so that they are
+    // read back while still in the block cache. With GDAL_NUM_THREADS,
+    // reading, resampling of all levels and writing are thus pipelined.
+    double dfCurPixelCount = 0;
+    CPLErr eErr = CE_None;
+    while (eErr == CE_None)
+    {
+        if (!bInterleaveLevels)
+        {
+            // Flush the levels that are entirely written, so that the next
+            // level reads them back through the codec.
+            for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
             {
-                std::unique_lock<std::mutex> oGuard(poOldestJob->mutex);
-                // coverity[missing_lock:FALSE]
-                while (!poOldestJob->bFinished)
+                OvrLevel &oLevel = aoLevels[iOverview];
+                if (!oLevel.bFlushed && oLevel.nDstYOff >= oLevel.nDstYOffEnd &&
+                    GetFirstUnwrittenLine(iOverview) >= oLevel.nDstYOffEnd)
                 {
-                    poOldestJob->cv.wait(oGuard);
+                    for (int iBand = 0; iBand < nBands; ++iBand)
+                    {
+                        papapoOverviewBands[iBand][iOverview]->FlushCache(
+                            false);
+                    }
+                    oLevel.bFlushed = true;
                 }
             }
-            CPLErr l_eErr = poOldestJob->eErr;
-            if (l_eErr == CE_None)
-            {
-                l_eErr = WriteJobData(poOldestJob);
-            }
-
-            jobList.pop_front();
-            return l_eErr;
-        };
+        }
 
-        // Queue of jobs
-        std::list<std::unique_ptr<OvrJob>> jobList;
+        // Favor the deepest level that can be computed, to release as soon
+        // as possible the strips of the upper levels.
+        int iOverview = nOverviews - 1;
+        while (iOverview >= 0 && !IsLevelReady(iOverview))
+            --iOverview;
+        if (iOverview < 0)
+        {
+            // Nothing can be done until pending jobs have been written.
+            // If there is none, all levels have been computed.
+            if (jobList.empty())
+                break;
+            eErr = WaitAndFinalizeOldestJob(jobList);
+            continue;
+        }
 
-        std::vector<void *> apaChunk(nBands);
-        std::vector<GByte *> apabyChunkNoDataMask(nBands);
+        OvrLevel &oLevel = aoLevels[iOverview];
+        const int iSrcOverview = oLevel.iSrcOverview;
+        const int nSrcWidth = oLevel.nSrcWidth;
+        const int nDstTotalWidth = oLevel.nDstTotalWidth;
+        const int nDstXOffStart = oLevel.nDstXOffStart;
+        const int nDstXOffEnd = oLevel.nDstXOffEnd;
+        const int nDstChunkXSize = oLevel.nDstChunkXSize;
+        const double dfXRatioDstToSrc = oLevel.dfXRatioDstToSrc;
+        const double dfYRatioDstToSrc = oLevel.dfYRatioDstToSrc;
+        const int nOvrFactor = oLevel.nOvrFactor;
+        const int nFullResXChunkQueried = oLevel.nFullResXChunkQueried;
+        const int nFullResYChunkQueried = oLevel.nFullResYChunkQueried;
+        auto &apaChunk = oLevel.apaChunk;
+        auto &apabyChunkNoDataMask = oLevel.apabyChunkNoDataMask;
+
+        const int nDstYOff = oLevel.nDstYOff;
+        const int nDstYCount =
+            std::min(oLevel.nDstChunkYSize, oLevel.nDstYOffEnd - nDstYOff);
+        oLevel.nDstYOff += nDstYCount;
+
+        int nChunkYOff = 0;
+        int nYCount = 0;
+        int nChunkYOffQueried = 0;
+        int nChunkYSizeQueried = 0;
+        GetSrcYWindow(oLevel, nDstYOff, nChunkYOff, nYCount, nChunkYOffQueried,
+                      nChunkYSizeQueried);
+        CPL_IGNORE_RET_VAL(nChunkYOff);
+        CPLAssert(nYCount <= oLevel.nFullResYChunk);
+        CPL_IGNORE_RET_VAL(nYCount);
+        CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
+
+        if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
 
         // Iterate on destination overview, block by block.
-        for (int nDstYOff = nDstYOffStart;
-             nDstYOff < nDstYOffEnd && eErr == CE_None;
-             nDstYOff += nDstChunkYSize)
+        for (int nDstXOff = nDstXOffStart;
+             nDstXOff < nDstXOffEnd && eErr == CE_None;
+             nDstXOff += nDstChunkXSize)
         {
-            int nDstYCount;
-            if (nDstYOff + nDstChunkYSize <= nDstYOffEnd)
-                nDstYCount = nDstChunkYSize;
+            int nDstXCount = 0;
+            if (nDstXOff + nDstChunkXSize <= nDstXOffEnd)
+                nDstXCount = nDstChunkXSize;
             else
-                nDstYCount = nDstYOffEnd - nDstYOff;
-
-            int nChunkYOff = static_cast<int>(nDstYOff * dfYRatioDstToSrc);
-            int nChunkYOff2 = static_cast<int>(
-                ceil((nDstYOff + nDstYCount) * dfYRatioDstToSrc));
-            if (nChunkYOff2 > nSrcHeight ||
-                nDstYOff + nDstYCount == nDstTotalHeight)
-                nChunkYOff2 = nSrcHeight;
-            int nYCount = nChunkYOff2 - nChunkYOff;
-            CPLAssert(nYCount <= nFullResYChunk);
-
-            int nChunkYOffQueried = nChunkYOff - nKernelRadius * nOvrFactor;
-            int nChunkYSizeQueried = nYCount + 2 * nKernelRadius * nOvrFactor;
-            if (nChunkYOffQueried < 0)
+                nDstXCount = nDstXOffEnd - nDstXOff;
+
+            dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
+
+            int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
+            int nChunkXOff2 = static_cast<int>(
+                ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
+            if (nChunkXOff2 > nSrcWidth ||
+                nDstXOff + nDstXCount == nDstTotalWidth)
+                nChunkXOff2 = nSrcWidth;
+            const int nXCount = nChunkXOff2 - nChunkXOff;
+            CPLAssert(nXCount <= oLevel.nFullResXChunk);
+
+            int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
+            int nChunkXSizeQueried = nXCount + 2 * nKernelRadius * nOvrFactor;
+            if (nChunkXOffQueried < 0)
             {
-                nChunkYSizeQueried += nChunkYOffQueried;
-                nChunkYOffQueried = 0;
+                nChunkXSizeQueried += nChunkXOffQueried;
+                nChunkXOffQueried = 0;
             }
-            if (nChunkYSizeQueried + nChunkYOffQueried > nSrcHeight)
-                nChunkYSizeQueried = nSrcHeight - nChunkYOffQueried;
-            CPLAssert(nChunkYSizeQueried <= nFullResYChunkQueried);
-
-            if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
-                             pProgressData))
-            {
-                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                eErr = CE_Failure;
-            }
-
-            // Iterate on destination overview, block by block.
-            for (int nDstXOff = nDstXOffStart;
-                 nDstXOff < nDstXOffEnd && eErr == CE_None;
-                 nDstXOff += nDstChunkXSize)
-            {
-                int nDstXCount = 0;
-                if (nDstXOff + nDstChunkXSize <= nDstXOffEnd)
-                    nDstXCount = nDstChunkXSize;
-                else
-                    nDstXCount = nDstXOffEnd - nDstXOff;
-
-                dfCurPixelCount += static_cast<double>(nDstXCount) * nDstYCount;
-
-                int nChunkXOff = static_cast<int>(nDstXOff * dfXRatioDstToSrc);
-                int nChunkXOff2 = static_cast<int>(
-                    ceil((nDstXOff + nDstXCount) * dfXRatioDstToSrc));
-                if (nChunkXOff2 > nSrcWidth ||
-                    nDstXOff + nDstXCount == nDstTotalWidth)
-                    nChunkXOff2 = nSrcWidth;
-                const int nXCount = nChunkXOff2 - nChunkXOff;
-                CPLAssert(nXCount <= nFullResXChunk);
-
-                int nChunkXOffQueried = nChunkXOff - nKernelRadius * nOvrFactor;
-                int nChunkXSizeQueried =
-                    nXCount + 2 * nKernelRadius * nOvrFactor;
-                if (nChunkXOffQueried < 0)
-                {
-                    nChunkXSizeQueried += nChunkXOffQueried;
-                    nChunkXOffQueried = 0;
-                }
-                if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
-                    nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
-                CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
+            if (nChunkXSizeQueried + nChunkXOffQueried > nSrcWidth)
+                nChunkXSizeQueried = nSrcWidth - nChunkXOffQueried;
+            CPLAssert(nChunkXSizeQueried <= nFullResXChunkQueried);
 #if DEBUG_VERBOSE
-                CPLDebug("GDAL",
-                         "Reading (%dx%d -> %dx%d) for output (%dx%d -> %dx%d)",
-                         nChunkXOffQueried, nChunkYOffQueried,
-                         nChunkXSizeQueried, nChunkYSizeQueried, nDstXOff,
-                         nDstYOff, nDstXCount, nDstYCount);
+            CPLDebug("GDAL",
+                     "Overview %d: reading (%dx%d -> %dx%d) for output "
+                     "(%dx%d -> %dx%d)",
+                     iOverview, nChunkXOffQueried, nChunkYOffQueried,
+                     nChunkXSizeQueried, nChunkYSizeQueried, nDstXOff,
+                     nDstYOff, nDstXCount, nDstYCount);
 #endif
 
-                // Avoid accumulating too many tasks and exhaust RAM
+            // Avoid accumulating too many tasks and exhaust RAM
 
-                // Try to complete already finished jobs
-                while (eErr == CE_None && !jobList.empty())
+            // Try to complete already finished jobs
+            while (eErr == CE_None && !jobList.empty())
+            {
+                auto poOldestJob = jobList.front().get();
                 {
-                    auto poOldestJob = jobList.front().get();
+                    std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
+                    if (!poOldestJob->bFinished)
                     {
-                        std::lock_guard<std::mutex> oGuard(poOldestJob->mutex);
-                        if (!poOldestJob->bFinished)
-                        {
-                            break;
-                        }
+                        break;
                     }
-                    eErr = poOldestJob->eErr;
-                    if (eErr == CE_None)
-                    {
-                        eErr = WriteJobData(poOldestJob);
-                    }
-
-                    jobList.pop_front();
                 }
-
-                // And in case we have saturated the number of threads,
-                // wait for completion of tasks to go below the threshold.
-                while (eErr == CE_None &&
-                       jobList.size() >= static_cast<size_t>(nThreads))
+                eErr = poOldestJob->eErr;
+                if (eErr == CE_None)
                 {
-                    eErr = WaitAndFinalizeOldestJob(jobList);
+                    eErr = WriteJobData(poOldestJob);
                 }
 
-                // (Re)allocate buffers if needed
-                for (int iBand = 0; iBand < nBands; ++iBand)
+                jobList.pop_front();
+            }
+
+            // And in case we have saturated the number of threads,
+            // wait for completion of tasks to go below the threshold.
+            while (eErr == CE_None &&
+                   jobList.size() >= static_cast<size_t>(nThreads))
+            {
+                eErr = WaitAndFinalizeOldestJob(jobList);
+            }
+
+            // (Re)allocate buffers if needed
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                if (apaChunk[iBand] == nullptr)
                 {
+                    apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
+                        nFullResXChunkQueried, nFullResYChunkQueried,
+                        GDALGetDataTypeSizeBytes(eWrkDataType));
                     if (apaChunk[iBand] == nullptr)
                     {
-                        apaChunk[iBand] = VSI_MALLOC3_VERBOSE(
-                            nFullResXChunkQueried, nFullResYChunkQueried,
-                            GDALGetDataTypeSizeBytes(eWrkDataType));
-                        if (apaChunk[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        eErr = CE_Failure;
                     }
-                    if (bUseNoDataMask &&
-                        apabyChunkNoDataMask[iBand] == nullptr)
+                }
+                if (bUseNoDataMask && apabyChunkNoDataMask[iBand] == nullptr)
+                {
+                    apabyChunkNoDataMask[iBand] =
+                        static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                            nFullResXChunkQueried, nFullResYChunkQueried));
+                    if (apabyChunkNoDataMask[iBand] == nullptr)
                     {
-                        apabyChunkNoDataMask[iBand] =
-                            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                                nFullResXChunkQueried, nFullResYChunkQueried));
-                        if (apabyChunkNoDataMask[iBand] == nullptr)
-                        {
-                            eErr = CE_Failure;
-                        }
+                        eErr = CE_Failure;
                     }
                 }
+            }
 
-                // Read the source buffers for all the bands.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            // Read the source buffers for all the bands.
+            for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            {
+                GDALRasterBand *poSrcBand = nullptr;
+                if (iSrcOverview == -1)
+                    poSrcBand = papoSrcBands[iBand];
+                else
+                    poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
+                eErr = poSrcBand->RasterIO(
+                    GF_Read, nChunkXOffQueried, nChunkYOffQueried,
+                    nChunkXSizeQueried, nChunkYSizeQueried, apaChunk[iBand],
+                    nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType, 0, 0,
+                    nullptr);
+
+                if (bUseNoDataMask && eErr == CE_None)
                 {
-                    GDALRasterBand *poSrcBand = nullptr;
-                    if (iSrcOverview == -1)
-                        poSrcBand = papoSrcBands[iBand];
-                    else
-                        poSrcBand = papapoOverviewBands[iBand][iSrcOverview];
-                    eErr = poSrcBand->RasterIO(
+                    auto poMaskBand = poSrcBand->IsMaskBand()
+                                          ? poSrcBand
+                                          : poSrcBand->GetMaskBand();
+                    eErr = poMaskBand->RasterIO(
                         GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                        nChunkXSizeQueried, nChunkYSizeQueried, apaChunk[iBand],
-                        nChunkXSizeQueried, nChunkYSizeQueried, eWrkDataType, 0,
-                        0, nullptr);
-
-                    if (bUseNoDataMask && eErr == CE_None)
-                    {
-                        auto poMaskBand = poSrcBand->IsMaskBand()
-                                              ? poSrcBand
-                                              : poSrcBand->GetMaskBand();
-                        eErr = poMaskBand->RasterIO(
-                            GF_Read, nChunkXOffQueried, nChunkYOffQueried,
-                            nChunkXSizeQueried, nChunkYSizeQueried,
-                            apabyChunkNoDataMask[iBand], nChunkXSizeQueried,
-                            nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
-                    }
+                        nChunkXSizeQueried, nChunkYSizeQueried,
+                        apabyChunkNoDataMask[iBand], nChunkXSizeQueried,
+                        nChunkYSizeQueried, GDT_Byte, 0, 0, nullptr);
                 }
+            }
 
-                // Compute the resulting overview block.
-                for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            // Compute the resulting overview block.
+            for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+            {
+                auto poJob = std::make_unique<OvrJob>();
+                poJob->pfnResampleFn = pfnResampleFn;
+                poJob->poDstBand = papapoOverviewBands[iBand][iOverview];
+                poJob->iOverview = iOverview;
+                poJob->args.eOvrDataType =
+                    poJob->poDstBand->GetRasterDataType();
+                poJob->args.nOvrXSize = poJob->poDstBand->GetXSize();
+                poJob->args.nOvrYSize = poJob->poDstBand->GetYSize();
+                const char *pszNBITS = poJob->poDstBand->GetMetadataItem(
+                    "NBITS", "IMAGE_STRUCTURE");
+                poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
+                poJob->args.dfXRatioDstToSrc = dfXRatioDstToSrc;
+                poJob->args.dfYRatioDstToSrc = dfYRatioDstToSrc;
+                poJob->args.eWrkDataType = eWrkDataType;
+                poJob->pChunk = apaChunk[iBand];
+                poJob->args.pabyChunkNodataMask = apabyChunkNoDataMask[iBand];
+                poJob->args.nChunkXOff = nChunkXOffQueried;
+                poJob->args.nChunkXSize = nChunkXSizeQueried;
+                poJob->args.nChunkYOff = nChunkYOffQueried;
+                poJob->args.nChunkYSize = nChunkYSizeQueried;
+                poJob->args.nDstXOff = nDstXOff;
+                poJob->args.nDstXOff2 = nDstXOff + nDstXCount;
+                poJob->args.nDstYOff = nDstYOff;
+                poJob->args.nDstYOff2 = nDstYOff + nDstYCount;
+                poJob->args.pszResampling = pszResampling;
+                poJob->args.bHasNoData = pabHasNoData[iBand];
+                poJob->args.dfNoDataValue = padfNoDataValue[iBand];
+                poJob->args.eSrcDataType = eDataType;
+                poJob->args.bPropagateNoData = bPropagateNoData;
+
+                if (poJobQueue)
                 {
-                    auto poJob = std::make_unique<OvrJob>();
-                    poJob->pfnResampleFn = pfnResampleFn;
-                    poJob->poDstBand = papapoOverviewBands[iBand][iOverview];
-                    poJob->args.eOvrDataType =
-                        poJob->poDstBand->GetRasterDataType();
-                    poJob->args.nOvrXSize = poJob->poDstBand->GetXSize();
-                    poJob->args.nOvrYSize = poJob->poDstBand->GetYSize();
-                    const char *pszNBITS = poJob->poDstBand->GetMetadataItem(
-                        "NBITS", "IMAGE_STRUCTURE");
-                    poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
-                    poJob->args.dfXRatioDstToSrc = dfXRatioDstToSrc;
-                    poJob->args.dfYRatioDstToSrc = dfYRatioDstToSrc;
-                    poJob->args.eWrkDataType = eWrkDataType;
-                    poJob->pChunk = apaChunk[iBand];
-                    poJob->args.pabyChunkNodataMask =
-                        apabyChunkNoDataMask[iBand];
-                    poJob->args.nChunkXOff = nChunkXOffQueried;
-                    poJob->args.nChunkXSize = nChunkXSizeQueried;
-                    poJob->args.nChunkYOff = nChunkYOffQueried;
-                    poJob->args.nChunkYSize = nChunkYSizeQueried;
-                    poJob->args.nDstXOff = nDstXOff;
-                    poJob->args.nDstXOff2 = nDstXOff + nDstXCount;
-                    poJob->args.nDstYOff = nDstYOff;
-                    poJob->args.nDstYOff2 = nDstYOff + nDstYCount;
-                    poJob->args.pszResampling = pszResampling;
-                    poJob->args.bHasNoData = pabHasNoData[iBand];
-                    poJob->args.dfNoDataValue = padfNoDataValue[iBand];
-                    poJob->args.eSrcDataType = eDataType;
-                    poJob->args.bPropagateNoData = bPropagateNoData;
-
-                    if (poJobQueue)
-                    {
-                        poJob->oSrcMaskBufferHolder.reset(
-                            new PointerHolder(apabyChunkNoDataMask[iBand]));
-                        apabyChunkNoDataMask[iBand] = nullptr;
+                    poJob->oSrcMaskBufferHolder.reset(
+                        new PointerHolder(apabyChunkNoDataMask[iBand]));
+                    apabyChunkNoDataMask[iBand] = nullptr;
 
-                        poJob->oSrcBufferHolder.reset(
-                            new PointerHolder(apaChunk[iBand]));
-                        apaChunk[iBand] = nullptr;
+                    poJob->oSrcBufferHolder.reset(
+                        new PointerHolder(apaChunk[iBand]));
+                    apaChunk[iBand] = nullptr;
 
-                        poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
-                        jobList.emplace_back(std::move(poJob));
-                    }
-                    else
+                    poJobQueue->SubmitJob(JobResampleFunc, poJob.get());
+                    jobList.emplace_back(std::move(poJob));
+                }
+                else
+                {
+                    JobResampleFunc(poJob.get());
+                    eErr = poJob->eErr;
+                    if (eErr == CE_None)
                     {
-                        JobResampleFunc(poJob.get());
-                        eErr = poJob->eErr;
-                        if (eErr == CE_None)
-                        {
-                            eErr = WriteJobData(poJob.get());
-                        }
+                        eErr = WriteJobData(poJob.get());
                     }
                 }
             }
         }
+    }
 
-        // Wait for all pending jobs to complete
-        while (!jobList.empty())
-        {
-            const auto l_eErr = WaitAndFinalizeOldestJob(jobList);
-            if (l_eErr != CE_None && eErr == CE_None)
-                eErr = l_eErr;
-        }
+    // Wait for all pending jobs to complete
+    while (!jobList.empty())
+    {
+        const auto l_eErr = WaitAndFinalizeOldestJob(jobList);
+        if (l_eErr != CE_None && eErr == CE_None)
+            eErr = l_eErr;
+    }
 
-        // Flush the data to overviews.
+    // Flush the data to overviews.
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
         for (int iBand = 0; iBand < nBands; ++iBand)
         {
-            CPLFree(apaChunk[iBand]);
+            CPLFree(aoLevels[iOverview].apaChunk[iBand]);
             papapoOverviewBands[iBand][iOverview]->FlushCache(false);
 
-            CPLFree(apabyChunkNoDataMask[iBand]);
+            CPLFree(aoLevels[iOverview].apabyChunkNoDataMask[iBand]);
         }
     }
-
     CPLFree(pabHasNoData);
     CPLFree(padfNoDataValue);
 
@@ -5570,12 +5776,18 @@ CPLErr GDALRegenerateOverviewsMultiBand(
  * It does not support color tables or complex data types.
  *
  * The pseudo-algorithm used by the function is :
- *    for each overview
- *       iterate on lines of the source by a step of deltay
+ *    while there are overview lines to compute
+ *       pick the smallest overview whose next strip of lines only depends
+ *       on already computed lines of its source (the previous overview or the
+ *       full resolution bands)
  *           iterate on columns of the source  by a step of deltax
  *               read the source data of size deltax * deltay for all the bands
  *               generate the corresponding overview block for all the bands
  *
+ * Consequently, overview level N+1 is computed from the lines of level N as
+ * soon as they are available, while they are still in the block cache,
+ * instead of after a full pass on level N.
+ *
  * This function will honour properly NODATA_VALUES tuples (special dataset
  * metadata) so that only a given RGB triplet (in case of a RGB image) will be
  * considered as the nodata value and not each value of the triplet
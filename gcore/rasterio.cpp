@@ -44,6 +44,7 @@
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -227,6 +228,12 @@ CPLErr GDALRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         return CE_Failure;
     }
 
+    if (eRWFlag == GF_Read && nBufXSize >= nXSize && nBufYSize >= nYSize)
+    {
+        GDALRasterBand *poThis = this;
+        PrefetchBlocksMultiThreaded(&poThis, 1, nXOff, nYOff, nXSize, nYSize);
+    }
+
     const int nBandDataSize = GDALGetDataTypeSizeBytes(eDataType);
     const int nBufDataSize = GDALGetDataTypeSizeBytes(eBufType);
     GByte dummyBlock[2] = {0, 0};
@@ -4051,6 +4058,16 @@ CPLErr GDALDataset::BlockBasedRasterIO(
         }
     }
 
+    if (eRWFlag == GF_Read && nBufXSize >= nXSize && nBufYSize >= nYSize)
+    {
+        std::vector<GDALRasterBand *> apoBands;
+        for (int iBand = 0; iBand < nBandCount; iBand++)
+            apoBands.push_back(GetRasterBand(panBandMap[iBand]));
+        GDALRasterBand::PrefetchBlocksMultiThreaded(apoBands.data(), nBandCount,
+                                                    nXOff, nYOff, nXSize,
+                                                    nYSize);
+    }
+
     /* ==================================================================== */
     /*      In this special case at full resolution we step through in      */
     /*      blocks, turning the request over to the per-band                */
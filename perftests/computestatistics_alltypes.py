@@ -0,0 +1,63 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2024, GDAL contributors
+
+# Benchmark of ComputeStatistics() and ComputeRasterMinMax() on all numeric
+# data types, with and without nodata value, and with GDAL_NUM_THREADS.
+
+import timeit
+
+from osgeo import gdal
+
+data_types = (
+    gdal.GDT_Byte,
+    gdal.GDT_Int8,
+    gdal.GDT_UInt16,
+    gdal.GDT_Int16,
+    gdal.GDT_UInt32,
+    gdal.GDT_Int32,
+    gdal.GDT_UInt64,
+    gdal.GDT_Int64,
+    gdal.GDT_Float32,
+    gdal.GDT_Float64,
+)
+
+tab_ds = {}
+for dt in data_types:
+    for with_nodata in (False, True):
+        ds = gdal.GetDriverByName("MEM").Create("", 10000, 1000, 1, dt)
+        band = ds.GetRasterBand(1)
+        band.Fill(1)
+        if with_nodata:
+            band.SetNoDataValue(0)
+        tab_ds[(dt, with_nodata)] = ds
+
+
+def test_stats(dt, with_nodata):
+    tab_ds[(dt, with_nodata)].GetRasterBand(1).ComputeStatistics(False)
+
+
+def test_minmax(dt, with_nodata):
+    tab_ds[(dt, with_nodata)].GetRasterBand(1).ComputeRasterMinMax(False)
+
+
+NITERS = 100
+setup = "from osgeo import gdal; from __main__ import test_stats, test_minmax"
+for num_threads in ("1", "ALL_CPUS"):
+    with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+        for dt in data_types:
+            for with_nodata in (False, True):
+                for func in ("test_stats", "test_minmax"):
+                    print(
+                        "%s(%s, nodata=%s, GDAL_NUM_THREADS=%s): %.3f"
+                        % (
+                            func,
+                            gdal.GetDataTypeName(dt),
+                            with_nodata,
+                            num_threads,
+                            timeit.timeit(
+                                "%s(%d, %s)" % (func, dt, with_nodata),
+                                setup=setup,
+                                number=NITERS,
+                            ),
+                        )
+                    )